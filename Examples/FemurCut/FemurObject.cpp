@@ -113,10 +113,10 @@ FemurObject::createVisualModels()
 void
 FemurObject::updateModifiedVoxels()
 {
-    // Forward the level set's modified nodes to the isosurface extraction
-    for (auto i : getLevelSetModel()->getNodesToUpdate())
+    // Forward the bounds of the level set's modified tiles to the isosurface extraction
+    for (const auto* tile : getLevelSetModel()->getNodesToUpdate().getActiveTiles())
     {
-        m_isoExtract->setModified(std::get<0>(i.second));
+        m_isoExtract->setModifiedRegion(tile->activeMin, tile->activeMax);
     }
 }
 
@@ -0,0 +1,186 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkCollidingObject.h"
+#include "imstkGeometryUtilities.h"
+#include "imstkLogger.h"
+#include "imstkNew.h"
+#include "imstkPbdModel.h"
+#include "imstkPbdModelConfig.h"
+#include "imstkPbdObject.h"
+#include "imstkScene.h"
+#include "imstkSceneThroughputRunner.h"
+#include "imstkSphObjectCollision.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkThreadManager.h"
+
+// Ball drop scene of the SPHFluid example
+#define SCENE_ID 1
+#include "../SPHFluid/Fluid.hpp"
+#include "../SPHFluid/Solid.hpp"
+
+#include <iostream>
+
+using namespace imstk;
+
+///
+/// \brief Cloth of the PBDCloth example, without its textures
+///
+static std::shared_ptr<Scene>
+makePbdClothScene()
+{
+    auto scene = std::make_shared<Scene>("PBDCloth");
+
+    const int rowCount = 16;
+    const int colCount = 16;
+    std::shared_ptr<SurfaceMesh> clothMesh =
+        GeometryUtils::toTriangleGrid(Vec3d::Zero(),
+            Vec2d(10.0, 10.0), Vec2i(rowCount, colCount), Quatd::Identity(), 2.0);
+
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0e2);
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Dihedral, 1.0e1);
+    pbdParams->m_gravity    = Vec3d(0.0, -9.8, 0.0);
+    pbdParams->m_dt         = 0.005;
+    pbdParams->m_iterations = 5;
+
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->configure(pbdParams);
+
+    auto clothObj = std::make_shared<PbdObject>("Cloth");
+    clothObj->setVisualGeometry(clothMesh);
+    clothObj->setPhysicsGeometry(clothMesh);
+    clothObj->setDynamicalModel(pbdModel);
+    clothObj->getPbdBody()->fixedNodeIds     = { 0, colCount - 1 };
+    clothObj->getPbdBody()->uniformMassValue = 10.0 * 10.0 / (rowCount * colCount);
+    scene->addSceneObject(clothObj);
+
+    return scene;
+}
+
+///
+/// \brief Fluid ball dropped on a sphere between two planes, the SPHFluid-BallDrop example
+///
+static std::shared_ptr<Scene>
+makeSphFluidScene(const double particleRadius)
+{
+    auto scene = std::make_shared<Scene>("SPHFluid");
+
+    std::shared_ptr<SphObject> fluidObj = generateFluid(particleRadius);
+    scene->addSceneObject(fluidObj);
+    for (std::shared_ptr<CollidingObject> solid : generateSolids(scene))
+    {
+        scene->addSceneObject(solid);
+        scene->addInteraction(std::make_shared<SphObjectCollision>(fluidObj, solid));
+    }
+
+    return scene;
+}
+
+///
+/// \brief Steps a scene headless, without a viewer, and reports the per TaskNode compute time
+/// percentiles, the critical path length and the steps per second as json. Meant to track the
+/// scene throughput in CI, the json is printed or written to the out file.
+///
+/// \brief Usage: ./SceneThroughput [scene=<PBDCloth|SPHFluid>] [steps=<num_steps>] [warmup=<num_steps>]
+///     [dt=<time_step>] [threads=<num_threads>] [radius=<sph_particle_radius>] [out=<file.json>]
+/// \brief Example: ./SceneThroughput scene=SPHFluid steps=500 threads=4 out=sph.json
+///
+int
+main(int argc, char* argv[])
+{
+    // Setup logger (write to file and stdout)
+    Logger::startLogger();
+
+    std::string sceneName      = "PBDCloth";
+    std::string outFileName    = "";
+    int         numSteps       = 1000;
+    int         numWarmupSteps = 10;
+    double      dt = 0.01;
+    double      particleRadius = 0.1;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string param = std::string(argv[i]);
+        const size_t      eqPos = param.find_first_of("=");
+        if (eqPos == std::string::npos)
+        {
+            LOG(FATAL) << "Invalid argument " << param;
+        }
+        const std::string key   = param.substr(0, eqPos);
+        const std::string value = param.substr(eqPos + 1);
+        if (key == "scene")
+        {
+            sceneName = value;
+        }
+        else if (key == "steps")
+        {
+            numSteps = std::stoi(value);
+        }
+        else if (key == "warmup")
+        {
+            numWarmupSteps = std::stoi(value);
+        }
+        else if (key == "dt")
+        {
+            dt = std::stod(value);
+        }
+        else if (key == "threads")
+        {
+            ParallelUtils::ThreadManager::setThreadPoolSize(static_cast<size_t>(std::stoi(value)));
+        }
+        else if (key == "radius")
+        {
+            particleRadius = std::stod(value);
+        }
+        else if (key == "out")
+        {
+            outFileName = value;
+        }
+        else
+        {
+            LOG(FATAL) << "Invalid argument " << param;
+        }
+    }
+
+    std::shared_ptr<Scene> scene = nullptr;
+    if (sceneName == "PBDCloth")
+    {
+        scene = makePbdClothScene();
+    }
+    else if (sceneName == "SPHFluid")
+    {
+        scene = makeSphFluidScene(particleRadius);
+    }
+    else
+    {
+        LOG(FATAL) << "Unknown scene " << sceneName << ", expected PBDCloth or SPHFluid";
+    }
+
+    SceneThroughputRunner runner;
+    runner.setScene(scene);
+    runner.setDt(dt);
+    runner.setNumSteps(numSteps);
+    runner.setNumWarmupSteps(numWarmupSteps);
+    if (!runner.run())
+    {
+        return 1;
+    }
+
+    LOG(INFO) << sceneName << ": " << runner.getStepsPerSecond() << " steps/s, critical path p50 " <<
+        runner.getCriticalPathStats().p50 << "ms, p99 " << runner.getCriticalPathStats().p99 << "ms";
+    if (outFileName.empty())
+    {
+        std::cout << runner.toJson();
+    }
+    else if (!runner.writeJson(outFileName))
+    {
+        return 1;
+    }
+
+    return 0;
+}
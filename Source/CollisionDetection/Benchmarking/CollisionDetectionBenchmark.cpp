@@ -0,0 +1,367 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkBidirectionalPlaneToSphereCD.h"
+#include "imstkCapsule.h"
+#include "imstkCapsuleToCapsuleCD.h"
+#include "imstkClosedSurfaceMeshToCapsuleCD.h"
+#include "imstkClosedSurfaceMeshToMeshCD.h"
+#include "imstkCollisionData.h"
+#include "imstkCylinder.h"
+#include "imstkGeometryUtilities.h"
+#include "imstkImplicitGeometryToPointSetCCD.h"
+#include "imstkImplicitGeometryToPointSetCD.h"
+#include "imstkLineMesh.h"
+#include "imstkLineMeshToCapsuleCD.h"
+#include "imstkLineMeshToLineMeshCCD.h"
+#include "imstkLineMeshToSphereCD.h"
+#include "imstkOrientedBox.h"
+#include "imstkPlane.h"
+#include "imstkPointSetToCapsuleCD.h"
+#include "imstkPointSetToCylinderCD.h"
+#include "imstkPointSetToOrientedBoxCD.h"
+#include "imstkPointSetToPlaneCD.h"
+#include "imstkPointSetToSphereCD.h"
+#include "imstkSphere.h"
+#include "imstkSphereToCapsuleCD.h"
+#include "imstkSphereToCylinderCD.h"
+#include "imstkSphereToSphereCD.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkSurfaceMeshToCapsuleCD.h"
+#include "imstkSurfaceMeshToSphereCD.h"
+#include "imstkSurfaceMeshToSurfaceMeshCD.h"
+#include "imstkTetraToLineMeshCD.h"
+#include "imstkTetraToPointSetCD.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkThreadManager.h"
+#include "imstkUnidirectionalPlaneToCapsuleCD.h"
+#include "imstkUnidirectionalPlaneToSphereCD.h"
+#include "imstkVecDataArray.h"
+
+#include <benchmark/benchmark.h>
+
+#include <thread>
+
+using namespace imstk;
+
+// Every algorithm is run on a pair of unit sized geometries, A centered at the origin and B
+// shifted along +x so that B overlaps the last depth percent of A. The arguments are
+//  range(0): resolution of the meshes (divisions per side), unused for primitives
+//  range(1): overlap in percent of the geometry size, 0 is touching, controls the contact density
+//  range(2): number of threads of the thread pool
+//
+// Results can be tracked across builds with google-benchmark's json reporter, ie:
+//  CollisionDetectionBenchmark --benchmark_out=cd.json --benchmark_out_format=json
+
+using MeshMaker = std::shared_ptr<Geometry> (*)(const int resolution, const Vec3d& center);
+using PrimitiveMaker = std::shared_ptr<Geometry> (*)(const Vec3d& center);
+using CDMaker = std::shared_ptr<CollisionDetectionAlgorithm> (*)();
+
+///
+/// \brief Center of geometry B for the overlap in range(1)
+///
+static Vec3d
+getCenterB(const benchmark::State& state)
+{
+    return Vec3d(1.0 - static_cast<double>(state.range(1)) / 100.0, 0.0, 0.0);
+}
+
+///
+/// \brief Thread counts swept, serial and all hardware threads
+///
+static std::vector<int64_t>
+getThreadCounts()
+{
+    const int64_t maxThreads = std::max(static_cast<int64_t>(std::thread::hardware_concurrency()), static_cast<int64_t>(1));
+    return (maxThreads == 1) ? std::vector<int64_t>{ 1 } : std::vector<int64_t>{ 1, maxThreads };
+}
+
+///
+/// \brief Factory of the algorithm benchmarked
+///
+template<typename CDType>
+static std::shared_ptr<CollisionDetectionAlgorithm>
+makeCD()
+{
+    return std::make_shared<CDType>();
+}
+
+///
+/// \brief Meshes spanning [-0.5, 0.5] about center
+///@{
+static std::shared_ptr<Geometry>
+makeTriangleGrid(const int resolution, const Vec3d& center)
+{
+    return GeometryUtils::toTriangleGrid(center, Vec2d(1.0, 1.0), Vec2i(resolution, resolution));
+}
+
+static std::shared_ptr<Geometry>
+makeClosedSurfaceMesh(const int resolution, const Vec3d& center)
+{
+    return GeometryUtils::toUVSphereSurfaceMesh(std::make_shared<Sphere>(center, 0.5), resolution, resolution);
+}
+
+static std::shared_ptr<Geometry>
+makeTetGrid(const int resolution, const Vec3d& center)
+{
+    return GeometryUtils::toTetGrid(center, Vec3d(1.0, 1.0, 1.0), Vec3i(resolution, resolution, resolution));
+}
+
+static std::shared_ptr<Geometry>
+makePointGrid(const int resolution, const Vec3d& center)
+{
+    auto tetMesh  = std::dynamic_pointer_cast<TetrahedralMesh>(makeTetGrid(resolution, center));
+    auto pointSet = std::make_shared<PointSet>();
+    pointSet->initialize(std::make_shared<VecDataArray<double, 3>>(*tetMesh->getVertexPositions()));
+    return pointSet;
+}
+
+///
+/// \brief Serpentine polyline in the xz plane, with its rows along x or z
+///
+static std::shared_ptr<LineMesh>
+makeSerpentine(const int resolution, const Vec3d& center, const bool rowsAlongX)
+{
+    auto vertices = std::make_shared<VecDataArray<double, 3>>();
+    auto indices  = std::make_shared<VecDataArray<int, 2>>();
+    const double spacing = 1.0 / static_cast<double>(resolution - 1);
+    for (int i = 0; i < resolution; ++i)
+    {
+        for (int j = 0; j < resolution; ++j)
+        {
+            // Alternate the direction of the rows so consecutive vertices are neighbors
+            const double u = -0.5 + spacing * ((i % 2 == 0) ? j : resolution - 1 - j);
+            const double v = -0.5 + spacing * i;
+            vertices->push_back(center + (rowsAlongX ? Vec3d(u, 0.0, v) : Vec3d(v, 0.0, u)));
+        }
+    }
+    for (int i = 0; i < vertices->size() - 1; ++i)
+    {
+        indices->push_back(Vec2i(i, i + 1));
+    }
+    auto lineMesh = std::make_shared<LineMesh>();
+    lineMesh->initialize(vertices, indices);
+    return lineMesh;
+}
+
+static std::shared_ptr<Geometry>
+makeLineMesh(const int resolution, const Vec3d& center)
+{
+    return makeSerpentine(resolution, center, true);
+}
+
+///@}
+
+///
+/// \brief Primitives of unit size about center
+///@{
+static std::shared_ptr<Geometry>
+makeSphere(const Vec3d& center)
+{
+    return std::make_shared<Sphere>(center, 0.5);
+}
+
+static std::shared_ptr<Geometry>
+makeCapsule(const Vec3d& center)
+{
+    return std::make_shared<Capsule>(center, 0.5, 0.5);
+}
+
+static std::shared_ptr<Geometry>
+makeCylinder(const Vec3d& center)
+{
+    return std::make_shared<Cylinder>(center, 0.5, 1.0);
+}
+
+static std::shared_ptr<Geometry>
+makeOrientedBox(const Vec3d& center)
+{
+    return std::make_shared<OrientedBox>(center, Vec3d(0.5, 0.5, 0.5));
+}
+
+///
+/// \brief Planes on the +x (A side) and -x (B side) face of the unit cell, facing outwards
+///@{
+static std::shared_ptr<Geometry>
+makePlanePosX(const Vec3d& center)
+{
+    return std::make_shared<Plane>(center + Vec3d(0.5, 0.0, 0.0), Vec3d(1.0, 0.0, 0.0));
+}
+
+static std::shared_ptr<Geometry>
+makePlaneNegX(const Vec3d& center)
+{
+    return std::make_shared<Plane>(center - Vec3d(0.5, 0.0, 0.0), Vec3d(-1.0, 0.0, 0.0));
+}
+
+///@}
+///@}
+
+///
+/// \brief Run the collision detection on the inputs and report the contacts found
+///
+static void
+runCollisionDetection(benchmark::State& state, std::shared_ptr<CollisionDetectionAlgorithm> cd,
+                      std::shared_ptr<Geometry> geomA, std::shared_ptr<Geometry> geomB,
+                      const int numVertices)
+{
+    ParallelUtils::ThreadManager::setThreadPoolSize(static_cast<size_t>(state.range(2)));
+
+    cd->setInputGeometryA(geomA);
+    cd->setInputGeometryB(geomB);
+    for (auto _ : state)
+    {
+        cd->update();
+    }
+
+    const std::shared_ptr<CollisionData> data = cd->getCollisionData();
+    const double numContacts = static_cast<double>(std::max(data->elementsA.size(), data->elementsB.size()));
+    state.counters["Vertices"]  = numVertices;
+    state.counters["ElementsA"] = static_cast<double>(data->elementsA.size());
+    state.counters["ElementsB"] = static_cast<double>(data->elementsB.size());
+    state.counters["Threads"]   = static_cast<double>(state.range(2));
+    state.counters["Contacts"]  = benchmark::Counter(numContacts, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static int
+getNumVertices(std::shared_ptr<Geometry> geom)
+{
+    auto pointSet = std::dynamic_pointer_cast<PointSet>(geom);
+    return (pointSet == nullptr) ? 0 : pointSet->getNumVertices();
+}
+
+///
+/// \brief Mesh A at the origin against primitive B
+///
+static void
+BM_MeshToPrimitive(benchmark::State& state, CDMaker makeCD, MeshMaker makeMesh, PrimitiveMaker makePrimitive)
+{
+    std::shared_ptr<Geometry> mesh = makeMesh(static_cast<int>(state.range(0)), Vec3d::Zero());
+    runCollisionDetection(state, makeCD(),
+        mesh, makePrimitive(getCenterB(state)), getNumVertices(mesh));
+}
+
+///
+/// \brief Primitive A at the origin against mesh B
+///
+static void
+BM_PrimitiveToMesh(benchmark::State& state, CDMaker makeCD, PrimitiveMaker makePrimitive, MeshMaker makeMesh)
+{
+    std::shared_ptr<Geometry> mesh = makeMesh(static_cast<int>(state.range(0)), getCenterB(state));
+    runCollisionDetection(state, makeCD(),
+        makePrimitive(Vec3d::Zero()), mesh, getNumVertices(mesh));
+}
+
+///
+/// \brief Mesh A at the origin against mesh B
+///
+static void
+BM_MeshToMesh(benchmark::State& state, CDMaker makeCD, MeshMaker makeMeshA, MeshMaker makeMeshB)
+{
+    const int resolution = static_cast<int>(state.range(0));
+    std::shared_ptr<Geometry> meshA = makeMeshA(resolution, Vec3d::Zero());
+    std::shared_ptr<Geometry> meshB = makeMeshB(resolution, getCenterB(state));
+    runCollisionDetection(state, makeCD(),
+        meshA, meshB, getNumVertices(meshA) + getNumVertices(meshB));
+}
+
+///
+/// \brief Primitive A at the origin against primitive B
+///
+static void
+BM_PrimitiveToPrimitive(benchmark::State& state, CDMaker makeCD, PrimitiveMaker makePrimitiveA, PrimitiveMaker makePrimitiveB)
+{
+    runCollisionDetection(state, makeCD(),
+        makePrimitiveA(Vec3d::Zero()), makePrimitiveB(getCenterB(state)), 0);
+}
+
+///
+/// \brief Implicit sphere against a point grid moving along +x, the points
+/// displacements over the step are given to the CCD
+///
+static void
+BM_ImplicitGeometryToPointSetCCD(benchmark::State& state)
+{
+    const Vec3d displacement(0.1, 0.0, 0.0);
+    auto        pointSet = std::dynamic_pointer_cast<PointSet>(
+        makePointGrid(static_cast<int>(state.range(0)), getCenterB(state)));
+    auto displacements = std::make_shared<VecDataArray<double, 3>>(pointSet->getNumVertices());
+    displacements->fill(displacement);
+    pointSet->setVertexAttribute("displacements", displacements);
+
+    runCollisionDetection(state, std::make_shared<ImplicitGeometryToPointSetCCD>(),
+        makeSphere(Vec3d::Zero()), pointSet, pointSet->getNumVertices());
+}
+
+///
+/// \brief Two serpentines with perpendicular rows crossing each other along y over the step
+///
+static void
+BM_LineMeshToLineMeshCCD(benchmark::State& state)
+{
+    const int resolution = static_cast<int>(state.range(0));
+    const Vec3d step(0.0, 0.05, 0.0);
+    std::shared_ptr<LineMesh> lineMeshA = makeSerpentine(resolution, Vec3d::Zero(), true);
+    std::shared_ptr<LineMesh> lineMeshB = makeSerpentine(resolution, getCenterB(state) - step, false);
+
+    std::shared_ptr<LineMesh> prevLineMeshB = lineMeshB->clone();
+    prevLineMeshB->translate(2.0 * step, Geometry::TransformType::ApplyToData);
+
+    auto cd = std::make_shared<LineMeshToLineMeshCCD>();
+    cd->updatePreviousTimestepGeometry(lineMeshA, prevLineMeshB);
+    runCollisionDetection(state, cd,
+        lineMeshA, lineMeshB, lineMeshA->getNumVertices() + lineMeshB->getNumVertices());
+}
+
+// Mesh resolutions, point and tet grids are resolution^3, surfaces and lines resolution^2
+static const std::vector<int64_t> VolumeResolutions  = { 8, 16, 32 };
+static const std::vector<int64_t> SurfaceResolutions = { 16, 64, 256 };
+// Mesh to mesh tests every element pair, keep the resolutions small
+static const std::vector<int64_t> MeshToMeshResolutions = { 8, 16, 32 };
+static const std::vector<int64_t> Overlaps = { 0, 10, 50 };
+
+#define IMSTK_CD_BENCHMARK_ARGS(resolutions)           \
+    ->Unit(benchmark::kMicrosecond)                    \
+    ->ArgNames({ "Resolution", "Overlap", "Threads" }) \
+    ->ArgsProduct({ resolutions, Overlaps, getThreadCounts() })
+
+// PointSet against primitives
+BENCHMARK_CAPTURE(BM_MeshToPrimitive, PointSetToSphereCD, makeCD<PointSetToSphereCD>, makePointGrid, makeSphere) IMSTK_CD_BENCHMARK_ARGS(VolumeResolutions);
+BENCHMARK_CAPTURE(BM_MeshToPrimitive, PointSetToCapsuleCD, makeCD<PointSetToCapsuleCD>, makePointGrid, makeCapsule) IMSTK_CD_BENCHMARK_ARGS(VolumeResolutions);
+BENCHMARK_CAPTURE(BM_MeshToPrimitive, PointSetToCylinderCD, makeCD<PointSetToCylinderCD>, makePointGrid, makeCylinder) IMSTK_CD_BENCHMARK_ARGS(VolumeResolutions);
+BENCHMARK_CAPTURE(BM_MeshToPrimitive, PointSetToOrientedBoxCD, makeCD<PointSetToOrientedBoxCD>, makePointGrid, makeOrientedBox) IMSTK_CD_BENCHMARK_ARGS(VolumeResolutions);
+BENCHMARK_CAPTURE(BM_MeshToPrimitive, PointSetToPlaneCD, makeCD<PointSetToPlaneCD>, makePointGrid, makePlaneNegX) IMSTK_CD_BENCHMARK_ARGS(VolumeResolutions);
+BENCHMARK_CAPTURE(BM_PrimitiveToMesh, ImplicitGeometryToPointSetCD, makeCD<ImplicitGeometryToPointSetCD>, makeSphere, makePointGrid) IMSTK_CD_BENCHMARK_ARGS(VolumeResolutions);
+BENCHMARK(BM_ImplicitGeometryToPointSetCCD) IMSTK_CD_BENCHMARK_ARGS(VolumeResolutions);
+
+// SurfaceMesh against primitives
+BENCHMARK_CAPTURE(BM_MeshToPrimitive, SurfaceMeshToSphereCD, makeCD<SurfaceMeshToSphereCD>, makeTriangleGrid, makeSphere) IMSTK_CD_BENCHMARK_ARGS(SurfaceResolutions);
+BENCHMARK_CAPTURE(BM_MeshToPrimitive, SurfaceMeshToCapsuleCD, makeCD<SurfaceMeshToCapsuleCD>, makeTriangleGrid, makeCapsule) IMSTK_CD_BENCHMARK_ARGS(SurfaceResolutions);
+BENCHMARK_CAPTURE(BM_MeshToPrimitive, ClosedSurfaceMeshToCapsuleCD, makeCD<ClosedSurfaceMeshToCapsuleCD>, makeClosedSurfaceMesh, makeCapsule) IMSTK_CD_BENCHMARK_ARGS(SurfaceResolutions);
+
+// LineMesh against primitives
+BENCHMARK_CAPTURE(BM_MeshToPrimitive, LineMeshToSphereCD, makeCD<LineMeshToSphereCD>, makeLineMesh, makeSphere) IMSTK_CD_BENCHMARK_ARGS(SurfaceResolutions);
+BENCHMARK_CAPTURE(BM_MeshToPrimitive, LineMeshToCapsuleCD, makeCD<LineMeshToCapsuleCD>, makeLineMesh, makeCapsule) IMSTK_CD_BENCHMARK_ARGS(SurfaceResolutions);
+
+// Mesh against mesh
+BENCHMARK_CAPTURE(BM_MeshToMesh, SurfaceMeshToSurfaceMeshCD, makeCD<SurfaceMeshToSurfaceMeshCD>, makeClosedSurfaceMesh, makeClosedSurfaceMesh) IMSTK_CD_BENCHMARK_ARGS(MeshToMeshResolutions);
+BENCHMARK_CAPTURE(BM_MeshToMesh, ClosedSurfaceMeshToMeshCD, makeCD<ClosedSurfaceMeshToMeshCD>, makeClosedSurfaceMesh, makeTriangleGrid) IMSTK_CD_BENCHMARK_ARGS(MeshToMeshResolutions);
+BENCHMARK_CAPTURE(BM_MeshToMesh, TetraToPointSetCD, makeCD<TetraToPointSetCD>, makeTetGrid, makePointGrid) IMSTK_CD_BENCHMARK_ARGS(VolumeResolutions);
+BENCHMARK_CAPTURE(BM_MeshToMesh, TetraToLineMeshCD, makeCD<TetraToLineMeshCD>, makeTetGrid, makeLineMesh) IMSTK_CD_BENCHMARK_ARGS(VolumeResolutions);
+BENCHMARK(BM_LineMeshToLineMeshCCD) IMSTK_CD_BENCHMARK_ARGS(MeshToMeshResolutions);
+
+// Primitive against primitive, the resolution is unused
+static const std::vector<int64_t> NoResolution = { 1 };
+BENCHMARK_CAPTURE(BM_PrimitiveToPrimitive, SphereToSphereCD, makeCD<SphereToSphereCD>, makeSphere, makeSphere) IMSTK_CD_BENCHMARK_ARGS(NoResolution);
+BENCHMARK_CAPTURE(BM_PrimitiveToPrimitive, SphereToCapsuleCD, makeCD<SphereToCapsuleCD>, makeSphere, makeCapsule) IMSTK_CD_BENCHMARK_ARGS(NoResolution);
+BENCHMARK_CAPTURE(BM_PrimitiveToPrimitive, SphereToCylinderCD, makeCD<SphereToCylinderCD>, makeSphere, makeCylinder) IMSTK_CD_BENCHMARK_ARGS(NoResolution);
+BENCHMARK_CAPTURE(BM_PrimitiveToPrimitive, CapsuleToCapsuleCD, makeCD<CapsuleToCapsuleCD>, makeCapsule, makeCapsule) IMSTK_CD_BENCHMARK_ARGS(NoResolution);
+BENCHMARK_CAPTURE(BM_PrimitiveToPrimitive, BidirectionalPlaneToSphereCD, makeCD<BidirectionalPlaneToSphereCD>, makePlanePosX, makeSphere) IMSTK_CD_BENCHMARK_ARGS(NoResolution);
+BENCHMARK_CAPTURE(BM_PrimitiveToPrimitive, UnidirectionalPlaneToSphereCD, makeCD<UnidirectionalPlaneToSphereCD>, makePlanePosX, makeSphere) IMSTK_CD_BENCHMARK_ARGS(NoResolution);
+BENCHMARK_CAPTURE(BM_PrimitiveToPrimitive, UnidirectionalPlaneToCapsuleCD, makeCD<UnidirectionalPlaneToCapsuleCD>, makePlanePosX, makeCapsule) IMSTK_CD_BENCHMARK_ARGS(NoResolution);
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -9,6 +9,7 @@
 #include "imstkLineMesh.h"
 #include "imstkOrientedBox.h"
 #include "imstkPlane.h"
+#include "imstkPointSetBvh.h"
 #include "imstkSphere.h"
 #include "imstkSurfaceMesh.h"
 #include "imstkTetrahedralMesh.h"
@@ -18,6 +19,24 @@
 
 namespace imstk
 {
+namespace
+{
+///
+/// \brief Returns if the ray hits the triangle a, b, c and where
+///
+bool
+testRayToTriangle(const Vec3d& rayStart, const Vec3d& rayDir,
+                  const Vec3d& a, const Vec3d& b, const Vec3d& c, Vec3d& iPt)
+{
+    if (CollisionUtils::testRayToPlane(rayStart, rayDir, a, (b - a).cross(c - a).normalized(), iPt))
+    {
+        const Vec3d uvw = baryCentric(iPt, a, b, c);
+        return uvw[0] >= 0.0 && uvw[1] >= 0.0 && uvw[2] >= 0.0; // Check if within triangle
+    }
+    return false;
+}
+} // namespace
+
 void
 PointPicker::requestUpdate()
 {
@@ -34,66 +53,95 @@ PointPicker::requestUpdate()
 
     std::shared_ptr<Geometry> geomToPick = getInput(0);
     geomToPick->updatePostTransformData();
-    if (auto surfMeshToPick = std::dynamic_pointer_cast<SurfaceMesh>(geomToPick))
+    if (std::dynamic_pointer_cast<SurfaceMesh>(geomToPick) != nullptr
+        || std::dynamic_pointer_cast<TetrahedralMesh>(geomToPick) != nullptr)
     {
-        std::shared_ptr<VecDataArray<double, 3>> verticesPtr = surfMeshToPick->getVertexPositions();
+        auto cellMeshToPick = std::dynamic_pointer_cast<AbstractCellMesh>(geomToPick);
+        if (m_bvh == nullptr)
+        {
+            m_bvh = std::make_shared<PointSetBvh>();
+        }
+        if (m_bvh->getGeometry() != cellMeshToPick || m_bvh->getPrimitiveType() != PointSetBvh::PrimitiveType::Cells)
+        {
+            m_bvh->setGeometry(cellMeshToPick, PointSetBvh::PrimitiveType::Cells);
+        }
+        m_bvh->update();
+        const Bvh& bvh = m_bvh->getBvh();
+
+        std::shared_ptr<VecDataArray<double, 3>> verticesPtr = cellMeshToPick->getVertexPositions();
         const VecDataArray<double, 3>&           vertices    = *verticesPtr;
-        std::shared_ptr<VecDataArray<int, 3>>    indicesPtr  = surfMeshToPick->getCells();
-        const VecDataArray<int, 3>&              indices     = *indicesPtr;
 
-        // Brute force
-        // For every cell
-        for (int i = 0; i < indices.size(); i++)
+        // Current implementation of tets just based off the triangle faces
+        static int faces[4][3] = { { 0, 1, 2 }, { 1, 2, 3 }, { 0, 2, 3 }, { 0, 1, 3 } };
+
+        auto surfMeshToPick = std::dynamic_pointer_cast<SurfaceMesh>(geomToPick);
+        std::shared_ptr<VecDataArray<int, 3>> trianglesPtr = (surfMeshToPick != nullptr) ? surfMeshToPick->getCells() : nullptr;
+        std::shared_ptr<VecDataArray<int, 4>> tetsPtr      = (surfMeshToPick == nullptr) ?
+                                                             std::dynamic_pointer_cast<TetrahedralMesh>(geomToPick)->getCells() : nullptr;
+        const CellTypeId cellType = (surfMeshToPick != nullptr) ? IMSTK_TRIANGLE : IMSTK_TETRAHEDRON;
+
+        // Calls func(iPt) for every face of the cell hit by the ray
+        auto forEachCellHit = [&](const int cellId, auto func)
+                              {
+                                  Vec3d iPt = Vec3d::Zero();
+                                  if (trianglesPtr != nullptr)
+                                  {
+                                      const Vec3i& cell = (*trianglesPtr)[cellId];
+                                      if (testRayToTriangle(m_rayStart, m_rayDir,
+                                          vertices[cell[0]], vertices[cell[1]], vertices[cell[2]], iPt))
+                                      {
+                                          func(iPt);
+                                      }
+                                      return;
+                                  }
+                                  const Vec4i& tet = (*tetsPtr)[cellId];
+                                  for (int j = 0; j < 4; j++)
+                                  {
+                                      if (testRayToTriangle(m_rayStart, m_rayDir, vertices[tet[faces[j][0]]],
+                                          vertices[tet[faces[j][1]]], vertices[tet[faces[j][2]]], iPt))
+                                      {
+                                          func(iPt);
+                                      }
+                                  }
+                              };
+
+        if (m_useFirstHit)
         {
-            const Vec3i& cell = indices[i];
-            const Vec3d& a    = vertices[cell[0]];
-            const Vec3d& b    = vertices[cell[1]];
-            const Vec3d& c    = vertices[cell[2]];
-            const Vec3d  n    = (b - a).cross(c - a).normalized();
-            Vec3d        iPt  = Vec3d::Zero();
-            if (CollisionUtils::testRayToPlane(m_rayStart, m_rayDir, vertices[cell[0]], n, iPt))
-            {
-                const Vec3d uvw = baryCentric(iPt, a, b, c);
-                if (uvw[0] >= 0.0 && uvw[1] >= 0.0 && uvw[2] >= 0.0) // Check if within triangle
+            // Only the closest cell is needed, cells behind it are not tested
+            double    tHit   = 0.0;
+            const int cellId = bvh.findClosestRayHit(m_rayStart, m_rayDir,
+                [&](const int id, double& t)
                 {
-                    resultSet.insert({ { i }, 1, IMSTK_TRIANGLE, iPt });
-                }
+                    bool hit = false;
+                    forEachCellHit(id, [&](const Vec3d& iPt)
+                    {
+                        const double tFace = (iPt - m_rayStart).dot(m_rayDir);
+                        if (!hit || tFace < t)
+                        {
+                            t = tFace;
+                        }
+                        hit = true;
+                    });
+                    return hit;
+                },
+                tHit, (m_maxDist != -1.0) ? m_maxDist : IMSTK_DOUBLE_MAX);
+            if (cellId != -1)
+            {
+                resultSet.insert({ { cellId }, 1, cellType, m_rayStart + m_rayDir * tHit });
             }
         }
-    }
-    else if (auto tetMeshToPick = std::dynamic_pointer_cast<TetrahedralMesh>(geomToPick))
-    {
-        // Current implementation just based off the triangle faces
-        static int faces[4][3] = { { 0, 1, 2 }, { 1, 2, 3 }, { 0, 2, 3 }, { 0, 1, 3 } };
-
-        std::shared_ptr<VecDataArray<double, 3>> verticesPtr = tetMeshToPick->getVertexPositions();
-        const VecDataArray<double, 3>&           vertices    = *verticesPtr;
-        std::shared_ptr<VecDataArray<int, 4>>    indicesPtr  = tetMeshToPick->getCells();
-        const VecDataArray<int, 4>&              indices     = *indicesPtr;
-
-        // For every tet
-        for (int i = 0; i < indices.size(); i++)
+        else
         {
-            const Vec4i& tet = indices[i];
-
-            // For every face
-            for (int j = 0; j < 4; j++)
+            // Insert in order of id, the first cell inserted at a distance is kept
+            std::vector<int> cellIds;
+            bvh.intersectRay(m_rayStart, m_rayDir, [&](const int cellId) { cellIds.push_back(cellId); });
+            std::sort(cellIds.begin(), cellIds.end());
+            for (const int cellId : cellIds)
             {
-                // Find intersection point and add constraints
-                const Vec3d& a = vertices[tet[faces[j][0]]];
-                const Vec3d& b = vertices[tet[faces[j][1]]];
-                const Vec3d& c = vertices[tet[faces[j][2]]];
-
-                Vec3d iPt;
-                if (CollisionUtils::testRayToPlane(m_rayStart, m_rayDir, a,
-                    (b - a).cross(c - a).normalized(), iPt))
+                forEachCellHit(cellId, [&](const Vec3d& iPt)
                 {
-                    const Vec3d uvw = baryCentric(iPt, a, b, c);
-                    if (uvw[0] >= 0.0 && uvw[1] >= 0.0 && uvw[2] >= 0.0) // Check if within triangle
-                    {
-                        resultSet.insert({ { i }, 1, IMSTK_TETRAHEDRON, iPt });
-                    }
-                }
+                    resultSet.insert({ { cellId }, 1, cellType, iPt });
+                });
             }
         }
     }
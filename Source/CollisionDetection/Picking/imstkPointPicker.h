@@ -11,12 +11,14 @@
 namespace imstk
 {
 class CollisionDetectionAlgorithm;
+class PointSetBvh;
 
 ///
 /// \class PointPicker
 ///
 /// \brief Picks points on elements of geomToPick via those that that are
-/// intersecting the provided ray.
+/// intersecting the provided ray. The cells of a SurfaceMesh or TetrahedralMesh
+/// are found through a Bvh, refit when the mesh is modified.
 /// \todo: Make extensible
 ///
 class PointPicker : public PickingAlgorithm
@@ -52,10 +54,20 @@ public:
     bool getUseFirstHit() const { return m_useFirstHit; }
 ///@}
 
+    ///
+    /// \brief Get/Set the tree of the cells of the mesh to pick, created on the first pick
+    /// of a SurfaceMesh or TetrahedralMesh if not set. Pickers of the same mesh can share it
+    /// to avoid rebuilding it
+    ///@{
+    void setBvh(std::shared_ptr<PointSetBvh> bvh) { m_bvh = bvh; }
+    std::shared_ptr<PointSetBvh> getBvh() const { return m_bvh; }
+///@}
+
 protected:
     Vec3d  m_rayStart    = Vec3d::Zero();
     Vec3d  m_rayDir      = Vec3d::Zero();
     double m_maxDist     = -1.0;
     bool   m_useFirstHit = true;
+    std::shared_ptr<PointSetBvh> m_bvh = nullptr;
 };
 } // namespace imstk
\ No newline at end of file
@@ -5,8 +5,12 @@
 */
 
 #include "imstkVertexPicker.h"
-#include "imstkImplicitGeometry.h"
+#include "imstkCapsule.h"
+#include "imstkCylinder.h"
+#include "imstkOrientedBox.h"
 #include "imstkPointSet.h"
+#include "imstkPointSetBvh.h"
+#include "imstkSphere.h"
 #include "imstkVecDataArray.h"
 
 namespace imstk
@@ -24,20 +28,53 @@ VertexPicker::requestUpdate()
     // Use implicit functions available in the geometries to sample if in or out of the shape
     std::shared_ptr<VecDataArray<double, 3>> verticesPtr = pointSetToPick->getVertexPositions();
     VecDataArray<double, 3>&                 vertices    = *verticesPtr;
-    for (int i = 0; i < vertices.size(); i++)
+    auto                                     pickVertex  = [&](const int i)
+                                                           {
+                                                               const double signedDist = m_pickGeometry->getFunctionValue(vertices[i]);
+
+                                                               // If inside the primitive
+                                                               // \todo: come back to this
+                                                               if (signedDist <= 0.0)
+                                                               {
+                                                                   PickData data;
+                                                                   data.ids[0]   = i;
+                                                                   data.idCount  = 1;
+                                                                   data.cellType = IMSTK_VERTEX;
+                                                                   m_results.push_back(data);
+                                                               }
+                                                           };
+
+    // Bounded primitives only need to test the vertices in their bounding box
+    if (std::dynamic_pointer_cast<Sphere>(m_pickGeometry) != nullptr
+        || std::dynamic_pointer_cast<Capsule>(m_pickGeometry) != nullptr
+        || std::dynamic_pointer_cast<Cylinder>(m_pickGeometry) != nullptr
+        || std::dynamic_pointer_cast<OrientedBox>(m_pickGeometry) != nullptr)
     {
-        const double signedDist = m_pickGeometry->getFunctionValue(vertices[i]);
+        if (m_bvh == nullptr)
+        {
+            m_bvh = std::make_shared<PointSetBvh>();
+        }
+        if (m_bvh->getGeometry() != pointSetToPick || m_bvh->getPrimitiveType() != PointSetBvh::PrimitiveType::Vertices)
+        {
+            m_bvh->setGeometry(pointSetToPick, PointSetBvh::PrimitiveType::Vertices);
+        }
+        m_bvh->update();
 
-        // If inside the primitive
-        // \todo: come back to this
-        if (signedDist <= 0.0)
+        Vec3d min, max;
+        m_pickGeometry->computeBoundingBox(min, max);
+        std::vector<int> vertexIds;
+        m_bvh->getBvh().intersectBox(min, max, [&](const int i) { vertexIds.push_back(i); });
+        std::sort(vertexIds.begin(), vertexIds.end());
+        for (const int i : vertexIds)
         {
-            PickData data;
-            data.ids[0]   = i;
-            data.idCount  = 1;
-            data.cellType = IMSTK_VERTEX;
-            m_results.push_back(data);
+            pickVertex(i);
         }
+        return;
+    }
+
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        pickVertex(i);
     }
 }
 } // namespace imstk
\ No newline at end of file
@@ -11,12 +11,14 @@
 namespace imstk
 {
 class ImplicitGeometry;
+class PointSetBvh;
 
 ///
 /// \class VertexPicker
 ///
 /// \brief Picks vertices of geomToPick via those that that are
-/// intersecting pickingGeom.
+/// intersecting pickingGeom. Only the vertices in the bounding box of a bounded
+/// pickingGeom (Sphere, Capsule, Cylinder, OrientedBox) are tested, found through a Bvh.
 ///
 class VertexPicker : public PickingAlgorithm
 {
@@ -29,7 +31,16 @@ public:
     void setPickingGeometry(std::shared_ptr<ImplicitGeometry> pickGeometry) { m_pickGeometry = pickGeometry; }
     std::shared_ptr<ImplicitGeometry> getPickGeometry() const { return m_pickGeometry; }
 
+    ///
+    /// \brief Get/Set the tree of the vertices of the geometry to pick, created on the first
+    /// pick with a bounded pick geometry if not set
+    ///@{
+    void setBvh(std::shared_ptr<PointSetBvh> bvh) { m_bvh = bvh; }
+    std::shared_ptr<PointSetBvh> getBvh() const { return m_bvh; }
+    ///@}
+
 protected:
     std::shared_ptr<ImplicitGeometry> m_pickGeometry = nullptr;
+    std::shared_ptr<PointSetBvh>      m_bvh = nullptr;
 };
 } // namespace imstk
\ No newline at end of file
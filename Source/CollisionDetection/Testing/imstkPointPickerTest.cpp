@@ -262,4 +262,65 @@ TEST(imstkPointerPickerTest, PickOrder)
     EXPECT_EQ(pickData1[0].ids[0], 1);
     EXPECT_EQ(pickData1[1].ids[0], 0);
     EXPECT_EQ(pickData1[2].ids[0], 2);
-}
\ No newline at end of file
+}
+///
+/// \brief Test picking a mesh of two stacked grids, then picking again after
+/// moving it, so the tree is refit
+///
+TEST(imstkPointerPickerTest, PickSurfaceMeshModified)
+{
+    // Two 30x30 grids of triangles in xz at y = 0 and y = -1
+    const int dim = 31;
+    auto      verticesPtr = std::make_shared<VecDataArray<double, 3>>();
+    auto      indicesPtr  = std::make_shared<VecDataArray<int, 3>>();
+    for (int layer = 0; layer < 2; layer++)
+    {
+        const int offset = layer * dim * dim;
+        for (int z = 0; z < dim; z++)
+        {
+            for (int x = 0; x < dim; x++)
+            {
+                verticesPtr->push_back(Vec3d(x, -layer, z));
+                if (x < dim - 1 && z < dim - 1)
+                {
+                    const int i = offset + x + z * dim;
+                    indicesPtr->push_back(Vec3i(i, i + 1, i + dim));
+                    indicesPtr->push_back(Vec3i(i + 1, i + dim + 1, i + dim));
+                }
+            }
+        }
+    }
+    auto surfMesh = std::make_shared<SurfaceMesh>();
+    surfMesh->initialize(verticesPtr, indicesPtr);
+
+    // Ray above the grids pointing down
+    PointPicker picker;
+    picker.setPickingRay(Vec3d(10.25, 5.0, 20.5), Vec3d(0.0, -1.0, 0.0));
+    const std::vector<PickData>& pickData1 = picker.pick(surfMesh);
+    ASSERT_EQ(pickData1.size(), 1);
+    EXPECT_TRUE(pickData1[0].pickPoint.isApprox(Vec3d(10.25, 0.0, 20.5))) <<
+        "Pick Point: " << pickData1[0].pickPoint.transpose();
+    EXPECT_EQ(pickData1[0].ids[0], 2 * (10 + 20 * (dim - 1)));
+
+    picker.setUseFirstHit(false);
+    const std::vector<PickData>& pickData2 = picker.pick(surfMesh);
+    ASSERT_EQ(pickData2.size(), 2);
+    EXPECT_TRUE(pickData2[1].pickPoint.isApprox(Vec3d(10.25, -1.0, 20.5))) <<
+        "Pick Point: " << pickData2[1].pickPoint.transpose();
+
+    // Move the top grid up, out of max distance, and the bottom one away from the ray
+    for (int i = 0; i < verticesPtr->size(); i++)
+    {
+        (*verticesPtr)[i] += (i < dim * dim) ? Vec3d(0.0, 3.0, 0.0) : Vec3d(100.0, 0.0, 0.0);
+    }
+    surfMesh->postModified();
+    picker.setUseFirstHit(true);
+    picker.setPickingRay(Vec3d(10.25, 5.0, 20.5), Vec3d(0.0, -1.0, 0.0), 1.0);
+    EXPECT_EQ(picker.pick(surfMesh).size(), 0);
+
+    picker.setPickingRay(Vec3d(10.25, 5.0, 20.5), Vec3d(0.0, -1.0, 0.0), 3.0);
+    const std::vector<PickData>& pickData3 = picker.pick(surfMesh);
+    ASSERT_EQ(pickData3.size(), 1);
+    EXPECT_TRUE(pickData3[0].pickPoint.isApprox(Vec3d(10.25, 3.0, 20.5))) <<
+        "Pick Point: " << pickData3[0].pickPoint.transpose();
+}
@@ -0,0 +1,98 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkCollisionData.h"
+#include "imstkPbdCollisionHandling.h"
+#include "imstkPbdConstraint.h"
+#include "imstkPbdModel.h"
+#include "imstkPbdModelConfig.h"
+#include "imstkPbdObject.h"
+#include "imstkPlane.h"
+#include "imstkPointSet.h"
+
+#include <gtest/gtest.h>
+
+using namespace imstk;
+
+///
+/// \brief Test that contacts of the same elements are warm started across steps, though
+/// resolved against virtual particles reallocated every step, and forgotten once the
+/// handling does not see them for more than the max age
+///
+TEST(imstkPbdCollisionHandlingTest, WarmStartPersistentContacts)
+{
+    auto pointSet = std::make_shared<PointSet>();
+    pointSet->initialize(std::make_shared<VecDataArray<double, 3>>(
+        VecDataArray<double, 3>({ Vec3d(0.0, -0.1, 0.0), Vec3d(1.0, -0.1, 0.0), Vec3d(2.0, -0.1, 0.0) })));
+
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->getConfig()->m_gravity = Vec3d::Zero();
+    pbdModel->getConfig()->m_dt      = 0.01;
+
+    auto pbdObj = std::make_shared<PbdObject>("Points");
+    pbdObj->setPhysicsGeometry(pointSet);
+    pbdObj->setCollidingGeometry(pointSet);
+    pbdObj->setDynamicalModel(pbdModel);
+    pbdObj->getPbdBody()->uniformMassValue = 1.0;
+    ASSERT_TRUE(pbdObj->initialize());
+    pbdModel->initialize();
+
+    auto planeObj = std::make_shared<CollidingObject>("Plane");
+    planeObj->setCollidingGeometry(std::make_shared<Plane>());
+
+    // Every vertex penetrates the plane, resolved one-way against virtual particles
+    auto colData = std::make_shared<CollisionData>();
+    colData->geomA = pointSet;
+    for (int i = 0; i < 3; i++)
+    {
+        PointIndexDirectionElement elem;
+        elem.ptIndex = i;
+        elem.dir     = Vec3d(0.0, 1.0, 0.0);
+        elem.penetrationDepth = 0.1;
+        colData->elementsA.push_back(elem);
+    }
+
+    auto pbdCH = std::make_shared<PbdCollisionHandling>();
+    pbdCH->setInputObjectA(pbdObj);
+    pbdCH->setInputObjectB(planeObj);
+    pbdCH->setInputCollisionData(colData);
+    pbdCH->setEnableWarmStart(true);
+    pbdCH->setContactMaxAge(2);
+
+    auto step = [&]()
+                {
+                    pbdModel->integratePosition();
+                    pbdCH->update();
+                    for (PbdConstraint* constraint : pbdCH->getConstraints())
+                    {
+                        constraint->warmStart(pbdModel->getBodies());
+                        constraint->projectConstraint(pbdModel->getBodies(),
+                            pbdModel->getConfig()->m_dt, PbdConstraint::SolverType::PBD);
+                    }
+                };
+
+    // Nothing to warm start from on the first step
+    step();
+    ASSERT_EQ(pbdCH->getConstraints().size(), 3);
+    EXPECT_EQ(pbdCH->getNumWarmStartedConstraints(), 0);
+
+    // Move the vertices back in so the contacts persist
+    for (int i = 0; i < 3; i++)
+    {
+        (*pointSet->getVertexPositions())[i][1] = -0.1;
+    }
+    step();
+    EXPECT_EQ(pbdCH->getNumWarmStartedConstraints(), 3);
+
+    // Skip the handling for more than the max age, ie: by the broad phase
+    for (int i = 0; i < 3; i++)
+    {
+        pbdModel->integratePosition();
+    }
+    step();
+    ASSERT_EQ(pbdCH->getConstraints().size(), 3);
+    EXPECT_EQ(pbdCH->getNumWarmStartedConstraints(), 0);
+}
@@ -305,8 +305,15 @@ PbdCollisionHandling::handle(
     const std::vector<CollisionElement>& elementsA,
     const std::vector<CollisionElement>& elementsB)
 {
+    // Remember the multipliers solved for the last contacts before clearing them, contacts
+    // are aged by the steps of the model as the handling may not run every step
+    auto pbdObjectA = std::dynamic_pointer_cast<PbdObject>(getInputObjectA());
+    updateContactHistory(pbdObjectA->getPbdModel()->getStepCount());
+
     // Clear constraints vectors
     m_collisionConstraints.clear();
+    m_contactKeys.clear();
+    m_numWarmStartedConstraints = 0;
 
     // Break early if no collision elements
     if (elementsA.size() == 0 && elementsB.size() == 0)
@@ -365,6 +372,7 @@ PbdCollisionHandling::handle(
         }
     }
 
+    warmStartCollisionConstraints();
     orderCollisionConstraints();
 
     if (m_collisionConstraints.size() == 0)
@@ -373,7 +381,6 @@ PbdCollisionHandling::handle(
     }
 
     // ObjA garunteed to be PbdObject
-    auto pbdObjectA = std::dynamic_pointer_cast<PbdObject>(getInputObjectA());
     pbdObjectA->getPbdModel()->getSolver()->addConstraints(&m_collisionConstraints);
 }
 
@@ -416,6 +423,10 @@ PbdCollisionHandling::handleElementPair(ColElemSide sideA, ColElemSide sideB)
     if (iter != m_funcTable.end())
     {
         iter->second(sideA, sideB);
+        if (m_enableWarmStart)
+        {
+            addContactKeys(sideA, sideB);
+        }
     }
     else
     {
@@ -693,4 +704,147 @@ PbdCollisionHandling::orderCollisionConstraints()
         m_constraintBins[i].resize(0);
     }
 }
-} // namespace imstk
\ No newline at end of file
+
+std::size_t
+PbdCollisionHandling::ContactKeyHash::operator()(const ContactKey& key) const
+{
+    std::size_t seed    = 0;
+    auto        combine = [&seed](const int value)
+                          {
+                              seed ^= std::hash<int>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                          };
+    combine(key.type);
+    combine(key.occurrence);
+    for (const int id : key.objects)
+    {
+        combine(id);
+    }
+    for (const int id : key.features)
+    {
+        combine(id);
+    }
+    return seed;
+}
+
+void
+PbdCollisionHandling::updateContactHistory(const size_t step)
+{
+    if (!m_enableWarmStart)
+    {
+        m_contactHistory.clear();
+        m_contactStep = step;
+        return;
+    }
+
+    // Keys are in the order of the constraints
+    for (size_t i = 0; i < m_collisionConstraints.size() && i < m_contactKeys.size(); i++)
+    {
+        if (m_contactKeys[i].type != -1)
+        {
+            ContactHistory& history = m_contactHistory[m_contactKeys[i]];
+            history.lambda = m_collisionConstraints[i]->getAccumulatedLambda();
+            history.step   = m_contactStep;
+        }
+    }
+
+    // Also forgets the contacts just recorded if the handling was skipped for too long
+    for (auto iter = m_contactHistory.begin(); iter != m_contactHistory.end();)
+    {
+        if (step > iter->second.step + static_cast<size_t>(m_contactMaxAge))
+        {
+            iter = m_contactHistory.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+    m_contactStep = step;
+}
+
+void
+PbdCollisionHandling::addContactKeys(const ColElemSide& sideA, const ColElemSide& sideB)
+{
+    // Features of the collision elements, stable across steps unlike virtual particles
+    ContactKey   key;
+    const size_t numFeatures = key.features.size() / 2;
+    bool         matchable   = true;
+    for (int i = 0; i < 2; i++)
+    {
+        const ColElemSide& side = (i == 0) ? sideA : sideB;
+        if (side.elem == nullptr)
+        {
+            continue;
+        }
+        key.objects[i] = static_cast<int>(side.data->colObj->getID());
+
+        int* features = &key.features[i * numFeatures];
+        features[0] = static_cast<int>(side.elem->m_type);
+        const CollisionElement::Element& elem = side.elem->m_element;
+        if (side.elem->m_type == CollisionElementType::CellIndex)
+        {
+            features[1] = static_cast<int>(elem.m_CellIndexElement.cellType);
+            for (int j = 0; j < elem.m_CellIndexElement.idCount && j < 4; j++)
+            {
+                features[2 + j] = elem.m_CellIndexElement.ids[j];
+            }
+        }
+        else if (side.elem->m_type == CollisionElementType::PointIndexDirection)
+        {
+            features[2] = elem.m_PointIndexDirectionElement.ptIndex;
+        }
+        else if (side.elem->m_type == CollisionElementType::CellVertex)
+        {
+            // Vertices given by value have no ids to match
+            matchable = false;
+        }
+    }
+
+    // Give the key to the constraints the element pair added, whichever their type
+    for (int i = 0; i < NumTypes; i++)
+    {
+        key.type = matchable ? i : -1;
+        while (m_contactKeyBins[i].size() < m_constraintBins[i].size())
+        {
+            m_contactKeyBins[i].push_back(key);
+        }
+    }
+}
+
+void
+PbdCollisionHandling::warmStartCollisionConstraints()
+{
+    // Number of contacts of each type and features, distinguishes several contacts
+    // between the same features
+    std::unordered_map<ContactKey, int, ContactKeyHash> occurrences;
+
+    // Iterated in the order of orderCollisionConstraints
+    for (int i = 0; i < NumTypes; i++)
+    {
+        for (size_t j = 0; j < m_constraintBins[i].size(); j++)
+        {
+            double lambda = 0.0;
+            if (m_enableWarmStart)
+            {
+                // Constraints added outside of handleElementPair have no key
+                ContactKey key = (j < m_contactKeyBins[i].size()) ? m_contactKeyBins[i][j] : ContactKey();
+                if (key.type != -1)
+                {
+                    key.occurrence = occurrences[key]++;
+
+                    auto iter = m_contactHistory.find(key);
+                    if (iter != m_contactHistory.end() && iter->second.lambda != 0.0)
+                    {
+                        lambda = m_warmStartFactor * iter->second.lambda;
+                        m_numWarmStartedConstraints++;
+                    }
+                }
+                m_contactKeys.push_back(key);
+            }
+            // Always set, constraints are reused from the cache
+            m_constraintBins[i][j]->setWarmStartLambda(lambda);
+        }
+        m_contactKeyBins[i].clear();
+    }
+}
+} // namespace imstk
@@ -217,6 +217,39 @@ public:
     double getDeformableStiffnessB() const { return m_stiffness[1]; }
     /// @}
 
+    ///
+    /// \brief Get/Set whether contacts persist across steps. New contacts are matched
+    /// to the ones of the previous steps by constraint type and collision element features
+    /// (the ids of the contacting vertices, edges, triangles or cells and of their objects),
+    /// and their solve is warm started with the multipliers solved for them. Contacts of
+    /// elements without ids (CellVertexElement) are not matched. Defaults off
+    /// @{
+    void setEnableWarmStart(const bool enableWarmStart) { m_enableWarmStart = enableWarmStart; }
+    bool getEnableWarmStart() const { return m_enableWarmStart; }
+    /// @}
+
+    ///
+    /// \brief Get/Set the fraction of the previous multiplier a matched contact is warm
+    /// started with. Below 1 to not push apart separating contacts too far
+    /// @{
+    void setWarmStartFactor(const double warmStartFactor) { m_warmStartFactor = warmStartFactor; }
+    double getWarmStartFactor() const { return m_warmStartFactor; }
+    /// @}
+
+    ///
+    /// \brief Get/Set the number of steps an unmatched contact is remembered for. Steps
+    /// of the PbdModel are counted, also the ones the handling did not run for
+    /// @{
+    void setContactMaxAge(const int contactMaxAge) { m_contactMaxAge = contactMaxAge; }
+    int getContactMaxAge() const { return m_contactMaxAge; }
+    /// @}
+
+    ///
+    /// \brief Returns the number of constraints of the last step warm started from a
+    /// previous contact
+    ///
+    int getNumWarmStartedConstraints() const { return m_numWarmStartedConstraints; }
+
     ///
     /// \brief Return the constraints generated by this handler
     /// This list of constraints is ordered in orderCollisionConstraints
@@ -313,6 +346,9 @@ private:
     bool   m_useCorrectVelocity       = true;
     std::array<double, 2> m_stiffness = { 0.3, 0.3 };
     int m_ccdSubsteps = 25;
+    bool   m_enableWarmStart = false;
+    double m_warmStartFactor = 0.8;
+    int    m_contactMaxAge   = 2;
 
     ///
     /// \brief Clear the collision constraints without clearning memory
@@ -327,6 +363,24 @@ private:
     ///
     void orderCollisionConstraints();
 
+    ///
+    /// \brief Remember the multipliers solved for the constraints of the previous
+    /// handling and forget the contacts unmatched for too long
+    /// \param Current step of the model
+    ///
+    void updateContactHistory(const size_t step);
+
+    ///
+    /// \brief Record the key of the constraints added for the element pair
+    ///
+    void addContactKeys(const ColElemSide& sideA, const ColElemSide& sideB);
+
+    ///
+    /// \brief Set the warm start multipliers of the binned constraints from the
+    /// contact history and record their keys
+    ///
+    void warmStartCollisionConstraints();
+
 protected:
 
     // Enum for binning constraint types to order for solver
@@ -360,6 +414,41 @@ protected:
 
     std::vector<PbdConstraint*> m_collisionConstraints; ///< Vector of all collision constraints
 
+    ///
+    /// \brief Identifies a contact across steps by its constraint type, the features of its
+    /// collision elements and occurrence among the contacts sharing both (ie: several contacts
+    /// of two bodies). Particles are not used as the virtual ones are reallocated every step
+    ///
+    struct ContactKey
+    {
+        int type       = -1; ///< Constraint type, -1 if the contact can't be matched
+        int occurrence = 0;
+        std::array<int, 2> objects = { -1, -1 };
+        /// Per side the element type, cell type and up to 4 ids
+        std::array<int, 12> features = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+
+        bool operator==(const ContactKey& other) const
+        {
+            return type == other.type && occurrence == other.occurrence
+                   && objects == other.objects && features == other.features;
+        }
+    };
+    struct ContactKeyHash
+    {
+        std::size_t operator()(const ContactKey& key) const;
+    };
+    struct ContactHistory
+    {
+        double lambda = 0.0;
+        size_t step   = 0; ///< Step of the model the contact was last matched
+    };
+
+    std::vector<ContactKey> m_contactKeyBins[NumTypes]; ///< Keys of the binned constraints
+    std::vector<ContactKey> m_contactKeys;              ///< Keys of the collision constraints
+    size_t m_contactStep = 0;                           ///< Step of the model the constraints were made
+    std::unordered_map<ContactKey, ContactHistory, ContactKeyHash> m_contactHistory;
+    int m_numWarmStartedConstraints = 0;
+
     std::unordered_map<PbdCHTableKey, std::function<void(
                                                         const ColElemSide& elemA, const ColElemSide& elemB)>> m_funcTable;
 };
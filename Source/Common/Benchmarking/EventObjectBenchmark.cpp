@@ -0,0 +1,104 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkEventObject.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace imstk;
+
+class BenchmarkSender : public EventObject
+{
+public:
+    // *INDENT-OFF*
+    SIGNAL(BenchmarkSender, posted);
+    // *INDENT-ON*
+
+    void post() { postEvent(Event(posted())); }
+};
+
+class BenchmarkReceiver : public EventObject
+{
+public:
+    void receive(Event*) { m_count++; }
+
+    int m_count = 0;
+};
+
+///
+/// \brief Receiver shared by all the threads of a benchmark
+///
+static std::shared_ptr<BenchmarkReceiver>
+getSharedReceiver()
+{
+    static auto receiver = std::make_shared<BenchmarkReceiver>();
+    return receiver;
+}
+
+///
+/// \brief Posting an event with no, or range(0) direct observers
+///
+static void
+BM_PostDirect(benchmark::State& state)
+{
+    auto sender   = std::make_shared<BenchmarkSender>();
+    auto receiver = std::make_shared<BenchmarkReceiver>();
+    for (int i = 0; i < state.range(0); i++)
+    {
+        connect(sender, &BenchmarkSender::posted, receiver, &BenchmarkReceiver::receive);
+    }
+
+    for (auto _ : state)
+    {
+        sender->post();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_PostDirect)
+->Name("Post to direct observers")
+->Arg(0)->Arg(1)->Arg(4);
+
+///
+/// \brief Posting from every thread to the queue of a single receiver, the first
+/// thread also processes the queue
+///
+static void
+BM_PostQueued(benchmark::State& state)
+{
+    const int batchSize = 64;
+
+    std::shared_ptr<BenchmarkReceiver> receiver = getSharedReceiver();
+    auto                               sender   = std::make_shared<BenchmarkSender>();
+    queueConnect(sender, &BenchmarkSender::posted, receiver, &BenchmarkReceiver::receive);
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < batchSize; i++)
+        {
+            sender->post();
+        }
+        if (state.thread_index() == 0)
+        {
+            receiver->doAllEvents();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+
+    disconnect(sender, receiver, &BenchmarkSender::posted);
+    if (state.thread_index() == 0)
+    {
+        receiver->clearEvents();
+    }
+}
+
+BENCHMARK(BM_PostQueued)
+->Name("Post to a queued observer")
+->ThreadRange(1, 8)
+->UseRealTime();
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -20,7 +20,7 @@ template<class T, class Function>
 void
 atomicOp(T& target, const T operand, Function&& f)
 {
-    std::atomic<T>& tgt = *(static_cast<std::atomic<T>*>(&target));
+    std::atomic<T>& tgt = *(reinterpret_cast<std::atomic<T>*>(&target));
 
     T cur_val = target;
     T new_val;
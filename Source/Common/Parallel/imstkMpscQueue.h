@@ -0,0 +1,196 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkSpinLock.h"
+
+#include <atomic>
+#include <utility>
+
+namespace imstk
+{
+namespace ParallelUtils
+{
+///
+/// \class MpscQueue
+///
+/// \brief Unbounded multi producer, single consumer FIFO queue. Pushing is lock free,
+/// a producer only swaps the head of the list and links the previous head to its node.
+/// Popping is serialized by a SpinLock that producers never take, so multiple threads
+/// may still consume, one at a time.
+/// An element pushed while another producer is between its swap and link only becomes
+/// visible to the consumer once that link is done, the queue then appears shorter.
+/// Popped nodes are kept in a free list and reused by the next pushes. Producers only
+/// try to take one, they allocate instead of waiting when another thread holds the list.
+/// Copying a queue gives an empty queue, as does the SpinLock copy an unlocked one.
+///
+template<typename T>
+class MpscQueue
+{
+protected:
+    struct Node
+    {
+        Node() = default;
+        Node(T&& val) : value(std::move(val)) { }
+
+        std::atomic<Node*> next = { nullptr };
+        T value;
+    };
+
+public:
+    MpscQueue() : m_head(new Node()), m_tail(m_head.load(std::memory_order_relaxed)) { }
+    MpscQueue(const MpscQueue&) : MpscQueue() { }
+    MpscQueue& operator=(const MpscQueue&) { return *this; }
+
+    ~MpscQueue()
+    {
+        clear();
+        delete m_tail;
+        while (m_freeNodes != nullptr)
+        {
+            Node* next = m_freeNodes->next.load(std::memory_order_relaxed);
+            delete m_freeNodes;
+            m_freeNodes = next;
+        }
+    }
+
+public:
+    ///
+    /// \brief Push to the back of the queue, thread safe and lock free
+    ///
+    void push(T value)
+    {
+        Node* node = acquireNode(std::move(value));
+        Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    ///
+    /// \brief Pop the front of the queue into value, returns false if empty
+    ///
+    bool pop(T& value)
+    {
+        m_consumerLock.lock();
+        const bool popped = popUnlocked(value);
+        m_consumerLock.unlock();
+        return popped;
+    }
+
+    ///
+    /// \brief Pop every element visible in the queue to the back of values, in order
+    ///
+    template<typename Container>
+    void popAll(Container& values)
+    {
+        T value;
+        m_consumerLock.lock();
+        while (popUnlocked(value))
+        {
+            values.push_back(std::move(value));
+        }
+        m_consumerLock.unlock();
+    }
+
+    ///
+    /// \brief Remove every element visible in the queue
+    ///
+    void clear()
+    {
+        T value;
+        m_consumerLock.lock();
+        while (popUnlocked(value))
+        {
+        }
+        m_consumerLock.unlock();
+    }
+
+    ///
+    /// \brief Returns if the queue appears empty, may change as soon as it returns
+    ///
+    bool empty()
+    {
+        m_consumerLock.lock();
+        const bool isEmpty = (m_tail->next.load(std::memory_order_acquire) == nullptr);
+        m_consumerLock.unlock();
+        return isEmpty;
+    }
+
+protected:
+    ///
+    /// \brief The tail is a dummy node, the front element is stored in the node after it.
+    /// Popping moves that value out and makes its node the new dummy
+    ///
+    bool popUnlocked(T& value)
+    {
+        Node* tail = m_tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            return false;
+        }
+        value       = std::move(next->value);
+        next->value = T();
+        m_tail      = next;
+        releaseNode(tail);
+        return true;
+    }
+
+    ///
+    /// \brief Returns a node holding value, reused from the free list when it isn't
+    /// held by another thread, allocated otherwise
+    ///
+    Node* acquireNode(T&& value)
+    {
+        Node* node = nullptr;
+        if (m_freeLock.tryLock())
+        {
+            node = m_freeNodes;
+            if (node != nullptr)
+            {
+                m_freeNodes = node->next.load(std::memory_order_relaxed);
+                m_numFreeNodes--;
+            }
+            m_freeLock.unlock();
+        }
+        if (node == nullptr)
+        {
+            return new Node(std::move(value));
+        }
+        node->next.store(nullptr, std::memory_order_relaxed);
+        node->value = std::move(value);
+        return node;
+    }
+
+    ///
+    /// \brief Keeps an emptied node for reuse, up to MaxNumFreeNodes
+    ///
+    void releaseNode(Node* node)
+    {
+        m_freeLock.lock();
+        if (m_numFreeNodes < MaxNumFreeNodes)
+        {
+            node->next.store(m_freeNodes, std::memory_order_relaxed);
+            m_freeNodes = node;
+            m_numFreeNodes++;
+            node = nullptr;
+        }
+        m_freeLock.unlock();
+        delete node;
+    }
+
+    static constexpr int MaxNumFreeNodes = 1024;
+
+    std::atomic<Node*> m_head;         ///< Last pushed node, swapped by producers
+    Node*    m_tail;                   ///< Dummy node before the front, only used by the consumer
+    SpinLock m_consumerLock;
+
+    Node*    m_freeNodes    = nullptr; ///< Emptied nodes linked by next, guarded by m_freeLock
+    int      m_numFreeNodes = 0;
+    SpinLock m_freeLock;
+};
+} // namespace ParallelUtils
+} // namespace imstk
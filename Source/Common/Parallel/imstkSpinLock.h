@@ -47,6 +47,15 @@ public:
         while (m_Lock.test_and_set(std::memory_order_acquire)) {}
     }
 
+    ///
+    /// \brief Start a thread-safe region if no other thread is in it, never waits
+    /// \return true if the region was entered, unlock must then be called
+    ///
+    bool tryLock()
+    {
+        return !m_Lock.test_and_set(std::memory_order_acquire);
+    }
+
     ///
     /// \brief End a thread-safe region
     ///
@@ -0,0 +1,133 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#define IMSTK_CHECK_ARRAY_RANGE
+#include "imstkDataArrayAllocator.h"
+#include "imstkVecDataArray.h"
+#undef IMSTK_CHECK_ARRAY_RANGE
+
+#include <cstdint>
+
+using namespace imstk;
+
+TEST(imstkDataArrayAllocatorTest, DefaultAlignment)
+{
+    DataArray<double> a(3);
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(a.getPointer()) % 64);
+    for (int i = 0; i < 100; i++)
+    {
+        a.push_back(static_cast<double>(i));
+    }
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(a.getPointer()) % 64);
+
+    VecDataArray<double, 3> b;
+    b.resize(1000);
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(b.getPointer()) % 64);
+    b.squeeze();
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(b.getPointer()) % 64);
+}
+
+TEST(imstkDataArrayAllocatorTest, HugePages)
+{
+    AlignedAllocator allocator(64, true);
+    void*            small = allocator.allocate(100);
+    void*            large = allocator.allocate(AlignedAllocator::HugePageSize + 1);
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(small) % 64);
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(large) % AlignedAllocator::HugePageSize);
+    allocator.deallocate(small, 100);
+    allocator.deallocate(large, AlignedAllocator::HugePageSize + 1);
+}
+
+TEST(imstkDataArrayAllocatorTest, ArenaGrowsInPlace)
+{
+    auto arena = std::make_shared<ArenaAllocator>(1024);
+
+    VecDataArray<double, 3> a;
+    a.setAllocator(arena);
+    a.push_back(Vec3d(1.0, 2.0, 3.0));
+    const Vec3d* ptr = a.getPointer();
+
+    // The last block of the arena grows without moving
+    for (int i = 1; i < 16; i++)
+    {
+        a.push_back(Vec3d(i, i, i));
+    }
+    EXPECT_EQ(ptr, a.getPointer());
+    EXPECT_EQ(Vec3d(1.0, 2.0, 3.0), a[0]);
+    EXPECT_EQ(Vec3d(15.0, 15.0, 15.0), a[15]);
+    EXPECT_EQ(1, arena->getNumAllocations());
+
+    // Past the chunk size it moves to a new chunk, keeping the values
+    a.resize(1000);
+    EXPECT_EQ(2, arena->getNumChunks());
+    EXPECT_EQ(Vec3d(1.0, 2.0, 3.0), a[0]);
+    EXPECT_EQ(Vec3d(15.0, 15.0, 15.0), a[15]);
+}
+
+TEST(imstkDataArrayAllocatorTest, ArenaRewinds)
+{
+    auto arena = std::make_shared<ArenaAllocator>(4096);
+    for (int frame = 0; frame < 3; frame++)
+    {
+        DataArray<int> a;
+        DataArray<int> b;
+        a.setAllocator(arena);
+        b.setAllocator(arena);
+        for (int i = 0; i < 100; i++)
+        {
+            a.push_back(i);
+            b.push_back(-i);
+        }
+        EXPECT_EQ(2, arena->getNumAllocations());
+        EXPECT_EQ(99, a[99]);
+        EXPECT_EQ(-99, b[99]);
+    }
+    // Once every array is freed the chunk is reused
+    EXPECT_EQ(0, arena->getNumAllocations());
+    EXPECT_EQ(1, arena->getNumChunks());
+}
+
+TEST(imstkDataArrayAllocatorTest, ClearKeepsCapacity)
+{
+    VecDataArray<double, 3> a;
+    for (int frame = 0; frame < 3; frame++)
+    {
+        a.clear();
+        for (int i = 0; i < 50; i++)
+        {
+            a.push_back(Vec3d(i, i, i));
+        }
+    }
+    const Vec3d* ptr = a.getPointer();
+    a.clear();
+    EXPECT_EQ(0, a.size());
+    EXPECT_EQ(64 * 3, a.getCapacity());
+    for (int i = 0; i < 50; i++)
+    {
+        a.push_back(Vec3d(i, i, i));
+    }
+    EXPECT_EQ(ptr, a.getPointer());
+}
+
+TEST(imstkDataArrayAllocatorTest, CopyKeepsAllocator)
+{
+    auto           arena = std::make_shared<ArenaAllocator>();
+    DataArray<int> a{ 1, 2, 3 };
+    a.setAllocator(arena);
+    EXPECT_EQ(1, a[0]);
+    EXPECT_EQ(3, a[2]);
+
+    DataArray<int> b(a);
+    EXPECT_EQ(arena, b.getAllocator());
+    EXPECT_EQ(2, arena->getNumAllocations());
+    EXPECT_EQ(3, b[2]);
+
+    DataArray<int> c(std::move(b));
+    EXPECT_EQ(arena, c.getAllocator());
+    EXPECT_EQ(2, arena->getNumAllocations());
+}
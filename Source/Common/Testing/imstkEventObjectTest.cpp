@@ -9,6 +9,8 @@
 
 #include "imstkEventObject.h"
 
+#include <thread>
+
 using namespace imstk;
 using testing::ElementsAre;
 
@@ -209,4 +211,92 @@ TEST(imstkEventObjectTest, ReceiverDeconstruct)
 
     // r1 should increment to 2
     EXPECT_EQ(2, r1->items.size());
-}
\ No newline at end of file
+}
+
+///
+/// \brief Test that a receiver may connect and disconnect observers of the sender
+/// while the sender calls its direct observers
+///
+TEST(imstkEventObjectTest, ConnectDisconnectInReceiver)
+{
+    auto m  = std::make_shared<MockSender>();
+    auto r0 = std::make_shared<MockReceiver>();
+    auto r1 = std::make_shared<MockReceiver>();
+    int  callCount = 0;
+
+    connect(m, MockSender::SignalOne, r0, &MockReceiver::receiverOne);
+    connect<Event>(m, MockSender::SignalOne, [&](Event*)
+        {
+            callCount++;
+            disconnect(m, r0, MockSender::SignalOne);
+            for (int i = 0; i < 100; i++)
+            {
+                connect(m, MockSender::SignalOne, r1, &MockReceiver::receiverTwo);
+                connect(m, MockSender::SignalTwo, r1, &MockReceiver::receiverTwo);
+            }
+        });
+
+    // Observers connected while posting are called from the next post on
+    m->postOne();
+    EXPECT_EQ(1, callCount);
+    EXPECT_EQ(1, r0->items.size());
+    EXPECT_EQ(0, r1->items.size());
+
+    m->postOne();
+    EXPECT_EQ(2, callCount);
+    EXPECT_EQ(1, r0->items.size());
+    EXPECT_EQ(100, r1->items.size());
+}
+
+///
+/// \brief Test that events queued from many threads to one receiver, while it
+/// processes its queue, are all received
+///
+TEST(imstkEventObjectTest, QueuedMultipleThreads)
+{
+    const int numThreads = 4;
+    const int numEvents  = 10000;
+
+    auto                                     r = std::make_shared<MockReceiver>();
+    std::vector<std::shared_ptr<MockSender>> senders;
+    std::vector<int>                         received(numThreads, 0);
+    for (int i = 0; i < numThreads; i++)
+    {
+        senders.push_back(std::make_shared<MockSender>());
+        queueConnect<Event>(senders[i], MockSender::SignalOne, r,
+            [&received, i](Event*) { received[i]++; });
+    }
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads; i++)
+    {
+        threads.emplace_back([&senders, i]()
+            {
+                for (int j = 0; j < numEvents; j++)
+                {
+                    senders[i]->postOne();
+                }
+            });
+    }
+    // Consume while posting
+    int numReceived = 0;
+    while (numReceived < numThreads * numEvents)
+    {
+        r->doAllEvents();
+        numReceived = 0;
+        for (int i = 0; i < numThreads; i++)
+        {
+            numReceived += received[i];
+        }
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    r->doAllEvents();
+
+    for (int i = 0; i < numThreads; i++)
+    {
+        EXPECT_EQ(numEvents, received[i]);
+    }
+}
@@ -9,6 +9,7 @@
 
 #include <g3log/g3log.hpp>
 #include <gtest/gtest.h>
+#include <thread>
 
 namespace imstk
 {
@@ -84,3 +85,35 @@ TEST_F(imstkModuleTest, UnInitialize)
     m_moduleObject.uninit();
     EXPECT_EQ(m_moduleObject.getInit(), false);
 }
+
+TEST_F(imstkModuleTest, SetTargetRate)
+{
+    m_moduleObject.setTargetRate(1000.0);
+    EXPECT_EQ(m_moduleObject.getTargetRate(), 1000.0);
+}
+
+TEST_F(imstkModuleTest, SchedulingStats)
+{
+    m_moduleObject.addSchedulingSample(1.0, false);
+    m_moduleObject.addSchedulingSample(3.0, true);
+
+    const ModuleSchedulingStats stats = m_moduleObject.getSchedulingStats();
+    EXPECT_EQ(stats.numSamples, 2);
+    EXPECT_EQ(stats.numOverruns, 1);
+    EXPECT_DOUBLE_EQ(stats.getMeanJitter(), 2.0);
+    EXPECT_DOUBLE_EQ(stats.getRmsJitter(), std::sqrt(5.0));
+    EXPECT_DOUBLE_EQ(stats.maxJitter, 3.0);
+
+    m_moduleObject.resetSchedulingStats();
+    EXPECT_EQ(m_moduleObject.getSchedulingStats().numSamples, 0);
+}
+
+TEST_F(imstkModuleTest, WaitForResume)
+{
+    m_moduleObject.pause();
+    EXPECT_FALSE(m_moduleObject.waitForResume(1.0));
+
+    std::thread resumeThread([this]() { m_moduleObject.resume(); });
+    EXPECT_TRUE(m_moduleObject.waitForResume(10000.0));
+    resumeThread.join();
+}
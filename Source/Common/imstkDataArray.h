@@ -7,16 +7,24 @@
 #pragma once
 
 #include "imstkAbstractDataArray.h"
+#include "imstkDataArrayAllocator.h"
 #include "imstkMath.h"
 #include "imstkMacros.h"
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
 namespace imstk
 {
 ///
 /// \class DataArray
 ///
 /// \brief Simple dynamic array implementation that also supports
-/// event posting and viewing/facade
+/// event posting and viewing/facade.
+/// Memory comes from a DataArrayAllocator, 64 byte aligned by default, and
+/// grows in place when the allocator can. Resizing down, as in clear, keeps
+/// the capacity, so arrays refilled every frame stop allocating.
 ///
 template<typename T>
 class DataArray : public AbstractDataArray
@@ -26,6 +34,7 @@ public:
     using ScalarType = T;
     using ValueType  = T;
     static constexpr int NumComponents = 1;
+    static_assert(std::is_trivially_copyable<T>::value, "DataArray values are copied as raw memory");
 
     class iterator
     {
@@ -122,7 +131,7 @@ public:
     /// \brief Constructs an empty data array
     /// DataArray will never have capacity < 1
     ///
-    DataArray() : m_mapped(false), m_data(new T[1])
+    DataArray() : m_mapped(false), m_data(allocate(1))
     {
         setType(TypeTemplateMacro(T));
         m_capacity = 1;
@@ -131,7 +140,7 @@ public:
     ///
     /// \brief Constructs a data array
     ///
-    DataArray(const int size) : AbstractDataArray(size), m_mapped(false), m_data(new T[size])
+    DataArray(const int size) : AbstractDataArray(size), m_mapped(false), m_data(allocate(size))
     {
         setType(TypeTemplateMacro(T));
     }
@@ -140,7 +149,7 @@ public:
     /// \brief Constructs from intializer list
     ///
     template<typename U>
-    DataArray(std::initializer_list<U> list) : AbstractDataArray(static_cast<int>(list.size())), m_mapped(false), m_data(new T[list.size()])
+    DataArray(std::initializer_list<U> list) : AbstractDataArray(static_cast<int>(list.size())), m_mapped(false), m_data(allocate(static_cast<int>(list.size())))
     {
         int j = 0;
         for (auto i : list)
@@ -159,6 +168,7 @@ public:
     DataArray(const DataArray& other) : AbstractDataArray(other)
     {
         // Copy the buffer instead of the pointer
+        m_allocator  = other.m_allocator;
         m_mapped     = other.m_mapped;
         m_size       = other.m_size;
         m_capacity   = other.m_capacity;
@@ -169,13 +179,14 @@ public:
         }
         else
         {
-            m_data = new T[m_size];
-            std::copy_n(other.m_data, m_size, m_data);
+            m_data = allocate(m_capacity);
+            copyValues(other.m_data, m_size, m_data);
         }
     }
 
-    DataArray(DataArray&& other)
+    DataArray(DataArray&& other) : m_mapped(true), m_data(nullptr)
     {
+        m_allocator    = other.m_allocator;
         m_mapped       = other.m_mapped;
         m_size         = other.m_size;
         m_capacity     = other.m_capacity;
@@ -186,11 +197,8 @@ public:
 
     ~DataArray() override
     {
-        if (!m_mapped)
-        {
-            delete[] m_data;
-            m_data = nullptr;
-        }
+        deallocate();
+        m_data = nullptr;
     }
 
 public:
@@ -211,11 +219,8 @@ public:
         }
         else
         {
-            const T* oldData = m_data;
-            m_data = new T[size];
-            std::copy_n(oldData, m_size, m_data);
-            delete[] oldData;
-            m_size = m_capacity = size;
+            reallocate(size);
+            m_size = size;
         }
     }
 
@@ -229,11 +234,11 @@ public:
     ///
     virtual inline void squeeze()
     {
-        const T* oldData = m_data;
-        m_data = new T[m_size];
-        std::copy_n(oldData, m_size, m_data);
-        delete[] oldData;
-        m_capacity = m_size;
+        if (m_mapped)
+        {
+            return;
+        }
+        reallocate(m_size);
     }
 
     ///
@@ -248,9 +253,9 @@ public:
         }
 
         const int newSize = m_size + 1;
-        if (newSize > m_capacity)   // If the new size exceeds capacity
+        if (newSize > m_capacity)                   // If the new size exceeds capacity
         {
-            resize(m_capacity * 2); // Conservative/copies values
+            reallocate(std::max(m_capacity * 2, 1)); // Conservative/copies values
         }
         m_size = newSize;
         m_data[newSize - 1] = val;
@@ -265,9 +270,9 @@ public:
         }
 
         const int newSize = m_size + 1;
-        if (newSize > m_capacity)    // If the new size exceeds capacity
+        if (newSize > m_capacity)                   // If the new size exceeds capacity
         {
-            reserve(m_capacity * 2); // Conservative/copies values
+            reallocate(std::max(m_capacity * 2, 1)); // Conservative/copies values
         }
         m_size = newSize;
         m_data[newSize - 1] = val;
@@ -352,11 +357,8 @@ public:
     DataArray<T>& operator=(std::initializer_list<U> list)
     {
         // If previously mapped, don't delete, just overwrite
-        if (!m_mapped)
-        {
-            delete[] m_data;
-        }
-        m_data = new T[list.size()];
+        deallocate();
+        m_data = allocate(static_cast<int>(list.size()));
         int j = 0;
         for (auto i : list)
         {
@@ -387,7 +389,7 @@ public:
                 m_mapped   = false;
             }
             reserve(other.size());
-            std::copy_n(other.m_data, other.m_size, m_data);
+            copyValues(other.m_data, other.m_size, m_data);
             m_size = other.m_size;
         }
 
@@ -413,17 +415,55 @@ public:
     ///
     inline void setData(T* ptr, const int size)
     {
-        if (!m_mapped)
-        {
-            delete[] m_data;
-        }
+        deallocate();
         m_mapped = true;
         m_data   = ptr;
         m_size   = m_capacity = size;
     }
 
+    ///
+    /// \brief Take ownership of a block of size values allocated from the allocator, the
+    /// allocator of the array becomes it and the block is freed through it
+    ///
+    inline void setData(T* ptr, const int size, std::shared_ptr<DataArrayAllocator> allocator)
+    {
+        deallocate();
+        m_allocator = allocator;
+        m_mapped    = false;
+        m_data      = ptr;
+        m_size      = m_capacity = size;
+    }
+
     inline virtual int getNumberOfComponents() const override { return NumComponents; }
 
+    ///
+    /// \brief Set the allocator of the array, the values are moved to memory from it.
+    /// Mapped arrays only keep it for when they are assigned an unmapped array
+    ///
+    virtual void setAllocator(std::shared_ptr<DataArrayAllocator> allocator)
+    {
+        if (allocator == nullptr)
+        {
+            throw std::runtime_error("DataArray requires an allocator");
+        }
+        if (allocator == m_allocator)
+        {
+            return;
+        }
+        if (m_mapped)
+        {
+            m_allocator = allocator;
+            return;
+        }
+        T* newData = static_cast<T*>(allocator->allocate(sizeof(T) * static_cast<size_t>(m_capacity)));
+        copyValues(m_data, m_size, newData);
+        deallocate();
+        m_data      = newData;
+        m_allocator = allocator;
+    }
+
+    std::shared_ptr<DataArrayAllocator> getAllocator() const { return m_allocator; }
+
     ///
     /// \brief Cast array to specific c++ type
     ///
@@ -470,7 +510,47 @@ public:
     }
 
 protected:
+    ///
+    /// \brief Allocate memory for count values from the allocator of the array
+    ///
+    T* allocate(const int count)
+    {
+        return static_cast<T*>(m_allocator->allocate(sizeof(T) * static_cast<size_t>(count)));
+    }
+
+    ///
+    /// \brief Free the memory of the array, unless mapped
+    ///
+    void deallocate()
+    {
+        if (!m_mapped && m_data != nullptr)
+        {
+            m_allocator->deallocate(m_data, sizeof(T) * static_cast<size_t>(m_capacity));
+        }
+    }
+
+    ///
+    /// \brief Change the capacity keeping the values within it, in place if the allocator can
+    ///
+    void reallocate(const int capacity)
+    {
+        m_data = static_cast<T*>(m_allocator->reallocate(m_data,
+            sizeof(T) * static_cast<size_t>(m_capacity),
+            sizeof(T) * static_cast<size_t>(capacity),
+            sizeof(T) * static_cast<size_t>(std::min(m_size, capacity))));
+        m_capacity = capacity;
+        m_size     = std::min(m_size, capacity);
+    }
+
+    static void copyValues(const T* src, const int count, T* dest)
+    {
+        if (count > 0)
+        {
+            std::memcpy(dest, src, sizeof(T) * static_cast<size_t>(count));
+        }
+    }
 
+    std::shared_ptr<DataArrayAllocator> m_allocator = DataArrayAllocator::getDefault();
     bool m_mapped;
     T*   m_data;
 
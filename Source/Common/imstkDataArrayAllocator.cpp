@@ -0,0 +1,284 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkDataArrayAllocator.h"
+#include "imstkLogger.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef WIN32
+#include <malloc.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace imstk
+{
+void*
+DataArrayAllocator::reallocate(void* ptr, const size_t numBytes, const size_t newNumBytes, const size_t numBytesUsed)
+{
+    if (ptr == nullptr)
+    {
+        return allocate(newNumBytes);
+    }
+    void* newPtr = allocate(newNumBytes);
+    std::memcpy(newPtr, ptr, std::min(numBytesUsed, newNumBytes));
+    deallocate(ptr, numBytes);
+    return newPtr;
+}
+
+std::shared_ptr<DataArrayAllocator>
+DataArrayAllocator::getDefault()
+{
+    static std::shared_ptr<DataArrayAllocator> allocator = std::make_shared<AlignedAllocator>();
+    return allocator;
+}
+
+AlignedAllocator::AlignedAllocator(const size_t alignment, const bool useHugePages) :
+    m_alignment(alignment), m_useHugePages(useHugePages)
+{
+    CHECK(alignment >= sizeof(void*) && (alignment & (alignment - 1)) == 0)
+        << "Alignment must be a power of two multiple of the pointer size";
+}
+
+void*
+AlignedAllocator::allocate(const size_t numBytes)
+{
+    size_t alignment = m_alignment;
+    size_t size      = ((std::max<size_t>(numBytes, 1) + alignment - 1) / alignment) * alignment;
+    if (m_useHugePages && size >= HugePageSize)
+    {
+        alignment = std::max(alignment, HugePageSize);
+        size      = ((size + alignment - 1) / alignment) * alignment;
+    }
+
+    void* ptr = nullptr;
+#ifdef WIN32
+    ptr = _aligned_malloc(size, alignment);
+#else
+    if (posix_memalign(&ptr, alignment, size) != 0)
+    {
+        ptr = nullptr;
+    }
+#endif
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (alignment >= HugePageSize)
+    {
+        // Only advice, the kernel may not have transparent huge pages enabled
+        madvise(ptr, size, MADV_HUGEPAGE);
+    }
+#endif
+    return ptr;
+}
+
+void
+AlignedAllocator::deallocate(void* ptr, const size_t)
+{
+#ifdef WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+ArenaAllocator::ArenaAllocator(const size_t chunkSize, const size_t alignment) :
+    m_chunkAllocator(alignment), m_chunkSize(chunkSize), m_alignment(alignment)
+{
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+    for (Chunk& chunk : m_chunks)
+    {
+        m_chunkAllocator.deallocate(chunk.data, chunk.size);
+    }
+}
+
+void*
+ArenaAllocator::allocate(const size_t numBytes)
+{
+    m_lock.lock();
+    void* block = bump(roundUp(std::max<size_t>(numBytes, 1)));
+    m_numAllocations++;
+    m_lock.unlock();
+    return block;
+}
+
+void
+ArenaAllocator::deallocate(void* ptr, const size_t)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+
+    m_lock.lock();
+    m_numAllocations--;
+    if (m_numAllocations == 0)
+    {
+        // Every block is free, reuse the chunks from the start
+        m_currChunk = 0;
+        m_offset    = 0;
+        m_lastBlock = nullptr;
+    }
+    else if (ptr == m_lastBlock)
+    {
+        m_offset    = static_cast<size_t>(m_lastBlock - m_chunks[m_currChunk].data);
+        m_lastBlock = nullptr;
+    }
+    m_lock.unlock();
+}
+
+void*
+ArenaAllocator::reallocate(void* ptr, const size_t numBytes, const size_t newNumBytes, const size_t numBytesUsed)
+{
+    if (ptr == nullptr)
+    {
+        return allocate(newNumBytes);
+    }
+
+    // The last block grows or shrinks in place if its chunk has room
+    m_lock.lock();
+    if (ptr == m_lastBlock)
+    {
+        const size_t blockOffset = static_cast<size_t>(m_lastBlock - m_chunks[m_currChunk].data);
+        const size_t newSize     = roundUp(std::max<size_t>(newNumBytes, 1));
+        if (blockOffset + newSize <= m_chunks[m_currChunk].size)
+        {
+            m_offset = blockOffset + newSize;
+            m_lock.unlock();
+            return ptr;
+        }
+    }
+    m_lock.unlock();
+
+    return DataArrayAllocator::reallocate(ptr, numBytes, newNumBytes, numBytesUsed);
+}
+
+void*
+ArenaAllocator::bump(const size_t numBytes)
+{
+    // Skip chunks too small, they are reused on the next rewind
+    while (m_currChunk < m_chunks.size() && m_offset + numBytes > m_chunks[m_currChunk].size)
+    {
+        m_currChunk++;
+        m_offset = 0;
+    }
+    if (m_currChunk == m_chunks.size())
+    {
+        const size_t size = std::max(m_chunkSize, numBytes);
+        m_chunks.push_back({ static_cast<char*>(m_chunkAllocator.allocate(size)), size });
+        m_offset = 0;
+    }
+
+    m_lastBlock = m_chunks[m_currChunk].data + m_offset;
+    m_offset   += numBytes;
+    return m_lastBlock;
+}
+
+MappedFileAllocator::MappedFileAllocator(const std::string& filePath, std::shared_ptr<DataArrayAllocator> fallback) :
+    m_fallback(fallback)
+{
+    CHECK(m_fallback != nullptr) << "MappedFileAllocator requires a fallback allocator";
+#ifdef WIN32
+    HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        LOG(WARNING) << "Failed to open " << filePath << " for mapping";
+        return;
+    }
+    m_fileHandle = file;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        LOG(WARNING) << "Failed to map empty file " << filePath;
+        return;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        LOG(WARNING) << "Failed to map " << filePath;
+        return;
+    }
+    m_mappingHandle = mapping;
+    m_data = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+    if (m_data != nullptr)
+    {
+        m_size = static_cast<size_t>(fileSize.QuadPart);
+    }
+#else
+    const int fd = open(filePath.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        LOG(WARNING) << "Failed to open " << filePath << " for mapping";
+        return;
+    }
+    struct stat buf;
+    if (fstat(fd, &buf) != 0 || buf.st_size == 0)
+    {
+        LOG(WARNING) << "Failed to map empty file " << filePath;
+        close(fd);
+        return;
+    }
+    // Private mapping, writes are copied on write and never reach the file
+    void* ptr = mmap(nullptr, static_cast<size_t>(buf.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps its own reference
+    if (ptr == MAP_FAILED)
+    {
+        LOG(WARNING) << "Failed to map " << filePath;
+        return;
+    }
+    m_data = static_cast<char*>(ptr);
+    m_size = static_cast<size_t>(buf.st_size);
+#endif
+}
+
+MappedFileAllocator::~MappedFileAllocator()
+{
+#ifdef WIN32
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mappingHandle != nullptr)
+    {
+        CloseHandle(m_mappingHandle);
+    }
+    if (m_fileHandle != nullptr)
+    {
+        CloseHandle(m_fileHandle);
+    }
+#else
+    if (m_data != nullptr)
+    {
+        munmap(m_data, m_size);
+    }
+#endif
+}
+
+void
+MappedFileAllocator::deallocate(void* ptr, const size_t numBytes)
+{
+    // Blocks of the file are released with the mapping
+    if (!contains(ptr))
+    {
+        m_fallback->deallocate(ptr, numBytes);
+    }
+}
+} // namespace imstk
@@ -0,0 +1,183 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkSpinLock.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace imstk
+{
+///
+/// \class DataArrayAllocator
+///
+/// \brief Allocates the raw memory of DataArrays. Arrays keep the allocator
+/// they were allocated with, so it outlives them.
+///
+class DataArrayAllocator
+{
+public:
+    virtual ~DataArrayAllocator() = default;
+
+    ///
+    /// \brief Allocate a block of numBytes, never returns nullptr
+    ///
+    virtual void* allocate(const size_t numBytes) = 0;
+
+    ///
+    /// \brief Deallocate a block given the number of bytes it was allocated with,
+    /// nullptr is ignored
+    ///
+    virtual void deallocate(void* ptr, const size_t numBytes) = 0;
+
+    ///
+    /// \brief Change the size of a block, keeping its first numBytesUsed. A nullptr block
+    /// is allocated. By default a new block is allocated and the bytes used copied
+    ///
+    virtual void* reallocate(void* ptr, const size_t numBytes, const size_t newNumBytes, const size_t numBytesUsed);
+
+    ///
+    /// \brief Returns the allocator used by arrays unless given another, 64 byte aligned
+    ///
+    static std::shared_ptr<DataArrayAllocator> getDefault();
+};
+
+///
+/// \class AlignedAllocator
+///
+/// \brief Allocates blocks aligned to a power of two alignment, 64 bytes by default
+/// so a block starts on a cache line and vectorized loads can be aligned.
+/// With huge pages on, blocks of at least HugePageSize are aligned to and padded to
+/// whole huge pages, on linux they are then advised to be backed by transparent huge pages.
+/// Thread safe.
+///
+class AlignedAllocator : public DataArrayAllocator
+{
+public:
+    static constexpr size_t HugePageSize = 2 * 1024 * 1024;
+
+    AlignedAllocator(const size_t alignment = 64, const bool useHugePages = false);
+    ~AlignedAllocator() override = default;
+
+    void* allocate(const size_t numBytes) override;
+    void deallocate(void* ptr, const size_t numBytes) override;
+
+    size_t getAlignment() const { return m_alignment; }
+    bool getUseHugePages() const { return m_useHugePages; }
+
+protected:
+    size_t m_alignment;
+    bool   m_useHugePages;
+};
+
+///
+/// \class ArenaAllocator
+///
+/// \brief Allocates blocks out of large aligned chunks by bumping a pointer. Only the last
+/// block can be freed, grown or shrunk in place, other blocks are reclaimed once every block
+/// of the arena is deallocated, at which point the chunks are reused from the start.
+/// Meant for arrays with a common lifetime, ie: temporaries rebuilt every frame, which then
+/// stop allocating once the chunks are large enough. Thread safe.
+///
+class ArenaAllocator : public DataArrayAllocator
+{
+public:
+    ArenaAllocator(const size_t chunkSize = 1024 * 1024, const size_t alignment = 64);
+    ~ArenaAllocator() override;
+
+    void* allocate(const size_t numBytes) override;
+    void deallocate(void* ptr, const size_t numBytes) override;
+    void* reallocate(void* ptr, const size_t numBytes, const size_t newNumBytes, const size_t numBytesUsed) override;
+
+    ///
+    /// \brief Returns the number of blocks not yet deallocated
+    ///
+    size_t getNumAllocations() const { return m_numAllocations; }
+
+    ///
+    /// \brief Returns the number of chunks allocated from the system
+    ///
+    size_t getNumChunks() const { return m_chunks.size(); }
+
+protected:
+    struct Chunk
+    {
+        char*  data;
+        size_t size;
+    };
+
+    ///
+    /// \brief Bump a block in the current chunk or the next one large enough, allocating
+    /// a new chunk if none is
+    ///
+    void* bump(const size_t numBytes);
+
+    size_t roundUp(const size_t numBytes) const { return ((numBytes + m_alignment - 1) / m_alignment) * m_alignment; }
+
+    AlignedAllocator   m_chunkAllocator;
+    size_t             m_chunkSize;
+    size_t             m_alignment;
+    std::vector<Chunk> m_chunks;
+    size_t             m_currChunk      = 0;       ///< Chunk being bumped
+    size_t             m_offset         = 0;       ///< Offset of the next block in the current chunk
+    char*              m_lastBlock      = nullptr; ///< Last block bumped, the only one resizable in place
+    size_t             m_numAllocations = 0;
+    ParallelUtils::SpinLock m_lock;
+};
+
+///
+/// \class MappedFileAllocator
+///
+/// \brief Maps a file copy-on-write in memory, arrays adopting blocks of the file
+/// (DataArray::setData with this allocator) then read it without copying and
+/// keep it mapped. Writes to the blocks stay private to the process. Blocks of the
+/// file are never freed by themselves, growing them moves the values to memory
+/// from the fallback allocator, which also serves any other allocation.
+///
+class MappedFileAllocator : public DataArrayAllocator
+{
+public:
+    MappedFileAllocator(const std::string& filePath,
+                        std::shared_ptr<DataArrayAllocator> fallback = DataArrayAllocator::getDefault());
+    ~MappedFileAllocator() override;
+
+    void* allocate(const size_t numBytes) override { return m_fallback->allocate(numBytes); }
+    void deallocate(void* ptr, const size_t numBytes) override;
+
+    ///
+    /// \brief Returns if the file was mapped
+    ///
+    bool isValid() const { return m_data != nullptr; }
+
+    ///
+    /// \brief Returns the mapped bytes of the file
+    ///@{
+    char* getData() const { return m_data; }
+    size_t getSize() const { return m_size; }
+    ///@}
+
+    ///
+    /// \brief Returns if the pointer is within the mapped file
+    ///
+    bool contains(const void* ptr) const
+    {
+        return static_cast<const char*>(ptr) >= m_data && static_cast<const char*>(ptr) < m_data + m_size;
+    }
+
+protected:
+    std::shared_ptr<DataArrayAllocator> m_fallback;
+    char*  m_data = nullptr;
+    size_t m_size = 0;
+#ifdef WIN32
+    void* m_fileHandle    = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+};
+} // namespace imstk
@@ -33,6 +33,7 @@ public:
         static constexpr int SolverTime_ms  = 0;
         static constexpr int NumConstraints = 1;
         static constexpr int AverageC       = 2;
+        static constexpr int NumIterations  = 3;
     };
     ///
     /// \brief Header names of the common data values to track
@@ -42,6 +43,7 @@ public:
         static constexpr char const* SolverTime_ms  = "SolverTime_ms";
         static constexpr char const* NumConstraints = "NumConstraints";
         static constexpr char const* AverageC       = "AverageC";
+        static constexpr char const* NumIterations  = "NumIterations";
     };
 
     DataTracker();
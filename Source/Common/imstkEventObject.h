@@ -6,12 +6,10 @@
 
 #pragma once
 
-#include "imstkSpinLock.h"
+#include "imstkMpscQueue.h"
 
 #include <algorithm>
-#include <deque>
 #include <functional>
-#include <list>
 #include <memory>
 #include <string>
 #include <vector>
@@ -96,7 +94,8 @@ static void disconnect(std::shared_ptr<EventObject>,
 /// Direct observers receive events immediately on the same thread
 /// This can either be posted on an object or be a function pointer
 /// Queued observers receive events within their queue which they can process whenever
-/// they like.
+/// they like. Posting to a queue is lock free so any number of threads may post
+/// to the same receiver.
 /// These can be connected with the connect/queuedConnect/disconnect functions
 /// Lambda recievers cannot be disconnected unless all receivers to a signal are removed
 /// \todo ThreadObject affinity
@@ -106,6 +105,11 @@ class EventObject
 public:
     // tuple<IsLambda, Receiver, Receiving Function
     using Observer = std::tuple<bool, std::weak_ptr<EventObject>, std::function<void (Event*)>>;
+    // Observers of every event type
+    using ObserverList = std::vector<std::pair<std::string, std::vector<Observer>>>;
+    // Observers of every event type, copy on write so they can be called while a receiver
+    // connects or disconnects observers
+    using SharedObserverList = std::vector<std::pair<std::string, std::shared_ptr<const std::vector<Observer>>>>;
 
 public:
     virtual ~EventObject() = default;
@@ -120,67 +124,75 @@ public:
     template<typename T>
     void postEvent(const T& e)
     {
-        std::shared_ptr<T> ePtr = std::make_shared<T>(e);
+        // Most events have no observers, avoid copying them
+        if (directObservers.empty() && queuedObservers.empty())
+        {
+            return;
+        }
+
+        T eCopy = e;
         // Don't overwrite the sender if the user provided one
-        if (ePtr->m_sender == nullptr)
+        if (eCopy.m_sender == nullptr)
         {
-            ePtr->m_sender = this;
+            eCopy.m_sender = this;
         }
 
         // For every direct observer
         // Directly call its function
-        for (auto i = directObservers.begin(); i != directObservers.end(); i++)
+        auto i1 = findObservers(directObservers, e.m_type);
+        if (i1 != directObservers.end())
         {
-            if (i->first == e.m_type)
+            // Hold the observers, connecting or disconnecting from a receiving function
+            // replaces the list instead of modifying it
+            const std::shared_ptr<const std::vector<Observer>> observers = i1->second;
+            bool                                               hasExpired = false;
+            for (const Observer& observer : *observers)
             {
-                std::vector<Observer>& observers = i->second;
-                for (std::vector<Observer>::iterator j = observers.begin(); j != observers.end();)
+                // If the receiver or receiving function is nullptr, cleanup after
+                // This would occur on deconstruction of a receiver
+                if (isExpired(observer))
                 {
-                    bool                        isLambda      = std::get<0>(*j);
-                    std::function<void(Event*)> receivingFunc = std::get<2>(*j);
-
-                    // If the receiver or receiving function is nullptr, cleanup
-                    // This would occur on deconstruction of a receiver
-                    if ((!isLambda && std::get<1>(*j).expired()) || receivingFunc == nullptr)
-                    {
-                        j = i->second.erase(j);
-                    }
-                    else
-                    {
-                        // Call the receiving function
-                        receivingFunc(ePtr.get());
-                        j++;
-                    }
+                    hasExpired = true;
                 }
+                else
+                {
+                    // Call the receiving function
+                    std::get<2>(observer)(&eCopy);
+                }
+            }
+            if (hasExpired)
+            {
+                removeDirectObservers(e.m_type, &EventObject::isExpired);
             }
         }
 
         // For every queued observer
-        for (auto i = queuedObservers.begin(); i != queuedObservers.end(); i++)
+        auto i2 = findObservers(queuedObservers, e.m_type);
+        if (i2 != queuedObservers.end())
         {
-            if (i->first == e.m_type)
+            // Queued observers share a single copy of the event
+            std::shared_ptr<T>     ePtr      = nullptr;
+            std::vector<Observer>& observers = i2->second;
+            for (std::vector<Observer>::iterator j = observers.begin(); j != observers.end();)
             {
-                std::vector<Observer>& observers = i->second;
-                for (std::vector<Observer>::iterator j = observers.begin(); j != observers.end();)
-                {
-                    bool                        isLambda      = std::get<0>(*j);
-                    std::function<void(Event*)> receivingFunc = std::get<2>(*j);
+                std::shared_ptr<EventObject>       receivingObj  = std::get<1>(*j).lock();
+                const std::function<void(Event*)>& receivingFunc = std::get<2>(*j);
 
-                    // If the receiver or receiving function is nullptr, cleanup
-                    // This would occur on deconstruction of a receiver
-                    if ((!isLambda && std::get<1>(*j).expired()) || receivingFunc == nullptr)
-                    {
-                        j = i->second.erase(j);
-                    }
-                    else
+                // If the receiver or receiving function is nullptr, cleanup
+                // This would occur on deconstruction of a receiver
+                if (receivingObj == nullptr || receivingFunc == nullptr)
+                {
+                    j = observers.erase(j);
+                }
+                else
+                {
+                    // Queue the command
+                    if (ePtr == nullptr)
                     {
-                        // Queue the command
-                        std::shared_ptr<EventObject> receivingObj = std::get<1>(*j).lock();
-                        receivingObj->eventQueueLock.lock();
-                        receivingObj->eventQueue.push_back(Command(receivingFunc, ePtr));
-                        receivingObj->eventQueueLock.unlock();
-                        j++;
+                        ePtr = std::make_shared<T>(std::move(eCopy));
                     }
+                    receivingObj->eventQueue.push(Command(receivingFunc, ePtr));
+                    j++;
                 }
             }
         }
@@ -199,9 +211,7 @@ public:
             ePtr->m_sender = this;
         }
 
-        eventQueueLock.lock();
-        eventQueue.push_back(Command(nullptr, ePtr));
-        eventQueueLock.unlock();
+        eventQueue.push(Command(nullptr, ePtr));
     }
 
     ///
@@ -209,21 +219,12 @@ public:
     ///
     void doEvent()
     {
-        // Avoid calling the function within the lock
-        eventQueueLock.lock();
-        if (eventQueue.empty())
+        // The command is called after popping so it may post to this
+        Command command;
+        if (eventQueue.pop(command))
         {
-            eventQueueLock.unlock();
-            return;
+            command.invoke();
         }
-
-        Command command = eventQueue.front();
-        eventQueue.pop_front();
-
-        eventQueueLock.unlock();
-
-        // Do the calls
-        command.invoke();
     }
 
     ///
@@ -231,59 +232,42 @@ public:
     ///
     void doAllEvents()
     {
-        // Avoid calling the function within the lock
-        std::list<Command> cmds;
-        eventQueueLock.lock();
-        {
-            while (!eventQueue.empty())
-            {
-                cmds.push_back(eventQueue.front());
-                eventQueue.pop_front();
-            }
-        }
-        eventQueueLock.unlock();
+        std::vector<Command> cmds;
+        eventQueue.popAll(cmds);
 
         // Do the calls
-        for (auto i : cmds)
+        for (Command& cmd : cmds)
         {
-            i.invoke();
+            cmd.invoke();
         }
     }
 
     ///
-    /// \brief Thread safe loop over all event commands, one can implement a custom handler
+    /// \brief Thread safe loop over all event commands, one can implement a custom handler.
+    /// The commands are removed from the queue before func is called on them
     ///
     void foreachEvent(std::function<void(Command cmd)> func)
     {
-        eventQueueLock.lock();
-        for (std::deque<Command>::iterator i = eventQueue.begin(); i != eventQueue.end(); i++)
+        std::vector<Command> cmds;
+        eventQueue.popAll(cmds);
+        for (std::vector<Command>::iterator i = cmds.begin(); i != cmds.end(); i++)
         {
             func(*i);
         }
-        while (!eventQueue.empty())
-        {
-            Command command = eventQueue.back();
-            eventQueue.pop_back();
-        }
-        eventQueueLock.unlock();
     }
 
     ///
-    /// \brief thread safe reverse loop over all event commands, one can implement a custom handler
+    /// \brief thread safe reverse loop over all event commands, one can implement a custom handler.
+    /// The commands are removed from the queue before func is called on them
     ///
     void rforeachEvent(std::function<void(Command cmd)> func)
     {
-        eventQueueLock.lock();
-        for (std::deque<Command>::reverse_iterator i = eventQueue.rbegin(); i != eventQueue.rend(); i++)
+        std::vector<Command> cmds;
+        eventQueue.popAll(cmds);
+        for (std::vector<Command>::reverse_iterator i = cmds.rbegin(); i != cmds.rend(); i++)
         {
             func(*i);
         }
-        while (!eventQueue.empty())
-        {
-            Command command = eventQueue.back();
-            eventQueue.pop_back();
-        }
-        eventQueueLock.unlock();
     }
 
     ///
@@ -292,15 +276,7 @@ public:
     ///
     void clearEvents()
     {
-        eventQueueLock.lock();
-        {
-            while (!eventQueue.empty())
-            {
-                Command command = eventQueue.back();
-                eventQueue.pop_back();
-            }
-        }
-        eventQueueLock.unlock();
+        eventQueue.clear();
     }
 
 public:
@@ -325,28 +301,45 @@ public:
 private:
     void addDirectObserver(std::string eventType, Observer observer)
     {
-        std::vector<std::pair<std::string, std::vector<Observer>>>::iterator i =
-            std::find_if(directObservers.begin(), directObservers.end(),
-                [eventType](const std::pair<std::string, std::vector<Observer>>& j)
-                { return j.first == eventType; });
+        SharedObserverList::iterator i = findObservers(directObservers, eventType);
         if (i == directObservers.end())
         {
-            std::pair<std::string, std::vector<Observer>> test = std::pair<std::string, std::vector<Observer>>(eventType, std::vector<Observer>());
-            test.second.push_back(observer);
-            directObservers.push_back(test);
+            directObservers.push_back({ eventType, std::make_shared<const std::vector<Observer>>(1, observer) });
         }
         else
         {
-            i->second.push_back(observer);
+            auto observers = std::make_shared<std::vector<Observer>>(*i->second);
+            observers->push_back(observer);
+            i->second = observers;
         }
     }
 
+    ///
+    /// \brief Replaces the direct observers of the given event type by those func is false for
+    ///
+    template<typename Func>
+    void removeDirectObservers(const std::string& eventType, Func func)
+    {
+        SharedObserverList::iterator i = findObservers(directObservers, eventType);
+        if (i != directObservers.end())
+        {
+            auto observers = std::make_shared<std::vector<Observer>>(*i->second);
+            observers->erase(std::remove_if(observers->begin(), observers->end(), func), observers->end());
+            i->second = observers;
+        }
+    }
+
+    ///
+    /// \brief Returns if the receiver or receiving function of the observer is gone
+    ///
+    static bool isExpired(const Observer& observer)
+    {
+        return (!std::get<0>(observer) && std::get<1>(observer).expired()) || std::get<2>(observer) == nullptr;
+    }
+
     void addQueuedObserver(std::string eventType, Observer observer)
     {
-        std::vector<std::pair<std::string, std::vector<Observer>>>::iterator i =
-            std::find_if(queuedObservers.begin(), queuedObservers.end(),
-                [eventType](const std::pair<std::string, std::vector<Observer>>& j)
-                { return j.first == eventType; });
+        ObserverList::iterator i = findObservers(queuedObservers, eventType);
         if (i == queuedObservers.end())
         {
             std::pair<std::string, std::vector<Observer>> test = std::pair<std::string, std::vector<Observer>>(eventType, std::vector<Observer>());
@@ -359,13 +352,23 @@ private:
         }
     }
 
+    ///
+    /// \brief Returns the observers of the given event type, end if none
+    ///
+    template<typename List>
+    static typename List::iterator findObservers(List& observerList, const std::string& eventType)
+    {
+        return std::find_if(observerList.begin(), observerList.end(),
+            [&eventType](const typename List::value_type& j)
+            { return j.first == eventType; });
+    }
+
 protected:
-    ParallelUtils::SpinLock eventQueueLock; // Data lock for the event queue
-    std::deque<Command>     eventQueue;
+    ParallelUtils::MpscQueue<Command> eventQueue; // Lock free for the senders
 
     // Vectors used as size is generally small
-    std::vector<std::pair<std::string, std::vector<Observer>>> queuedObservers;
-    std::vector<std::pair<std::string, std::vector<Observer>>> directObservers;
+    ObserverList       queuedObservers;
+    SharedObserverList directObservers;
 };
 
 #ifdef WIN32
@@ -471,20 +474,27 @@ disconnect(std::shared_ptr<EventObject> sender,
 {
     const std::string eventType = senderFunc();
 
-    auto i1 = std::find_if(sender->directObservers.begin(), sender->directObservers.end(),
-        [eventType](const std::pair<std::string, std::vector<EventObject::Observer>>& j) { return j.first == eventType; });
+    auto i1 = EventObject::findObservers(sender->directObservers, eventType);
     if (i1 != sender->directObservers.end())
     {
-        auto j = std::find_if(i1->second.begin(), i1->second.end(), [reciever](const EventObject::Observer& k) { return std::get<1>(k).lock() == reciever; });
-        i1->second.erase(j);
+        auto j = std::find_if(i1->second->begin(), i1->second->end(), [reciever](const EventObject::Observer& k) { return std::get<1>(k).lock() == reciever; });
+        if (j != i1->second->end())
+        {
+            // Copy on write, the observers may be being called
+            auto observers = std::make_shared<std::vector<EventObject::Observer>>(*i1->second);
+            observers->erase(observers->begin() + std::distance(i1->second->begin(), j));
+            i1->second = observers;
+        }
     }
 
-    auto i2 = std::find_if(sender->queuedObservers.begin(), sender->queuedObservers.end(),
-        [eventType](const std::pair<std::string, std::vector<EventObject::Observer>>& j) { return j.first == eventType; });
+    auto i2 = EventObject::findObservers(sender->queuedObservers, eventType);
     if (i2 != sender->queuedObservers.end())
     {
         auto j = std::find_if(i2->second.begin(), i2->second.end(), [reciever](const EventObject::Observer& k) { return std::get<1>(k).lock() == reciever; });
-        i2->second.erase(j);
+        if (j != i2->second.end())
+        {
+            i2->second.erase(j);
+        }
     }
 }
 
@@ -18,6 +18,60 @@ Module::setSleepDelay(const double ms)
     m_sleepDelay = ms;
 }
 
+void
+Module::setTargetRate(const double hz)
+{
+    CHECK(hz >= 0.0);
+    m_targetRate = hz;
+}
+
+void
+Module::setPaused(const bool paused)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_pauseMutex);
+        m_paused = paused;
+    }
+    m_pauseCondition.notify_all();
+}
+
+bool
+Module::waitForResume(const double maxWait)
+{
+    std::unique_lock<std::mutex> lock(m_pauseMutex);
+    return m_pauseCondition.wait_for(lock,
+        std::chrono::duration<double, std::milli>(maxWait),
+        [this]() { return !m_paused; });
+}
+
+ModuleSchedulingStats
+Module::getSchedulingStats() const
+{
+    std::lock_guard<ParallelUtils::SpinLock> guard(m_statsLock);
+    return m_schedulingStats;
+}
+
+void
+Module::resetSchedulingStats()
+{
+    std::lock_guard<ParallelUtils::SpinLock> guard(m_statsLock);
+    m_schedulingStats = ModuleSchedulingStats();
+}
+
+void
+Module::addSchedulingSample(const double jitter, const bool overrun)
+{
+    std::lock_guard<ParallelUtils::SpinLock> guard(m_statsLock);
+    m_schedulingStats.numSamples++;
+    m_schedulingStats.totalJitter    += jitter;
+    m_schedulingStats.totalSqrJitter += jitter * jitter;
+    m_schedulingStats.maxJitter       = std::max(m_schedulingStats.maxJitter, jitter);
+    if (overrun)
+    {
+        m_schedulingStats.numOverruns++;
+    }
+}
+
 void
 Module::update()
 {
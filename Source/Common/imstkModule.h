@@ -8,9 +8,32 @@
 
 #include "imstkTimer.h"
 #include "imstkEventObject.h"
+#include "imstkSpinLock.h"
+
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
 
 namespace imstk
 {
+///
+/// \struct ModuleSchedulingStats
+///
+/// \brief Wake up jitter of a rate limited module, measured by the driver
+/// as the difference between the actual wake up and the requested deadline (ms)
+///
+struct ModuleSchedulingStats
+{
+    size_t numSamples     = 0;
+    double totalJitter    = 0.0;
+    double totalSqrJitter = 0.0;
+    double maxJitter      = 0.0;
+    size_t numOverruns    = 0;  ///< Number of updates that took longer than the period
+
+    double getMeanJitter() const { return (numSamples == 0) ? 0.0 : totalJitter / numSamples; }
+    double getRmsJitter() const { return (numSamples == 0) ? 0.0 : std::sqrt(totalSqrJitter / numSamples); }
+};
+
 ///
 /// \class Module
 ///
@@ -75,7 +98,7 @@ public:
     /// \brief Set/Get whether the module is currently paused
     ///
     bool getPaused() const { return m_paused; }
-    void setPaused(const bool paused) { m_paused = paused; }
+    void setPaused(const bool paused);
 
     ///
     /// \brief Set/Get whether the module should post pre/post update events
@@ -92,8 +115,35 @@ public:
     void setSleepDelay(const double ms);
     double getSleepDelay() const { return m_sleepDelay; }
 
-    void pause() { m_paused = true; }
-    void resume() { m_paused = false; }
+    ///
+    /// \brief Set/Get the rate (hz) the driver should update this module at.
+    /// The driver sleeps between updates to meet the deadline instead of spinning.
+    /// 0 updates as fast as possible, yielding the core between updates, default 0
+    ///
+    void setTargetRate(const double hz);
+    double getTargetRate() const { return m_targetRate; }
+
+    ///
+    /// \brief Get/Reset the scheduling statistics of the module, only
+    /// gathered when a target rate is set
+    ///@{
+    ModuleSchedulingStats getSchedulingStats() const;
+    void resetSchedulingStats();
+    ///@}
+
+    ///
+    /// \brief Record a wake up jitter sample (ms), called by the driver
+    ///
+    void addSchedulingSample(const double jitter, const bool overrun);
+
+    void pause() { setPaused(true); }
+    void resume() { setPaused(false); }
+
+    ///
+    /// \brief Block the calling thread until the module is resumed
+    /// or maxWait (ms) has passed, returns whether the module is running
+    ///
+    bool waitForResume(const double maxWait);
 
 public:
     void init() { m_init = initModule(); }
@@ -116,5 +166,12 @@ protected:
     ExecutionType m_executionType = ExecutionType::PARALLEL; // Defaults to parallel, subclass and set
     bool   m_muteUpdateEvents     = false;                   // Avoid posting pre/post update, useful when running modules at extremely fast rates
     double m_sleepDelay = 0.0;                               // ms sleep for the module, useful for throttling some modules
+    double m_targetRate = 0.0;                               // hz the driver should update the module at, 0 for unlimited (yields between updates)
+
+    std::mutex m_pauseMutex;
+    std::condition_variable m_pauseCondition;
+
+    mutable ParallelUtils::SpinLock m_statsLock;
+    ModuleSchedulingStats m_schedulingStats;
 };
 } // namespace imstk
\ No newline at end of file
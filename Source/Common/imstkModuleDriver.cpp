@@ -9,6 +9,16 @@
 
 namespace imstk
 {
+void
+ModuleDriver::requestStatus(ModuleDriverStatus status)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_statusMutex);
+        simState = status;
+    }
+    m_statusCondition.notify_all();
+}
+
 void
 ModuleDriver::waitForInit()
 {
@@ -25,4 +35,11 @@ ModuleDriver::waitForInit()
         }
     }
 }
+
+void
+ModuleDriver::waitWhilePaused()
+{
+    std::unique_lock<std::mutex> lock(m_statusMutex);
+    m_statusCondition.wait(lock, [this]() { return simState != ModuleDriverPaused; });
+}
 } // namespace imstk
\ No newline at end of file
@@ -8,6 +8,9 @@
 
 #include "imstkEventObject.h"
 
+#include <condition_variable>
+#include <mutex>
+
 namespace imstk
 {
 using ModuleDriverStatus = int;
@@ -45,7 +48,11 @@ public:
     ///
     virtual void clearModules() { m_modules.clear(); }
 
-    void requestStatus(ModuleDriverStatus status) { simState = status; }
+    ///
+    /// \brief Request the driver to run/pause/stop, wakes any threads blocked
+    /// in waitWhilePaused
+    ///
+    void requestStatus(ModuleDriverStatus status);
     ModuleDriverStatus getStatus() const { return simState; }
 
     std::vector<std::shared_ptr<Module>>& getModules() { return m_modules; }
@@ -55,9 +62,17 @@ public:
     ///
     void waitForInit();
 
+    ///
+    /// \brief Block the calling thread while the driver is paused
+    ///
+    void waitWhilePaused();
+
 protected:
     std::vector<std::shared_ptr<Module>> m_modules;
 
     std::atomic<ModuleDriverStatus> simState = { ModuleDriverRunning };
+
+    std::mutex m_statusMutex;
+    std::condition_variable m_statusCondition;
 };
 }; // namespace imstk
\ No newline at end of file
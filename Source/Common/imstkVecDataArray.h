@@ -114,7 +114,10 @@ public:
     ///
     /// \brief Constructs an empty data array
     ///
-    VecDataArray() : DataArray<T>(N), m_vecSize(0), m_vecCapacity(1), m_dataCast(reinterpret_cast<ValueType*>(DataArray<T>::m_data)) { }
+    VecDataArray() : DataArray<T>(N), m_vecSize(0), m_vecCapacity(1), m_dataCast(reinterpret_cast<ValueType*>(DataArray<T>::m_data))
+    {
+        AbstractDataArray::m_size = 0;
+    }
 
     ///
     /// \brief Constructs a data array of size
@@ -137,37 +140,18 @@ public:
         }
     }
 
-    VecDataArray(const VecDataArray& other)
+    VecDataArray(const VecDataArray& other) : DataArray<T>(other)
     {
-        DataArray<T>::m_mapped          = other.m_mapped;
-        AbstractDataArray::m_size       = other.m_size;
-        AbstractDataArray::m_capacity   = other.m_capacity;
-        AbstractDataArray::m_scalarType = other.m_scalarType;
-        if (DataArray<T>::m_mapped)
-        {
-            DataArray<T>::m_data = other.m_data;
-        }
-        else
-        {
-            DataArray<T>::m_data = new T[AbstractDataArray::m_capacity];
-            std::copy_n(other.m_data, AbstractDataArray::m_size, DataArray<T>::m_data);
-        }
         m_vecSize     = other.m_vecSize;
         m_vecCapacity = other.m_vecCapacity;
         m_dataCast    = reinterpret_cast<ValueType*>(DataArray<T>::m_data);
     }
 
-    VecDataArray(VecDataArray&& other)
+    VecDataArray(VecDataArray&& other) : DataArray<T>(std::move(other)) // Takes the others buffer
     {
-        DataArray<T>::m_mapped        = other.m_mapped;
-        AbstractDataArray::m_size     = other.m_size;
-        AbstractDataArray::m_capacity = other.m_capacity;
         m_vecSize     = other.m_vecSize;
         m_vecCapacity = other.m_vecCapacity;
-        AbstractDataArray::m_scalarType = other.m_scalarType;
-        DataArray<T>::m_data = other.m_data; // Take the others buffer
-        m_dataCast     = other.m_dataCast;
-        other.m_mapped = true;
+        m_dataCast    = other.m_dataCast;
     }
 
     ~VecDataArray() override = default;
@@ -265,7 +249,7 @@ public:
         const int newVecSize = m_vecSize + 1;
         if (newVecSize > m_vecCapacity)              // If the new size exceeds capacity
         {
-            VecDataArray::resize(m_vecCapacity * 2); // Conservative/copies values
+            VecDataArray::resize(std::max(m_vecCapacity * 2, 1)); // Conservative/copies values
         }
         m_vecSize = newVecSize;
         AbstractDataArray::m_size  = newVecSize * N;
@@ -283,7 +267,7 @@ public:
         const int newVecSize = m_vecSize + 1;
         if (newVecSize > m_vecCapacity)              // If the new size exceeds capacity
         {
-            VecDataArray::resize(m_vecCapacity * 2); // Conservative/copies values
+            VecDataArray::resize(std::max(m_vecCapacity * 2, 1)); // Conservative/copies values
         }
         m_vecSize = newVecSize;
         AbstractDataArray::m_size  = newVecSize * N;
@@ -401,11 +385,8 @@ public:
     VecDataArray<T, N>& operator=(std::initializer_list<Eigen::Matrix<U, M, 1>> list)
     {
         // If previously mapped, don't delete, just overwrite
-        if (!DataArray<T>::m_mapped)
-        {
-            delete[] DataArray<T>::m_data;
-        }
-        DataArray<T>::m_data = new T[list.size() * N];
+        DataArray<T>::deallocate();
+        DataArray<T>::m_data = DataArray<T>::allocate(static_cast<int>(list.size()) * N);
         m_dataCast = reinterpret_cast<ValueType*>(DataArray<T>::m_data);
         int j = 0;
         for (auto i : list)
@@ -437,11 +418,12 @@ public:
                 DataArray<T>::m_size     = 0;
                 m_vecCapacity = 0;
                 m_vecSize     = 0;
+                m_dataCast    = nullptr;
                 DataArray<T>::m_mapped = false;
             }
 
             reserve(other.size());
-            std::copy_n(other.m_data, other.m_size, DataArray<T>::m_data);
+            DataArray<T>::copyValues(other.m_data, other.m_size, DataArray<T>::m_data);
             AbstractDataArray::m_size = other.m_size;
             m_vecSize = other.m_vecSize;
         }
@@ -468,10 +450,7 @@ public:
     ///
     inline void setData(ValueType* ptr, const int size)
     {
-        if (!DataArray<T>::m_mapped)
-        {
-            delete[] DataArray<T>::m_data;
-        }
+        DataArray<T>::deallocate();
 
         DataArray<T>::m_mapped = true;
         DataArray<T>::m_data   = reinterpret_cast<T*>(ptr);
@@ -480,8 +459,25 @@ public:
         m_vecSize = m_vecCapacity = size;
     }
 
+    ///
+    /// \brief Take ownership of a block of size vectors allocated from the allocator, the
+    /// allocator of the array becomes it and the block is freed through it
+    ///
+    inline void setData(ValueType* ptr, const int size, std::shared_ptr<DataArrayAllocator> allocator)
+    {
+        DataArray<T>::setData(reinterpret_cast<T*>(ptr), size * N, allocator);
+        m_dataCast = ptr;
+        m_vecSize  = m_vecCapacity = size;
+    }
+
     inline int getNumberOfComponents() const override { return N; }
 
+    void setAllocator(std::shared_ptr<DataArrayAllocator> allocator) override
+    {
+        DataArray<T>::setAllocator(allocator);
+        m_dataCast = reinterpret_cast<ValueType*>(DataArray<T>::m_data);
+    }
+
     ///
     /// \brief Polymorphic clone, shadows the declaration in the superclasss
     ///        but returns own type
@@ -19,6 +19,8 @@ PbdAngularConstraint::projectConstraint(PbdState& bodies,
 
     double c      = 0.0;
     bool   update = this->computeValueAndGradient(bodies, c, m_dcdx);
+    m_C       = update ? c : 0.0;
+    m_dlambda = 0.0;
     if (!update)
     {
         return;
@@ -55,6 +57,7 @@ PbdAngularConstraint::projectConstraint(PbdState& bodies,
         m_lambda += dlambda;
         break;
     }
+    m_dlambda = dlambda;
 
     for (size_t i = 0; i < m_particles.size(); i++)
     {
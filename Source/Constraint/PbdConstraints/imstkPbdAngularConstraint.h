@@ -28,6 +28,11 @@ public:
     ///
     void projectConstraint(PbdState& bodies,
                            const double dt, const SolverType& type) override;
+
+    ///
+    /// \brief Projection rotates the oriented particles, solved sequentially
+    ///
+    bool getSupportsJacobi() const override { return false; }
 };
 
 ///
@@ -18,22 +18,26 @@ PbdCollisionConstraint::PbdCollisionConstraint(const int numParticlesA, const in
     }
 }
 
-void
-PbdCollisionConstraint::projectConstraint(PbdState& bodies, const double dt, const SolverType&)
+bool
+PbdCollisionConstraint::solveLambda(PbdState& bodies, const double dt, double& lambda)
 {
     if (dt == 0.0)
     {
-        return;
+        return false;
     }
 
     double c      = 0.0;
     bool   update = this->computeValueAndGradient(bodies, c, m_dcdx);
+
+    // Save the collision depth, separated collisions report no violation
+    m_C       = update ? c : 0.0;
+    m_dlambda = 0.0;
     if (!update)
     {
-        return;
+        return false;
     }
 
-    double lambda = 0.0;
+    lambda = 0.0;
 
     // Sum the mass (so we can weight displacements)
     for (size_t i = 0; i < m_particles.size(); i++)
@@ -46,11 +50,52 @@ PbdCollisionConstraint::projectConstraint(PbdState& bodies, const double dt, con
     }
 
     if (lambda == 0.0)
+    {
+        return false;
+    }
+
+    lambda    = c / lambda;
+    m_dlambda = lambda;
+    return true;
+}
+
+void
+PbdCollisionConstraint::warmStart(PbdState& bodies)
+{
+    m_lambda = 0.0;
+    m_accumulatedLambda = 0.0;
+    if (m_warmStartLambda == 0.0)
     {
         return;
     }
 
-    lambda = c / lambda;
+    double c = 0.0;
+    if (!this->computeValueAndGradient(bodies, c, m_dcdx))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < m_particles.size(); i++)
+    {
+        const double invMass = bodies.getInvMass(m_particles[i]);
+        if (invMass > 0.0)
+        {
+            bodies.getPosition(m_particles[i]) += invMass * m_warmStartLambda *
+                                                  m_dcdx[i] * m_stiffness[m_bodiesSides[i]];
+        }
+    }
+    m_accumulatedLambda = m_warmStartLambda;
+}
+
+void
+PbdCollisionConstraint::projectConstraint(PbdState& bodies, const double dt, const SolverType&)
+{
+    double lambda = 0.0;
+    if (!solveLambda(bodies, dt, lambda))
+    {
+        return;
+    }
+    m_accumulatedLambda += lambda;
 
     for (size_t i = 0; i < m_particles.size(); i++)
     {
@@ -63,4 +108,24 @@ PbdCollisionConstraint::projectConstraint(PbdState& bodies, const double dt, con
         }
     }
 }
+
+bool
+PbdCollisionConstraint::computeCorrections(PbdState& bodies, const double dt,
+                                           const SolverType&, std::vector<Vec3d>& dx)
+{
+    double lambda = 0.0;
+    if (!solveLambda(bodies, dt, lambda))
+    {
+        return false;
+    }
+    m_accumulatedLambda += lambda;
+
+    dx.resize(m_particles.size());
+    for (size_t i = 0; i < m_particles.size(); i++)
+    {
+        dx[i] = bodies.getInvMass(m_particles[i]) * lambda *
+                m_dcdx[i] * m_stiffness[m_bodiesSides[i]];
+    }
+    return true;
+}
 } // namespace imstk
\ No newline at end of file
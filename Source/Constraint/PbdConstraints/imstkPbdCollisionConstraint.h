@@ -49,12 +49,37 @@ public:
     const double getEnableBoundaryCollisions() const { return m_enableBoundaryCollisions; }
     ///@}
 
+    ///
+    /// \brief Collisions are not solved with XPBD, the PBD multipliers of the last solve
+    /// are accumulated for warm starting instead
+    ///
+    double getAccumulatedLambda() const override { return m_accumulatedLambda; }
+
+    ///
+    /// \brief Apply the positional correction of the warm start multiplier, weighted
+    /// by the stiffness of each side
+    ///
+    void warmStart(PbdState& bodies) override;
+
     ///
     /// \brief Performs the actual positional solve
     ///
     void projectConstraint(PbdState& bodies,
                            const double dt, const SolverType& type) override;
 
+    ///
+    /// \brief Computes the positional solve without applying it
+    ///
+    bool computeCorrections(PbdState& bodies, const double dt,
+                            const SolverType& type, std::vector<Vec3d>& dx) override;
+
+protected:
+    ///
+    /// \brief Computes the value & gradient then the (PBD) lambda of the collision,
+    /// returns false if the constraint should not be applied
+    ///
+    bool solveLambda(PbdState& bodies, const double dt, double& lambda);
+
 protected:
     PbdCollisionConstraint(const int numParticlesA, const int numParticlesB);
 
@@ -63,5 +88,6 @@ protected:
     /// Enables boundary collisions, turned off by default due to the edge cases present
     /// when a point is fixed/infinite mass that can cause instabilities
     bool m_enableBoundaryCollisions = false;
+    double m_accumulatedLambda      = 0.0; ///< Sum of the PBD multipliers of the last solve
 };
 } // namespace imstk
@@ -42,6 +42,11 @@ public:
     void projectConstraint(PbdState& bodies, const double dt,
                            const SolverType& type) override;
 
+    ///
+    /// \brief Projects all fluid particles at once, solved sequentially
+    ///
+    bool getSupportsJacobi() const override { return false; }
+
     bool computeValueAndGradient(
         PbdState&           imstkNotUsed(bodies),
         double&             imstkNotUsed(c),
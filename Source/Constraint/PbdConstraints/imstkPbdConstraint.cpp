@@ -8,25 +8,26 @@
 
 namespace imstk
 {
-void
-PbdConstraint::projectConstraint(PbdState& bodies,
-                                 const double dt, const SolverType& solverType)
+bool
+PbdConstraint::solveDeltaLambda(PbdState& bodies,
+                                const double dt, const SolverType& solverType, double& dlambda)
 {
     if (dt == 0.0)
     {
-        return;
+        return false;
     }
 
     double c      = 0.0;
     bool   update = this->computeValueAndGradient(bodies, c, m_dcdx);
+
+    // Save constraint value, constraints with no effect report no violation
+    m_C       = update ? c : 0.0;
+    m_dlambda = 0.0;
     if (!update)
     {
-        return;
+        return false;
     }
 
-    // Save constraint value
-    m_C = c;
-
     // Compute generalized inverse mass sum
     double w = 0.0;
     for (size_t i = 0; i < m_particles.size(); i++)
@@ -38,11 +39,10 @@ PbdConstraint::projectConstraint(PbdState& bodies,
     }
     if (w == 0.0)
     {
-        return;
+        return false;
     }
 
-    double dlambda = 0.0;
-    double alpha   = 0.0;
+    double alpha = 0.0;
     switch (solverType)
     {
     case (SolverType::PBD):
@@ -55,6 +55,45 @@ PbdConstraint::projectConstraint(PbdState& bodies,
         break;
     }
     m_lambda += dlambda;
+    m_dlambda = dlambda;
+    return true;
+}
+
+void
+PbdConstraint::warmStart(PbdState& bodies)
+{
+    m_lambda = 0.0;
+    if (m_warmStartLambda == 0.0)
+    {
+        return;
+    }
+
+    double c = 0.0;
+    if (!this->computeValueAndGradient(bodies, c, m_dcdx))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < m_particles.size(); i++)
+    {
+        const double invMass = bodies.getInvMass(m_particles[i]);
+        if (invMass > 0.0)
+        {
+            bodies.getPosition(m_particles[i]) += invMass * m_warmStartLambda * m_dcdx[i];
+        }
+    }
+    m_lambda = m_warmStartLambda;
+}
+
+void
+PbdConstraint::projectConstraint(PbdState& bodies,
+                                 const double dt, const SolverType& solverType)
+{
+    double dlambda = 0.0;
+    if (!solveDeltaLambda(bodies, dt, solverType, dlambda))
+    {
+        return;
+    }
 
     for (size_t i = 0; i < m_particles.size(); i++)
     {
@@ -66,6 +105,24 @@ PbdConstraint::projectConstraint(PbdState& bodies,
     }
 }
 
+bool
+PbdConstraint::computeCorrections(PbdState& bodies,
+                                  const double dt, const SolverType& solverType, std::vector<Vec3d>& dx)
+{
+    double dlambda = 0.0;
+    if (!solveDeltaLambda(bodies, dt, solverType, dlambda))
+    {
+        return false;
+    }
+
+    dx.resize(m_particles.size());
+    for (size_t i = 0; i < m_particles.size(); i++)
+    {
+        dx[i] = bodies.getInvMass(m_particles[i]) * dlambda * m_dcdx[i];
+    }
+    return true;
+}
+
 void
 PbdConstraint::correctVelocity(PbdState& bodies, const double)
 {
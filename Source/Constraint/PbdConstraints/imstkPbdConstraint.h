@@ -119,10 +119,16 @@ public:
     double getConstraintC() const { return m_C; }
 
     ///
-    /// \brief Get constraint value C (how much the constraint is violated)
+    /// \brief Get the lagrange multiplier
     ///
     double getLambda() const { return m_lambda; }
 
+    ///
+    /// \brief Get the change in lagrange multiplier of the last projection, 0 if
+    /// the constraint had no effect
+    ///
+    double getDeltaLambda() const { return m_dlambda; }
+
     ///
     /// \brief Get reference constraint value. This value will have different context depending on
     /// the constraint being used.
@@ -135,11 +141,52 @@ public:
     ///
     void zeroOutLambda() { m_lambda = 0.0; }
 
+    ///
+    /// \brief Get/Set the lagrange multiplier carried over from the previous step, applied
+    /// by warmStart. Used for persistent contacts, 0 (default) to not warm start
+    ///@{
+    void setWarmStartLambda(const double lambda) { m_warmStartLambda = lambda; }
+    double getWarmStartLambda() const { return m_warmStartLambda; }
+    ///@}
+
+    ///
+    /// \brief Get the lagrange multiplier accumulated over the last solve, including
+    /// the warm start. This is what is carried over to warm start the next step
+    ///
+    virtual double getAccumulatedLambda() const { return m_lambda; }
+
+    ///
+    /// \brief Zero out the lagrange multiplier then apply the positional correction of
+    /// the warm start multiplier along the current gradient, as if solved by a first
+    /// iteration. Constraints currently without effect are not warm started
+    ///
+    virtual void warmStart(PbdState& bodies);
+
     ///
     /// \brief Update positions by projecting constraints.
     ///
     virtual void projectConstraint(PbdState& bodies, const double dt, const SolverType& type);
 
+    ///
+    /// \brief Computes the positional corrections of the constraint without applying them.
+    /// Used by Jacobi style solvers that project many constraints concurrently. The lagrange
+    /// multiplier is still accumulated.
+    /// \param bodies of the system, only read
+    /// \param dt time step
+    /// \param type of solver
+    /// \param dx Resized and filled with the positional correction per particle of the constraint
+    /// \return false if the constraint had no effect
+    ///
+    virtual bool computeCorrections(PbdState& bodies, const double dt,
+                                    const SolverType& type, std::vector<Vec3d>& dx);
+
+    ///
+    /// \brief Whether the constraint can be solved through computeCorrections. Constraints
+    /// that modify more than particle positions (orientations, multiple substeps, ...) return false
+    /// and are always projected sequentially
+    ///
+    virtual bool getSupportsJacobi() const { return true; }
+
     ///
     /// \brief Correct velocities according to friction and restitution
     /// Corrects according to the gradient direction
@@ -188,6 +235,13 @@ public:
     }
 
 protected:
+    ///
+    /// \brief Computes the value & gradient then solves for the change in lagrange multiplier,
+    /// accumulating it. Returns false if the constraint should not be applied
+    ///
+    bool solveDeltaLambda(PbdState& bodies, const double dt,
+                          const SolverType& type, double& dlambda);
+
     PbdConstraint(const size_t numParticles)
     {
         m_particles.resize(numParticles);
@@ -200,6 +254,8 @@ protected:
     double m_stiffness  = 1.0;              ///< used in PBD, [0, 1]
     double m_compliance = 1e-7;             ///< used in xPBD, inverse of Stiffness
     double m_lambda     = 0.0;              ///< Lagrange multiplier
+    double m_dlambda    = 0.0;              ///< Change in lagrange multiplier of the last projection
+    double m_warmStartLambda = 0.0;         ///< Lagrange multiplier carried over from the previous step
     double m_C = 0.0;                       ///< Constraint Value
     double m_friction        = 0.0;
     double m_restitution     = 0.0;
@@ -5,9 +5,25 @@
 */
 
 #include "imstkPbdConstraintContainer.h"
-#include "imstkGraph.h"
+#include "imstkParallelUtils.h"
 
-#include <unordered_map>
+#include <numeric>
+
+namespace
+{
+///
+/// \brief Pseudo random, but deterministic, coloring priority of a constraint
+///
+inline uint64_t
+coloringPriority(uint64_t x)
+{
+    // splitmix64 finalizer
+    x += 0x9E3779B97F4A7C15ULL;
+    x  = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x  = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+} // namespace
 
 namespace imstk
 {
@@ -81,52 +97,208 @@ PbdConstraintContainer::eraseConstraint(const_iterator iter)
 void
 PbdConstraintContainer::partitionConstraints(const int partitionedThreshold)
 {
-    // Form the map { vertex : list_of_constraints_involve_vertex }
     std::vector<std::shared_ptr<PbdConstraint>>& allConstraints = m_constraints;
 
-    //std::cout << "---------partitionConstraints: " << allConstraints.size() << std::endl;
+    // Repartition everything, constraints may have been added since the last partitioning
+    for (const auto& partition : m_partitionedConstraints)
+    {
+        allConstraints.insert(allConstraints.end(), partition.begin(), partition.end());
+    }
+    m_partitionedConstraints.clear();
+    const int numConstraints = static_cast<int>(allConstraints.size());
 
-    std::unordered_map<size_t, std::vector<size_t>> vertexConstraints;
-    for (size_t constrIdx = 0; constrIdx < allConstraints.size(); ++constrIdx)
+    // Give every particle a dense index keyed on the full (body, particle) id
+    std::vector<int> bodyOffsets;
+    for (const auto& constraint : allConstraints)
     {
-        const auto& constr = allConstraints[constrIdx];
-        for (const auto& vIds : constr->getParticles())
+        for (const PbdParticleId& pid : constraint->getParticles())
         {
-            vertexConstraints[vIds.second].push_back(constrIdx);
+            if (pid.first >= static_cast<int>(bodyOffsets.size()))
+            {
+                bodyOffsets.resize(pid.first + 1, 0);
+            }
+            bodyOffsets[pid.first] = std::max(bodyOffsets[pid.first], pid.second + 1);
         }
     }
+    int numParticles = 0;
+    for (int& offset : bodyOffsets)
+    {
+        const int bodySize = offset;
+        offset        = numParticles;
+        numParticles += bodySize;
+    }
 
-    // Add edges to the constraint graph
-    // Each edge represent a shared vertex between two constraints
-    Graph constraintGraph(allConstraints.size());
-    for (const auto& kv : vertexConstraints)
+    // Constraint to particles, and particle to constraints incidence in compressed rows (CSR)
+    std::vector<int> constraintStart(numConstraints + 1, 0);
+    for (int constrIdx = 0; constrIdx < numConstraints; constrIdx++)
+    {
+        constraintStart[constrIdx + 1] = constraintStart[constrIdx] +
+                                         static_cast<int>(allConstraints[constrIdx]->getParticles().size());
+    }
+    std::vector<int> constraintParticles(constraintStart.back());
+    std::vector<int> particleStart(numParticles + 1, 0);
+    for (int constrIdx = 0; constrIdx < numConstraints; constrIdx++)
     {
-        const auto& constraints = kv.second;     // the list of constraints for a vertex
-        for (size_t i = 0; i < constraints.size(); ++i)
+        int i = constraintStart[constrIdx];
+        for (const PbdParticleId& pid : allConstraints[constrIdx]->getParticles())
         {
-            for (size_t j = i + 1; j < constraints.size(); ++j)
+            constraintParticles[i] = bodyOffsets[pid.first] + pid.second;
+            particleStart[constraintParticles[i] + 1]++;
+            i++;
+        }
+    }
+    std::partial_sum(particleStart.begin(), particleStart.end(), particleStart.begin());
+    std::vector<int> particleConstraints(particleStart.back());
+    {
+        std::vector<int> fillIdx(particleStart.begin(), particleStart.end() - 1);
+        for (int constrIdx = 0; constrIdx < numConstraints; constrIdx++)
+        {
+            for (int i = constraintStart[constrIdx]; i < constraintStart[constrIdx + 1]; i++)
             {
-                constraintGraph.addEdge(constraints[i], constraints[j]);
+                particleConstraints[fillIdx[constraintParticles[i]]++] = constrIdx;
             }
         }
     }
-    vertexConstraints.clear();
 
-    // do graph coloring for the constraint graph
-    const auto coloring = constraintGraph.doColoring(Graph::ColoringMethod::WelshPowell);
-    // const auto  coloring = constraintGraph.doColoring(Graph::ColoringMethod::Greedy);
-    const auto& partitionIndices = coloring.first;
-    const auto  numPartitions    = coloring.second;
-    assert(partitionIndices.size() == allConstraints.size());
+    // Calls func(neighborIdx) for every constraint sharing a particle with constrIdx (with repeats)
+    // until func returns false
+    auto forEachNeighbor = [&](const int constrIdx, auto func)
+                           {
+                               for (int j = constraintStart[constrIdx]; j < constraintStart[constrIdx + 1]; j++)
+                               {
+                                   const int particleIdx = constraintParticles[j];
+                                   for (int i = particleStart[particleIdx]; i < particleStart[particleIdx + 1]; i++)
+                                   {
+                                       if (particleConstraints[i] != constrIdx && !func(particleConstraints[i]))
+                                       {
+                                           return;
+                                       }
+                                   }
+                               }
+                           };
+
+    // Jones-Plassmann coloring, every round the uncolored constraints with the highest
+    // priority among their uncolored neighbors take the smallest color free among their
+    // neighbors. Those can't be neighbors of each other so they are colored in parallel
+    std::vector<int>  colors(numConstraints, -1);
+    std::vector<char> isLocalMax(numConstraints, 0);
+    std::vector<int>  uncolored(numConstraints);
+    std::iota(uncolored.begin(), uncolored.end(), 0);
+    std::vector<uint64_t> priorities(numConstraints);
+    for (int constrIdx = 0; constrIdx < numConstraints; constrIdx++)
+    {
+        priorities[constrIdx] = coloringPriority(static_cast<uint64_t>(constrIdx));
+    }
+    auto higherPriority = [&](const int a, const int b)
+                          {
+                              return (priorities[a] == priorities[b]) ? (a > b) : (priorities[a] > priorities[b]);
+                          };
+    while (!uncolored.empty())
+    {
+        ParallelUtils::parallelFor(uncolored.size(),
+            [&](const size_t i)
+            {
+                const int constrIdx = uncolored[i];
+                bool localMax       = true;
+                forEachNeighbor(constrIdx, [&](const int neighborIdx)
+                {
+                    localMax = !(colors[neighborIdx] == -1 && higherPriority(neighborIdx, constrIdx));
+                    return localMax;
+                });
+                isLocalMax[constrIdx] = localMax;
+            }, uncolored.size() > 50);
+
+        ParallelUtils::parallelFor(uncolored.size(),
+            [&](const size_t i)
+            {
+                const int constrIdx = uncolored[i];
+                if (!isLocalMax[constrIdx])
+                {
+                    return;
+                }
+                thread_local std::vector<int> neighborColors;
+                neighborColors.clear();
+                forEachNeighbor(constrIdx, [&](const int neighborIdx)
+                {
+                    if (colors[neighborIdx] != -1)
+                    {
+                        neighborColors.push_back(colors[neighborIdx]);
+                    }
+                    return true;
+                });
+                std::sort(neighborColors.begin(), neighborColors.end());
+                int color = 0;
+                for (const int neighborColor : neighborColors)
+                {
+                    if (neighborColor == color)
+                    {
+                        color++;
+                    }
+                    else if (neighborColor > color)
+                    {
+                        break;
+                    }
+                }
+                colors[constrIdx] = color;
+            }, uncolored.size() > 50);
+
+        uncolored.erase(std::remove_if(uncolored.begin(), uncolored.end(),
+            [&](const int constrIdx) { return colors[constrIdx] != -1; }), uncolored.end());
+    }
+
+    const int numPartitions = (numConstraints == 0) ? 0 : *std::max_element(colors.begin(), colors.end()) + 1;
+
+    // Balance the partitions, greedy coloring leaves the first colors large and the last
+    // ones small. Move constraints of colors over the average size to a color under it
+    // that none of its neighbors use
+    std::vector<int> partitionSizes(numPartitions, 0);
+    for (const int color : colors)
+    {
+        partitionSizes[color]++;
+    }
+    if (numPartitions > 1)
+    {
+        const int         targetSize = (numConstraints + numPartitions - 1) / numPartitions;
+        std::vector<char> usedColors(numPartitions, 0);
+        for (int constrIdx = 0; constrIdx < numConstraints; constrIdx++)
+        {
+            if (partitionSizes[colors[constrIdx]] <= targetSize)
+            {
+                continue;
+            }
+            forEachNeighbor(constrIdx, [&](const int neighborIdx)
+            {
+                usedColors[colors[neighborIdx]] = 1;
+                return true;
+            });
+            for (int color = 0; color < numPartitions; color++)
+            {
+                if (!usedColors[color] && partitionSizes[color] < targetSize)
+                {
+                    partitionSizes[colors[constrIdx]]--;
+                    partitionSizes[color]++;
+                    colors[constrIdx] = color;
+                    break;
+                }
+            }
+            forEachNeighbor(constrIdx, [&](const int neighborIdx)
+            {
+                usedColors[colors[neighborIdx]] = 0;
+                return true;
+            });
+        }
+    }
 
     std::vector<std::vector<std::shared_ptr<PbdConstraint>>>& partitionedConstraints = m_partitionedConstraints;
     partitionedConstraints.resize(0);
     partitionedConstraints.resize(static_cast<size_t>(numPartitions));
-
-    for (size_t constrIdx = 0; constrIdx < partitionIndices.size(); ++constrIdx)
+    for (int partitionIdx = 0; partitionIdx < numPartitions; partitionIdx++)
     {
-        const auto partitionIdx = partitionIndices[constrIdx];
-        partitionedConstraints[partitionIdx].push_back(allConstraints[constrIdx]);
+        partitionedConstraints[partitionIdx].reserve(partitionSizes[partitionIdx]);
+    }
+    for (int constrIdx = 0; constrIdx < numConstraints; ++constrIdx)
+    {
+        partitionedConstraints[colors[constrIdx]].push_back(allConstraints[constrIdx]);
     }
 
     // If a partition has size smaller than the partition threshold, then move its constraints back
@@ -158,21 +330,5 @@ PbdConstraintContainer::partitionConstraints(const int partitionedThreshold)
         }
     }
     partitionedConstraints.resize(writeIdx);
-
-    // Print
-    /*if (print)
-    {
-        size_t numConstraints = 0;
-        int    idx = 0;
-        for (const auto& constraints : partitionedConstraints)
-        {
-            std::cout << "Partition # " << idx++ << " | # nodes: " << constraints.size() << std::endl;
-            numConstraints += constraints.size();
-        }
-        std::cout << "Sequential processing # nodes: " << allConstraints.size() << std::endl;
-        numConstraints += allConstraints.size();
-        std::cout << "Total constraints: " << numConstraints << " | Graph size: "
-            << constraintGraph.size() << std::endl;
-    }*/
 }
-} // namespace imstk
\ No newline at end of file
+} // namespace imstk
@@ -71,10 +71,12 @@ public:
     ///
     /// \brief Get the partitioned constraints
     ///
-    const std::vector<std::vector<std::shared_ptr<PbdConstraint>>> getPartitionedConstraints() const { return m_partitionedConstraints; }
+    const std::vector<std::vector<std::shared_ptr<PbdConstraint>>>& getPartitionedConstraints() const { return m_partitionedConstraints; }
 
     ///
-    /// \brief Partitions pbd constraints into separate vectors via graph coloring
+    /// \brief Partitions pbd constraints into separate vectors via graph coloring, constraints
+    /// in the same partition don't share particles. Colors in parallel (Jones-Plassmann) and
+    /// then balances the partition sizes. Calling it again repartitions all constraints
     /// \param Minimum number of constraints in groups, any under will be dumped back into m_constraints
     ///
     void partitionConstraints(const int partitionThreshold);
@@ -0,0 +1,351 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkPbdFemConstraint.h"
+
+#include <limits>
+
+namespace imstk
+{
+///
+/// \brief Scalar templated value and gradient functions of the common pbd constraints.
+/// The double precision constraints and the single precision solver share these so
+/// both compute the same thing. Each returns false when the constraint can't be
+/// solved (degenerate element). dcdx must point to one gradient per particle
+///
+namespace PbdConstraintKernels
+{
+template<typename T>
+using Vec3 = Eigen::Matrix<T, 3, 1>;
+template<typename T>
+using Mat3 = Eigen::Matrix<T, 3, 3>;
+
+///
+/// \brief Distance between two particles, c = |p0 - p1| - restLength
+///
+template<typename T>
+bool
+distance(const Vec3<T>& p0, const Vec3<T>& p1, const T restLength,
+         T& c, Vec3<T>* dcdx)
+{
+    dcdx[0] = p0 - p1;
+    const T len = dcdx[0].norm();
+    if (len < T(1.0e-16))
+    {
+        return false;
+    }
+    dcdx[0] /= len;
+    dcdx[1]  = -dcdx[0];
+    c        = len - restLength;
+    return true;
+}
+
+///
+/// \brief Signed volume of a tetrahedron, c = volume - restVolume
+///
+template<typename T>
+bool
+volume(const Vec3<T>& x0, const Vec3<T>& x1, const Vec3<T>& x2, const Vec3<T>& x3,
+       const T restVolume, T& c, Vec3<T>* dcdx)
+{
+    const T onesixth = T(1.0 / 6.0);
+
+    dcdx[0] = onesixth * (x1 - x2).cross(x3 - x1);
+    dcdx[1] = onesixth * (x2 - x0).cross(x3 - x0);
+    dcdx[2] = onesixth * (x3 - x0).cross(x1 - x0);
+    dcdx[3] = onesixth * (x1 - x0).cross(x2 - x0);
+
+    c = dcdx[3].dot(x3 - x0) - restVolume;
+    return true;
+}
+
+///
+/// \brief Angle between the triangles (p0, p2, p3) and (p1, p3, p2), c = angle - restAngle
+///
+template<typename T>
+bool
+dihedral(const Vec3<T>& p0, const Vec3<T>& p1, const Vec3<T>& p2, const Vec3<T>& p3,
+         const T restAngle, T& c, Vec3<T>* dcdx)
+{
+    const Vec3<T> e  = p3 - p2;
+    const Vec3<T> e1 = p3 - p0;
+    const Vec3<T> e2 = p0 - p2;
+    const Vec3<T> e3 = p3 - p1;
+    const Vec3<T> e4 = p1 - p2;
+    // To accelerate, all normal (area) vectors and edge length should be precomputed in parallel
+    Vec3<T> n1 = e1.cross(e);
+    Vec3<T> n2 = e.cross(e3);
+    const T A1 = n1.norm();
+    const T A2 = n2.norm();
+    n1 /= A1;
+    n2 /= A2;
+
+    const T l = e.norm();
+    if (l < T(1.0e-16))
+    {
+        return false;
+    }
+
+    dcdx[0] = -(l / A1) * n1;
+    dcdx[1] = -(l / A2) * n2;
+    dcdx[2] = (e.dot(e1) / (A1 * l)) * n1 + (e.dot(e3) / (A2 * l)) * n2;
+    dcdx[3] = (e.dot(e2) / (A1 * l)) * n1 + (e.dot(e4) / (A2 * l)) * n2;
+
+    c = std::atan2(n1.cross(n2).dot(e), l * n1.dot(n2)) - restAngle;
+    return true;
+}
+
+///
+/// \brief Handle inverted tets with the method described by Irving et. al. in
+/// "Invertible Finite Elements For Robust Simulation of Large Deformation"
+/// Computes F = U * Fhat * VT with U, VT pure rotations and clamped singular values
+///
+template<typename T>
+void
+handleTetInversion(const Mat3<T>& F, Mat3<T>& U, Mat3<T>& Fhat, Mat3<T>& VT)
+{
+    // Compute SVD of F and return U and VT. Modify to handle inversions. F = U\hat{F} V^{T}
+    Eigen::JacobiSVD<Mat3<T>> svd(F, Eigen::ComputeFullU | Eigen::ComputeFullV);
+
+    // Save \hat{F}
+    const Vec3<T> sigma(svd.singularValues());
+
+    // Store as matrix
+    for (int i = 0; i < 3; i++)
+    {
+        Fhat(i, i) = sigma(i);
+    }
+
+    // Save U and V
+    U = svd.matrixU();
+    Mat3<T> V = svd.matrixV();
+
+    // If detV is negative, then V includes a reflection.
+    // Switch to reflection by multiplying one column by -1
+    if (V.determinant() < T(0.0))
+    {
+        T   minLambda = std::numeric_limits<T>::max();
+        int column    = 0;
+        for (int i = 0; i < 3; i++)
+        {
+            if (Fhat(i, i) < minLambda)
+            {
+                column    = i;
+                minLambda = Fhat(i, i);
+            }
+        }
+
+        V.col(column) *= T(-1.0);
+    }
+
+    VT = V.transpose();
+
+    // Check for small singular values
+    int count    = 0; // number of small singlar values
+    int position = 0; // position of small singular values
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (std::abs(Fhat(i, i)) < T(1E-4))
+        {
+            position = i;
+            count++;
+        }
+    }
+
+    if (count > 0)
+    {
+        // If more than one singular value is small the element has collapsed
+        // to a line or point. To fix set U to identity.
+        if (count > 1)
+        {
+            U.setIdentity();
+        }
+        else
+        {
+            U = F * V;
+
+            for (int i = 0; i < 3; i++)
+            {
+                if (i != position)
+                {
+                    for (int j = 0; j < 3; j++)
+                    {
+                        U(j, i) *= T(1.0) / Fhat(i, i);
+                    }
+                }
+            }
+
+            // Replace column of U associated with small singular value with
+            // new basis orthogonal to other columns of U
+            Vec3<T> v[2];
+            int     index = 0;
+            for (int i = 0; i < 3; i++)
+            {
+                if (i != position)
+                {
+                    v[index++] = U.col(i);
+                }
+            }
+
+            U.col(position) = v[0].cross(v[1]).normalized();
+        }
+    }
+    else // No modificaitons required: U = FV\hat{F}^{-1}
+    {
+        U = F * V * Fhat.inverse();
+    }
+
+    // If detU is negative, then U includes a reflection.
+    if (U.determinant() < T(0.0))
+    {
+        int positionU = 0;
+        T   minLambda = std::numeric_limits<T>::max();
+        for (int i = 0; i < 3; i++)
+        {
+            if (Fhat(i, i) < minLambda)
+            {
+                positionU = i;
+                minLambda = Fhat(i, i);
+            }
+        }
+
+        // Invert values of smallest singular value and associated column of U
+        // This "pushes" the node nearest the uninverted state towards the uninverted state
+        Fhat(positionU, positionU) *= T(-1.0);
+        U.col(positionU)           *= T(-1.0);
+    }
+
+    // Clamp small singular values of Fhat
+    const T clamp = T(0.577);
+    for (int i = 0; i < 3; i++)
+    {
+        if (Fhat(i, i) < clamp)
+        {
+            Fhat(i, i) = clamp;
+        }
+    }
+}
+
+///
+/// \brief Strain energy of a linear tetrahedral element, c = restVolume * W(F)
+/// \param invRestMat inverse of the rest shape matrix, columns (p0 - p3, p1 - p3, p2 - p3)
+///
+template<typename T>
+bool
+femTet(const Vec3<T>& p0, const Vec3<T>& p1, const Vec3<T>& p2, const Vec3<T>& p3,
+       const Mat3<T>& invRestMat, const T restVolume, const T mu, const T lambda,
+       const PbdFemConstraint::MaterialType material, const bool handleInversions,
+       T& c, Vec3<T>* dcdx)
+{
+    Mat3<T> m;
+    m.col(0) = p0 - p3;
+    m.col(1) = p1 - p3;
+    m.col(2) = p2 - p3;
+
+    // deformation gradient (F)
+    const Mat3<T> defgrad = m * invRestMat;
+
+    // SVD matrices
+    Mat3<T> U    = Mat3<T>::Identity();
+    Mat3<T> Fhat = Mat3<T>::Identity();
+    Mat3<T> VT   = Mat3<T>::Identity();
+
+    Mat3<T> F = defgrad;
+
+    // If inverted, handle if flag set to true
+    if (handleInversions && defgrad.determinant() <= T(1E-8))
+    {
+        handleTetInversion<T>(defgrad, U, Fhat, VT);
+        F = Fhat; // diagonalized deformation gradient
+    }
+
+    // First Piola-Kirchhoff tensor
+    Mat3<T> P = Mat3<T>::Zero();
+    // energy constraint
+    T C = T(0.0);
+
+    switch (material)
+    {
+    // P(F) = F*(2*mu*E + lambda*tr(E)*I)
+    // E = (F^T*F - I)/2
+    case PbdFemConstraint::MaterialType::StVK:
+    {
+        const Mat3<T> I = Mat3<T>::Identity();
+        const Mat3<T> E = T(0.5) * (F.transpose() * F - I);
+
+        P = F * (T(2.0) * mu * E + lambda * E.trace() * I);
+
+        // C here is strain energy (Often denoted as W in literature)
+        // for the StVK mondel W = mu[tr(E^{T}E)] + 0.5*lambda*(tr(E))^2
+        C = T(0.5) * lambda * (E.trace() * E.trace()) + mu * (E * E).trace();
+        break;
+    }
+    // P(F) = (2*mu*(F-R) + lambda*(J-1)*J*F^-T
+    case PbdFemConstraint::MaterialType::Corotation:
+    {
+        Eigen::JacobiSVD<Mat3<T>> svd(F, Eigen::ComputeFullU | Eigen::ComputeFullV);
+        const Mat3<T>             R = svd.matrixU() * svd.matrixV().adjoint();
+        const Vec3<T>             Sigma(svd.singularValues());
+        Mat3<T>                   invFT = svd.matrixU();
+        invFT.col(0) /= Sigma(0);
+        invFT.col(1) /= Sigma(1);
+        invFT.col(2) /= Sigma(2);
+        invFT *= svd.matrixV().adjoint();
+        const T       J  = Sigma(0) * Sigma(1) * Sigma(2);
+        const Mat3<T> FR = F - R;
+
+        P = T(2.0) * mu * FR + lambda * (J - T(1.0)) * J * invFT;
+        C = mu * FR.squaredNorm() + T(0.5) * lambda * (J - T(1.0)) * (J - T(1.0));
+        break;
+    }
+    // P(F) = mu*(F - mu*F^-T) + 0.5*lambda*log^{2}(J)F^-T;
+    // C = 0.5*mu*(I1 - log(I3) - 3) + (lambda/8)*log^{2}(I3)
+    case PbdFemConstraint::MaterialType::NeoHookean:
+    {
+        // First invariant
+        const T I1 = (F * F.transpose()).trace();
+
+        // Third invariant
+        const T I3    = (F.transpose() * F).determinant();
+        const T logI3 = std::log(I3);
+
+        const Mat3<T> F_invT = F.inverse().transpose();
+
+        P = mu * (F - F_invT) + T(0.5) * lambda * logI3 * F_invT;
+        C = T(0.5) * mu * (I1 - logI3 - T(3.0)) + T(0.125) * lambda * (logI3 * logI3);
+        break;
+    }
+    // e = 0.5*(F*F^{T} - I)
+    // P = 2*mu*e + lambda*tr(e)*I
+    case PbdFemConstraint::MaterialType::Linear:
+    {
+        const Mat3<T> I = Mat3<T>::Identity();
+        const Mat3<T> e = T(0.5) * (F * F.transpose() - I);
+
+        P = T(2.0) * mu * e + lambda * e.trace() * I;
+        C = mu * (e * e).trace() + T(0.5) * lambda * e.trace() * e.trace();
+        break;
+    }
+    default:
+        break;
+    }
+
+    // Rotate P back here. P = U\hat{P}V^{T}
+    P = U * P * VT;
+
+    const Mat3<T> gradC = restVolume * P * invRestMat.transpose();
+    c       = C * restVolume;
+    dcdx[0] = gradC.col(0);
+    dcdx[1] = gradC.col(1);
+    dcdx[2] = gradC.col(2);
+    dcdx[3] = -dcdx[0] - dcdx[1] - dcdx[2];
+    return true;
+}
+} // namespace PbdConstraintKernels
+} // namespace imstk
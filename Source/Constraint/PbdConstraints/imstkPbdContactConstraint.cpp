@@ -22,6 +22,8 @@ PbdContactConstraint::projectConstraint(PbdState& bodies,
     double c      = 0.0;
     bool   update = this->computeValueAndGradient(bodies, c,
         m_dcdx);
+    m_C       = update ? c : 0.0;
+    m_dlambda = 0.0;
     if (!update)
     {
         return;
@@ -52,7 +54,32 @@ PbdContactConstraint::projectConstraint(PbdState& bodies,
         m_lambda += dlambda;
         break;
     }
+    m_dlambda = dlambda;
 
+    applyPositionalImpulse(bodies, dlambda);
+}
+
+void
+PbdContactConstraint::warmStart(PbdState& bodies)
+{
+    m_lambda = 0.0;
+    if (m_warmStartLambda == 0.0)
+    {
+        return;
+    }
+
+    double c = 0.0;
+    if (!this->computeValueAndGradient(bodies, c, m_dcdx))
+    {
+        return;
+    }
+    applyPositionalImpulse(bodies, m_warmStartLambda);
+    m_lambda = m_warmStartLambda;
+}
+
+void
+PbdContactConstraint::applyPositionalImpulse(PbdState& bodies, const double dlambda)
+{
     for (size_t i = 0; i < m_particles.size(); i++)
     {
         const double invMass = bodies.getInvMass(m_particles[i]);
@@ -38,6 +38,17 @@ public:
     void projectConstraint(PbdState& bodies,
                            const double dt, const SolverType& type) override;
 
+    ///
+    /// \brief Warm start correcting rigid body orientations as well, the multiplier is
+    /// only accumulated with xPBD
+    ///
+    void warmStart(PbdState& bodies) override;
+
+    ///
+    /// \brief Projection also corrects rigid body orientations, solved sequentially
+    ///
+    bool getSupportsJacobi() const override { return false; }
+
     virtual Vec3d computeRelativeVelocity(PbdState& imstkNotUsed(bodies)) { return Vec3d::Zero(); }
 
     ///
@@ -75,6 +86,12 @@ public:
     }
 
 protected:
+    ///
+    /// \brief Apply the positional impulse dlambda along the gradients at the support
+    /// points, translating and rotating the bodies
+    ///
+    void applyPositionalImpulse(PbdState& bodies, const double dlambda);
+
     std::vector<Vec3d>  m_r;
     std::vector<double> m_weights;
 };
@@ -5,6 +5,7 @@
 */
 
 #include "imstkPbdDistanceConstraint.h"
+#include "imstkPbdConstraintKernels.h"
 
 namespace  imstk
 {
@@ -25,19 +26,8 @@ bool
 PbdDistanceConstraint::computeValueAndGradient(PbdState& bodies,
                                                double& c, std::vector<Vec3d>& dcdx)
 {
-    const Vec3d& p0 = bodies.getPosition(m_particles[0]);
-    const Vec3d& p1 = bodies.getPosition(m_particles[1]);
-
-    dcdx[0] = p0 - p1;
-    const double len = dcdx[0].norm();
-    if (len < 1.0e-16)
-    {
-        return false;
-    }
-    dcdx[0] /= len;
-    dcdx[1]  = -dcdx[0];
-    c        = len - m_restLength;
-
-    return true;
+    return PbdConstraintKernels::distance<double>(
+        bodies.getPosition(m_particles[0]), bodies.getPosition(m_particles[1]),
+        m_restLength, c, dcdx.data());
 }
 } // namespace imstk
\ No newline at end of file
@@ -38,6 +38,11 @@ public:
     void projectConstraint(PbdState& bodies,
                            const double dt, const SolverType& type) override;
 
+    ///
+    /// \brief Projection is substepped, solved sequentially
+    ///
+    bool getSupportsJacobi() const override { return false; }
+
     ///
     /// \brief Compute value and gradient of constraint function
     /// \param[inout] set of bodies involved in system
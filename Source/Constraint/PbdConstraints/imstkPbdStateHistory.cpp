@@ -0,0 +1,141 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkPbdStateHistory.h"
+
+#include <cstring>
+
+namespace imstk
+{
+void
+PbdStateHistory::setCapacity(const size_t capacity)
+{
+    m_deltas.resize(capacity);
+    clear();
+}
+
+void
+PbdStateHistory::push(const PbdState& state)
+{
+    if (m_deltas.empty())
+    {
+        return;
+    }
+
+    m_scratch.save(state);
+
+    // Nothing to diff against
+    if (m_latest.isEmpty() || !m_latest.hasSameLayout(m_scratch))
+    {
+        m_firstDelta = 0;
+        m_numDeltas  = 0;
+        std::swap(m_latest, m_scratch);
+        return;
+    }
+
+    // Overwrite the oldest delta when full
+    size_t index = 0;
+    if (m_numDeltas < m_deltas.size())
+    {
+        index = (m_firstDelta + m_numDeltas) % m_deltas.size();
+        m_numDeltas++;
+    }
+    else
+    {
+        index        = m_firstDelta;
+        m_firstDelta = (m_firstDelta + 1) % m_deltas.size();
+    }
+    computeDelta(m_latest.getData(), m_scratch.getData(), m_deltas[index]);
+
+    // Swapping keeps both arenas allocated
+    std::swap(m_latest, m_scratch);
+}
+
+bool
+PbdStateHistory::rewind(PbdState& state, const size_t numSteps)
+{
+    if (numSteps > m_numDeltas || !m_latest.hasSameLayout(state))
+    {
+        return false;
+    }
+
+    // Undo the newest deltas in the latest state
+    std::vector<double>& data = m_latest.getData();
+    for (size_t i = 0; i < numSteps; i++)
+    {
+        const Delta& delta = m_deltas[(m_firstDelta + m_numDeltas - 1) % m_deltas.size()];
+        const double* values = delta.values.data();
+        for (const auto& run : delta.runs)
+        {
+            std::memcpy(data.data() + run.first, values, run.second * sizeof(double));
+            values += run.second;
+        }
+        m_numDeltas--;
+    }
+    return m_latest.restore(state);
+}
+
+void
+PbdStateHistory::clear()
+{
+    m_latest.clear();
+    m_firstDelta = 0;
+    m_numDeltas  = 0;
+}
+
+size_t
+PbdStateHistory::getNumBytes() const
+{
+    size_t numBytes = m_latest.getNumBytes();
+    for (size_t i = 0; i < m_numDeltas; i++)
+    {
+        const Delta& delta = m_deltas[(m_firstDelta + i) % m_deltas.size()];
+        numBytes += delta.runs.size() * sizeof(std::pair<size_t, size_t>) + delta.values.size() * sizeof(double);
+    }
+    return numBytes;
+}
+
+void
+PbdStateHistory::computeDelta(const std::vector<double>& a, const std::vector<double>& b, Delta& delta)
+{
+    // Runs separated by less unchanged values than this are merged
+    static constexpr size_t maxGap = 4;
+
+    delta.runs.clear();
+    delta.values.clear();
+
+    // Compare bits so that equal nan values don't count as changes
+    auto changed = [&](const size_t i)
+                   {
+                       return std::memcmp(&a[i], &b[i], sizeof(double)) != 0;
+                   };
+
+    const size_t n = a.size();
+    size_t       i = 0;
+    while (i < n)
+    {
+        if (!changed(i))
+        {
+            i++;
+            continue;
+        }
+
+        // Extend the run until maxGap unchanged values in a row
+        size_t lastChanged = i;
+        for (size_t j = i + 1; j < n && j - lastChanged <= maxGap; j++)
+        {
+            if (changed(j))
+            {
+                lastChanged = j;
+            }
+        }
+
+        delta.runs.push_back({ i, lastChanged + 1 - i });
+        delta.values.insert(delta.values.end(), a.begin() + i, a.begin() + lastChanged + 1);
+        i = lastChanged + 1;
+    }
+}
+} // namespace imstk
@@ -0,0 +1,91 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkPbdStateSnapshot.h"
+
+namespace imstk
+{
+///
+/// \class PbdStateHistory
+///
+/// \brief Ring buffer of the last N states of a PbdState for multi step rewind. Only
+/// the newest state is stored in full. For every older state, the history keeps the
+/// values that differed from its successor, as runs in the snapshot arena. Bodies at
+/// rest, or partially moving, cost next to nothing. The ring's buffers are reused, so
+/// pushing stops allocating once they have grown to the typical delta size.
+///
+/// The history is cleared when the bodies or their particle counts change.
+///
+class PbdStateHistory
+{
+public:
+    PbdStateHistory(const size_t capacity = 0) { setCapacity(capacity); }
+    virtual ~PbdStateHistory() = default;
+
+    ///
+    /// \brief Set/Get the number of steps that can be rewound, 0 disables the history.
+    /// Setting it clears the history
+    ///@{
+    void setCapacity(const size_t capacity);
+    size_t getCapacity() const { return m_deltas.size(); }
+    ///@}
+
+    ///
+    /// \brief Record the current state, overwrites the oldest step when full
+    ///
+    void push(const PbdState& state);
+
+    ///
+    /// \brief Restore the state from numSteps pushes ago (1 being the one before the
+    /// last push). The newer steps are dropped. Returns false if not enough steps
+    /// are recorded or the state layout changed
+    ///
+    bool rewind(PbdState& state, const size_t numSteps = 1);
+
+    ///
+    /// \brief Restore the last pushed state
+    ///
+    bool restoreLatest(PbdState& state) const { return m_latest.restore(state); }
+
+    ///
+    /// \brief Returns the number of steps that can be rewound
+    ///
+    size_t getNumSteps() const { return m_numDeltas; }
+
+    ///
+    /// \brief Drop all recorded steps, keeps the buffers
+    ///
+    void clear();
+
+    ///
+    /// \brief Returns the memory used by the recorded steps in bytes, including the latest state
+    ///
+    size_t getNumBytes() const;
+
+protected:
+    ///
+    /// \brief Values of a state that differ from its successor
+    ///
+    struct Delta
+    {
+        std::vector<std::pair<size_t, size_t>> runs; ///< Offset and length into the arena
+        std::vector<double> values;                  ///< Values of all runs, in order
+    };
+
+    ///
+    /// \brief Computes the delta to get from the state b to state a
+    ///
+    static void computeDelta(const std::vector<double>& a, const std::vector<double>& b, Delta& delta);
+
+    PbdStateSnapshot   m_latest;        ///< Last pushed state
+    PbdStateSnapshot   m_scratch;       ///< State being pushed
+    std::vector<Delta> m_deltas;        ///< Ring of deltas, the newest undoes the last push
+    size_t m_firstDelta = 0;            ///< Oldest delta in the ring
+    size_t m_numDeltas  = 0;            ///< Number of recorded deltas
+};
+} // namespace imstk
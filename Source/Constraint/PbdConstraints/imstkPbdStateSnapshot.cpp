@@ -0,0 +1,153 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkPbdStateSnapshot.h"
+#include "imstkLogger.h"
+
+#include <cstring>
+
+namespace
+{
+using namespace imstk;
+
+///
+/// \brief Number of doubles of an array, 0 if not allocated
+///
+template<typename ArrayType>
+size_t
+numValues(const std::shared_ptr<ArrayType>& array, const size_t valuesPerElement)
+{
+    return (array == nullptr) ? 0 : static_cast<size_t>(array->size()) * valuesPerElement;
+}
+
+template<typename ArrayType>
+double*
+valuePointer(const std::shared_ptr<ArrayType>& array)
+{
+    return (array == nullptr) ? nullptr : reinterpret_cast<double*>(array->data());
+}
+
+template<typename T, int N>
+double*
+valuePointer(const std::shared_ptr<VecDataArray<T, N>>& array)
+{
+    return (array == nullptr) ? nullptr : reinterpret_cast<double*>(array->getPointer());
+}
+
+double*
+valuePointer(const std::shared_ptr<DataArray<double>>& array)
+{
+    return (array == nullptr) ? nullptr : array->getPointer();
+}
+
+///
+/// \brief Calls func(values, count) for every saved array of a body, in a fixed order
+///
+template<typename Func>
+void
+forEachArray(PbdBody& body, Func func)
+{
+    func(valuePointer(body.prevVertices), numValues(body.prevVertices, 3));
+    func(valuePointer(body.vertices), numValues(body.vertices, 3));
+    func(valuePointer(body.velocities), numValues(body.velocities, 3));
+    func(valuePointer(body.masses), numValues(body.masses, 1));
+    func(valuePointer(body.invMasses), numValues(body.invMasses, 1));
+    if (body.getOriented())
+    {
+        func(valuePointer(body.prevOrientations), numValues(body.prevOrientations, 4));
+        func(valuePointer(body.orientations), numValues(body.orientations, 4));
+        func(valuePointer(body.angularVelocities), numValues(body.angularVelocities, 3));
+        func(valuePointer(body.inertias), numValues(body.inertias, 9));
+        func(valuePointer(body.invInertias), numValues(body.invInertias, 9));
+    }
+    func(body.externalForce.data(), 3);
+    func(body.externalTorque.data(), 3);
+}
+} // namespace
+
+namespace imstk
+{
+void
+PbdStateSnapshot::save(const PbdState& state)
+{
+    m_layout.clear();
+    size_t size = 0;
+    for (const auto& body : state.m_bodies)
+    {
+        CHECK(body != nullptr) << "PbdStateSnapshot cannot save a null body";
+        forEachArray(*body, [&](const double*, const size_t count)
+            {
+                m_layout.push_back(count);
+                size += count;
+            });
+    }
+    // Only grows, restores and saves of the same state never allocate
+    m_data.resize(size);
+
+    double* dest = m_data.data();
+    for (const auto& body : state.m_bodies)
+    {
+        forEachArray(*body, [&](const double* src, const size_t count)
+            {
+                if (count > 0)
+                {
+                    std::memcpy(dest, src, count * sizeof(double));
+                    dest += count;
+                }
+            });
+    }
+    m_saved = true;
+}
+
+bool
+PbdStateSnapshot::restore(PbdState& state) const
+{
+    if (!hasSameLayout(state))
+    {
+        LOG(WARNING) << "Cannot restore PbdStateSnapshot, bodies or particle counts changed since it was saved";
+        return false;
+    }
+
+    const double* src = m_data.data();
+    for (const auto& body : state.m_bodies)
+    {
+        forEachArray(*body, [&](double* dest, const size_t count)
+            {
+                if (count > 0)
+                {
+                    std::memcpy(dest, src, count * sizeof(double));
+                    src += count;
+                }
+            });
+    }
+    return true;
+}
+
+bool
+PbdStateSnapshot::hasSameLayout(const PbdState& state) const
+{
+    if (!m_saved)
+    {
+        return false;
+    }
+
+    size_t i       = 0;
+    bool   matches = true;
+    for (const auto& body : state.m_bodies)
+    {
+        if (body == nullptr)
+        {
+            return false;
+        }
+        forEachArray(*body, [&](const double*, const size_t count)
+            {
+                matches = matches && (i < m_layout.size()) && (m_layout[i] == count);
+                i++;
+            });
+    }
+    return matches && (i == m_layout.size());
+}
+} // namespace imstk
@@ -0,0 +1,78 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkPbdBody.h"
+
+namespace imstk
+{
+///
+/// \class PbdStateSnapshot
+///
+/// \brief Copy of the dynamic state of all bodies of a PbdState (positions, velocities,
+/// masses, orientations, inertias and external forces) packed into one contiguous arena.
+/// Saving and restoring are plain copies, the arena is only reallocated when the amount
+/// of bodies or particles grows. Restoring copies into the existing body arrays, so
+/// geometries sharing them with the bodies stay valid.
+///
+/// Fixed node ids, mass values and body types are setup and not part of the snapshot.
+///
+class PbdStateSnapshot
+{
+public:
+    PbdStateSnapshot() = default;
+    virtual ~PbdStateSnapshot() = default;
+
+    ///
+    /// \brief Copy the state into the snapshot
+    ///
+    void save(const PbdState& state);
+
+    ///
+    /// \brief Copy the snapshot back into the state, fails if the bodies or their
+    /// particle counts changed since the snapshot was saved
+    ///
+    bool restore(PbdState& state) const;
+
+    ///
+    /// \brief Returns true if the state has the same bodies and particle counts
+    ///
+    bool hasSameLayout(const PbdState& state) const;
+
+    ///
+    /// \brief Returns true if both snapshots were saved from the same bodies and particle counts
+    ///
+    bool hasSameLayout(const PbdStateSnapshot& other) const { return m_saved && other.m_saved && m_layout == other.m_layout; }
+
+    ///
+    /// \brief Returns if nothing has been saved yet
+    ///
+    bool isEmpty() const { return !m_saved; }
+
+    ///
+    /// \brief Mark the snapshot empty, keeps the arena allocated
+    ///
+    void clear() { m_saved = false; }
+
+    ///
+    /// \brief Get the arena, all saved values in order
+    ///@{
+    const std::vector<double>& getData() const { return m_data; }
+    std::vector<double>& getData() { return m_data; }
+    ///@}
+
+    ///
+    /// \brief Returns the size of the saved state in bytes
+    ///
+    size_t getNumBytes() const { return m_data.size() * sizeof(double); }
+
+protected:
+    bool m_saved = false;         ///< Something was saved
+    std::vector<double> m_data;   ///< Arena of all saved values
+    std::vector<size_t> m_layout; ///< Number of values of every saved array, in order
+};
+} // namespace imstk
@@ -5,6 +5,7 @@
 */
 
 #include "imstkPbdVolumeConstraint.h"
+#include "imstkPbdConstraintKernels.h"
 
 namespace imstk
 {
@@ -29,20 +30,9 @@ bool
 PbdVolumeConstraint::computeValueAndGradient(PbdState& bodies,
                                              double& c, std::vector<Vec3d>& dcdx)
 {
-    const Vec3d& x0 = bodies.getPosition(m_particles[0]);
-    const Vec3d& x1 = bodies.getPosition(m_particles[1]);
-    const Vec3d& x2 = bodies.getPosition(m_particles[2]);
-    const Vec3d& x3 = bodies.getPosition(m_particles[3]);
-
-    const double onesixth = 1.0 / 6.0;
-
-    dcdx[0] = onesixth * (x1 - x2).cross(x3 - x1);
-    dcdx[1] = onesixth * (x2 - x0).cross(x3 - x0);
-    dcdx[2] = onesixth * (x3 - x0).cross(x1 - x0);
-    dcdx[3] = onesixth * (x1 - x0).cross(x2 - x0);
-
-    const double volume = dcdx[3].dot(x3 - x0);
-    c = volume - m_restVolume;
-    return true;
+    return PbdConstraintKernels::volume<double>(
+        bodies.getPosition(m_particles[0]), bodies.getPosition(m_particles[1]),
+        bodies.getPosition(m_particles[2]), bodies.getPosition(m_particles[3]),
+        m_restVolume, c, dcdx.data());
 }
 } // namespace imstk
\ No newline at end of file
@@ -0,0 +1,123 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkPbdConstraintContainer.h"
+#include "imstkPbdDistanceConstraint.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+using namespace imstk;
+
+///
+/// \brief Adds distance constraints between all neighbors of a dim^3 grid of particles
+///
+static void
+addGridConstraints(PbdConstraintContainer& container, const int bodyId, const int dim)
+{
+    auto index = [&](const int x, const int y, const int z) { return x + dim * (y + dim * z); };
+    for (int z = 0; z < dim; z++)
+    {
+        for (int y = 0; y < dim; y++)
+        {
+            for (int x = 0; x < dim; x++)
+            {
+                const int neighbors[3][3] = { { x + 1, y, z }, { x, y + 1, z }, { x, y, z + 1 } };
+                for (const auto& n : neighbors)
+                {
+                    if (n[0] < dim && n[1] < dim && n[2] < dim)
+                    {
+                        auto constraint = std::make_shared<PbdDistanceConstraint>();
+                        constraint->initConstraint(1.0,
+                            { bodyId, index(x, y, z) }, { bodyId, index(n[0], n[1], n[2]) }, 1.0);
+                        container.addConstraint(constraint);
+                    }
+                }
+            }
+        }
+    }
+}
+
+///
+/// \brief Returns true if no two constraints of any partition share a particle
+///
+static bool
+partitionsIndependent(PbdConstraintContainer& container)
+{
+    for (const auto& partition : container.getPartitionedConstraints())
+    {
+        std::set<PbdParticleId> particles;
+        for (const auto& constraint : partition)
+        {
+            for (const PbdParticleId& pid : constraint->getParticles())
+            {
+                if (!particles.insert(pid).second)
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+///
+/// \brief Test that partitions are independent, balanced, and contain all constraints
+///
+TEST(imstkPbdConstraintContainerTest, PartitionConstraints)
+{
+    PbdConstraintContainer container;
+    addGridConstraints(container, 2, 10);
+    const size_t numConstraints = container.getConstraints().size();
+
+    container.partitionConstraints(1);
+    const auto partitions = container.getPartitionedConstraints();
+    EXPECT_TRUE(container.getConstraints().empty());
+    EXPECT_TRUE(partitionsIndependent(container));
+
+    size_t numPartitioned = 0;
+    size_t minSize = numConstraints;
+    size_t maxSize = 0;
+    for (const auto& partition : partitions)
+    {
+        numPartitioned += partition.size();
+        minSize         = std::min(minSize, partition.size());
+        maxSize         = std::max(maxSize, partition.size());
+    }
+    EXPECT_EQ(numPartitioned, numConstraints);
+    // Every particle has at most 6 constraints, greedy coloring uses at most 11 colors
+    EXPECT_LE(partitions.size(), 11);
+    EXPECT_LE(maxSize, 2 * minSize);
+
+    // Partitioning again keeps all constraints
+    container.partitionConstraints(1);
+    EXPECT_TRUE(partitionsIndependent(container));
+    numPartitioned = container.getConstraints().size();
+    for (const auto& partition : container.getPartitionedConstraints())
+    {
+        numPartitioned += partition.size();
+    }
+    EXPECT_EQ(numPartitioned, numConstraints);
+}
+
+///
+/// \brief Test that particles with the same index in different bodies are not treated as shared
+///
+TEST(imstkPbdConstraintContainerTest, PartitionConstraintsMultipleBodies)
+{
+    PbdConstraintContainer container;
+    auto                   constraint0 = std::make_shared<PbdDistanceConstraint>();
+    constraint0->initConstraint(1.0, { 2, 0 }, { 2, 1 }, 1.0);
+    auto constraint1 = std::make_shared<PbdDistanceConstraint>();
+    constraint1->initConstraint(1.0, { 3, 0 }, { 3, 1 }, 1.0);
+    container.addConstraint(constraint0);
+    container.addConstraint(constraint1);
+
+    container.partitionConstraints(1);
+    ASSERT_EQ(container.getPartitionedConstraints().size(), 1);
+    EXPECT_EQ(container.getPartitionedConstraints()[0].size(), 2);
+}
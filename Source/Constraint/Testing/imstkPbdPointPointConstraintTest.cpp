@@ -34,4 +34,43 @@ TEST_F(PbdConstraintTest, PointPointConstraint_TestConvergence1)
     }
 
     ASSERT_EQ(m_vertices[0][1], m_vertices[1][1]);
-}
\ No newline at end of file
+}
+
+///
+/// \brief Test that warm starting with the multiplier of a solve reproduces the solve
+///
+TEST_F(PbdConstraintTest, PointPointConstraint_TestWarmStart)
+{
+    setNumParticles(2);
+
+    m_invMasses.fill(1.0);
+
+    m_vertices[0] = Vec3d(0.0, 0.0, 0.0);
+    m_vertices[1] = Vec3d(0.0, -1.0, 0.0);
+
+    PbdPointPointConstraint constraint;
+    m_constraint = &constraint;
+    constraint.initConstraint(
+        { 0, 0 }, { 0, 1 },
+        0.5, 0.5);
+    solve(0.01, PbdConstraint::SolverType::PBD);
+
+    const Vec3d  solvedPos0 = m_vertices[0];
+    const Vec3d  solvedPos1 = m_vertices[1];
+    const double lambda     = constraint.getAccumulatedLambda();
+    ASSERT_NE(lambda, 0.0);
+
+    // No warm start multiplier, nothing moves
+    m_vertices[0] = Vec3d(0.0, 0.0, 0.0);
+    m_vertices[1] = Vec3d(0.0, -1.0, 0.0);
+    constraint.warmStart(m_state);
+    EXPECT_EQ(m_vertices[0], Vec3d(0.0, 0.0, 0.0));
+    EXPECT_EQ(m_vertices[1], Vec3d(0.0, -1.0, 0.0));
+    EXPECT_EQ(constraint.getAccumulatedLambda(), 0.0);
+
+    constraint.setWarmStartLambda(lambda);
+    constraint.warmStart(m_state);
+    EXPECT_TRUE(m_vertices[0].isApprox(solvedPos0));
+    EXPECT_TRUE(m_vertices[1].isApprox(solvedPos1));
+    EXPECT_EQ(constraint.getAccumulatedLambda(), lambda);
+}
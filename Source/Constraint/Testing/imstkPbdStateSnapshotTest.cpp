@@ -0,0 +1,171 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkPbdStateHistory.h"
+#include "imstkPbdStateSnapshot.h"
+
+#include <gtest/gtest.h>
+
+using namespace imstk;
+
+///
+/// \brief Creates a state with a deformable and a rigid body
+///
+static void
+setupState(PbdState& state, const int numParticles)
+{
+    auto body = std::make_shared<PbdBody>(0);
+    body->prevVertices = std::make_shared<VecDataArray<double, 3>>(numParticles);
+    body->vertices     = std::make_shared<VecDataArray<double, 3>>(numParticles);
+    body->velocities   = std::make_shared<VecDataArray<double, 3>>(numParticles);
+    body->masses       = std::make_shared<DataArray<double>>(numParticles);
+    body->invMasses    = std::make_shared<DataArray<double>>(numParticles);
+    for (int i = 0; i < numParticles; i++)
+    {
+        (*body->prevVertices)[i] = Vec3d(i, 0.0, 0.0);
+        (*body->vertices)[i]     = Vec3d(i, 0.0, 0.0);
+        (*body->velocities)[i]   = Vec3d::Zero();
+        (*body->masses)[i]       = 1.0;
+        (*body->invMasses)[i]    = 1.0;
+    }
+    state.m_bodies.push_back(body);
+
+    auto rigidBody = std::make_shared<PbdBody>(1);
+    rigidBody->setRigid(Vec3d(0.0, 1.0, 0.0), 2.0, Quatd::Identity());
+    state.m_bodies.push_back(rigidBody);
+}
+
+///
+/// \brief Moves every particle of the deformable body and rotates the rigid body
+///
+static void
+stepState(PbdState& state, const double t)
+{
+    VecDataArray<double, 3>& vertices = *state.m_bodies[0]->vertices;
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        (*state.m_bodies[0]->prevVertices)[i] = vertices[i];
+        vertices[i] += Vec3d(0.0, t, 0.0);
+        (*state.m_bodies[0]->velocities)[i] = Vec3d(0.0, t, 0.0);
+    }
+    (*state.m_bodies[1]->orientations)[0] = Quatd(Eigen::AngleAxisd(t, Vec3d::UnitZ()));
+    state.m_bodies[1]->externalForce      = Vec3d(t, 0.0, 0.0);
+}
+
+///
+/// \brief Returns true if all the saved arrays of both states are equal
+///
+static bool
+statesEqual(const PbdState& a, const PbdState& b)
+{
+    PbdStateSnapshot snapshotA;
+    PbdStateSnapshot snapshotB;
+    snapshotA.save(a);
+    snapshotB.save(b);
+    return snapshotA.hasSameLayout(snapshotB) && snapshotA.getData() == snapshotB.getData();
+}
+
+///
+/// \brief Test that restoring brings back the saved state into the same arrays
+///
+TEST(imstkPbdStateSnapshotTest, SaveRestore)
+{
+    PbdState state;
+    setupState(state, 10);
+    PbdState initialState;
+    initialState.deepCopy(state);
+
+    PbdStateSnapshot snapshot;
+    EXPECT_TRUE(snapshot.isEmpty());
+    snapshot.save(state);
+    EXPECT_FALSE(snapshot.isEmpty());
+    // 10 particles * (3 + 3 + 3 + 1 + 1), the rigid body only has a position (3), orientation (4)
+    // and inertia (9), both bodies have a force and torque (3 + 3)
+    EXPECT_EQ(snapshot.getData().size(), 10 * 11 + 16 + 2 * 6);
+
+    const Vec3d* verticesPtr = state.m_bodies[0]->vertices->getPointer();
+    stepState(state, 0.5);
+    EXPECT_FALSE(statesEqual(state, initialState));
+
+    EXPECT_TRUE(snapshot.restore(state));
+    EXPECT_TRUE(statesEqual(state, initialState));
+    EXPECT_EQ(state.m_bodies[0]->vertices->getPointer(), verticesPtr);
+}
+
+///
+/// \brief Test that a snapshot can't be restored after particles are added
+///
+TEST(imstkPbdStateSnapshotTest, LayoutChange)
+{
+    PbdState state;
+    setupState(state, 10);
+
+    PbdStateSnapshot snapshot;
+    snapshot.save(state);
+    EXPECT_TRUE(snapshot.hasSameLayout(state));
+
+    state.m_bodies[0]->vertices->push_back(Vec3d::Zero());
+    EXPECT_FALSE(snapshot.hasSameLayout(state));
+    EXPECT_FALSE(snapshot.restore(state));
+}
+
+///
+/// \brief Test rewinding multiple steps, and that only the last steps are kept
+///
+TEST(imstkPbdStateHistoryTest, Rewind)
+{
+    PbdState state;
+    setupState(state, 10);
+
+    PbdStateHistory history(3);
+    std::vector<PbdState> states(6);
+    for (int i = 0; i < 6; i++)
+    {
+        states[i].deepCopy(state);
+        history.push(state);
+        stepState(state, 0.1 * (i + 1));
+    }
+    // The oldest pushes were overwritten
+    EXPECT_EQ(history.getNumSteps(), 3);
+    EXPECT_FALSE(history.rewind(state, 4));
+
+    EXPECT_TRUE(history.restoreLatest(state));
+    EXPECT_TRUE(statesEqual(state, states[5]));
+
+    EXPECT_TRUE(history.rewind(state, 2));
+    EXPECT_TRUE(statesEqual(state, states[3]));
+    EXPECT_EQ(history.getNumSteps(), 1);
+
+    EXPECT_TRUE(history.rewind(state, 1));
+    EXPECT_TRUE(statesEqual(state, states[2]));
+    EXPECT_EQ(history.getNumSteps(), 0);
+}
+
+///
+/// \brief Test that steps where only part of the state changes are stored as small deltas
+///
+TEST(imstkPbdStateHistoryTest, DeltaCompression)
+{
+    PbdState state;
+    setupState(state, 1000);
+
+    PbdStateHistory history(10);
+    history.push(state);
+    const size_t fullBytes = history.getNumBytes();
+
+    PbdState initialState;
+    initialState.deepCopy(state);
+    for (int i = 0; i < 10; i++)
+    {
+        // Only move one particle
+        (*state.m_bodies[0]->vertices)[500] += Vec3d(0.0, 0.1, 0.0);
+        history.push(state);
+    }
+    EXPECT_LT(history.getNumBytes(), fullBytes + fullBytes / 10);
+
+    EXPECT_TRUE(history.rewind(state, 10));
+    EXPECT_TRUE(statesEqual(state, initialState));
+}
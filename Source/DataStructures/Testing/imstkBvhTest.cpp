@@ -0,0 +1,248 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkBvh.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+using namespace imstk;
+
+///
+/// \brief Generate a triangle soup of random small triangles in [-10, 10]^3
+///
+static void
+generateTriangleSoup(std::mt19937& rng, const int numTriangles,
+                     VecDataArray<double, 3>& vertices, VecDataArray<int, 3>& triangles)
+{
+    std::uniform_real_distribution<double> centerDist(-10.0, 10.0);
+    std::uniform_real_distribution<double> offsetDist(-0.5, 0.5);
+    vertices.resize(numTriangles * 3);
+    triangles.resize(numTriangles);
+    for (int i = 0; i < numTriangles; i++)
+    {
+        const Vec3d center(centerDist(rng), centerDist(rng), centerDist(rng));
+        for (int j = 0; j < 3; j++)
+        {
+            vertices[i * 3 + j] = center + Vec3d(offsetDist(rng), offsetDist(rng), offsetDist(rng));
+        }
+        triangles[i] = Vec3i(i * 3, i * 3 + 1, i * 3 + 2);
+    }
+}
+
+///
+/// \brief Returns the sorted ids of the triangles whose box is crossed by the segment p-q,
+/// by testing all of them
+///
+static std::vector<int>
+bruteForceSegment(const VecDataArray<double, 3>& vertices, const VecDataArray<int, 3>& triangles,
+                  const Vec3d& p, const Vec3d& q)
+{
+    std::vector<int> result;
+    for (int i = 0; i < triangles.size(); i++)
+    {
+        Vec3d lower = vertices[triangles[i][0]];
+        Vec3d upper = lower;
+        for (int j = 1; j < 3; j++)
+        {
+            lower = lower.cwiseMin(vertices[triangles[i][j]]);
+            upper = upper.cwiseMax(vertices[triangles[i][j]]);
+        }
+        // Sample the segment densely
+        for (int k = 0; k <= 1000; k++)
+        {
+            const Vec3d x = p + (q - p) * (k / 1000.0);
+            if ((x.array() >= lower.array()).all() && (x.array() <= upper.array()).all())
+            {
+                result.push_back(i);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+///
+/// \brief Test that box and segment queries find the same triangles as testing all of them,
+/// before and after moving the triangles and refitting
+///
+TEST(imstkBvhTest, SegmentAndBoxQueries)
+{
+    std::mt19937            rng(0);
+    VecDataArray<double, 3> vertices;
+    VecDataArray<int, 3>    triangles;
+    generateTriangleSoup(rng, 2000, vertices, triangles);
+
+    Bvh bvh;
+    bvh.build(vertices, triangles);
+    EXPECT_EQ(bvh.getNumPrimitives(), 2000);
+
+    std::uniform_real_distribution<double> pointDist(-10.0, 10.0);
+    for (int pass = 0; pass < 2; pass++)
+    {
+        if (pass == 1)
+        {
+            // Move the triangles and refit
+            for (int i = 0; i < vertices.size(); i++)
+            {
+                vertices[i] = vertices[i] * 0.5 + Vec3d(1.0, 2.0, 0.0);
+            }
+            bvh.refit(vertices, triangles);
+        }
+
+        for (int query = 0; query < 20; query++)
+        {
+            const Vec3d p(pointDist(rng), pointDist(rng), pointDist(rng));
+            const Vec3d q = p + Vec3d(pointDist(rng), pointDist(rng), pointDist(rng)) * 0.2;
+
+            // The segment test is exact, the brute force samples, so it may only find less
+            std::vector<int> segmentResult;
+            bvh.intersectSegment(p, q, [&](const int triId) { segmentResult.push_back(triId); });
+            std::sort(segmentResult.begin(), segmentResult.end());
+            const std::vector<int> expected = bruteForceSegment(vertices, triangles, p, q);
+            EXPECT_TRUE(std::includes(segmentResult.begin(), segmentResult.end(), expected.begin(), expected.end()));
+
+            // Every triangle crossed by the segment overlaps its box
+            std::vector<int> boxResult;
+            bvh.intersectBox(p.cwiseMin(q), p.cwiseMax(q), [&](const int triId) { boxResult.push_back(triId); });
+            std::sort(boxResult.begin(), boxResult.end());
+            EXPECT_TRUE(std::includes(boxResult.begin(), boxResult.end(), segmentResult.begin(), segmentResult.end()));
+            EXPECT_LT(boxResult.size(), 200);
+        }
+    }
+
+    // A segment through the whole domain along x at a known triangle center
+    const Vec3d center = (vertices[0] + vertices[1] + vertices[2]) / 3.0;
+    bool        found  = false;
+    bvh.intersectSegment(Vec3d(-20.0, center[1], center[2]), Vec3d(20.0, center[1], center[2]),
+        [&](const int triId) { found |= (triId == 0); });
+    EXPECT_TRUE(found);
+}
+
+///
+/// \brief Test that the closest ray hit is the closest of all triangles hit
+///
+TEST(imstkBvhTest, ClosestRayHit)
+{
+    std::mt19937            rng(1);
+    VecDataArray<double, 3> vertices;
+    VecDataArray<int, 3>    triangles;
+    generateTriangleSoup(rng, 2000, vertices, triangles);
+
+    Bvh bvh;
+    bvh.build(vertices, triangles);
+
+    // Hit a triangle where the ray crosses its plane within its box
+    auto hitTriangle = [&](const Vec3d& origin, const Vec3d& dir, const int triId, double& t)
+                       {
+                           const Vec3d& a     = vertices[triangles[triId][0]];
+                           const Vec3d& b     = vertices[triangles[triId][1]];
+                           const Vec3d& c     = vertices[triangles[triId][2]];
+                           const Vec3d  n     = (b - a).cross(c - a);
+                           const double denom = dir.dot(n);
+                           if (std::abs(denom) < 1.0e-12)
+                           {
+                               return false;
+                           }
+                           t = (a - origin).dot(n) / denom;
+                           const Vec3d x = origin + dir * t;
+                           const Vec3d u = n.cross(b - a);
+                           const Vec3d v = n.cross(c - b);
+                           const Vec3d w = n.cross(a - c);
+                           return t >= 0.0 && (x - a).dot(u) >= 0.0 && (x - b).dot(v) >= 0.0 && (x - c).dot(w) >= 0.0;
+                       };
+
+    std::uniform_real_distribution<double> pointDist(-10.0, 10.0);
+    int                                    numHits = 0;
+    for (int query = 0; query < 200; query++)
+    {
+        const Vec3d origin(pointDist(rng), pointDist(rng), -15.0);
+        const Vec3d dir = Vec3d(pointDist(rng) * 0.05, pointDist(rng) * 0.05, 1.0).normalized();
+
+        int    expectedId = -1;
+        double expectedT  = IMSTK_DOUBLE_MAX;
+        for (int i = 0; i < triangles.size(); i++)
+        {
+            double t = 0.0;
+            if (hitTriangle(origin, dir, i, t) && t < expectedT)
+            {
+                expectedT  = t;
+                expectedId = i;
+            }
+        }
+
+        double    tHit = 0.0;
+        const int id   = bvh.findClosestRayHit(origin, dir,
+            [&](const int triId, double& t) { return hitTriangle(origin, dir, triId, t); }, tHit);
+        EXPECT_EQ(id, expectedId);
+        if (id != -1)
+        {
+            EXPECT_NEAR(tHit, expectedT, 1.0e-10);
+            numHits++;
+
+            // Every triangle hit has its box crossed by the ray
+            bool found = false;
+            bvh.intersectRay(origin, dir, [&](const int triId) { found |= (triId == id); });
+            EXPECT_TRUE(found);
+
+            // Nothing is closer than the closest hit
+            EXPECT_EQ(bvh.findClosestRayHit(origin, dir,
+                [&](const int triId, double& t) { return hitTriangle(origin, dir, triId, t); }, tHit, expectedT * 0.99), -1);
+        }
+    }
+    EXPECT_GT(numHits, 0);
+}
+
+///
+/// \brief Test that the closest primitive to a point is the closest of all of them
+///
+TEST(imstkBvhTest, Closest)
+{
+    std::mt19937            rng(2);
+    VecDataArray<double, 3> vertices;
+    VecDataArray<int, 3>    triangles;
+    generateTriangleSoup(rng, 2000, vertices, triangles);
+
+    Bvh bvh;
+    bvh.build(vertices, triangles);
+
+    // Distance to the centers, which lie in the boxes of the triangles
+    auto getSqrDist = [&](const Vec3d& point, const int triId)
+                      {
+                          const Vec3d center = (vertices[triangles[triId][0]]
+                                                + vertices[triangles[triId][1]] + vertices[triangles[triId][2]]) / 3.0;
+                          return (center - point).squaredNorm();
+                      };
+
+    std::uniform_real_distribution<double> pointDist(-15.0, 15.0);
+    for (int query = 0; query < 200; query++)
+    {
+        const Vec3d point(pointDist(rng), pointDist(rng), pointDist(rng));
+
+        int    expectedId      = -1;
+        double expectedSqrDist = IMSTK_DOUBLE_MAX;
+        for (int i = 0; i < triangles.size(); i++)
+        {
+            const double sqrDist = getSqrDist(point, i);
+            if (sqrDist < expectedSqrDist)
+            {
+                expectedSqrDist = sqrDist;
+                expectedId      = i;
+            }
+        }
+
+        double    sqrDist = 0.0;
+        const int id      = bvh.findClosest(point, [&](const int triId) { return getSqrDist(point, triId); }, sqrDist);
+        EXPECT_EQ(id, expectedId);
+        EXPECT_DOUBLE_EQ(sqrDist, expectedSqrDist);
+
+        // Nothing is closer than the closest
+        EXPECT_EQ(bvh.findClosest(point, [&](const int triId) { return getSqrDist(point, triId); },
+            sqrDist, expectedSqrDist * 0.99), -1);
+    }
+}
@@ -0,0 +1,110 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkVoxelTileGrid.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+using namespace imstk;
+
+///
+/// \brief Test that values set are found back, the active tiles covering exactly the active voxels
+///
+TEST(imstkVoxelTileGridTest, SetAndFind)
+{
+    const Vec3i          dim(20, 13, 9);
+    VoxelTileGrid<double> grid;
+    grid.setDimensions(dim);
+
+    std::mt19937                       rng(3);
+    std::uniform_int_distribution<int> distX(-2, dim[0] + 1);
+    std::uniform_int_distribution<int> distY(-2, dim[1] + 1);
+    std::uniform_int_distribution<int> distZ(-2, dim[2] + 1);
+
+    // Reference of the voxels set, keyed by linear index
+    std::map<int, double> expected;
+    for (int i = 0; i < 300; i++)
+    {
+        const Vec3i coord(distX(rng), distY(rng), distZ(rng));
+        grid.setValue(coord, static_cast<double>(i));
+        if (grid.isInside(coord))
+        {
+            expected[coord[0] + dim[0] * (coord[1] + dim[1] * coord[2])] = static_cast<double>(i);
+        }
+    }
+    EXPECT_EQ(expected.size(), grid.getNumActiveVoxels());
+
+    for (int z = -1; z <= dim[2]; z++)
+    {
+        for (int y = -1; y <= dim[1]; y++)
+        {
+            for (int x = -1; x <= dim[0]; x++)
+            {
+                const double* value = grid.find(Vec3i(x, y, z));
+                const auto    iter  = expected.find(x + dim[0] * (y + dim[1] * z));
+                if (grid.isInside(Vec3i(x, y, z)) && iter != expected.end())
+                {
+                    ASSERT_NE(nullptr, value);
+                    EXPECT_EQ(iter->second, *value);
+                }
+                else
+                {
+                    EXPECT_EQ(nullptr, value);
+                }
+            }
+        }
+    }
+
+    // Every active voxel of the tiles is expected, within the tile bounds
+    size_t numActive = 0;
+    for (const VoxelTileGrid<double>::Tile* tile : grid.getActiveTiles())
+    {
+        for (int i = 0; i < VoxelTileGrid<double>::TileSize; i++)
+        {
+            if (tile->activeMask[i])
+            {
+                const Vec3i coord = tile->getCoord(i);
+                EXPECT_EQ(1, expected.count(coord[0] + dim[0] * (coord[1] + dim[1] * coord[2])));
+                EXPECT_TRUE((coord.array() >= tile->activeMin.array()).all());
+                EXPECT_TRUE((coord.array() <= tile->activeMax.array()).all());
+                EXPECT_EQ(expected[coord[0] + dim[0] * (coord[1] + dim[1] * coord[2])], tile->values[i]);
+                numActive++;
+            }
+        }
+    }
+    EXPECT_EQ(expected.size(), numActive);
+}
+
+///
+/// \brief Test that clearing deactivates every voxel and keeps the tiles allocated
+///
+TEST(imstkVoxelTileGridTest, Clear)
+{
+    VoxelTileGrid<int> grid;
+    grid.setDimensions(Vec3i(32, 32, 32));
+    grid.setValue(Vec3i(1, 1, 1), 1);
+    grid.setValue(Vec3i(2, 1, 1), 2);
+    grid.setValue(Vec3i(30, 30, 30), 3);
+    EXPECT_EQ(2, grid.getActiveTiles().size());
+    EXPECT_EQ(3, grid.getNumActiveVoxels());
+
+    grid.clear();
+    EXPECT_EQ(0, grid.getActiveTiles().size());
+    EXPECT_EQ(0, grid.getNumActiveVoxels());
+    EXPECT_EQ(2, grid.getNumAllocatedTiles());
+    EXPECT_FALSE(grid.isActive(Vec3i(1, 1, 1)));
+
+    // Reactivating reuses the tile
+    grid.setValue(Vec3i(5, 5, 5), 4);
+    EXPECT_EQ(2, grid.getNumAllocatedTiles());
+    ASSERT_EQ(1, grid.getActiveTiles().size());
+    EXPECT_EQ(Vec3i(5, 5, 5), grid.getActiveTiles()[0]->activeMin);
+    EXPECT_EQ(Vec3i(5, 5, 5), grid.getActiveTiles()[0]->activeMax);
+    EXPECT_EQ(4, *grid.find(Vec3i(5, 5, 5)));
+}
@@ -0,0 +1,128 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkBvh.h"
+#include "imstkLogger.h"
+
+#include <numeric>
+
+namespace imstk
+{
+void
+Bvh::build(const std::vector<Vec3d>& lowerCorners, const std::vector<Vec3d>& upperCorners)
+{
+    CHECK(lowerCorners.size() == upperCorners.size()) << "Bvh needs as many lower as upper corners";
+    m_primLower = lowerCorners;
+    m_primUpper = upperCorners;
+    buildTree();
+}
+
+void
+Bvh::refit(const std::vector<Vec3d>& lowerCorners, const std::vector<Vec3d>& upperCorners)
+{
+    CHECK(lowerCorners.size() == upperCorners.size()) << "Bvh needs as many lower as upper corners";
+    m_primLower = lowerCorners;
+    m_primUpper = upperCorners;
+    refitTree();
+}
+
+void
+Bvh::buildTree()
+{
+    const int numPrims = static_cast<int>(m_primLower.size());
+    m_primIds.resize(numPrims);
+    std::iota(m_primIds.begin(), m_primIds.end(), 0);
+    m_nodes.clear();
+    if (numPrims == 0)
+    {
+        return;
+    }
+    m_nodes.reserve(2 * (numPrims / m_maxLeafSize + 1));
+
+    std::vector<Vec3d> centers(numPrims);
+    for (int i = 0; i < numPrims; i++)
+    {
+        centers[i] = (m_primLower[i] + m_primUpper[i]) * 0.5;
+    }
+
+    // Split nodes top down, a node starts as a leaf of all its primitives
+    Node root;
+    root.first = 0;
+    root.count = numPrims;
+    m_nodes.push_back(root);
+    std::vector<int> toSplit = { 0 };
+    while (!toSplit.empty())
+    {
+        const int nodeId = toSplit.back();
+        toSplit.pop_back();
+        const int first = m_nodes[nodeId].first;
+        const int count = m_nodes[nodeId].count;
+        if (count <= m_maxLeafSize)
+        {
+            continue;
+        }
+
+        // Split at the median along the longest axis of the centers
+        Vec3d lower = centers[m_primIds[first]];
+        Vec3d upper = lower;
+        for (int i = first + 1; i < first + count; i++)
+        {
+            lower = lower.cwiseMin(centers[m_primIds[i]]);
+            upper = upper.cwiseMax(centers[m_primIds[i]]);
+        }
+        int axis = 0;
+        (upper - lower).maxCoeff(&axis);
+        const int mid = first + count / 2;
+        std::nth_element(m_primIds.begin() + first, m_primIds.begin() + mid, m_primIds.begin() + first + count,
+            [&](const int a, const int b) { return centers[a][axis] < centers[b][axis]; });
+
+        Node left;
+        left.first = first;
+        left.count = mid - first;
+        Node right;
+        right.first = mid;
+        right.count = first + count - mid;
+        const int leftId = static_cast<int>(m_nodes.size());
+        m_nodes.push_back(left);
+        m_nodes.push_back(right);
+        m_nodes[nodeId].first = leftId;
+        m_nodes[nodeId].count = 0;
+        toSplit.push_back(leftId);
+        toSplit.push_back(leftId + 1);
+    }
+
+    refitTree();
+}
+
+void
+Bvh::refitTree()
+{
+    CHECK(m_primLower.size() == m_primIds.size()) << "Bvh refit with a different amount of primitives than built with";
+
+    // Children are stored after their parents, so going backwards visits them first
+    for (int nodeId = static_cast<int>(m_nodes.size()) - 1; nodeId >= 0; nodeId--)
+    {
+        Node& node = m_nodes[nodeId];
+        if (node.count > 0)
+        {
+            node.lower = m_primLower[m_primIds[node.first]];
+            node.upper = m_primUpper[m_primIds[node.first]];
+            for (int i = node.first + 1; i < node.first + node.count; i++)
+            {
+                node.lower = node.lower.cwiseMin(m_primLower[m_primIds[i]]);
+                node.upper = node.upper.cwiseMax(m_primUpper[m_primIds[i]]);
+            }
+        }
+        else
+        {
+            const Node& left  = m_nodes[node.first];
+            const Node& right = m_nodes[node.first + 1];
+            node.lower = left.lower.cwiseMin(right.lower);
+            node.upper = left.upper.cwiseMax(right.upper);
+        }
+    }
+}
+} // namespace imstk
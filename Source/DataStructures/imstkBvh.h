@@ -0,0 +1,442 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkMath.h"
+#include "imstkParallelUtils.h"
+#include "imstkVecDataArray.h"
+
+#include <array>
+
+namespace imstk
+{
+///
+/// \class Bvh
+///
+/// \brief Bounding volume hierarchy of axis aligned boxes, ie: of the cells of a mesh.
+/// The tree is built top down, splitting the primitives at the median along the longest
+/// axis of their centers. When the primitives move without changing topology the tree
+/// is refit instead, only recomputing the boxes bottom up, linear in the number of primitives.
+/// Queries visit the primitives whose box overlaps a box, a segment or a ray, or is near
+/// a point, so their cost scales with the neighborhood of the query rather than the whole mesh.
+///
+class Bvh
+{
+public:
+    Bvh() = default;
+    virtual ~Bvh() = default;
+
+    ///
+    /// \brief Build the tree from the bounding boxes of the primitives
+    ///
+    void build(const std::vector<Vec3d>& lowerCorners, const std::vector<Vec3d>& upperCorners);
+
+    ///
+    /// \brief Build the tree over the cells of a mesh
+    ///
+    template<int N>
+    void build(const VecDataArray<double, 3>& vertices, const VecDataArray<int, N>& cells)
+    {
+        computeCellBounds(vertices, cells);
+        buildTree();
+    }
+
+    ///
+    /// \brief Refit the tree to the moved bounding boxes of the primitives, there should
+    /// be as many as the tree was built with
+    ///
+    void refit(const std::vector<Vec3d>& lowerCorners, const std::vector<Vec3d>& upperCorners);
+
+    ///
+    /// \brief Refit the tree to the moved vertices of the cells it was built with
+    ///
+    template<int N>
+    void refit(const VecDataArray<double, 3>& vertices, const VecDataArray<int, N>& cells)
+    {
+        computeCellBounds(vertices, cells);
+        refitTree();
+    }
+
+    ///
+    /// \brief Call func(primitiveId) for every primitive whose box overlaps the given box
+    ///
+    template<typename Func>
+    void intersectBox(const Vec3d& lowerCorner, const Vec3d& upperCorner, Func func) const
+    {
+        traverse([&](const Node& node)
+            {
+                return (node.lower.array() <= upperCorner.array()).all() && (node.upper.array() >= lowerCorner.array()).all();
+            },
+            [&](const int primId)
+            {
+                if ((m_primLower[primId].array() <= upperCorner.array()).all()
+                    && (m_primUpper[primId].array() >= lowerCorner.array()).all())
+                {
+                    func(primId);
+                }
+            });
+    }
+
+    ///
+    /// \brief Call func(primitiveId) for every primitive whose box is crossed by the segment p-q
+    ///
+    template<typename Func>
+    void intersectSegment(const Vec3d& p, const Vec3d& q, Func func) const
+    {
+        const Vec3d dir = q - p;
+        traverse([&](const Node& node) { return testRayBox(p, dir, 1.0, node.lower, node.upper); },
+            [&](const int primId)
+            {
+                if (testRayBox(p, dir, 1.0, m_primLower[primId], m_primUpper[primId]))
+                {
+                    func(primId);
+                }
+            });
+    }
+
+    ///
+    /// \brief Call func(primitiveId) for every primitive whose box is crossed by the
+    /// ray origin + t * dir, t in [0, tMax]
+    ///
+    template<typename Func>
+    void intersectRay(const Vec3d& origin, const Vec3d& dir, Func func, const double tMax = IMSTK_DOUBLE_MAX) const
+    {
+        double tEnter = 0.0;
+        traverse([&](const Node& node) { return testRayBox(origin, dir, tMax, node.lower, node.upper, tEnter); },
+            [&](const int primId)
+            {
+                if (testRayBox(origin, dir, tMax, m_primLower[primId], m_primUpper[primId], tEnter))
+                {
+                    func(primId);
+                }
+            });
+    }
+
+    ///
+    /// \brief Find the closest primitive hit by the ray origin + t * dir, t in [0, tMax].
+    /// hitFunc(primitiveId, t) returns true and sets t if the primitive itself is hit.
+    /// Nodes are visited nearest first and those entered after the closest hit so far skipped,
+    /// so usually only the primitives around the hit are tested. Ties go to the lowest id.
+    /// \param origin of the ray
+    /// \param direction of the ray
+    /// \param hit test of a primitive
+    /// \param parameter of the closest hit along the ray
+    /// \param max parameter of a hit
+    /// \return id of the closest primitive hit, -1 if none
+    ///
+    template<typename HitFunc>
+    int findClosestRayHit(const Vec3d& origin, const Vec3d& dir, HitFunc hitFunc,
+                          double& tHit, const double tMax = IMSTK_DOUBLE_MAX) const
+    {
+        int    closestId = -1;
+        double tClosest  = tMax;
+        double tEnter    = 0.0;
+        if (m_nodes.empty() || !testRayBox(origin, dir, tClosest, m_nodes[0].lower, m_nodes[0].upper, tEnter))
+        {
+            return -1;
+        }
+
+        // Stack of nodes with the parameter the ray enters them at
+        std::array<std::pair<int, double>, 64> stack;
+        int                                    stackSize = 0;
+        stack[stackSize++] = { 0, tEnter };
+        while (stackSize > 0)
+        {
+            const std::pair<int, double> entry = stack[--stackSize];
+            if (entry.second > tClosest)
+            {
+                continue;
+            }
+            const Node& node = m_nodes[entry.first];
+            if (node.count > 0)
+            {
+                for (int i = node.first; i < node.first + node.count; i++)
+                {
+                    const int primId = m_primIds[i];
+                    double    t      = tClosest;
+                    if (hitFunc(primId, t) && t >= 0.0
+                        && (t < tClosest || (t == tClosest && (closestId == -1 || primId < closestId))))
+                    {
+                        tClosest  = t;
+                        closestId = primId;
+                    }
+                }
+                continue;
+            }
+
+            // Push the farther child first so the nearer one is visited first
+            double    tLeft  = 0.0;
+            double    tRight = 0.0;
+            const int left   = node.first;
+            const int right  = node.first + 1;
+            const bool hitLeft  = testRayBox(origin, dir, tClosest, m_nodes[left].lower, m_nodes[left].upper, tLeft);
+            const bool hitRight = testRayBox(origin, dir, tClosest, m_nodes[right].lower, m_nodes[right].upper, tRight);
+            if (hitLeft && hitRight)
+            {
+                if (tLeft <= tRight)
+                {
+                    stack[stackSize++] = { right, tRight };
+                    stack[stackSize++] = { left, tLeft };
+                }
+                else
+                {
+                    stack[stackSize++] = { left, tLeft };
+                    stack[stackSize++] = { right, tRight };
+                }
+            }
+            else if (hitLeft)
+            {
+                stack[stackSize++] = { left, tLeft };
+            }
+            else if (hitRight)
+            {
+                stack[stackSize++] = { right, tRight };
+            }
+        }
+        if (closestId != -1)
+        {
+            tHit = tClosest;
+        }
+        return closestId;
+    }
+
+    ///
+    /// \brief Find the primitive closest to a point.
+    /// sqrDistFunc(primitiveId) returns the squared distance of the primitive to the point.
+    /// Nodes are visited nearest first and those farther than the closest primitive so far
+    /// skipped. Ties go to the lowest id.
+    /// \param point to find the closest primitive to
+    /// \param squared distance to a primitive
+    /// \param squared distance of the closest primitive
+    /// \param max squared distance of a primitive, a good bound speeds up the search
+    /// \return id of the closest primitive, -1 if none within maxSqrDist
+    ///
+    template<typename SqrDistFunc>
+    int findClosest(const Vec3d& point, SqrDistFunc sqrDistFunc,
+                    double& sqrDist, const double maxSqrDist = IMSTK_DOUBLE_MAX) const
+    {
+        int    closestId      = -1;
+        double closestSqrDist = maxSqrDist;
+        if (m_nodes.empty() || getSqrDistToBox(point, m_nodes[0].lower, m_nodes[0].upper) > closestSqrDist)
+        {
+            return -1;
+        }
+
+        // Stack of nodes with their squared distance to the point
+        std::array<std::pair<int, double>, 64> stack;
+        int                                    stackSize = 0;
+        stack[stackSize++] = { 0, 0.0 };
+        while (stackSize > 0)
+        {
+            const std::pair<int, double> entry = stack[--stackSize];
+            if (entry.second > closestSqrDist)
+            {
+                continue;
+            }
+            const Node& node = m_nodes[entry.first];
+            if (node.count > 0)
+            {
+                for (int i = node.first; i < node.first + node.count; i++)
+                {
+                    const int primId = m_primIds[i];
+                    if (getSqrDistToBox(point, m_primLower[primId], m_primUpper[primId]) > closestSqrDist)
+                    {
+                        continue;
+                    }
+                    const double primSqrDist = sqrDistFunc(primId);
+                    if (primSqrDist < closestSqrDist
+                        || (primSqrDist == closestSqrDist && (closestId == -1 || primId < closestId)))
+                    {
+                        closestSqrDist = primSqrDist;
+                        closestId      = primId;
+                    }
+                }
+                continue;
+            }
+
+            // Push the farther child first so the nearer one is visited first
+            const int    left      = node.first;
+            const int    right     = node.first + 1;
+            const double leftDist  = getSqrDistToBox(point, m_nodes[left].lower, m_nodes[left].upper);
+            const double rightDist = getSqrDistToBox(point, m_nodes[right].lower, m_nodes[right].upper);
+            if (leftDist <= rightDist)
+            {
+                stack[stackSize++] = { right, rightDist };
+                stack[stackSize++] = { left, leftDist };
+            }
+            else
+            {
+                stack[stackSize++] = { left, leftDist };
+                stack[stackSize++] = { right, rightDist };
+            }
+        }
+        if (closestId != -1)
+        {
+            sqrDist = closestSqrDist;
+        }
+        return closestId;
+    }
+
+    ///
+    /// \brief Returns the number of primitives the tree was built with
+    ///
+    int getNumPrimitives() const { return static_cast<int>(m_primLower.size()); }
+
+    ///
+    /// \brief Returns the number of nodes of the tree
+    ///
+    int getNumNodes() const { return static_cast<int>(m_nodes.size()); }
+
+    ///
+    /// \brief Set/Get the max number of primitives in a leaf, takes effect on the next build
+    ///@{
+    void setMaxLeafSize(const int maxLeafSize) { m_maxLeafSize = std::max(maxLeafSize, 1); }
+    int getMaxLeafSize() const { return m_maxLeafSize; }
+    ///@}
+
+protected:
+    ///
+    /// \brief Node of the tree, the children of internal nodes are stored next to each
+    /// other and after their parent
+    ///
+    struct Node
+    {
+        Vec3d lower = Vec3d::Zero();
+        Vec3d upper = Vec3d::Zero();
+        int first   = 0; ///< Left child for internal nodes, first primitive in m_primIds for leaves
+        int count   = 0; ///< Number of primitives of a leaf, 0 for internal nodes
+    };
+
+    ///
+    /// \brief Visit the tree, descending into the nodes for which visitNode returns true
+    /// and calling visitPrim on every primitive of the leaves reached
+    ///
+    template<typename NodeFunc, typename PrimFunc>
+    void traverse(NodeFunc visitNode, PrimFunc visitPrim) const
+    {
+        if (m_nodes.empty() || !visitNode(m_nodes[0]))
+        {
+            return;
+        }
+        std::array<int, 64> stack;
+        int                 stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0)
+        {
+            const Node& node = m_nodes[stack[--stackSize]];
+            if (node.count > 0)
+            {
+                for (int i = node.first; i < node.first + node.count; i++)
+                {
+                    visitPrim(m_primIds[i]);
+                }
+                continue;
+            }
+            for (int child = node.first; child < node.first + 2; child++)
+            {
+                if (visitNode(m_nodes[child]))
+                {
+                    stack[stackSize++] = child;
+                }
+            }
+        }
+    }
+
+    ///
+    /// \brief Slab test of the ray origin + t * dir, t in [0, tMax], against a box
+    ///
+    static bool testRayBox(const Vec3d& origin, const Vec3d& dir, const double tMax,
+                           const Vec3d& lowerCorner, const Vec3d& upperCorner)
+    {
+        double tEnter = 0.0;
+        return testRayBox(origin, dir, tMax, lowerCorner, upperCorner, tEnter);
+    }
+
+    ///
+    /// \brief Slab test of the ray origin + t * dir, t in [0, tMax], against a box,
+    /// also giving the parameter the ray enters the box at
+    ///
+    static bool testRayBox(const Vec3d& origin, const Vec3d& dir, const double tMax,
+                           const Vec3d& lowerCorner, const Vec3d& upperCorner, double& tEnter)
+    {
+        tEnter = 0.0;
+        double tExit = tMax;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            if (std::abs(dir[axis]) < IMSTK_DOUBLE_EPS)
+            {
+                if (origin[axis] < lowerCorner[axis] || origin[axis] > upperCorner[axis])
+                {
+                    return false;
+                }
+                continue;
+            }
+            const double invDir = 1.0 / dir[axis];
+            double       t0     = (lowerCorner[axis] - origin[axis]) * invDir;
+            double       t1     = (upperCorner[axis] - origin[axis]) * invDir;
+            if (t0 > t1)
+            {
+                std::swap(t0, t1);
+            }
+            tEnter = std::max(tEnter, t0);
+            tExit  = std::min(tExit, t1);
+            if (tEnter > tExit)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ///
+    /// \brief Squared distance of a point to a box, 0 inside
+    ///
+    static double getSqrDistToBox(const Vec3d& point, const Vec3d& lowerCorner, const Vec3d& upperCorner)
+    {
+        return (lowerCorner - point).cwiseMax(point - upperCorner).cwiseMax(0.0).squaredNorm();
+    }
+
+    ///
+    /// \brief Compute the bounding boxes of the cells into m_primLower/m_primUpper
+    ///
+    template<int N>
+    void computeCellBounds(const VecDataArray<double, 3>& vertices, const VecDataArray<int, N>& cells)
+    {
+        m_primLower.resize(cells.size());
+        m_primUpper.resize(cells.size());
+        ParallelUtils::parallelFor(cells.size(), [&](const int cellId)
+            {
+                const Eigen::Matrix<int, N, 1>& cell = cells[cellId];
+                Vec3d lower = vertices[cell[0]];
+                Vec3d upper = lower;
+                for (int i = 1; i < N; i++)
+                {
+                    lower = lower.cwiseMin(vertices[cell[i]]);
+                    upper = upper.cwiseMax(vertices[cell[i]]);
+                }
+                m_primLower[cellId] = lower;
+                m_primUpper[cellId] = upper;
+            }, cells.size() > 1000);
+    }
+
+    ///
+    /// \brief Build the tree from m_primLower/m_primUpper
+    ///
+    void buildTree();
+
+    ///
+    /// \brief Recompute the node boxes from m_primLower/m_primUpper
+    ///
+    void refitTree();
+
+    std::vector<Node>  m_nodes;       ///< Nodes of the tree, the root first
+    std::vector<int>   m_primIds;     ///< Primitive ids ordered by leaf
+    std::vector<Vec3d> m_primLower;   ///< Lower corner of the box of every primitive
+    std::vector<Vec3d> m_primUpper;   ///< Upper corner of the box of every primitive
+    int m_maxLeafSize = 4;
+};
+} // namespace imstk
@@ -0,0 +1,117 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkPointSetBvh.h"
+#include "imstkCellMesh.h"
+#include "imstkLogger.h"
+
+namespace imstk
+{
+void
+PointSetBvh::setGeometry(std::shared_ptr<PointSet> geometry, const PrimitiveType primitiveType)
+{
+    if (m_geometry != nullptr)
+    {
+        disconnect(m_geometry, shared_from_this(), &Geometry::modified);
+    }
+    m_geometry      = geometry;
+    m_primitiveType = primitiveType;
+    m_cells         = nullptr;
+    m_numPrimitives = -1;
+    m_modified      = true;
+    if (m_geometry != nullptr)
+    {
+        CHECK(m_primitiveType == PrimitiveType::Vertices || std::dynamic_pointer_cast<AbstractCellMesh>(m_geometry) != nullptr)
+            << "PointSetBvh can only be built over the cells of a cell mesh, got " << m_geometry->getTypeName();
+        connect<Event>(m_geometry, &Geometry::modified,
+            shared_from_this(), &PointSetBvh::setModified);
+    }
+}
+
+void
+PointSetBvh::update()
+{
+    CHECK(m_geometry != nullptr) << "PointSetBvh has no geometry to update";
+
+    m_geometry->updatePostTransformData();
+    bool rebuild = false;
+    if (m_primitiveType == PrimitiveType::Cells)
+    {
+        auto cellMesh = std::dynamic_pointer_cast<AbstractCellMesh>(m_geometry);
+        rebuild = (cellMesh->getAbstractCells() != m_cells || cellMesh->getNumCells() != m_numPrimitives);
+    }
+    else
+    {
+        rebuild = (m_geometry->getNumVertices() != m_numPrimitives);
+    }
+
+    // The transform doesn't post modified when changed
+    if (rebuild || m_modified || !m_geometry->getTransform().isApprox(m_transform))
+    {
+        updateTree(rebuild);
+    }
+}
+
+void
+PointSetBvh::updateTree(const bool rebuild)
+{
+    const VecDataArray<double, 3>& vertices = *m_geometry->getVertexPositions();
+    if (m_primitiveType == PrimitiveType::Vertices)
+    {
+        std::vector<Vec3d> points(vertices.size());
+        for (int i = 0; i < vertices.size(); i++)
+        {
+            points[i] = vertices[i];
+        }
+        if (rebuild)
+        {
+            m_bvh.build(points, points);
+        }
+        else
+        {
+            m_bvh.refit(points, points);
+        }
+        m_numPrimitives = vertices.size();
+    }
+    else
+    {
+        auto cellMesh = std::dynamic_pointer_cast<AbstractCellMesh>(m_geometry);
+        m_cells = cellMesh->getAbstractCells();
+        m_numPrimitives = cellMesh->getNumCells();
+        auto buildOrRefit = [&](const auto& cells)
+                            {
+                                if (rebuild)
+                                {
+                                    m_bvh.build(vertices, cells);
+                                }
+                                else
+                                {
+                                    m_bvh.refit(vertices, cells);
+                                }
+                            };
+        switch (cellMesh->getCellVertexCount())
+        {
+        case 2:
+            buildOrRefit(*std::dynamic_pointer_cast<VecDataArray<int, 2>>(m_cells));
+            break;
+        case 3:
+            buildOrRefit(*std::dynamic_pointer_cast<VecDataArray<int, 3>>(m_cells));
+            break;
+        case 4:
+            buildOrRefit(*std::dynamic_pointer_cast<VecDataArray<int, 4>>(m_cells));
+            break;
+        case 8:
+            buildOrRefit(*std::dynamic_pointer_cast<VecDataArray<int, 8>>(m_cells));
+            break;
+        default:
+            LOG(FATAL) << "PointSetBvh does not support cells of " << cellMesh->getCellVertexCount() << " vertices";
+            break;
+        }
+    }
+    m_transform = m_geometry->getTransform();
+    m_modified  = false;
+}
+} // namespace imstk
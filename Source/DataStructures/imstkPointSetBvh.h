@@ -0,0 +1,84 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkBvh.h"
+#include "imstkEventObject.h"
+
+namespace imstk
+{
+class AbstractDataArray;
+class PointSet;
+
+///
+/// \class PointSetBvh
+///
+/// \brief Bvh over the cells or the vertices of a PointSet (ie: SurfaceMesh, TetrahedralMesh)
+/// kept up to date with it. It listens to the geometry being modified, then refits the tree
+/// on the next update. The tree is only rebuilt when the cells are replaced or their count changes.
+/// Must be owned by a shared_ptr when given a geometry as it connects itself to it.
+///
+class PointSetBvh : public EventObject, public std::enable_shared_from_this<PointSetBvh>
+{
+public:
+    enum class PrimitiveType
+    {
+        Vertices,
+        Cells
+    };
+
+public:
+    PointSetBvh() = default;
+    ~PointSetBvh() override = default;
+
+    ///
+    /// \brief Set the geometry to build the tree over, the cells of a mesh, or its vertices
+    ///
+    void setGeometry(std::shared_ptr<PointSet> geometry, const PrimitiveType primitiveType = PrimitiveType::Cells);
+
+    ///
+    /// \brief Get the geometry the tree is built over
+    ///
+    std::shared_ptr<PointSet> getGeometry() const { return m_geometry; }
+
+    ///
+    /// \brief Get the type of primitive the tree is built over
+    ///
+    PrimitiveType getPrimitiveType() const { return m_primitiveType; }
+
+    ///
+    /// \brief Mark the tree as out of date, it is refit on the next update. Called
+    /// when the geometry posts modified
+    ///
+    void setModified(Event* imstkNotUsed(e) = nullptr) { m_modified = true; }
+
+    ///
+    /// \brief Rebuild or refit the tree to the post transform vertices of the geometry
+    /// if needed, should be called before querying
+    ///
+    void update();
+
+    ///
+    /// \brief Get the tree, up to date as of the last update
+    ///
+    const Bvh& getBvh() const { return m_bvh; }
+
+protected:
+    ///
+    /// \brief Compute the bounds of the primitives and build or refit the tree to them
+    ///
+    void updateTree(const bool rebuild);
+
+    Bvh m_bvh;
+    std::shared_ptr<PointSet> m_geometry      = nullptr;
+    PrimitiveType m_primitiveType             = PrimitiveType::Cells;
+    std::shared_ptr<AbstractDataArray> m_cells = nullptr; ///< Cells the tree was built with
+    int   m_numPrimitives = -1;                           ///< Number of primitives the tree was built with
+    Mat4d m_transform     = Mat4d::Identity();            ///< Transform of the geometry when last updated
+    bool  m_modified      = true;
+};
+} // namespace imstk
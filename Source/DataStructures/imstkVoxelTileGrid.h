@@ -0,0 +1,181 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkMath.h"
+
+#include <array>
+#include <bitset>
+#include <memory>
+#include <vector>
+
+namespace imstk
+{
+///
+/// \class VoxelTileGrid
+///
+/// \brief Sparse storage of values over the voxels of an image. The image is split
+/// in tiles of TileWidth^3 voxels, a tile is only allocated once one of its voxels is
+/// activated and keeps a mask of its active voxels and their values in a dense block.
+/// Clearing deactivates every voxel but keeps the tiles allocated, so a region active
+/// over many steps allocates only once. Active tiles are listed in order of activation,
+/// so they can be processed in parallel, each tile being disjoint.
+/// Activating is not thread safe.
+///
+template<typename T>
+class VoxelTileGrid
+{
+public:
+    static constexpr int TileWidth = 8;
+    static constexpr int TileSize  = TileWidth * TileWidth * TileWidth;
+
+    struct Tile
+    {
+        Vec3i origin;                   ///< Coordinate of the first voxel of the tile
+        Vec3i activeMin;                ///< Bounds of the active voxels, inclusive
+        Vec3i activeMax;
+        std::bitset<TileSize>   activeMask;
+        std::array<T, TileSize> values; ///< Only the values of active voxels are valid
+
+        ///
+        /// \brief Returns the coordinate of the local voxel index
+        ///
+        Vec3i getCoord(const int localIndex) const
+        {
+            return origin + Vec3i(localIndex % TileWidth, (localIndex / TileWidth) % TileWidth, localIndex / (TileWidth * TileWidth));
+        }
+    };
+
+public:
+    ///
+    /// \brief Set the dimensions of the image in voxels, deallocates every tile
+    ///
+    void setDimensions(const Vec3i& dim)
+    {
+        m_dim      = dim;
+        m_tileDim  = (dim + Vec3i(TileWidth - 1, TileWidth - 1, TileWidth - 1)) / TileWidth;
+        m_tileIds.assign(static_cast<size_t>(m_tileDim[0]) * m_tileDim[1] * m_tileDim[2], -1);
+        m_tiles.clear();
+        m_activeTiles.clear();
+        m_numActiveVoxels = 0;
+    }
+
+    const Vec3i& getDimensions() const { return m_dim; }
+
+    ///
+    /// \brief Returns if the coordinate is within the image
+    ///
+    bool isInside(const Vec3i& coord) const
+    {
+        return coord[0] >= 0 && coord[0] < m_dim[0]
+               && coord[1] >= 0 && coord[1] < m_dim[1]
+               && coord[2] >= 0 && coord[2] < m_dim[2];
+    }
+
+    ///
+    /// \brief Returns the value of an active voxel, nullptr if inactive or outside
+    ///
+    T* find(const Vec3i& coord)
+    {
+        if (!isInside(coord))
+        {
+            return nullptr;
+        }
+        const int tileId = m_tileIds[getTileIndex(coord)];
+        if (tileId == -1)
+        {
+            return nullptr;
+        }
+        Tile&     tile       = *m_tiles[tileId];
+        const int localIndex = getLocalIndex(coord);
+        return tile.activeMask[localIndex] ? &tile.values[localIndex] : nullptr;
+    }
+
+    bool isActive(const Vec3i& coord) { return find(coord) != nullptr; }
+
+    ///
+    /// \brief Activate the voxel and set its value, allocating its tile if needed.
+    /// Coordinates outside the image are ignored
+    ///
+    void setValue(const Vec3i& coord, const T& value)
+    {
+        if (!isInside(coord))
+        {
+            return;
+        }
+        int& tileId = m_tileIds[getTileIndex(coord)];
+        if (tileId == -1)
+        {
+            tileId = static_cast<int>(m_tiles.size());
+            m_tiles.push_back(std::make_unique<Tile>());
+            m_tiles.back()->origin = (coord / TileWidth) * TileWidth;
+        }
+        Tile& tile = *m_tiles[tileId];
+        if (tile.activeMask.none())
+        {
+            tile.activeMin = coord;
+            tile.activeMax = coord;
+            m_activeTiles.push_back(&tile);
+        }
+
+        const int localIndex = getLocalIndex(coord);
+        if (!tile.activeMask[localIndex])
+        {
+            tile.activeMask.set(localIndex);
+            tile.activeMin = tile.activeMin.cwiseMin(coord);
+            tile.activeMax = tile.activeMax.cwiseMax(coord);
+            m_numActiveVoxels++;
+        }
+        tile.values[localIndex] = value;
+    }
+
+    ///
+    /// \brief Deactivate every voxel, tiles stay allocated
+    ///
+    void clear()
+    {
+        for (Tile* tile : m_activeTiles)
+        {
+            tile->activeMask.reset();
+        }
+        m_activeTiles.clear();
+        m_numActiveVoxels = 0;
+    }
+
+    ///
+    /// \brief Returns the tiles with at least one active voxel
+    ///
+    const std::vector<Tile*>& getActiveTiles() const { return m_activeTiles; }
+
+    size_t getNumActiveVoxels() const { return m_numActiveVoxels; }
+
+    ///
+    /// \brief Returns the number of tiles allocated
+    ///
+    size_t getNumAllocatedTiles() const { return m_tiles.size(); }
+
+protected:
+    size_t getTileIndex(const Vec3i& coord) const
+    {
+        const Vec3i tileCoord = coord / TileWidth;
+        return tileCoord[0] + m_tileDim[0] * (static_cast<size_t>(tileCoord[1]) + static_cast<size_t>(tileCoord[2]) * m_tileDim[1]);
+    }
+
+    static int getLocalIndex(const Vec3i& coord)
+    {
+        return (coord[0] % TileWidth) + TileWidth * ((coord[1] % TileWidth) + TileWidth * (coord[2] % TileWidth));
+    }
+
+    Vec3i m_dim     = Vec3i::Zero();
+    Vec3i m_tileDim = Vec3i::Zero();
+
+    std::vector<int> m_tileIds;                ///< Id of the tile allocated at every tile coordinate, -1 if none
+    std::vector<std::unique_ptr<Tile>> m_tiles;
+    std::vector<Tile*> m_activeTiles;
+    size_t m_numActiveVoxels = 0;
+};
+} // namespace imstk
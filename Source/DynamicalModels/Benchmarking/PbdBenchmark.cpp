@@ -9,10 +9,13 @@
 #include "imstkGeometry.h"
 #include "imstkMath.h"
 #include "imstkMeshIO.h"
+#include "imstkPbdConstraintContainer.h"
+#include "imstkPbdDistanceConstraint.h"
 #include "imstkPbdModel.h"
 #include "imstkPbdModelConfig.h"
 #include "imstkPbdObject.h"
 #include "imstkPbdObjectCollision.h"
+#include "imstkPbdVolumeConstraint.h"
 #include "imstkPointSetToCapsuleCD.h"
 #include "imstkPointwiseMap.h"
 #include "imstkRbdConstraint.h"
@@ -198,6 +201,243 @@ BENCHMARK(BM_DistanceVolume)
 ->Name("Distance and Volume Constraints: Tet Mesh")
 ->ArgsProduct({ { 4, 6, 8, 10, 16, 20 }, { 2, 5, 8 } });
 
+///
+/// \brief Time evolution step of PBD using Distance+Volume constraint on tet mesh
+/// comparing the graph colored Gauss-Seidel solve (0) with the Jacobi solve (1)
+///
+static void
+BM_DistanceVolumeSolverMode(benchmark::State& state)
+{
+    // Setup simulation
+    std::shared_ptr<Scene> scene = std::make_shared<Scene>("PbdBenchmark");
+
+    double dt = 0.05;
+
+    // Create PBD object
+    std::shared_ptr<PbdObject> prismObj = std::make_shared<PbdObject>("Prism");
+
+    // Setup the Geometry
+    std::shared_ptr<TetrahedralMesh> prismMesh = makeTetGrid(
+        Vec3d(4.0, 4.0, 4.0),
+        Vec3i(state.range(0), state.range(0), state.range(0)),
+        Vec3d(0.0, 0.0, 0.0));
+
+    // Setup the Parameters
+    const bool useJacobi = (state.range(2) == 1);
+    std::shared_ptr<PbdModelConfig> pbdParams = std::make_shared<PbdModelConfig>();
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Volume, 1.0);
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0);
+    pbdParams->m_doPartitioning = !useJacobi;
+    pbdParams->m_solverMode     = useJacobi ? PbdSolver::SolverMode::Jacobi : PbdSolver::SolverMode::GaussSeidel;
+    pbdParams->m_gravity    = Vec3d(0.0, -1.0, 0.0);
+    pbdParams->m_dt         = dt;
+    pbdParams->m_iterations = state.range(1);
+    pbdParams->m_linearDampingCoeff = 0.03;
+
+    // Setup the Model
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->configure(pbdParams);
+
+    // Setup the Object
+    prismObj->setPhysicsGeometry(prismMesh);
+    prismObj->setDynamicalModel(pbdModel);
+    prismObj->getPbdBody()->uniformMassValue = 0.05;
+    // Fix the borders
+    for (int z = 0; z < state.range(0); z++)
+    {
+        for (int x = 0; x < state.range(0); x++)
+        {
+            const int y = state.range(0) - 1;
+            prismObj->getPbdBody()->fixedNodeIds.push_back(x + state.range(0) * (y + state.range(0) * z));
+        }
+    }
+
+    // Create the scene
+    scene->addSceneObject(prismObj);
+    scene->initialize();
+
+    // Setup outputs for results
+    state.counters["DOFs"]       = state.range(0) * state.range(0) * state.range(0);
+    state.counters["Tets"]       = prismMesh->getNumTetrahedra();
+    state.counters["Iterations"] = state.range(1);
+    state.counters["Jacobi"]     = state.range(2);
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        scene->advance(dt);
+    }
+}
+
+BENCHMARK(BM_DistanceVolumeSolverMode)
+->Unit(benchmark::kMillisecond)
+->Name("Distance and Volume Constraints: Tet Mesh, Colored Gauss-Seidel vs Jacobi")
+->ArgsProduct({ { 10, 20, 30 }, { 5, 10 }, { 0, 1 } });
+
+///
+/// \brief Graph coloring of the Distance+Volume constraints of a tet mesh into
+/// independent partitions
+///
+static void
+BM_PartitionConstraints(benchmark::State& state)
+{
+    std::shared_ptr<TetrahedralMesh> prismMesh = makeTetGrid(
+        Vec3d(4.0, 4.0, 4.0),
+        Vec3i(state.range(0), state.range(0), state.range(0)),
+        Vec3d(0.0, 0.0, 0.0));
+    const VecDataArray<double, 3>& vertices = *prismMesh->getVertexPositions();
+
+    // Edges shared by tets get one constraint per tet, as partitioning doesn't care
+    PbdConstraintContainer container;
+    for (const Vec4i& tet : *prismMesh->getCells())
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            for (int j = i + 1; j < 4; j++)
+            {
+                auto distConstraint = std::make_shared<PbdDistanceConstraint>();
+                distConstraint->initConstraint(vertices[tet[i]], vertices[tet[j]], { 2, tet[i] }, { 2, tet[j] });
+                container.addConstraint(distConstraint);
+            }
+        }
+        auto volConstraint = std::make_shared<PbdVolumeConstraint>();
+        volConstraint->initConstraint(vertices[tet[0]], vertices[tet[1]], vertices[tet[2]], vertices[tet[3]],
+            { 2, tet[0] }, { 2, tet[1] }, { 2, tet[2] }, { 2, tet[3] });
+        container.addConstraint(volConstraint);
+    }
+    const size_t numConstraints = container.getConstraints().size();
+
+    // This loop gets timed, partitioning again colors all the constraints from scratch
+    for (auto _ : state)
+    {
+        container.partitionConstraints(1);
+    }
+
+    size_t minSize = numConstraints;
+    size_t maxSize = 0;
+    for (const auto& partition : container.getPartitionedConstraints())
+    {
+        minSize = std::min(minSize, partition.size());
+        maxSize = std::max(maxSize, partition.size());
+    }
+    state.counters["Constraints"] = numConstraints;
+    state.counters["Partitions"]  = container.getPartitionedConstraints().size();
+    state.counters["MinPartitionSize"] = minSize;
+    state.counters["MaxPartitionSize"] = maxSize;
+}
+
+BENCHMARK(BM_PartitionConstraints)
+->Unit(benchmark::kMillisecond)
+->Name("Distance and Volume Constraints: Tet Mesh, Partitioning")
+->Arg(10)->Arg(20)->Arg(30)->Arg(40);
+
+///
+/// \brief Creates a scene with a tet grid prism fixed at the top
+/// \param useFem FEM StVK constraints when true, distance+volume otherwise
+/// \param singlePrecision project the constraints in float, see PbdSinglePrecisionSolver
+///
+static std::shared_ptr<Scene>
+makePrismPrecisionScene(const int dim, const int iterations, const bool useFem, const bool singlePrecision,
+                        std::shared_ptr<PbdObject>& prismObj)
+{
+    auto scene = std::make_shared<Scene>("PbdBenchmark");
+    prismObj = std::make_shared<PbdObject>("Prism");
+
+    std::shared_ptr<TetrahedralMesh> prismMesh = makeTetGrid(
+        Vec3d(4.0, 4.0, 4.0), Vec3i(dim, dim, dim), Vec3d(0.0, 0.0, 0.0));
+
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    if (useFem)
+    {
+        pbdParams->m_femParams->m_YoungModulus = 5.0;
+        pbdParams->m_femParams->m_PoissonRatio = 0.4;
+        pbdParams->enableFemConstraint(PbdFemConstraint::MaterialType::StVK);
+    }
+    else
+    {
+        pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Volume, 1.0);
+        pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0);
+    }
+    pbdParams->m_singlePrecision = singlePrecision;
+    pbdParams->m_gravity    = Vec3d(0.0, -1.0, 0.0);
+    pbdParams->m_dt         = 0.05;
+    pbdParams->m_iterations = iterations;
+    pbdParams->m_linearDampingCoeff = 0.03;
+
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->configure(pbdParams);
+
+    prismObj->setPhysicsGeometry(prismMesh);
+    prismObj->setDynamicalModel(pbdModel);
+    prismObj->getPbdBody()->uniformMassValue = 0.05;
+    // Fix the borders
+    for (int z = 0; z < dim; z++)
+    {
+        for (int x = 0; x < dim; x++)
+        {
+            const int y = dim - 1;
+            prismObj->getPbdBody()->fixedNodeIds.push_back(x + dim * (y + dim * z));
+        }
+    }
+
+    scene->addSceneObject(prismObj);
+    scene->initialize();
+    return scene;
+}
+
+///
+/// \brief Time evolution step of PBD on a tet mesh comparing double (0) with single (1)
+/// precision constraint projection. Distance+volume (0) or FEM StVK (1) constraints.
+/// After timing, the other precision is stepped the same amount and the max vertex
+/// deviation between both is reported
+///
+static void
+BM_PbdPrecision(benchmark::State& state)
+{
+    const int  dim    = static_cast<int>(state.range(0));
+    const bool useFem = (state.range(2) == 1);
+    const bool singlePrecision = (state.range(3) == 1);
+
+    std::shared_ptr<PbdObject> prismObj;
+    std::shared_ptr<PbdObject> referenceObj;
+    std::shared_ptr<Scene>     scene = makePrismPrecisionScene(dim, static_cast<int>(state.range(1)),
+        useFem, singlePrecision, prismObj);
+    std::shared_ptr<Scene> referenceScene = makePrismPrecisionScene(dim, static_cast<int>(state.range(1)),
+        useFem, !singlePrecision, referenceObj);
+
+    // Setup outputs for results
+    state.counters["DOFs"]       = dim * dim * dim;
+    state.counters["Iterations"] = state.range(1);
+    state.counters["Fem"]    = state.range(2);
+    state.counters["Single"] = state.range(3);
+
+    // This loop gets timed
+    int numSteps = 0;
+    for (auto _ : state)
+    {
+        scene->advance(0.05);
+        numSteps++;
+    }
+
+    for (int i = 0; i < numSteps; i++)
+    {
+        referenceScene->advance(0.05);
+    }
+    const VecDataArray<double, 3>& vertices = *prismObj->getPbdBody()->vertices;
+    const VecDataArray<double, 3>& referenceVertices = *referenceObj->getPbdBody()->vertices;
+    double maxDeviation = 0.0;
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        maxDeviation = std::max(maxDeviation, (vertices[i] - referenceVertices[i]).norm());
+    }
+    state.counters["MaxDeviation"] = maxDeviation;
+}
+
+BENCHMARK(BM_PbdPrecision)
+->Unit(benchmark::kMillisecond)
+->Name("Tet Mesh, Double vs Single Precision Constraints")
+->ArgsProduct({ { 10, 20, 30 }, { 5, 10 }, { 0, 1 }, { 0, 1 } });
+
 ///
 /// \brief Time evolution step of PBD using distance+dihedral constraint on surface mesh
 ///
@@ -0,0 +1,128 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkCollidingObject.h"
+#include "imstkMath.h"
+#include "imstkPlane.h"
+#include "imstkPointSet.h"
+#include "imstkScene.h"
+#include "imstkSphModel.h"
+#include "imstkSphObject.h"
+#include "imstkSphObjectCollision.h"
+#include "imstkSphere.h"
+#include "imstkVecDataArray.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace imstk;
+
+///
+/// \brief Ball of fluid dropped on a sphere between two planes, scene 1 of the SPHFluid example
+///
+static std::shared_ptr<Scene>
+makeBallDropScene(const double particleRadius, const bool implicit, const bool verletLists,
+                  std::shared_ptr<SphModel>& sphModel)
+{
+    auto scene = std::make_shared<Scene>("SphBenchmark");
+
+    // Fluid ball
+    const double sphereRadius = 2.0;
+    const Vec3d  sphereCenter(0.0, 1.0, 0.0);
+    const double spacing = 2.0 * particleRadius;
+    const int    n       = static_cast<int>(2.0 * sphereRadius / spacing);
+    auto         particles = std::make_shared<VecDataArray<double, 3>>();
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            for (int k = 0; k < n; ++k)
+            {
+                const Vec3d pos = sphereCenter - Vec3d::Constant(sphereRadius) + Vec3d(i, j, k) * spacing;
+                if ((pos - sphereCenter).squaredNorm() < sphereRadius * sphereRadius)
+                {
+                    particles->push_back(pos);
+                }
+            }
+        }
+    }
+    auto geometry = std::make_shared<PointSet>();
+    geometry->initialize(particles);
+
+    auto sphParams = std::make_shared<SphModelConfig>(particleRadius);
+    sphParams->m_bNormalizeDensity = true;
+    sphParams->m_bUseVerletLists   = verletLists;
+    if (implicit)
+    {
+        // No sound speed limit, only the velocities limit the time step
+        sphParams->m_pressureSolverType = SphModelConfig::PressureSolverType::Implicit;
+        sphParams->m_maxTimestep = 5.0e-3;
+    }
+
+    sphModel = std::make_shared<SphModel>();
+    sphModel->setModelGeometry(geometry);
+    sphModel->configure(sphParams);
+    sphModel->setTimeStepSizeType(TimeSteppingType::RealTime);
+
+    auto fluidObj = std::make_shared<SphObject>("Fluid");
+    fluidObj->setCollidingGeometry(geometry);
+    fluidObj->setDynamicalModel(sphModel);
+    fluidObj->setPhysicsGeometry(geometry);
+    scene->addSceneObject(fluidObj);
+
+    // Solids
+    auto addSolid = [&](std::shared_ptr<Geometry> solidGeometry, const std::string& name)
+                    {
+                        auto obj = std::make_shared<CollidingObject>(name);
+                        obj->setCollidingGeometry(solidGeometry);
+                        scene->addSceneObject(obj);
+                        scene->addInteraction(std::make_shared<SphObjectCollision>(fluidObj, obj));
+                    };
+    auto floor = std::make_shared<Plane>(Vec3d(0.0, -6.0, 0.0), Vec3d(0.0, 1.0, -0.5));
+    addSolid(floor, "Floor");
+    auto backPlane = std::make_shared<Plane>(Vec3d(0.0, -6.0, 0.0), Vec3d(0.0, 1.0, 1.0));
+    addSolid(backPlane, "Back Plane");
+    auto sphere = std::make_shared<Sphere>(Vec3d(0.0, -6.0, 0.0), 2.0);
+    addSolid(sphere, "Sphere on Floor");
+
+    scene->initialize();
+    return scene;
+}
+
+///
+/// \brief Advance of the ball drop, range(0) selects the weakly compressible (0) or implicit (1)
+/// pressure solver, range(1) enables Verlet neighbor lists. SimulatedTime is the simulated
+/// seconds per wall-clock second
+///
+static void
+BM_SphBallDrop(benchmark::State& state)
+{
+    std::shared_ptr<SphModel> sphModel;
+    std::shared_ptr<Scene>    scene = makeBallDropScene(0.1, state.range(0) == 1, state.range(1) == 1, sphModel);
+
+    double simulatedTime = 0.0;
+    double numPressureIterations = 0.0;
+    for (auto _ : state)
+    {
+        scene->advance(0.01);
+        simulatedTime += sphModel->getTimeStep();
+        numPressureIterations += sphModel->getNumPressureIterations();
+    }
+
+    state.counters["Particles"]     = static_cast<double>(sphModel->getCurrentState()->getNumParticles());
+    state.counters["SimulatedTime"] = benchmark::Counter(simulatedTime, benchmark::Counter::kIsRate);
+    state.counters["TimeStep"]      = benchmark::Counter(simulatedTime, benchmark::Counter::kAvgIterations);
+    state.counters["PressureIterations"] = benchmark::Counter(numPressureIterations, benchmark::Counter::kAvgIterations);
+    state.counters["NeighborRebuilds"]   = sphModel->getNumNeighborRebuilds();
+}
+
+BENCHMARK(BM_SphBallDrop)
+->Unit(benchmark::kMillisecond)
+->Name("SPH ball drop: 0 weakly compressible, 1 implicit / 1 Verlet lists")
+->Args({ 0, 0 })->Args({ 0, 1 })->Args({ 1, 0 })->Args({ 1, 1 })
+->Iterations(500);
+
+// Run the benchmark
+BENCHMARK_MAIN();
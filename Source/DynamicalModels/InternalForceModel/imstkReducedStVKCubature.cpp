@@ -0,0 +1,417 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkReducedStVKCubature.h"
+#include "imstkLogger.h"
+#include "imstkParallelFor.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkVecDataArray.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace imstk
+{
+ReducedStVKCubature::ReducedStVKCubature(std::shared_ptr<TetrahedralMesh> tetMesh,
+                                         const double youngsModulus, const double poissonRatio)
+{
+    CHECK(tetMesh != nullptr) << "ReducedStVKCubature requires a TetrahedralMesh";
+
+    m_lambda = youngsModulus * poissonRatio / ((1.0 + poissonRatio) * (1.0 - 2.0 * poissonRatio));
+    m_mu     = youngsModulus / (2.0 * (1.0 + poissonRatio));
+
+    const VecDataArray<double, 3>& vertices = *tetMesh->getInitialVertexPositions();
+    const VecDataArray<int, 4>&    tets     = *tetMesh->getCells();
+    m_numVertices = vertices.size();
+    m_tets.resize(tets.size());
+    m_DmInv.resize(tets.size());
+    m_volumes.resize(tets.size());
+    for (int i = 0; i < tets.size(); i++)
+    {
+        const Vec4i& tet = tets[i];
+        Mat3d        Dm;
+        Dm.col(0)    = vertices[tet[1]] - vertices[tet[0]];
+        Dm.col(1)    = vertices[tet[2]] - vertices[tet[0]];
+        Dm.col(2)    = vertices[tet[3]] - vertices[tet[0]];
+        m_tets[i]    = tet;
+        m_DmInv[i]   = Dm.inverse();
+        m_volumes[i] = std::abs(Dm.determinant()) / 6.0;
+    }
+}
+
+void
+ReducedStVKCubature::computeElementForce(const int tetId, const Vec12d& ue, Vec12d& fe, Mat12d* Ke) const
+{
+    const Mat3d& B = m_DmInv[tetId];
+    const double V = m_volumes[tetId];
+
+    Mat3d Du;
+    for (int i = 0; i < 3; i++)
+    {
+        Du.col(i) = ue.segment<3>(3 * (i + 1)) - ue.segment<3>(0);
+    }
+
+    // First Piola-Kirchhoff stress of the Green strain
+    const Mat3d F = Mat3d::Identity() + Du * B;
+    const Mat3d E = 0.5 * (F.transpose() * F - Mat3d::Identity());
+    const Mat3d S = m_lambda * E.trace() * Mat3d::Identity() + 2.0 * m_mu * E;
+    const Mat3d H = V * F * S * B.transpose();
+
+    // Gradient of the energy, the first vertex balances the other three
+    fe.segment<3>(3) = H.col(0);
+    fe.segment<3>(6) = H.col(1);
+    fe.segment<3>(9) = H.col(2);
+    fe.segment<3>(0) = -(H.col(0) + H.col(1) + H.col(2));
+
+    if (Ke == nullptr)
+    {
+        return;
+    }
+
+    // Differentiate the force along each vertex displacement
+    for (int j = 0; j < 4; j++)
+    {
+        for (int d = 0; d < 3; d++)
+        {
+            Mat3d dDu = Mat3d::Zero();
+            if (j == 0)
+            {
+                dDu.row(d).setConstant(-1.0);
+            }
+            else
+            {
+                dDu(d, j - 1) = 1.0;
+            }
+            const Mat3d dF = dDu * B;
+            const Mat3d dE = 0.5 * (dF.transpose() * F + F.transpose() * dF);
+            const Mat3d dS = m_lambda * dE.trace() * Mat3d::Identity() + 2.0 * m_mu * dE;
+            const Mat3d dH = V * (dF * S + F * dS) * B.transpose();
+
+            auto col = Ke->col(3 * j + d);
+            col.segment<3>(3) = dH.col(0);
+            col.segment<3>(6) = dH.col(1);
+            col.segment<3>(9) = dH.col(2);
+            col.segment<3>(0) = -(dH.col(0) + dH.col(1) + dH.col(2));
+        }
+    }
+}
+
+void
+ReducedStVKCubature::computeInternalForce(const Vectord& u, Vectord& f) const
+{
+    f.setZero(3 * m_numVertices);
+    Vec12d ue;
+    Vec12d fe;
+    for (int i = 0; i < getNumElements(); i++)
+    {
+        const Vec4i& tet = m_tets[i];
+        for (int j = 0; j < 4; j++)
+        {
+            ue.segment<3>(3 * j) = u.segment<3>(3 * tet[j]);
+        }
+        computeElementForce(i, ue, fe);
+        for (int j = 0; j < 4; j++)
+        {
+            f.segment<3>(3 * tet[j]) += fe.segment<3>(3 * j);
+        }
+    }
+}
+
+void
+ReducedStVKCubature::computeTangentStiffness(const Vectord& u, SparseMatrixd& K) const
+{
+    // Elements are independent, each writes its own triplets
+    std::vector<Eigen::Triplet<double>> triplets(m_tets.size() * 144);
+    ParallelUtils::parallelFor(getNumElements(),
+        [&](const int i)
+        {
+            const Vec4i& tet = m_tets[i];
+            Vec12d ue;
+            for (int j = 0; j < 4; j++)
+            {
+                ue.segment<3>(3 * j) = u.segment<3>(3 * tet[j]);
+            }
+            Vec12d fe;
+            Mat12d Ke;
+            computeElementForce(i, ue, fe, &Ke);
+            size_t k = static_cast<size_t>(i) * 144;
+            for (int c = 0; c < 12; c++)
+            {
+                for (int r = 0; r < 12; r++)
+                {
+                    triplets[k++] = Eigen::Triplet<double>(3 * tet[r / 3] + r % 3, 3 * tet[c / 3] + c % 3, Ke(r, c));
+                }
+            }
+        });
+    K.resize(3 * m_numVertices, 3 * m_numVertices);
+    K.setFromTriplets(triplets.begin(), triplets.end());
+}
+
+void
+ReducedStVKCubature::setBasis(const Matrixd& U)
+{
+    CHECK(U.rows() == 3 * m_numVertices) << "Basis doesn't match the mesh";
+    m_U = U;
+    m_elements.clear();
+    m_weights.clear();
+    m_bases.clear();
+}
+
+Eigen::Matrix<double, 12, Eigen::Dynamic>
+ReducedStVKCubature::getElementBasis(const int tetId) const
+{
+    Eigen::Matrix<double, 12, Eigen::Dynamic> Ue(12, m_U.cols());
+    for (int j = 0; j < 4; j++)
+    {
+        Ue.middleRows<3>(3 * j) = m_U.middleRows<3>(3 * m_tets[tetId][j]);
+    }
+    return Ue;
+}
+
+Vectord
+ReducedStVKCubature::computeTrainingColumn(const int tetId, const Matrixd& displacements, const Vectord& poseScales) const
+{
+    const Eigen::Index r      = m_U.cols();
+    const Vec4i&       tet    = m_tets[tetId];
+    const auto         Ue     = getElementBasis(tetId);
+    Vectord            column(r * displacements.cols());
+    Vec12d             ue;
+    Vec12d             fe;
+    for (Eigen::Index t = 0; t < displacements.cols(); t++)
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            ue.segment<3>(3 * j) = displacements.col(t).segment<3>(3 * tet[j]);
+        }
+        computeElementForce(tetId, ue, fe);
+        column.segment(t * r, r).noalias() = poseScales[t] * (Ue.transpose() * fe);
+    }
+    return column;
+}
+
+double
+ReducedStVKCubature::train(const std::vector<Vectord>& poses, const int maxNumElements, const double tolerance)
+{
+    CHECK(m_U.size() > 0) << "ReducedStVKCubature requires a basis to train";
+    const Eigen::Index r        = m_U.cols();
+    const Eigen::Index numPoses = static_cast<Eigen::Index>(poses.size());
+    m_elements.clear();
+    m_weights.clear();
+    m_bases.clear();
+
+    // Full displacements and exact reduced forces of every pose. Each pose is scaled
+    // to unit force so large poses don't dominate the fit
+    Matrixd displacements(m_U.rows(), numPoses);
+    Vectord b(r * numPoses);
+    Vectord poseScales(numPoses);
+    ParallelUtils::parallelFor(numPoses,
+        [&](const Eigen::Index t)
+        {
+            displacements.col(t).noalias() = m_U * poses[t];
+            Vectord f;
+            computeInternalForce(displacements.col(t), f);
+            const Vectord g = m_U.transpose() * f;
+            const double  norm = g.norm();
+            poseScales[t] = (norm > 0.0) ? 1.0 / norm : 0.0;
+            b.segment(t * r, r) = poseScales[t] * g;
+        });
+    const double bNorm = b.norm();
+    if (bNorm == 0.0)
+    {
+        return 0.0;
+    }
+
+    // Greedily add the element whose forces best align with the residual, out of a
+    // random subset of candidates, then refit all weights
+    const int          numElements   = getNumElements();
+    const int          numCandidates = std::min(numElements, 1000);
+    std::mt19937       rng(0);
+    std::vector<int>   candidates(numElements);
+    std::vector<char>  isSelected(numElements, false);
+    std::iota(candidates.begin(), candidates.end(), 0);
+    Matrixd A(b.size(), 0);
+    Vectord residual = b;
+    Vectord weights;
+    double  error    = 1.0;
+    while (static_cast<int>(m_elements.size()) < std::min(maxNumElements, numElements) && error > tolerance)
+    {
+        std::shuffle(candidates.begin(), candidates.end(), rng);
+        std::vector<double> scores(numCandidates, 0.0);
+        ParallelUtils::parallelFor(numCandidates,
+            [&](const int i)
+            {
+                if (isSelected[candidates[i]])
+                {
+                    return;
+                }
+                const Vectord column = computeTrainingColumn(candidates[i], displacements, poseScales);
+                const double  norm   = column.norm();
+                scores[i] = (norm > 0.0) ? column.dot(residual) / norm : 0.0;
+            });
+        const int best = static_cast<int>(std::max_element(scores.begin(), scores.end()) - scores.begin());
+        if (scores[best] <= 0.0)
+        {
+            break;
+        }
+
+        const int tetId = candidates[best];
+        isSelected[tetId] = true;
+        m_elements.push_back(tetId);
+        A.conservativeResize(Eigen::NoChange, A.cols() + 1);
+        A.col(A.cols() - 1) = computeTrainingColumn(tetId, displacements, poseScales);
+
+        weights  = solveNonNegativeLeastSquares(A, b);
+        residual = b - A * weights;
+        error    = residual.norm() / bNorm;
+    }
+
+    // Elements the fit dropped don't need evaluating
+    std::vector<int> elements;
+    for (size_t i = 0; i < m_elements.size(); i++)
+    {
+        if (weights[i] > 0.0)
+        {
+            elements.push_back(m_elements[i]);
+            m_weights.push_back(weights[i]);
+        }
+    }
+    m_elements = elements;
+    setCubature(m_elements, m_weights);
+    return error;
+}
+
+void
+ReducedStVKCubature::setCubature(const std::vector<int>& elements, const std::vector<double>& weights)
+{
+    CHECK(elements.size() == weights.size()) << "Every cubature element requires a weight";
+    m_elements = elements;
+    m_weights  = weights;
+    m_bases.resize(m_elements.size());
+    for (size_t i = 0; i < m_elements.size(); i++)
+    {
+        CHECK(m_elements[i] >= 0 && m_elements[i] < getNumElements()) << "Invalid cubature element";
+        m_bases[i] = getElementBasis(m_elements[i]);
+    }
+}
+
+void
+ReducedStVKCubature::computeReducedInternalForce(const Vectord& q, Vectord& g) const
+{
+    g.setZero(m_U.cols());
+    Vec12d fe;
+    for (size_t i = 0; i < m_elements.size(); i++)
+    {
+        const Vec12d ue = m_bases[i] * q;
+        computeElementForce(m_elements[i], ue, fe);
+        g.noalias() += m_weights[i] * (m_bases[i].transpose() * fe);
+    }
+}
+
+void
+ReducedStVKCubature::computeReducedTangentStiffness(const Vectord& q, Matrixd& K) const
+{
+    K.setZero(m_U.cols(), m_U.cols());
+    Vec12d fe;
+    Mat12d Ke;
+    for (size_t i = 0; i < m_elements.size(); i++)
+    {
+        const Vec12d ue = m_bases[i] * q;
+        computeElementForce(m_elements[i], ue, fe, &Ke);
+        K.noalias() += m_weights[i] * (m_bases[i].transpose() * Ke * m_bases[i]);
+    }
+}
+
+void
+ReducedStVKCubature::computeExactReducedInternalForce(const Vectord& q, Vectord& g) const
+{
+    Vectord f;
+    computeInternalForce(m_U * q, f);
+    g = m_U.transpose() * f;
+}
+
+Vectord
+ReducedStVKCubature::solveNonNegativeLeastSquares(const Matrixd& A, const Vectord& b)
+{
+    const Eigen::Index n = A.cols();
+    Vectord            x = Vectord::Zero(n);
+    std::vector<char>  isPassive(n, false);
+    const double       tol = 1.0e-10 * A.norm() * b.norm();
+
+    for (Eigen::Index iter = 0; iter < 3 * n; iter++)
+    {
+        // Free the variable whose increase reduces the residual the most
+        const Vectord w   = A.transpose() * (b - A * x);
+        Eigen::Index  t   = -1;
+        double        max = tol;
+        for (Eigen::Index j = 0; j < n; j++)
+        {
+            if (!isPassive[j] && w[j] > max)
+            {
+                max = w[j];
+                t   = j;
+            }
+        }
+        if (t == -1)
+        {
+            break;
+        }
+        isPassive[t] = true;
+
+        while (true)
+        {
+            // Unconstrained least squares on the passive set
+            std::vector<Eigen::Index> ids;
+            for (Eigen::Index j = 0; j < n; j++)
+            {
+                if (isPassive[j])
+                {
+                    ids.push_back(j);
+                }
+            }
+            Matrixd Ap(A.rows(), ids.size());
+            for (size_t j = 0; j < ids.size(); j++)
+            {
+                Ap.col(j) = A.col(ids[j]);
+            }
+            const Vectord zp = Ap.colPivHouseholderQr().solve(b);
+            Vectord       z  = Vectord::Zero(n);
+            for (size_t j = 0; j < ids.size(); j++)
+            {
+                z[ids[j]] = zp[j];
+            }
+            if ((zp.array() > 0.0).all())
+            {
+                x = z;
+                break;
+            }
+
+            // Step towards z until a variable hits zero, it becomes active again
+            double       alpha   = 1.0;
+            Eigen::Index blocker = ids[0];
+            for (const Eigen::Index j : ids)
+            {
+                if (z[j] <= 0.0 && x[j] - z[j] > 0.0 && x[j] / (x[j] - z[j]) <= alpha)
+                {
+                    alpha   = x[j] / (x[j] - z[j]);
+                    blocker = j;
+                }
+            }
+            x += alpha * (z - x);
+            x[blocker] = 0.0;
+            for (const Eigen::Index j : ids)
+            {
+                if (x[j] <= 0.0)
+                {
+                    isPassive[j] = false;
+                    x[j] = 0.0;
+                }
+            }
+        }
+    }
+    return x;
+}
+} // namespace imstk
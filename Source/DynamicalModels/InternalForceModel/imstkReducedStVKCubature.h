@@ -0,0 +1,119 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkMath.h"
+
+namespace imstk
+{
+class TetrahedralMesh;
+
+///
+/// \class ReducedStVKCubature
+///
+/// \brief Saint Venant-Kirchhoff internal forces of a linear tetrahedral mesh, in the
+/// full space or in the reduced space of a basis U (full = U * reduced).
+///
+/// Reduced forces are approximated by optimized cubature (An, Kim, James 2008): a
+/// weighted sum over a few elements, g(q) = sum_e w_e U_e^T f_e(U_e q), so evaluating
+/// them costs the number of cubature elements instead of the size of the mesh.
+/// The elements and weights are trained to match the exact reduced forces of sampled
+/// poses, greedily adding the element most aligned with the residual and refitting
+/// the weights by non-negative least squares.
+///
+class ReducedStVKCubature
+{
+public:
+    using Vec12d = Eigen::Matrix<double, 12, 1>;
+    using Mat12d = Eigen::Matrix<double, 12, 12>;
+
+    ReducedStVKCubature(std::shared_ptr<TetrahedralMesh> tetMesh,
+                        const double youngsModulus = 1.0e7, const double poissonRatio = 0.4);
+    virtual ~ReducedStVKCubature() = default;
+
+    ///
+    /// \brief Internal force, and optionally stiffness, of an element given the
+    /// displacements of its 4 vertices
+    ///
+    void computeElementForce(const int tetId, const Vec12d& ue, Vec12d& fe, Mat12d* Ke = nullptr) const;
+
+    ///
+    /// \brief Internal forces of the whole mesh given the vertex displacements
+    ///
+    void computeInternalForce(const Vectord& u, Vectord& f) const;
+
+    ///
+    /// \brief Stiffness matrix of the whole mesh given the vertex displacements
+    ///
+    void computeTangentStiffness(const Vectord& u, SparseMatrixd& K) const;
+
+    ///
+    /// \brief Set the basis the reduced forces are computed in, clears the cubature
+    ///
+    void setBasis(const Matrixd& U);
+    const Matrixd& getBasis() const { return m_U; }
+
+    ///
+    /// \brief Train the cubature elements and weights on the reduced poses given. Stops
+    /// when the relative error of the training forces is below the tolerance or when
+    /// maxNumElements were chosen. Returns the relative training error
+    ///
+    double train(const std::vector<Vectord>& poses, const int maxNumElements, const double tolerance);
+
+    ///
+    /// \brief Set the cubature elements and weights, ie: of a previous training
+    ///
+    void setCubature(const std::vector<int>& elements, const std::vector<double>& weights);
+    const std::vector<int>& getCubatureElements() const { return m_elements; }
+    const std::vector<double>& getCubatureWeights() const { return m_weights; }
+
+    ///
+    /// \brief Reduced internal forces of the reduced displacements q
+    ///
+    void computeReducedInternalForce(const Vectord& q, Vectord& g) const;
+
+    ///
+    /// \brief Reduced tangent stiffness of the reduced displacements q
+    ///
+    void computeReducedTangentStiffness(const Vectord& q, Matrixd& K) const;
+
+    ///
+    /// \brief Exact reduced internal forces, U^T f(U q), evaluating every element
+    ///
+    void computeExactReducedInternalForce(const Vectord& q, Vectord& g) const;
+
+    int getNumElements() const { return static_cast<int>(m_tets.size()); }
+
+    ///
+    /// \brief Solve min |Ax - b| with x >= 0 (Lawson-Hanson active set)
+    ///
+    static Vectord solveNonNegativeLeastSquares(const Matrixd& A, const Vectord& b);
+
+protected:
+    ///
+    /// \brief Rows of the basis of the element vertices
+    ///
+    Eigen::Matrix<double, 12, Eigen::Dynamic> getElementBasis(const int tetId) const;
+
+    ///
+    /// \brief Reduced forces of an element for every pose, stacked and scaled by the pose scales
+    ///
+    Vectord computeTrainingColumn(const int tetId, const Matrixd& displacements, const Vectord& poseScales) const;
+
+    std::vector<Vec4i>  m_tets;
+    StdVectorOfMat3d    m_DmInv;   ///< Inverse rest edge matrix of each element
+    std::vector<double> m_volumes; ///< Rest volume of each element
+    double m_lambda = 0.0;         ///< First Lame parameter
+    double m_mu     = 0.0;         ///< Shear modulus
+    int    m_numVertices = 0;
+
+    Matrixd m_U;                                                     ///< Basis, 3 * numVertices x r
+    std::vector<int>    m_elements;                                  ///< Cubature elements
+    std::vector<double> m_weights;                                   ///< Cubature weights
+    std::vector<Eigen::Matrix<double, 12, Eigen::Dynamic>> m_bases; ///< Basis rows of each cubature element
+};
+} // namespace imstk
@@ -8,12 +8,43 @@
 #include "imstkImageData.h"
 #include "imstkLevelSetModel.h"
 #include "imstkLogger.h"
-#include "imstkMacros.h"
 #include "imstkParallelFor.h"
 #include "imstkTaskGraph.h"
 
 namespace imstk
 {
+namespace
+{
+///
+/// \brief Returns the upwind gradient magnitudes squared from the forward and backward
+/// gradients, used for negative and positive speeds
+///
+Vec2d
+computeGradientMagnitudes(const Vec3d& gradPos, const Vec3d& gradNeg)
+{
+    Vec3d gradNegMax = gradNeg.cwiseMax(0.0);
+    Vec3d gradNegMin = gradNeg.cwiseMin(0.0);
+    Vec3d gradPosMax = gradPos.cwiseMax(0.0);
+    Vec3d gradPosMin = gradPos.cwiseMin(0.0);
+
+    // Square them
+    gradNegMax = gradNegMax.cwiseProduct(gradNegMax);
+    gradNegMin = gradNegMin.cwiseProduct(gradNegMin);
+    gradPosMax = gradPosMax.cwiseProduct(gradPosMax);
+    gradPosMin = gradPosMin.cwiseProduct(gradPosMin);
+
+    const double posMag =
+        gradNegMax[0] + gradNegMax[1] + gradNegMax[2] +
+        gradPosMin[0] + gradPosMin[1] + gradPosMin[2];
+
+    const double negMag =
+        gradNegMin[0] + gradNegMin[1] + gradNegMin[2] +
+        gradPosMax[0] + gradPosMax[1] + gradPosMax[2];
+
+    return Vec2d(negMag, posMag);
+}
+} // namespace
+
 LevelSetModel::LevelSetModel() :
     m_config(std::make_shared<LevelSetModelConfig>())
 {
@@ -73,6 +104,10 @@ LevelSetModel::initialize()
             m_velocities = std::make_shared<ImageData>();
             m_velocities->allocate(IMSTK_DOUBLE, 1, sdfImage->getDimensions(), sdfImage->getSpacing(), sdfImage->getOrigin());
         }
+        else
+        {
+            m_nodesToUpdate.setDimensions(sdfImage->getDimensions());
+        }
 
         const Vec3d actualSpacing = sdf->getImage()->getSpacing();// *sdf->getScale();
         m_forwardGrad.setDx(Vec3i(1, 1, 1), actualSpacing);
@@ -80,9 +115,6 @@ LevelSetModel::initialize()
         m_curvature.setDx(Vec3i(1, 1, 1), actualSpacing);
     }
 
-    m_nodeUpdatePool.resize(5000);
-    noteUpdatePoolSize = 0;
-
     return true;
 }
 
@@ -106,87 +138,66 @@ LevelSetModel::evolve()
 
     if (m_config->m_sparseUpdate)
     {
-        // Sparse update
-        if (m_nodesToUpdate.size() == 0)
+        // Sparse update, over the tiles of voxels that recieved a velocity
+        using Tile = VoxelTileGrid<double>::Tile;
+        const std::vector<Tile*>& tiles = m_nodesToUpdate.getActiveTiles();
+        if (tiles.size() == 0)
         {
             return;
         }
+        m_sparseGradientMagnitudes.resize(tiles.size() * VoxelTileGrid<double>::TileSize);
+        const bool doParallel = m_nodesToUpdate.getNumActiveVoxels() > m_maxVelocitiesParallel;
 
-        // Setup a map of 0 based index -> image sparse index m_nodesToUpdate to parallelize
-        std::vector<size_t> baseIndexToImageIndex;
-        baseIndexToImageIndex.reserve(m_nodesToUpdate.size());
-        for (std::unordered_map<size_t, std::tuple<Vec3i, double>>::iterator iter = m_nodesToUpdate.begin(); iter != m_nodesToUpdate.end(); iter++)
-        {
-            baseIndexToImageIndex.push_back(iter->first);
-        }
-        DISABLE_WARNING_PUSH
-        DISABLE_WARNING_PADDING
-
-        // Compute gradients
-        const double                             constantVel = m_config->m_constantVelocity;
-        std::tuple<size_t, Vec3i, double, Vec2d> val;
+        const double constantVel = m_config->m_constantVelocity;
         for (int j = 0; j < m_config->m_substeps; j++)
         {
-            ParallelUtils::parallelFor(baseIndexToImageIndex.size(), [&](const size_t i)
+            // Compute gradients, all of them before any distance is updated
+            ParallelUtils::parallelFor(tiles.size(), [&](const size_t i)
                 {
-                    std::tuple<size_t, Vec3i, double, Vec2d, double>& outputVal = m_nodeUpdatePool[i];
-                    const size_t& index = std::get<0>(outputVal) = baseIndexToImageIndex[i];
-
-                    std::tuple<Vec3i, double>& inputVal = m_nodesToUpdate[index];
-
-                    const Vec3i& coords    = std::get<1>(outputVal) = std::get<0>(inputVal);
-                    std::get<2>(outputVal) = std::get<1>(inputVal);
-
-                    // Gradients
-                    const Vec3d gradPos = m_forwardGrad(Vec3d(coords[0], coords[1], coords[2]));
-                    const Vec3d gradNeg = m_backwardGrad(Vec3d(coords[0], coords[1], coords[2]));
-
-                    Vec3d gradNegMax = gradNeg.cwiseMax(0.0);
-                    Vec3d gradNegMin = gradNeg.cwiseMin(0.0);
-                    Vec3d gradPosMax = gradPos.cwiseMax(0.0);
-                    Vec3d gradPosMin = gradPos.cwiseMin(0.0);
-
-                    // Square them
-                    gradNegMax = gradNegMax.cwiseProduct(gradNegMax);
-                    gradNegMin = gradNegMin.cwiseProduct(gradNegMin);
-                    gradPosMax = gradPosMax.cwiseProduct(gradPosMax);
-                    gradPosMin = gradPosMin.cwiseProduct(gradPosMin);
-
-                    const double posMag =
-                        gradNegMax[0] + gradNegMax[1] + gradNegMax[2] +
-                        gradPosMin[0] + gradPosMin[1] + gradPosMin[2];
-
-                    const double negMag =
-                        gradNegMin[0] + gradNegMin[1] + gradNegMin[2] +
-                        gradPosMax[0] + gradPosMax[1] + gradPosMax[2];
-
-                    std::get<3>(outputVal) = Vec2d(negMag, posMag);
-
-                    // Curvature
-                    //const double kappa = m_curvature(Vec3d(coords[0], coords[1], coords[2]));
-                }, baseIndexToImageIndex.size() > 50);
+                    const Tile& tile     = *tiles[i];
+                    Vec2d*      gradMags = &m_sparseGradientMagnitudes[i * VoxelTileGrid<double>::TileSize];
+                    for (int k = 0; k < VoxelTileGrid<double>::TileSize; k++)
+                    {
+                        if (tile.activeMask[k])
+                        {
+                            const Vec3d coords = tile.getCoord(k).cast<double>();
+                            gradMags[k] = computeGradientMagnitudes(m_forwardGrad(coords), m_backwardGrad(coords));
+
+                            // Curvature
+                            //const double kappa = m_curvature(coords);
+                        }
+                    }
+                }, doParallel);
 
             // Update levelset
-            ParallelUtils::parallelFor(baseIndexToImageIndex.size(), [&](const size_t& i)
+            ParallelUtils::parallelFor(tiles.size(), [&](const size_t i)
                 {
-                    const size_t index = std::get<0>(m_nodeUpdatePool[i]);
-                    const double vel   = std::get<2>(m_nodeUpdatePool[i]) + constantVel;
-                    const Vec2d& g     = std::get<3>(m_nodeUpdatePool[i]);
-                    //const double kappa = std::get<4>(nodeUpdates[i]);
-
-                    // If speed function positive use forward difference (posMag)
-                    if (vel > 0.0)
+                    const Tile&  tile     = *tiles[i];
+                    const Vec2d* gradMags = &m_sparseGradientMagnitudes[i * VoxelTileGrid<double>::TileSize];
+                    for (int k = 0; k < VoxelTileGrid<double>::TileSize; k++)
                     {
-                        imgPtr[index] += dt * (vel * std::sqrt(g[0]) /*+ kappa * k*/);
+                        if (!tile.activeMask[k])
+                        {
+                            continue;
+                        }
+                        const Vec3i  coord = tile.getCoord(k);
+                        const size_t index = coord[0] + dim[0] * (static_cast<size_t>(coord[1]) + static_cast<size_t>(coord[2]) * dim[1]);
+                        const double vel   = tile.values[k] + constantVel;
+                        const Vec2d& g     = gradMags[k];
+
+                        // If speed function positive use forward difference (posMag)
+                        if (vel > 0.0)
+                        {
+                            imgPtr[index] += dt * (vel * std::sqrt(g[0]) /*+ kappa * k*/);
+                        }
+                        // If speed function negative use backward difference (negMag)
+                        else if (vel < 0.0)
+                        {
+                            imgPtr[index] += dt * (vel * std::sqrt(g[1]) /*+ kappa * k*/);
+                        }
                     }
-                    // If speed function negative use backward difference (negMag)
-                    else if (vel < 0.0)
-                    {
-                        imgPtr[index] += dt * (vel * std::sqrt(g[1]) /*+ kappa * k*/);
-                    }
-            }, noteUpdatePoolSize > m_maxVelocitiesParallel);
+                }, doParallel);
         }
-        DISABLE_WARNING_POP
         m_nodesToUpdate.clear();
     }
     else
@@ -206,30 +217,10 @@ LevelSetModel::evolve()
                     for (int x = 0; x < dim[0]; x++, i++)
                     {
                         // Gradients
-                        const Vec3d gradPos = m_forwardGrad(Vec3d(x, y, z));
-                        const Vec3d gradNeg = m_backwardGrad(Vec3d(x, y, z));
                         //curvaturesPtr[i] = m_curvature(Vec3d(x, y, z));
-
-                        Vec3d gradNegMax = gradNeg.cwiseMax(0.0);
-                        Vec3d gradNegMin = gradNeg.cwiseMin(0.0);
-                        Vec3d gradPosMax = gradPos.cwiseMax(0.0);
-                        Vec3d gradPosMin = gradPos.cwiseMin(0.0);
-
-                        // Square them
-                        gradNegMax = gradNegMax.cwiseProduct(gradNegMax);
-                        gradNegMin = gradNegMin.cwiseProduct(gradNegMin);
-                        gradPosMax = gradPosMax.cwiseProduct(gradPosMax);
-                        gradPosMin = gradPosMin.cwiseProduct(gradPosMin);
-
-                        // Pos
-                        gradientMagPtr[i * 2 + 1] =
-                            gradNegMax[0] + gradNegMax[1] + gradNegMax[2] +
-                            gradPosMin[0] + gradPosMin[1] + gradPosMin[2];
-
-                        // Neg
-                        gradientMagPtr[i * 2] =
-                            gradNegMin[0] + gradNegMin[1] + gradNegMin[2] +
-                            gradPosMax[0] + gradPosMax[1] + gradPosMax[2];
+                        const Vec2d gradMags = computeGradientMagnitudes(m_forwardGrad(Vec3d(x, y, z)), m_backwardGrad(Vec3d(x, y, z)));
+                        gradientMagPtr[i * 2]     = gradMags[0]; // Neg
+                        gradientMagPtr[i * 2 + 1] = gradMags[1]; // Pos
                     }
                 }
             });
@@ -267,13 +258,13 @@ LevelSetModel::addImpulse(const Vec3i& coord, double f)
         const size_t index = coord[0] + coord[1] * dim[0] + coord[2] * dim[0] * dim[1];
         if (m_config->m_sparseUpdate)
         {
-            if (m_nodesToUpdate.count(index) > 0)
+            if (double* vel = m_nodesToUpdate.find(coord))
             {
-                m_nodesToUpdate[index] = std::tuple<Vec3i, double>(coord, std::max(std::get<1>(m_nodesToUpdate[index]), f));
+                *vel = std::max(*vel, f);
             }
             else
             {
-                m_nodesToUpdate[index] = std::tuple<Vec3i, double>(coord, f);
+                m_nodesToUpdate.setValue(coord, f);
             }
         }
         else
@@ -298,7 +289,7 @@ LevelSetModel::setImpulse(const Vec3i& coord, double f)
         const size_t index = coord[0] + coord[1] * dim[0] + coord[2] * dim[0] * dim[1];
         if (m_config->m_sparseUpdate)
         {
-            m_nodesToUpdate[index] = std::tuple<Vec3i, double>(coord, f);
+            m_nodesToUpdate.setValue(coord, f);
         }
         else
         {
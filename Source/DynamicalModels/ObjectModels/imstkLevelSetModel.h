@@ -8,9 +8,7 @@
 
 #include "imstkDynamicalModel.h"
 #include "imstkImplicitFunctionFiniteDifferenceFunctor.h"
-
-#include <unordered_map>
-#include <tuple>
+#include "imstkVoxelTileGrid.h"
 
 namespace imstk
 {
@@ -19,7 +17,7 @@ class ImageData;
 struct LevelSetModelConfig
 {
     double m_dt = 0.001;             ///< Time step size
-    bool m_sparseUpdate = false;     ///< Only updates nodes that recieve force
+    bool m_sparseUpdate = false;     ///< Only updates nodes that recieve force, the distances stay dense
     bool m_useCurvature = false;
     double m_k = 0.05;               // Curvature term
     double m_constantVelocity = 0.0; // Constant velocity
@@ -32,6 +30,11 @@ struct LevelSetModelConfig
 /// \brief This class implements a generic level set model, it requires both a forward
 /// and backward finite differencing method
 ///
+/// The distances are always stored in the dense image of the SignedDistanceField, which
+/// collision and rendering read directly. The sparse update only tiles the velocities and
+/// the set of nodes to update, it saves the dense velocity and gradient images but the
+/// memory of the level set itself is unchanged.
+///
 class LevelSetModel : public AbstractDynamicalModel
 {
 public:
@@ -73,7 +76,11 @@ public:
     std::shared_ptr<TaskNode> getGenerateVelocitiesBeginNode() const { return m_generateVelocitiesBegin; }
     std::shared_ptr<TaskNode> getGenerateVelocitiesEndNode() const { return m_generateVelocitiesEnd; }
 
-    std::unordered_map<size_t, std::tuple<Vec3i, double>>& getNodesToUpdate() { return m_nodesToUpdate; }
+    ///
+    /// \brief Returns the velocities of the nodes to update on the next evolve in sparse mode,
+    /// cleared once evolved
+    ///
+    const VoxelTileGrid<double>& getNodesToUpdate() const { return m_nodesToUpdate; }
 
     void resetToInitialState() override;
 
@@ -92,9 +99,8 @@ protected:
 
     std::shared_ptr<LevelSetModelConfig> m_config;
 
-    std::unordered_map<size_t, std::tuple<Vec3i, double>> m_nodesToUpdate;
-    std::vector<std::tuple<size_t, Vec3i, double, Vec2d, double>> m_nodeUpdatePool;
-    size_t noteUpdatePoolSize;
+    VoxelTileGrid<double> m_nodesToUpdate;                     ///< Velocities of the nodes to update in sparse mode
+    std::vector<Vec2d>    m_sparseGradientMagnitudes;          ///< Gradient magnitudes of every voxel of the active tiles
     size_t m_maxVelocitiesParallel = 100;                      // In sparse mode, if surpass this value, switch to parallel
 
     std::shared_ptr<ImageData> m_gradientMagnitudes = nullptr; ///< Gradient magnitude field when using dense
@@ -0,0 +1,510 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkModalAnalysis.h"
+#include "imstkLogger.h"
+#include "imstkReducedStVKCubature.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkVecDataArray.h"
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/SparseCholesky>
+
+#include <cstring>
+#include <fstream>
+#include <random>
+
+namespace imstk
+{
+namespace
+{
+constexpr char     Magic[8] = { 'I', 'M', 'S', 'T', 'K', 'M', 'O', 'D' };
+constexpr uint32_t Version  = 1;
+
+///
+/// \brief FNV-1a over the bytes given
+///
+void
+hashBytes(uint64_t& hash, const void* data, const size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+}
+
+template<typename T>
+void
+hashValue(uint64_t& hash, const T& value)
+{
+    hashBytes(hash, &value, sizeof(T));
+}
+
+///
+/// \brief Keep the rows and columns of the free dofs, dofMap gives the free index or -1
+///
+SparseMatrixd
+restrictMatrix(const SparseMatrixd& A, const std::vector<int>& dofMap, const int numFree)
+{
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(A.nonZeros());
+    for (int i = 0; i < A.outerSize(); i++)
+    {
+        if (dofMap[i] == -1)
+        {
+            continue;
+        }
+        for (SparseMatrixd::InnerIterator iter(A, i); iter; ++iter)
+        {
+            if (dofMap[iter.col()] != -1)
+            {
+                triplets.push_back(Eigen::Triplet<double>(dofMap[i], dofMap[iter.col()], iter.value()));
+            }
+        }
+    }
+    SparseMatrixd results(numFree, numFree);
+    results.setFromTriplets(triplets.begin(), triplets.end());
+    return results;
+}
+
+Vectord
+restrictVector(const Vectord& x, const std::vector<int>& dofMap, const int numFree)
+{
+    Vectord results(numFree);
+    for (size_t i = 0; i < dofMap.size(); i++)
+    {
+        if (dofMap[i] != -1)
+        {
+            results[dofMap[i]] = x[i];
+        }
+    }
+    return results;
+}
+
+Matrixd
+prolongateMatrix(const Matrixd& X, const std::vector<int>& dofMap)
+{
+    Matrixd results = Matrixd::Zero(dofMap.size(), X.cols());
+    for (size_t i = 0; i < dofMap.size(); i++)
+    {
+        if (dofMap[i] != -1)
+        {
+            results.row(i) = X.row(dofMap[i]);
+        }
+    }
+    return results;
+}
+} // namespace
+
+void
+ModalAnalysis::computeMassMatrix(std::shared_ptr<TetrahedralMesh> tetMesh, const double density, SparseMatrixd& M)
+{
+    const VecDataArray<double, 3>& vertices = *tetMesh->getInitialVertexPositions();
+    const VecDataArray<int, 4>&    tets     = *tetMesh->getCells();
+
+    // Consistent mass of linear tetrahedra, rho * V / 20 * (1 + delta_ab) per dimension
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(tets.size() * 48);
+    for (int i = 0; i < tets.size(); i++)
+    {
+        const Vec4i& tet = tets[i];
+        Mat3d        Dm;
+        Dm.col(0) = vertices[tet[1]] - vertices[tet[0]];
+        Dm.col(1) = vertices[tet[2]] - vertices[tet[0]];
+        Dm.col(2) = vertices[tet[3]] - vertices[tet[0]];
+        const double m = density * std::abs(Dm.determinant()) / 6.0 / 20.0;
+        for (int a = 0; a < 4; a++)
+        {
+            for (int b = 0; b < 4; b++)
+            {
+                for (int d = 0; d < 3; d++)
+                {
+                    triplets.push_back(Eigen::Triplet<double>(3 * tet[a] + d, 3 * tet[b] + d, (a == b) ? 2.0 * m : m));
+                }
+            }
+        }
+    }
+    M.resize(3 * vertices.size(), 3 * vertices.size());
+    M.setFromTriplets(triplets.begin(), triplets.end());
+}
+
+bool
+ModalAnalysis::solveGeneralizedEigenproblem(const SparseMatrixd& K, const SparseMatrixd& M,
+                                            const int numModes, const double shift,
+                                            Matrixd& modes, Vectord& eigenvalues)
+{
+    const Eigen::Index n = K.rows();
+    CHECK(numModes > 0 && numModes <= n) << "Invalid number of modes " << numModes;
+
+    // Lanczos on (K - shift * M)^-1 M, self adjoint in the M inner product. Its largest
+    // eigenvalues theta = 1 / (lambda - shift) are the lambdas closest above the shift
+    const Eigen::SparseMatrix<double> A = K - shift * M;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver(A);
+    if (solver.info() != Eigen::Success)
+    {
+        LOG(WARNING) << "Failed to factorize the shifted stiffness matrix";
+        return false;
+    }
+
+    std::mt19937                     rng(0);
+    std::normal_distribution<double> normal;
+    auto                             randomVector = [&]()
+                                                    {
+                                                        Vectord v(n);
+                                                        for (Eigen::Index i = 0; i < n; i++)
+                                                        {
+                                                            v[i] = normal(rng);
+                                                        }
+                                                        return v;
+                                                    };
+
+    Eigen::Index m = std::min(n, std::max<Eigen::Index>(2 * numModes, numModes + 20));
+    while (true)
+    {
+        Matrixd V(n, m);
+        Vectord alpha = Vectord::Zero(m);
+        Vectord beta  = Vectord::Zero(m);
+        Vectord v     = randomVector();
+        V.col(0) = v / std::sqrt(v.dot(M * v));
+        for (Eigen::Index j = 0; j < m; j++)
+        {
+            Vectord w = solver.solve(M * V.col(j));
+            alpha[j] = w.dot(M * V.col(j));
+
+            // Full reorthogonalization, twice is enough
+            for (int pass = 0; pass < 2; pass++)
+            {
+                const Vectord Mw = M * w;
+                w.noalias() -= V.leftCols(j + 1) * (V.leftCols(j + 1).transpose() * Mw);
+            }
+            if (j + 1 == m)
+            {
+                beta[j] = std::sqrt(std::max(w.dot(M * w), 0.0));
+                break;
+            }
+
+            // On an invariant subspace continue with a new direction, T is then block diagonal
+            double norm = std::sqrt(std::max(w.dot(M * w), 0.0));
+            beta[j] = norm;
+            if (norm <= 1.0e-12 * std::abs(alpha[j]))
+            {
+                beta[j] = 0.0;
+                w       = randomVector();
+                for (int pass = 0; pass < 2; pass++)
+                {
+                    const Vectord Mw = M * w;
+                    w.noalias() -= V.leftCols(j + 1) * (V.leftCols(j + 1).transpose() * Mw);
+                }
+                norm = std::sqrt(w.dot(M * w));
+            }
+            V.col(j + 1) = w / norm;
+        }
+
+        Matrixd T = Matrixd::Zero(m, m);
+        T.diagonal() = alpha;
+        T.diagonal(1)  = beta.head(m - 1);
+        T.diagonal(-1) = beta.head(m - 1);
+        Eigen::SelfAdjointEigenSolver<Matrixd> tSolver(T);
+
+        // Ritz pairs of the largest thetas, the residual of each is beta_m times the last
+        // component of its eigenvector
+        bool converged = true;
+        modes.resize(n, numModes);
+        eigenvalues.resize(numModes);
+        for (int i = 0; i < numModes; i++)
+        {
+            const Eigen::Index k     = m - 1 - i;
+            const double       theta = tSolver.eigenvalues()[k];
+            if (std::abs(beta[m - 1] * tSolver.eigenvectors()(m - 1, k)) > 1.0e-8 * std::abs(theta))
+            {
+                converged = false;
+            }
+            modes.col(i)   = V * tSolver.eigenvectors().col(k);
+            eigenvalues[i] = shift + 1.0 / theta;
+        }
+        if (converged || m == n)
+        {
+            return true;
+        }
+        m = std::min(n, 2 * m);
+    }
+}
+
+bool
+ModalAnalysis::compute()
+{
+    CHECK(m_mesh != nullptr) << "ModalAnalysis requires a TetrahedralMesh";
+    m_loadedFromCache = false;
+
+    const uint64_t hash = computeHash();
+    if (!m_cacheFileName.empty() && loadCache(hash))
+    {
+        m_loadedFromCache = true;
+        return true;
+    }
+
+    auto          cubature = std::make_shared<ReducedStVKCubature>(m_mesh, m_youngsModulus, m_poissonRatio);
+    const int     numDofs  = 3 * m_mesh->getNumVertices();
+    SparseMatrixd K0;
+    SparseMatrixd M;
+    cubature->computeTangentStiffness(Vectord::Zero(numDofs), K0);
+    computeMassMatrix(m_mesh, m_density, M);
+
+    // Eliminate the fixed dofs
+    std::vector<int> dofMap(numDofs, 0);
+    for (const int id : m_fixedNodeIds)
+    {
+        dofMap[3 * id] = dofMap[3 * id + 1] = dofMap[3 * id + 2] = -1;
+    }
+    int numFree = 0;
+    for (int& dof : dofMap)
+    {
+        if (dof != -1)
+        {
+            dof = numFree++;
+        }
+    }
+    const SparseMatrixd K = restrictMatrix(K0, dofMap, numFree);
+    const SparseMatrixd Mf = restrictMatrix(M, dofMap, numFree);
+
+    // Free floating K is singular, shift below zero and drop the 6 rigid modes
+    const int numRigidModes = m_fixedNodeIds.empty() ? 6 : 0;
+    double    shift = 0.0;
+    if (numRigidModes > 0)
+    {
+        shift = -1.0e-4 * K.diagonal().mean() / Mf.diagonal().mean();
+    }
+
+    const int numLinearModes = (m_numModalDerivativeModes > 0) ? m_numModalDerivativeModes : m_numModes;
+    Matrixd   modes;
+    Vectord   eigenvalues;
+    if (!solveGeneralizedEigenproblem(K, Mf, numLinearModes + numRigidModes, shift, modes, eigenvalues))
+    {
+        return false;
+    }
+    modes       = modes.rightCols(numLinearModes).eval();
+    eigenvalues = eigenvalues.tail(numLinearModes).eval();
+
+    Matrixd basis = modes;
+    if (m_numModalDerivativeModes > 0)
+    {
+        // Modal derivatives solve K Psi_ij = -(dK/dq_i) phi_j. StVK stiffness is quadratic
+        // in the displacements so central differences of it are exact
+        const Eigen::SparseMatrix<double>                  A = K - shift * Mf;
+        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver(A);
+        const Matrixd                                      fullModes = prolongateMatrix(modes, dofMap);
+
+        const int numDerivatives = numLinearModes * (numLinearModes + 1) / 2;
+        Matrixd   X(numFree, numLinearModes + numDerivatives);
+        int       k = numLinearModes;
+        for (int i = 0; i < numLinearModes; i++)
+        {
+            SparseMatrixd Kp;
+            SparseMatrixd Km;
+            cubature->computeTangentStiffness(fullModes.col(i), Kp);
+            cubature->computeTangentStiffness(-fullModes.col(i), Km);
+            const SparseMatrixd dK = 0.5 * (Kp - Km);
+
+            // Weight by the frequencies, low modes and their derivatives dominate
+            X.col(i) = eigenvalues[0] / eigenvalues[i] * modes.col(i);
+            for (int j = i; j < numLinearModes; j++)
+            {
+                const Vectord rhs = -restrictVector(dK * fullModes.col(j), dofMap, numFree);
+                X.col(k++) = eigenvalues[0] * eigenvalues[0] / (eigenvalues[i] * eigenvalues[j]) * solver.solve(rhs);
+            }
+        }
+
+        // Mass-PCA of the weighted modes and derivatives, keep the largest components
+        const Matrixd                          G = X.transpose() * (Mf * X);
+        Eigen::SelfAdjointEigenSolver<Matrixd> gSolver(G);
+        const Eigen::Index                     c = G.rows();
+        std::vector<Eigen::Index>              components;
+        for (Eigen::Index i = c - 1; i >= 0 && static_cast<int>(components.size()) < m_numModes; i--)
+        {
+            if (gSolver.eigenvalues()[i] > 1.0e-12 * gSolver.eigenvalues()[c - 1])
+            {
+                components.push_back(i);
+            }
+        }
+        basis.resize(numFree, components.size());
+        for (size_t i = 0; i < components.size(); i++)
+        {
+            basis.col(i) = X * gSolver.eigenvectors().col(components[i]) / std::sqrt(gSolver.eigenvalues()[components[i]]);
+        }
+    }
+
+    m_basis       = prolongateMatrix(basis, dofMap);
+    m_eigenvalues = (m_basis.transpose() * (K0 * m_basis)).diagonal();
+
+    m_cubature = nullptr;
+    if (m_numCubaturePoses > 0)
+    {
+        cubature->setBasis(m_basis);
+        const double error = cubature->train(samplePoses(), m_maxNumCubatureElements, m_cubatureTolerance);
+        LOG(INFO) << "Trained cubature with " << cubature->getCubatureElements().size()
+                  << " elements, relative error " << error;
+        m_cubature = cubature;
+    }
+
+    if (!m_cacheFileName.empty())
+    {
+        saveCache(hash);
+    }
+    return true;
+}
+
+std::vector<Vectord>
+ModalAnalysis::samplePoses() const
+{
+    const VecDataArray<double, 3>& vertices = *m_mesh->getInitialVertexPositions();
+    Vec3d                          min      = Vec3d::Constant(IMSTK_DOUBLE_MAX);
+    Vec3d                          max      = Vec3d::Constant(IMSTK_DOUBLE_MIN);
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        min = min.cwiseMin(vertices[i]);
+        max = max.cwiseMax(vertices[i]);
+    }
+    const double maxDisplacement = m_cubaturePoseScale * (max - min).norm();
+
+    // Random directions, lower modes deform more
+    std::mt19937                     rng(0);
+    std::normal_distribution<double> normal;
+    std::vector<Vectord>             poses(m_numCubaturePoses);
+    for (int t = 0; t < m_numCubaturePoses; t++)
+    {
+        Vectord q(m_basis.cols());
+        for (Eigen::Index i = 0; i < q.size(); i++)
+        {
+            q[i] = normal(rng) / std::sqrt(std::max(m_eigenvalues[i], IMSTK_DOUBLE_EPS));
+        }
+        const Vectord u    = m_basis * q;
+        double        norm = 0.0;
+        for (Eigen::Index i = 0; i < u.size(); i += 3)
+        {
+            norm = std::max(norm, u.segment<3>(i).norm());
+        }
+        poses[t] = (norm > 0.0) ? (q * maxDisplacement * (t + 1) / (m_numCubaturePoses * norm)).eval() : q;
+    }
+    return poses;
+}
+
+uint64_t
+ModalAnalysis::computeHash() const
+{
+    uint64_t                 hash     = 0xCBF29CE484222325ull;
+    VecDataArray<double, 3>& vertices = *m_mesh->getInitialVertexPositions();
+    VecDataArray<int, 4>&    tets     = *m_mesh->getCells();
+    hashBytes(hash, vertices.getPointer(), sizeof(double) * 3 * vertices.size());
+    hashBytes(hash, tets.getPointer(), sizeof(int) * 4 * tets.size());
+    hashBytes(hash, m_fixedNodeIds.data(), sizeof(int) * m_fixedNodeIds.size());
+    hashValue(hash, m_youngsModulus);
+    hashValue(hash, m_poissonRatio);
+    hashValue(hash, m_density);
+    hashValue(hash, m_numModes);
+    hashValue(hash, m_numModalDerivativeModes);
+    hashValue(hash, m_numCubaturePoses);
+    hashValue(hash, m_maxNumCubatureElements);
+    hashValue(hash, m_cubatureTolerance);
+    hashValue(hash, m_cubaturePoseScale);
+    return hash;
+}
+
+bool
+ModalAnalysis::saveCache(const uint64_t hash) const
+{
+    std::ofstream file(m_cacheFileName, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        LOG(WARNING) << "Failed to open " << m_cacheFileName << " for writing";
+        return false;
+    }
+
+    const int32_t             numRows = static_cast<int32_t>(m_basis.rows());
+    const int32_t             numCols = static_cast<int32_t>(m_basis.cols());
+    const std::vector<int>    emptyElements;
+    const std::vector<double> emptyWeights;
+    const std::vector<int>&    elements = (m_cubature != nullptr) ? m_cubature->getCubatureElements() : emptyElements;
+    const std::vector<double>& weights  = (m_cubature != nullptr) ? m_cubature->getCubatureWeights() : emptyWeights;
+    const int32_t              numCubatureElements = (m_cubature != nullptr) ? static_cast<int32_t>(elements.size()) : -1;
+
+    file.write(Magic, sizeof(Magic));
+    file.write(reinterpret_cast<const char*>(&Version), sizeof(Version));
+    file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+    file.write(reinterpret_cast<const char*>(&numRows), sizeof(numRows));
+    file.write(reinterpret_cast<const char*>(&numCols), sizeof(numCols));
+    file.write(reinterpret_cast<const char*>(&numCubatureElements), sizeof(numCubatureElements));
+    file.write(reinterpret_cast<const char*>(m_basis.data()), sizeof(double) * m_basis.size());
+    file.write(reinterpret_cast<const char*>(m_eigenvalues.data()), sizeof(double) * m_eigenvalues.size());
+    file.write(reinterpret_cast<const char*>(elements.data()), sizeof(int) * elements.size());
+    file.write(reinterpret_cast<const char*>(weights.data()), sizeof(double) * weights.size());
+    if (!file)
+    {
+        LOG(WARNING) << "Failed to write " << m_cacheFileName;
+        return false;
+    }
+    return true;
+}
+
+bool
+ModalAnalysis::loadCache(const uint64_t hash)
+{
+    std::ifstream file(m_cacheFileName, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    char     magic[8];
+    uint32_t version = 0;
+    uint64_t fileHash = 0;
+    int32_t  numRows  = 0;
+    int32_t  numCols  = 0;
+    int32_t  numCubatureElements = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&fileHash), sizeof(fileHash));
+    file.read(reinterpret_cast<char*>(&numRows), sizeof(numRows));
+    file.read(reinterpret_cast<char*>(&numCols), sizeof(numCols));
+    file.read(reinterpret_cast<char*>(&numCubatureElements), sizeof(numCubatureElements));
+    if (!file || std::memcmp(magic, Magic, sizeof(Magic)) != 0 || version != Version)
+    {
+        LOG(WARNING) << "Invalid modal analysis cache " << m_cacheFileName;
+        return false;
+    }
+    // Stale, the mesh or parameters changed
+    if (fileHash != hash || numRows != 3 * m_mesh->getNumVertices() || numCols < 0)
+    {
+        return false;
+    }
+
+    Matrixd basis(numRows, numCols);
+    Vectord eigenvalues(numCols);
+    file.read(reinterpret_cast<char*>(basis.data()), sizeof(double) * basis.size());
+    file.read(reinterpret_cast<char*>(eigenvalues.data()), sizeof(double) * eigenvalues.size());
+    std::vector<int>    elements(std::max(numCubatureElements, 0));
+    std::vector<double> weights(elements.size());
+    file.read(reinterpret_cast<char*>(elements.data()), sizeof(int) * elements.size());
+    file.read(reinterpret_cast<char*>(weights.data()), sizeof(double) * weights.size());
+    if (!file)
+    {
+        LOG(WARNING) << "Truncated modal analysis cache " << m_cacheFileName;
+        return false;
+    }
+
+    m_basis       = basis;
+    m_eigenvalues = eigenvalues;
+    m_cubature    = nullptr;
+    if (numCubatureElements >= 0)
+    {
+        m_cubature = std::make_shared<ReducedStVKCubature>(m_mesh, m_youngsModulus, m_poissonRatio);
+        m_cubature->setBasis(m_basis);
+        m_cubature->setCubature(elements, weights);
+    }
+    return true;
+}
+} // namespace imstk
@@ -0,0 +1,167 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkMath.h"
+
+namespace imstk
+{
+class ReducedStVKCubature;
+class TetrahedralMesh;
+
+///
+/// \class ModalAnalysis
+///
+/// \brief Computes the reduced basis of a reduced StVK model for a tetrahedral mesh.
+///
+/// The linear modes are the lowest eigenvectors of the generalized problem K u = lambda M u
+/// of the rest stiffness and mass matrices, solved by shift-invert Lanczos. Without fixed
+/// nodes the 6 rigid modes are solved for and dropped. With modal derivatives (Barbic, James
+/// 2005) the derivatives of the linear modes are added and the basis is the mass-PCA of the
+/// weighted modes and derivatives. Cubature for the reduced forces is then trained on sampled
+/// poses of the basis, see ReducedStVKCubature.
+///
+/// The result can be cached in a binary file keyed on a hash of the mesh and parameters,
+/// compute then loads it instead when nothing changed.
+///
+class ModalAnalysis
+{
+public:
+    ModalAnalysis() = default;
+    virtual ~ModalAnalysis() = default;
+
+    ///
+    /// \brief Set the mesh to analyze
+    ///
+    void setMesh(std::shared_ptr<TetrahedralMesh> tetMesh) { m_mesh = tetMesh; }
+
+    ///
+    /// \brief Material of the mesh
+    ///@{
+    void setYoungsModulus(const double value) { m_youngsModulus = value; }
+    double getYoungsModulus() const { return m_youngsModulus; }
+    void setPoissonRatio(const double value) { m_poissonRatio = value; }
+    double getPoissonRatio() const { return m_poissonRatio; }
+    void setDensity(const double value) { m_density = value; }
+    double getDensity() const { return m_density; }
+    ///@}
+
+    ///
+    /// \brief Ids of the vertices fixed in place, none means free floating
+    ///
+    void setFixedNodeIds(const std::vector<int>& fixedNodeIds) { m_fixedNodeIds = fixedNodeIds; }
+
+    ///
+    /// \brief Size of the basis
+    ///
+    void setNumModes(const int value) { m_numModes = value; }
+    int getNumModes() const { return m_numModes; }
+
+    ///
+    /// \brief Number of linear modes whose derivatives are added, 0 to only use linear modes
+    ///
+    void setNumModalDerivativeModes(const int value) { m_numModalDerivativeModes = value; }
+    int getNumModalDerivativeModes() const { return m_numModalDerivativeModes; }
+
+    ///
+    /// \brief Cubature training, number of poses sampled, max number of elements and relative
+    /// force error to stop at. No poses skips the training
+    ///@{
+    void setNumCubaturePoses(const int value) { m_numCubaturePoses = value; }
+    int getNumCubaturePoses() const { return m_numCubaturePoses; }
+    void setMaxNumCubatureElements(const int value) { m_maxNumCubatureElements = value; }
+    int getMaxNumCubatureElements() const { return m_maxNumCubatureElements; }
+    void setCubatureTolerance(const double value) { m_cubatureTolerance = value; }
+    double getCubatureTolerance() const { return m_cubatureTolerance; }
+    ///@}
+
+    ///
+    /// \brief Largest vertex displacement of the training poses, relative to the mesh bounds
+    ///
+    void setCubaturePoseScale(const double value) { m_cubaturePoseScale = value; }
+    double getCubaturePoseScale() const { return m_cubaturePoseScale; }
+
+    ///
+    /// \brief File to cache the basis and cubature in, empty (default) to not cache
+    ///
+    void setCacheFileName(const std::string& value) { m_cacheFileName = value; }
+    const std::string& getCacheFileName() const { return m_cacheFileName; }
+
+    ///
+    /// \brief Compute or load from the cache the basis, and the cubature if requested
+    ///
+    bool compute();
+
+    ///
+    /// \brief Returns the basis, 3 * numVertices x numModes, mass orthonormal
+    ///
+    const Matrixd& getBasis() const { return m_basis; }
+
+    ///
+    /// \brief Returns the Rayleigh quotient of each basis vector, the squared angular frequencies
+    ///
+    const Vectord& getEigenvalues() const { return m_eigenvalues; }
+
+    ///
+    /// \brief Returns the cubature trained for the basis, nullptr if not trained
+    ///
+    std::shared_ptr<ReducedStVKCubature> getCubature() const { return m_cubature; }
+
+    ///
+    /// \brief Returns if the last compute loaded the cache
+    ///
+    bool getLoadedFromCache() const { return m_loadedFromCache; }
+
+    ///
+    /// \brief Assemble the consistent mass matrix of the mesh
+    ///
+    static void computeMassMatrix(std::shared_ptr<TetrahedralMesh> tetMesh, const double density, SparseMatrixd& M);
+
+    ///
+    /// \brief Solve the numModes generalized eigenpairs of K u = lambda M u closest above the
+    /// shift, with shift-invert Lanczos and full reorthogonalization. K - shift * M must be
+    /// positive definite. Eigenvalues are ascending, the modes mass orthonormal
+    ///
+    static bool solveGeneralizedEigenproblem(const SparseMatrixd& K, const SparseMatrixd& M,
+                                             const int numModes, const double shift,
+                                             Matrixd& modes, Vectord& eigenvalues);
+
+protected:
+    ///
+    /// \brief Hash of the mesh and parameters the cache is keyed on
+    ///
+    uint64_t computeHash() const;
+
+    bool saveCache(const uint64_t hash) const;
+    bool loadCache(const uint64_t hash);
+
+    ///
+    /// \brief Sample the cubature training poses, random directions weighted by the
+    /// inverse frequencies with magnitudes ramping up to the pose scale
+    ///
+    std::vector<Vectord> samplePoses() const;
+
+    std::shared_ptr<TetrahedralMesh> m_mesh;
+    double m_youngsModulus = 1.0e7;
+    double m_poissonRatio  = 0.4;
+    double m_density       = 1000.0;
+    std::vector<int> m_fixedNodeIds;
+
+    int    m_numModes = 20;
+    int    m_numModalDerivativeModes = 0;
+    int    m_numCubaturePoses       = 100;
+    int    m_maxNumCubatureElements = 300;
+    double m_cubatureTolerance      = 0.01;
+    double m_cubaturePoseScale      = 0.1;
+    std::string m_cacheFileName     = "";
+
+    Matrixd m_basis;
+    Vectord m_eigenvalues;
+    std::shared_ptr<ReducedStVKCubature> m_cubature;
+    bool m_loadedFromCache = false;
+};
+} // namespace imstk
@@ -12,6 +12,7 @@
 #include "imstkParallelUtils.h"
 #include "imstkPbdConstraintFunctor.h"
 #include "imstkPbdModelConfig.h"
+#include "imstkPbdSinglePrecisionSolver.h"
 #include "imstkPbdSolver.h"
 #include "imstkTaskGraph.h"
 
@@ -76,6 +77,8 @@ void
 PbdModel::resetToInitialState()
 {
     m_state.deepCopy(m_initialState);
+    m_history.clear();
+    m_rewound = false;
 
     // Set previous particle positions, orientations to current to avoid a jump
     for (auto bodyIter = m_state.m_bodies.begin();
@@ -221,8 +224,17 @@ PbdModel::initialize()
     // Setup the default pbd solver if none exists
     if (m_pbdSolver == nullptr)
     {
-        m_pbdSolver = std::make_shared<PbdSolver>();
+        if (m_config->m_singlePrecision)
+        {
+            m_pbdSolver = std::make_shared<PbdSinglePrecisionSolver>();
+        }
+        else
+        {
+            m_pbdSolver = std::make_shared<PbdSolver>();
+        }
     }
+    // The constraints were regenerated
+    m_pbdSolver->invalidate();
 
     if (m_config->m_dataTracker)
     {
@@ -230,6 +242,7 @@ PbdModel::initialize()
         m_config->m_dataTracker->configureProbe(DataTracker::Physics::SolverTime_ms, DataTracker::ePhysics::SolverTime_ms);
         m_config->m_dataTracker->configureProbe(DataTracker::Physics::NumConstraints, DataTracker::ePhysics::NumConstraints);
         m_config->m_dataTracker->configureProbe(DataTracker::Physics::AverageC, DataTracker::ePhysics::AverageC);
+        m_config->m_dataTracker->configureProbe(DataTracker::Physics::NumIterations, DataTracker::ePhysics::NumIterations);
     }
 
     return true;
@@ -261,6 +274,42 @@ PbdModel::addConstraints(std::shared_ptr<std::unordered_set<size_t>> vertices, c
             }
         }
     }
+    invalidateConstraints();
+}
+
+void
+PbdModel::removeConstraints(std::shared_ptr<std::unordered_set<size_t>> vertices, const int bodyId)
+{
+    m_constraints->removeConstraints(vertices, bodyId);
+    invalidateConstraints();
+}
+
+void
+PbdModel::invalidateConstraints()
+{
+    if (m_pbdSolver != nullptr)
+    {
+        m_pbdSolver->invalidate();
+    }
+}
+
+bool
+PbdModel::rewind(const size_t numSteps)
+{
+    if (numSteps == 0)
+    {
+        return false;
+    }
+
+    // The latest state of the history is the start of the last step, unless
+    // that step was undone already
+    clearVirtualParticles();
+    if (!m_history.rewind(m_state, m_rewound ? numSteps : numSteps - 1))
+    {
+        return false;
+    }
+    m_rewound = true;
+    return true;
 }
 
 void
@@ -280,6 +329,14 @@ PbdModel::integratePosition()
 {
     // resize 0 virtual particles (avoids reallocation)
     clearVirtualParticles();
+    m_stepCount++;
+
+    // Record the state at the start of the step, it's already the latest if the last step was undone
+    if (!m_rewound)
+    {
+        m_history.push(m_state);
+    }
+    m_rewound = false;
 
     // There are two virtual particles buffer, skip the first two
     for (auto bodyIter = std::next(std::next(m_state.m_bodies.begin()));
@@ -457,6 +514,11 @@ PbdModel::solveConstraints()
     m_pbdSolver->setTimeStep(m_config->m_dt);
     m_pbdSolver->setIterations(m_config->m_iterations);
     m_pbdSolver->setSolverType(m_config->m_solverType);
+    m_pbdSolver->setSolverMode(m_config->m_solverMode);
+    m_pbdSolver->setJacobiRelaxation(m_config->m_jacobiRelaxation);
+    m_pbdSolver->setMinIterations(m_config->m_minIterations);
+    m_pbdSolver->setConvergenceCriterion(m_config->m_convergenceCriterion);
+    m_pbdSolver->setConvergenceTolerance(m_config->m_convergenceTolerance);
     m_pbdSolver->solve();
 }
 
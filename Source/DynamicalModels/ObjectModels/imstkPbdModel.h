@@ -9,6 +9,7 @@
 #include "imstkAbstractDynamicalModel.h"
 #include "imstkPbdBody.h"
 #include "imstkPbdConstraint.h"
+#include "imstkPbdStateHistory.h"
 
 #include <unordered_map>
 #include <unordered_set>
@@ -65,6 +66,31 @@ public:
 
     PbdState& getBodies() { return m_state; }
 
+    ///
+    /// \brief Save/Restore the dynamic state of all bodies (positions, velocities, orientations, ...)
+    /// Restoring fails if bodies or particles were added or removed since saving
+    ///@{
+    void saveSnapshot(PbdStateSnapshot& snapshot) const { snapshot.save(m_state); }
+    bool restoreSnapshot(const PbdStateSnapshot& snapshot) { return snapshot.restore(m_state); }
+    ///@}
+
+    ///
+    /// \brief Get the history of the last steps. The state is pushed to it at the start of
+    /// every step once given a capacity, see PbdStateHistory::setCapacity
+    ///
+    PbdStateHistory& getHistory() { return m_history; }
+
+    ///
+    /// \brief Undo the last numSteps steps using the history, returns false if not enough
+    /// were recorded. Clears the non persistent virtual particles
+    ///
+    bool rewind(const size_t numSteps = 1);
+
+    ///
+    /// \brief Get the number of steps integrated so far, ie: to age data kept across steps
+    ///
+    size_t getStepCount() const { return m_stepCount; }
+
     ///
     /// \brief Add a particle to a virtual pool/buffer of particles for quick removal/insertion
     /// The persist flag indicates if it should be cleared at the end of the frame or not
@@ -102,6 +128,18 @@ public:
     ///
     void addConstraints(std::shared_ptr<std::unordered_set<size_t>> vertices, const int bodyId);
 
+    ///
+    /// \brief Removes all constraints associated with the vertices of the body, useful for
+    /// topology changes
+    ///
+    void removeConstraints(std::shared_ptr<std::unordered_set<size_t>> vertices, const int bodyId);
+
+    ///
+    /// \brief Tells the solver the constraints changed, call after adding, removing or changing
+    /// the parameters (stiffness, rest values, ...) of constraints directly in the container
+    ///
+    void invalidateConstraints();
+
     void setTimeStep(const double timeStep) override;
     double getTimeStep() const override;
 
@@ -181,6 +219,9 @@ protected:
 
     PbdState m_initialState;
     PbdState m_state;
+    PbdStateHistory m_history;   ///< Last steps for rewinding, disabled by default
+    bool m_rewound = false;      ///< The state is the latest of the history, the step was undone
+    size_t m_stepCount = 0;      ///< Number of steps integrated
 
     std::shared_ptr<PbdSolver>      m_pbdSolver = nullptr;     ///< PBD solver
     std::shared_ptr<PbdModelConfig> m_config    = nullptr;     ///< Model parameters, must be set before simulation
@@ -9,6 +9,7 @@
 #include "imstkPbdCollisionConstraint.h"
 #include "imstkPbdFemConstraint.h"
 #include "imstkPbdConstraintFunctor.h"
+#include "imstkPbdSolver.h"
 #include "imstkDataTracker.h"
 
 #include <unordered_map>
@@ -128,7 +129,11 @@ public:
     double m_linearDampingCoeff  = 0.01;      ///< Damping coefficient applied to linear velocity [0, 1]
     double m_angularDampingCoeff = 0.01;      ///< Damping coefficient applied to angular velcoity [0, 1]
 
-    unsigned int m_iterations = 10;           ///< Internal constraints pbd solver iterations
+    unsigned int m_iterations = 10;           ///< Internal constraints pbd solver iterations, max iterations if a convergence criterion is used
+    unsigned int m_minIterations = 1;         ///< Iterations run before convergence is checked
+
+    PbdSolver::ConvergenceCriterion m_convergenceCriterion = PbdSolver::ConvergenceCriterion::None; ///< Residual measure for early termination
+    double m_convergenceTolerance = 1.0e-6;   ///< Residual at which the solver stops iterating
     double       m_dt     = 0.01;             ///< Time step size
     bool m_doPartitioning = true;             ///< Does graph coloring to solve in parallel
 
@@ -145,6 +150,13 @@ public:
 
     PbdConstraint::SolverType m_solverType = PbdConstraint::SolverType::xPBD;
 
+    ///< Gauss-Seidel (with partitioning for parallelism) or Jacobi, Jacobi doesn't require m_doPartitioning
+    PbdSolver::SolverMode m_solverMode = PbdSolver::SolverMode::GaussSeidel;
+    double m_jacobiRelaxation = 1.0;        ///< Scales the averaged Jacobi corrections, only used with Jacobi
+
+    ///< Project the common deformable body constraints in float (see PbdSinglePrecisionSolver), used when no solver is set
+    bool m_singlePrecision = false;
+
     std::unordered_map<int, double> m_bodyLinearDampingCoeff;  ///< Per body linear damping, Body id -> linear damping for given body [0, 1]
     std::unordered_map<int, double> m_bodyAngularDampingCoeff; ///< Per body angular damping, Body id -> angular damping for given body [0, 1]
 
@@ -23,11 +23,16 @@
 #include <fstream>
 #include <ios>
 #include <iomanip>
+#include <numeric>
 
 // imstk
 #include "imstkMath.h"
+#include "imstkModalAnalysis.h"
 #include "imstkNewtonSolver.h"
+#include "imstkParallelFor.h"
 #include "imstkReducedStVKBodyModel.h"
+#include "imstkReducedStVKCubature.h"
+#include "imstkTetrahedralMesh.h"
 #include "imstkTimeIntegrator.h"
 #include "imstkVegaMeshIO.h"
 #include "imstkVolumetricMesh.h"
@@ -37,7 +42,6 @@
 // vega
 #include "StVKReducedInternalForces.h"
 #include "matrixIO.h"
-#include "modalMatrix.h"
 #include "reducedStVKForceModel.h"
 
 #pragma warning(push)
@@ -181,13 +185,23 @@ ReducedStVK::initialize()
         setSolver(nlSolver);
     }
 
-    // This will specify \p m_numDOF and \p m_numDOFReduced
-    this->readModalMatrix(m_config->m_modesFileName);
+    // This will specify \p m_numDof and \p m_numDOFReduced
+    if (m_config->m_modesFileName.empty())
+    {
+        if (!this->computeModalBasis())
+        {
+            return false;
+        }
+    }
+    else
+    {
+        this->readModalMatrix(m_config->m_modesFileName);
+    }
     this->loadInitialStates();
 
     auto physicsMesh = std::dynamic_pointer_cast<imstk::VolumetricMesh>(this->getModelGeometry());
     m_vegaPhysicsMesh = VegaMeshIO::convertVolumetricMeshToVegaMesh(physicsMesh);
-    CHECK(m_numDOF == m_vegaPhysicsMesh->getNumVertices() * 3);
+    CHECK(m_numDof == m_vegaPhysicsMesh->getNumVertices() * 3);
 
     if (!this->initializeForceModel() || !this->initializeMassMatrix()
         || !this->initializeTangentStiffness() || !this->initializeDampingMatrix()
@@ -207,9 +221,9 @@ ReducedStVK::initialize()
     m_FexplicitExternalReduced.resize(m_numDOFReduced);
 
     // full-space variable
-    m_Fcontact.resize(m_numDOF);
+    m_Fcontact.resize(m_numDof);
     m_Fcontact.setConstant(0.0);
-    m_qSol.resize(m_numDOF);
+    m_qSol.resize(m_numDof);
     m_qSol.setConstant(0.0);
 
     return true;
@@ -221,32 +235,70 @@ ReducedStVK::readModalMatrix(const std::string& fname)
     std::vector<float> Ufloat;
     int                m, n;
     vega::ReadMatrixFromDisk_(fname.c_str(), m, n, Ufloat);
-    m_numDOF = m;
+    m_numDof = m;
     m_numDOFReduced = n;
-    std::vector<double> Udouble(Ufloat.size());
 
-    for (size_t i = 0; i < Ufloat.size(); ++i)
+    // Vega matrices are column-major
+    m_U = Eigen::Map<Eigen::MatrixXf>(Ufloat.data(), m, n).cast<double>();
+    return;
+}
+
+bool
+ReducedStVK::computeModalBasis()
+{
+    auto tetMesh = std::dynamic_pointer_cast<TetrahedralMesh>(m_geometry);
+    if (tetMesh == nullptr)
+    {
+        LOG(WARNING) << "Computing the basis requires a TetrahedralMesh, set a modes file instead";
+        return false;
+    }
+
+    ModalAnalysis analysis;
+    analysis.setMesh(tetMesh);
+    analysis.setYoungsModulus(m_config->m_youngModulus);
+    analysis.setPoissonRatio(m_config->m_poissonRatio);
+    analysis.setDensity(m_config->m_density);
+    analysis.setFixedNodeIds(std::vector<int>(m_fixedNodeIds.begin(), m_fixedNodeIds.end()));
+    analysis.setNumModes(m_config->m_numModes);
+    analysis.setNumModalDerivativeModes(m_config->m_numModalDerivativeModes);
+    analysis.setNumCubaturePoses(m_config->m_numCubaturePoses);
+    analysis.setMaxNumCubatureElements(m_config->m_maxNumCubatureElements);
+    analysis.setCubatureTolerance(m_config->m_cubatureTolerance);
+    analysis.setCacheFileName(m_config->m_modalCacheFileName);
+    if (!analysis.compute())
     {
-        Udouble[i] = Ufloat[i];
+        return false;
     }
 
-    m_modalMatrix =
-        std::make_shared<vega::ModalMatrix>(m_numDOF / 3, m_numDOFReduced, Udouble.data());
-    return;
+    m_U = analysis.getBasis();
+    m_numDof = m_U.rows();
+    m_numDOFReduced = m_U.cols();
+
+    // Without cubature every element is evaluated with unit weight, the exact reduced forces
+    m_cubature = analysis.getCubature();
+    if (m_cubature == nullptr)
+    {
+        m_cubature = std::make_shared<ReducedStVKCubature>(tetMesh, m_config->m_youngModulus, m_config->m_poissonRatio);
+        m_cubature->setBasis(m_U);
+        std::vector<int> elements(m_cubature->getNumElements());
+        std::iota(elements.begin(), elements.end(), 0);
+        m_cubature->setCubature(elements, std::vector<double>(elements.size(), 1.0));
+    }
+    return true;
 }
 
 void
 ReducedStVK::loadInitialStates()
 {
-    if (m_numDOF == 0 || m_numDOFReduced == 0)
+    if (m_numDof == 0 || m_numDOFReduced == 0)
     {
         LOG(WARNING) << "Num. of degree of freedom is zero!";
     }
 
     // For now the initial states are set to zero
-    m_initialState  = std::make_shared<kinematicState>(m_numDOF);
-    m_previousState = std::make_shared<kinematicState>(m_numDOF);
-    m_currentState  = std::make_shared<kinematicState>(m_numDOF);
+    m_initialState  = std::make_shared<kinematicState>(m_numDof);
+    m_previousState = std::make_shared<kinematicState>(m_numDof);
+    m_currentState  = std::make_shared<kinematicState>(m_numDof);
 
     m_initialStateReduced  = std::make_shared<kinematicState>(m_numDOFReduced);
     m_previousStateReduced = std::make_shared<kinematicState>(m_numDOFReduced);
@@ -256,8 +308,11 @@ ReducedStVK::loadInitialStates()
 bool
 ReducedStVK::initializeForceModel()
 {
-    const double g = m_config->m_gravity;
-    const bool   isGravityPresent = (g > 0) ? true : false;
+    // The built-in basis comes with its cubature
+    if (m_cubature != nullptr)
+    {
+        return true;
+    }
 
     // m_numDOFReduced = m_config->r;
     m_internalForceModel = std::make_shared<vega::StVKReducedInternalForces>(
@@ -307,21 +362,19 @@ ReducedStVK::initializeDampingMatrix()
 bool
 ReducedStVK::initializeTangentStiffness()
 {
-    CHECK(m_forceModel != nullptr)
+    CHECK(m_forceModel != nullptr || m_cubature != nullptr)
         << "Tangent stiffness cannot be initialized without force model";
 
     this->m_stiffnessMatrix.resize(m_numDOFReduced * m_numDOFReduced, 0.0);
-    m_forceModel->GetTangentStiffnessMatrix(m_initialStateReduced->getQ().data(),
-                                            m_stiffnessMatrix.data());
     this->m_K.resize(m_numDOFReduced, m_numDOFReduced);
-    this->initializeEigenMatrixFromStdVector(m_stiffnessMatrix, m_K);
+    this->updateTangentStiffness(m_initialStateReduced->getQ());
     return true;
 }
 
 bool
 ReducedStVK::initializeGravityForce()
 {
-    m_Fgravity.resize(m_numDOF);
+    m_Fgravity.resize(m_numDof);
     const double gravity = m_config->m_gravity;
 
     m_vegaPhysicsMesh->computeGravity(m_Fgravity.data(), gravity);
@@ -342,8 +395,7 @@ ReducedStVK::computeImplicitSystemRHS(kinematicState&       stateAtT,
     const auto& v     = newState.getQDot();
 
     // Do checks if there are uninitialized matrices
-    m_forceModel->GetTangentStiffnessMatrix(u.data(), m_stiffnessMatrix.data());
-    this->initializeEigenMatrixFromStdVector(m_stiffnessMatrix, m_K);
+    this->updateTangentStiffness(u);
 
     const double dT = m_timeIntegrator->getTimestepSize();
 
@@ -358,7 +410,7 @@ ReducedStVK::computeImplicitSystemRHS(kinematicState&       stateAtT,
             m_Feff -= m_C * v;
         }
 
-        m_forceModel->GetInternalForce(u.data(), m_Finternal.data());
+        this->computeReducedInternalForce(u, m_Finternal);
         m_Feff -= m_Finternal;
         this->project(m_FexplicitExternal, m_FexplicitExternalReduced);
         m_Feff += m_FexplicitExternalReduced;
@@ -387,8 +439,7 @@ ReducedStVK::computeSemiImplicitSystemRHS(kinematicState&       stateAtT,
     // auto& v     = newState.getQDot();
 
     // Do checks if there are uninitialized matrices
-    m_forceModel->GetTangentStiffnessMatrix(u.data(), m_stiffnessMatrix.data());
-    this->initializeEigenMatrixFromStdVector(m_stiffnessMatrix, m_K);
+    this->updateTangentStiffness(u);
 
     const double dT = m_timeIntegrator->getTimestepSize();
 
@@ -403,7 +454,7 @@ ReducedStVK::computeSemiImplicitSystemRHS(kinematicState&       stateAtT,
             m_Feff -= m_C * vPrev;
         }
 
-        m_forceModel->GetInternalForce(u.data(), m_Finternal.data());
+        this->computeReducedInternalForce(u, m_Finternal);
         m_Feff -= m_Finternal;
         this->project(m_FexplicitExternal, m_FexplicitExternalReduced);
         m_Feff += m_FexplicitExternalReduced;
@@ -435,9 +486,7 @@ ReducedStVK::computeImplicitSystemLHS(const kinematicState& stateAtT,
                        // ignored)
 
         this->updateMassMatrix();
-        m_forceModel->GetTangentStiffnessMatrix(newState.getQ().data(),
-                                                    m_stiffnessMatrix.data());
-        this->initializeEigenMatrixFromStdVector(m_stiffnessMatrix, m_K);
+        this->updateTangentStiffness(newState.getQ());
         this->updateDampingMatrix();
 
         m_Keff = m_M;
@@ -457,7 +506,7 @@ ReducedStVK::computeImplicitSystemLHS(const kinematicState& stateAtT,
 bool
 ReducedStVK::initializeExplicitExternalForces()
 {
-    m_FexplicitExternal.resize(m_numDOF);
+    m_FexplicitExternal.resize(m_numDof);
     m_FexplicitExternal.setZero();
     m_FexplicitExternalReduced.resize(m_numDOFReduced);
     m_FexplicitExternalReduced.setZero();
@@ -661,11 +710,51 @@ ReducedStVK::getTimeStep() const
     return m_timeIntegrator->getTimestepSize();
 };
 
+void
+ReducedStVK::computeReducedInternalForce(const Vectord& q, Vectord& f)
+{
+    if (m_cubature != nullptr)
+    {
+        m_cubature->computeReducedInternalForce(q, f);
+    }
+    else
+    {
+        m_forceModel->GetInternalForce(const_cast<double*>(q.data()), f.data());
+    }
+}
+
+void
+ReducedStVK::updateTangentStiffness(const Vectord& q)
+{
+    if (m_cubature != nullptr)
+    {
+        // Matrixd is column-major like the vega matrix
+        m_cubature->computeReducedTangentStiffness(q, m_K);
+        std::copy(m_K.data(), m_K.data() + m_K.size(), m_stiffnessMatrix.begin());
+    }
+    else
+    {
+        m_forceModel->GetTangentStiffnessMatrix(const_cast<double*>(q.data()), m_stiffnessMatrix.data());
+        this->initializeEigenMatrixFromStdVector(m_stiffnessMatrix, m_K);
+    }
+}
+
 void
 ReducedStVK::prolongate(const Vectord& uReduced, Vectord& u) const
 {
-    //\todo: check sizes
-    m_modalMatrix->AssembleVector(const_cast<double*>(uReduced.data()), u.data());
+    CHECK(uReduced.size() == m_U.cols()) << "Reduced vector doesn't match the basis";
+
+    // Rows are independent, prolongate blocks of vertices in parallel
+    const Eigen::Index blockSize = 3 * 1024;
+    const Eigen::Index numBlocks = (m_U.rows() + blockSize - 1) / blockSize;
+    u.resize(m_U.rows());
+    ParallelUtils::parallelFor(numBlocks,
+        [&](const Eigen::Index i)
+        {
+            const Eigen::Index start = i * blockSize;
+            const Eigen::Index size  = std::min(blockSize, m_U.rows() - start);
+            u.segment(start, size).noalias() = m_U.middleRows(start, size) * uReduced;
+        }, numBlocks > 1);
 }
 
 void
@@ -678,7 +767,7 @@ ReducedStVK::prolongate(kinematicState& uReduced, kinematicState& u) const
 void
 ReducedStVK::project(const Vectord& u, Vectord& uReduced) const
 {
-    m_modalMatrix->ProjectVector(const_cast<double*>(u.data()), uReduced.data());
+    uReduced.noalias() = m_U.transpose() * u;
 }
 
 void
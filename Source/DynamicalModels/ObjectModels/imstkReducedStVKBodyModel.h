@@ -33,12 +33,12 @@ namespace vega
 class VolumetricMesh;
 class ReducedStVKForceModel;
 class StVKReducedInternalForces;
-class ModalMatrix;
 } // namespace vega
 
 namespace imstk
 {
 class InternalForceModel;
+class ReducedStVKCubature;
 class SolverBase;
 class TaskNode;
 class TimeIntegrator;
@@ -50,6 +50,18 @@ struct ReducedStVKConfig
     std::string m_modesFileName;
     // int         r;
 
+    // Without a modes file the basis and cubature are computed from the TetrahedralMesh,
+    // see ModalAnalysis. The fixed nodes of the model are fixed in the basis
+    double      m_youngModulus = 1.0e7;
+    double      m_poissonRatio = 0.4;
+    double      m_density      = 1000.0;
+    int         m_numModes     = 20;
+    int         m_numModalDerivativeModes = 0; ///< Linear modes to add derivatives of, 0 for none
+    int         m_numCubaturePoses       = 100; ///< 0 evaluates every element instead of cubature
+    int         m_maxNumCubatureElements = 300;
+    double      m_cubatureTolerance      = 0.01;
+    std::string m_modalCacheFileName;           ///< Caches the basis and cubature, empty for none
+
     double m_dampingMassCoefficient      = 0.1;
     double m_dampingStiffnessCoefficient = 0.01;
     double m_dampingLaplacianCoefficient = 0.0;
@@ -299,11 +311,21 @@ public:
     ///
     void project(const Vectord& u, Vectord& uReduced) const;
     ///
-    /// \brief Read in the basis file and create m_modalMatrix
+    /// \brief Read in the basis file into m_U
     /// \todo: make it private/protected?
     ///
     void readModalMatrix(const std::string& fname);
 
+    ///
+    /// \brief Compute the basis and cubature of the TetrahedralMesh, when no basis file is given
+    ///
+    bool computeModalBasis();
+
+    ///
+    /// \brief Returns the basis, full = U * reduced
+    ///
+    const Matrixd& getBasis() const { return m_U; }
+
     std::shared_ptr<TaskNode> getSolveNode() const { return m_solveNode; }
 
     std::shared_ptr<SolverBase> getSolver() const { return m_solver; }
@@ -315,13 +337,24 @@ protected:
     ///
     void initGraphEdges(std::shared_ptr<TaskNode> source, std::shared_ptr<TaskNode> sink) override;
 
+    ///
+    /// \brief Reduced internal forces of the reduced displacements q, with the cubature or vega
+    ///
+    void computeReducedInternalForce(const Vectord& q, Vectord& f);
+
+    ///
+    /// \brief Update m_stiffnessMatrix and m_K to the reduced displacements q
+    ///
+    void updateTangentStiffness(const Vectord& q);
+
 protected:
     std::shared_ptr<SolverBase> m_solver = nullptr;
     std::shared_ptr<vega::StVKReducedInternalForces> m_internalForceModel; ///> Mathematical model for intenal forces
     std::shared_ptr<vega::ReducedStVKForceModel>     m_forceModel;
     std::shared_ptr<TimeIntegrator> m_timeIntegrator;                      ///> Time integrator
     std::shared_ptr<NonLinearSystem<Matrixd>> m_nonLinearSystem;           ///> Nonlinear system resulting from TI and force model
-    std::shared_ptr<vega::ModalMatrix> m_modalMatrix;
+    std::shared_ptr<ReducedStVKCubature> m_cubature;                   ///> Force model of a built-in basis
+    Matrixd m_U;                                                       ///> Basis, 3 * numVertices x r
 
     std::shared_ptr<ReducedStVKConfig> m_config;
 
@@ -10,6 +10,8 @@
 #include "imstkTaskGraph.h"
 #include "imstkVTKMeshIO.h"
 
+#include <numeric>
+
 namespace imstk
 {
 SphModelConfig::SphModelConfig(const double particleRadius)
@@ -153,9 +155,14 @@ SphModel::initialize()
     // Initialize simulation dependent parameters and kernel data
     m_kernels.initialize(m_modelParameters->m_kernelRadius);
 
-    // Initialize neighbor searcher
-    m_neighborSearcher = std::make_shared<NeighborSearch>(m_modelParameters->m_neighborSearchMethod,
-      m_modelParameters->m_kernelRadius);
+    // Initialize neighbor searcher, Verlet lists search up to the skin
+    const double searchRadius = m_modelParameters->m_bUseVerletLists ?
+                                m_modelParameters->m_kernelRadius * (1.0 + m_modelParameters->m_verletSkinOverKernelRadiusRatio) :
+                                m_modelParameters->m_kernelRadius;
+    m_neighborSearcher = std::make_shared<NeighborSearch>(m_modelParameters->m_neighborSearchMethod, searchRadius);
+    m_verletPositions     = nullptr;
+    m_verletDisplacements = std::make_shared<VecDataArray<double, 3>>(numParticles);
+    m_numNeighborRebuilds = 0;
 
     m_pressureAccels = std::make_shared<VecDataArray<double, 3>>(numParticles);
     std::fill_n(m_pressureAccels->getPointer(), m_pressureAccels->size(), Vec3d(0, 0, 0));
@@ -173,10 +180,14 @@ SphModel::initialize()
     m_particleShift = std::make_shared<VecDataArray<double, 3>>(numParticles);
     std::fill_n(m_particleShift->getPointer(), m_particleShift->size(), Vec3d(0, 0, 0));
 
+    m_pressures = std::make_shared<DataArray<double>>(numParticles);
+    std::fill_n(m_pressures->getPointer(), m_pressures->size(), 0.0);
+
     // Add all the attributes to the geometry
     m_pointSetGeometry->setVertexAttribute("Pressure Accels", m_pressureAccels);
     m_pointSetGeometry->setVertexAttribute("Surface Tension Accels", m_surfaceTensionAccels);
     m_pointSetGeometry->setVertexAttribute("Viscous Accels", m_viscousAccels);
+    m_pointSetGeometry->setVertexAttribute("Pressures", m_pressures);
     m_pointSetGeometry->setVertexAttribute("Densities", m_currentState->getDensities());
     m_pointSetGeometry->setVertexAttribute("Velocities", m_currentState->getVelocities());
     m_pointSetGeometry->setVertexAttribute("Diffuse Velocities", m_currentState->getDiffuseVelocities());
@@ -195,16 +206,32 @@ SphModel::initGraphEdges(std::shared_ptr<TaskNode> source, std::shared_ptr<TaskN
     m_taskGraph->addEdge(m_computeDensityNode, m_normalizeDensityNode);
     m_taskGraph->addEdge(m_normalizeDensityNode, m_collectNeighborDensityNode);
 
-    // Pressure, Surface Tension, and time step size can be done in parallel
-    m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computePressureAccelNode);
-    m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computeSurfaceTensionNode);
-    m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computeViscosityNode);
-    m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computeTimeStepSizeNode);
+    if (m_modelParameters->m_pressureSolverType == SphModelConfig::PressureSolverType::Implicit)
+    {
+        // The implicit pressures depend on the other forces and the time step size
+        m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computeSurfaceTensionNode);
+        m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computeViscosityNode);
+        m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computeTimeStepSizeNode);
 
-    m_taskGraph->addEdge(m_computePressureAccelNode, m_integrateNode);
-    m_taskGraph->addEdge(m_computeSurfaceTensionNode, m_integrateNode);
-    m_taskGraph->addEdge(m_computeViscosityNode, m_integrateNode);
-    m_taskGraph->addEdge(m_computeTimeStepSizeNode, m_integrateNode);
+        m_taskGraph->addEdge(m_computeSurfaceTensionNode, m_computePressureAccelNode);
+        m_taskGraph->addEdge(m_computeViscosityNode, m_computePressureAccelNode);
+        m_taskGraph->addEdge(m_computeTimeStepSizeNode, m_computePressureAccelNode);
+
+        m_taskGraph->addEdge(m_computePressureAccelNode, m_integrateNode);
+    }
+    else
+    {
+        // Pressure, Surface Tension, and time step size can be done in parallel
+        m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computePressureAccelNode);
+        m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computeSurfaceTensionNode);
+        m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computeViscosityNode);
+        m_taskGraph->addEdge(m_collectNeighborDensityNode, m_computeTimeStepSizeNode);
+
+        m_taskGraph->addEdge(m_computePressureAccelNode, m_integrateNode);
+        m_taskGraph->addEdge(m_computeSurfaceTensionNode, m_integrateNode);
+        m_taskGraph->addEdge(m_computeViscosityNode, m_integrateNode);
+        m_taskGraph->addEdge(m_computeTimeStepSizeNode, m_integrateNode);
+    }
 
     m_taskGraph->addEdge(m_integrateNode, m_updateVelocityNode);
     m_taskGraph->addEdge(m_updateVelocityNode, m_moveParticlesNode);
@@ -222,9 +249,11 @@ SphModel::computeCFLTimeStepSize()
 {
     auto maxVel = ParallelUtils::findMaxL2Norm(*getCurrentState()->getFullStepVelocities());
 
-    // dt = CFL * 2r / (speed of sound + max{|| v ||})
+    // dt = CFL * 2r / (speed of sound + max{|| v ||}), incompressible fluids have no sound speed limit
+    const double speedOfSound =
+        (m_modelParameters->m_pressureSolverType == SphModelConfig::PressureSolverType::Implicit) ? 0.0 : m_modelParameters->m_speedOfSound;
     double timestep = maxVel > 1.0e-6 ?
-                      m_modelParameters->m_cflFactor * (2.0 * m_modelParameters->m_particleRadius / (m_modelParameters->m_speedOfSound + maxVel)) :
+                      m_modelParameters->m_cflFactor * (2.0 * m_modelParameters->m_particleRadius / (speedOfSound + maxVel)) :
                       m_modelParameters->m_maxTimestep;
 
     // clamp the time step size to be within a given range
@@ -242,6 +271,13 @@ SphModel::computeCFLTimeStepSize()
 void
 SphModel::findParticleNeighbors()
 {
+    if (m_modelParameters->m_bUseVerletLists)
+    {
+        updateVerletLists();
+        return;
+    }
+
+    m_numNeighborRebuilds++;
     m_neighborSearcher->getNeighbors(getCurrentState()->getFluidNeighborLists(), *getCurrentState()->getPositions());
 
     if (m_modelParameters->m_bDensityWithBoundary)   // if considering boundary particles for computing fluid density
@@ -252,6 +288,67 @@ SphModel::findParticleNeighbors()
     }
 }
 
+void
+SphModel::updateVerletLists()
+{
+    std::shared_ptr<VecDataArray<double, 3>> positionsPtr = getCurrentState()->getPositions();
+    const VecDataArray<double, 3>&           positions    = *positionsPtr;
+    const size_t                             numParticles = positions.size();
+
+    // Two particles each moving less than half the skin stay within the searched radius
+    bool rebuild = (m_verletPositions == nullptr || m_verletPositions->size() != positions.size());
+    if (!rebuild)
+    {
+        VecDataArray<double, 3>&       displacements = *m_verletDisplacements;
+        const VecDataArray<double, 3>& refPositions  = *m_verletPositions;
+        displacements.resize(static_cast<int>(numParticles));
+        ParallelUtils::parallelFor(numParticles,
+            [&](const size_t p)
+            {
+                displacements[p] = positions[p] - refPositions[p];
+            });
+        const double halfSkin = 0.5 * m_modelParameters->m_kernelRadius * m_modelParameters->m_verletSkinOverKernelRadiusRatio;
+        rebuild = ParallelUtils::findMaxL2Norm(displacements) > halfSkin;
+    }
+
+    if (rebuild)
+    {
+        m_neighborSearcher->getNeighbors(m_verletFluidLists, positions);
+        if (m_modelParameters->m_bDensityWithBoundary)
+        {
+            m_neighborSearcher->getNeighbors(m_verletBoundaryLists, positions, *getCurrentState()->getBoundaryParticlePositions());
+        }
+        m_verletPositions = std::make_shared<VecDataArray<double, 3>>(positions);
+        m_numNeighborRebuilds++;
+    }
+
+    // Filter the candidates by the kernel radius
+    auto filter = [&](std::vector<std::vector<size_t>>& result, const std::vector<std::vector<size_t>>& candidates,
+                      const VecDataArray<double, 3>& candidatePositions)
+                  {
+                      result.resize(numParticles);
+                      ParallelUtils::parallelFor(numParticles,
+                          [&](const size_t p)
+                          {
+                              const Vec3d&         ppos = positions[p];
+                              std::vector<size_t>& neighbors = result[p];
+                              neighbors.resize(0);
+                              for (const size_t q : candidates[p])
+                              {
+                                  if ((ppos - candidatePositions[q]).squaredNorm() < m_modelParameters->m_kernelRadiusSqr)
+                                  {
+                                      neighbors.push_back(q);
+                                  }
+                              }
+                        });
+                  };
+    filter(getCurrentState()->getFluidNeighborLists(), m_verletFluidLists, positions);
+    if (m_modelParameters->m_bDensityWithBoundary)
+    {
+        filter(getCurrentState()->getBoundaryNeighborLists(), m_verletBoundaryLists, *getCurrentState()->getBoundaryParticlePositions());
+    }
+}
+
 void
 SphModel::computeNeighborRelativePositions()
 {
@@ -422,6 +519,12 @@ SphModel::normalizeDensity()
 void
 SphModel::computePressureAcceleration()
 {
+    if (m_modelParameters->m_pressureSolverType == SphModelConfig::PressureSolverType::Implicit)
+    {
+        computeImplicitPressureAcceleration();
+        return;
+    }
+
     std::shared_ptr<DataArray<double>> densitiesPtr   = getCurrentState()->getDensities();
     const DataArray<double>&           densities      = *densitiesPtr;
     VecDataArray<double, 3>&           pressureAccels = *m_pressureAccels;
@@ -465,6 +568,201 @@ SphModel::computePressureAcceleration()
       });
 }
 
+void
+SphModel::computeImplicitPressureAcceleration()
+{
+    const double dt          = m_dt;
+    const double dt2         = dt * dt;
+    const double mass        = m_modelParameters->m_particleMass;
+    const double restDensity = m_modelParameters->m_restDensity;
+    const double omega       = m_modelParameters->m_pressureRelaxation;
+    const size_t numParticles = getCurrentState()->getNumParticles();
+
+    const DataArray<double>&       densities            = *getCurrentState()->getDensities();
+    const VecDataArray<double, 3>& velocities           = *getCurrentState()->getHalfStepVelocities();
+    const VecDataArray<double, 3>& surfaceTensionAccels = *m_surfaceTensionAccels;
+    const VecDataArray<double, 3>& viscousAccels        = *m_viscousAccels;
+    VecDataArray<double, 3>&       pressureAccels       = *m_pressureAccels;
+    DataArray<double>&             pressures            = *m_pressures;
+
+    const std::vector<std::vector<NeighborInfo>>& neighborInfos = getCurrentState()->getNeighborInfo();
+    const std::vector<std::vector<size_t>>&       neighborLists = getCurrentState()->getFluidNeighborLists();
+
+    // Wall and buffer particles don't move, their pressure stays zero
+    auto isStatic = [&](const size_t p)
+                    {
+                        return m_sphBoundaryConditions
+                               && (m_sphBoundaryConditions->getParticleTypes()[p] == SphBoundaryConditions::ParticleType::Buffer
+                                   || m_sphBoundaryConditions->getParticleTypes()[p] == SphBoundaryConditions::ParticleType::Wall);
+                    };
+    auto isSolved = [&](const size_t p) { return !isStatic(p) && neighborInfos[p].size() > 1; };
+
+    m_advectedVelocities.resize(numParticles);
+    m_advectedDensities.resize(numParticles);
+    m_selfDisplacements.resize(numParticles);
+    m_diagonal.resize(numParticles);
+    m_neighborDisplacements.resize(numParticles);
+    m_nextPressures.resize(numParticles);
+    m_densityErrors.resize(numParticles);
+
+    // Advect the velocities by the non pressure forces
+    ParallelUtils::parallelFor(numParticles,
+        [&](const size_t p)
+        {
+            m_advectedVelocities[p] = isStatic(p) ? Vec3d::Zero() :
+                                      (velocities[p] + dt * (m_modelParameters->m_gravity + surfaceTensionAccels[p] + viscousAccels[p])).eval();
+        });
+
+    // Density after advection, and displacement and density change per pressure of the particle itself.
+    // Boundary neighbors (after the fluid ones) don't move
+    ParallelUtils::parallelFor(numParticles,
+        [&](const size_t p)
+        {
+            m_selfDisplacements[p] = Vec3d::Zero();
+            m_diagonal[p] = 0.0;
+            if (!isSolved(p))
+            {
+                pressures[p] = 0.0;
+                return;
+            }
+
+            const std::vector<NeighborInfo>& neighborInfo = neighborInfos[p];
+            const std::vector<size_t>&       fluidNeighborList = neighborLists[p];
+            const double                     pdensity = densities[p];
+            const double                     scale    = dt2 * mass / (pdensity * pdensity);
+
+            Vec3d  dii = Vec3d::Zero();
+            double densityChange = 0.0;
+            for (size_t i = 0; i < neighborInfo.size(); ++i)
+            {
+                const Vec3d gradW = m_kernels.gradW(neighborInfo[i].relativePos);
+                const Vec3d qvel  = (i < fluidNeighborList.size()) ? m_advectedVelocities[fluidNeighborList[i]] : Vec3d::Zero();
+                dii -= gradW;
+                densityChange += (m_advectedVelocities[p] - qvel).dot(gradW);
+            }
+            dii *= scale;
+            m_selfDisplacements[p] = dii;
+            m_advectedDensities[p] = pdensity + dt * mass * densityChange;
+
+            // a_ii = sum_j m (d_ii - d_ji) . gradW_ij, where d_ji moves the neighbor by our pressure
+            double aii = 0.0;
+            for (size_t i = 0; i < neighborInfo.size(); ++i)
+            {
+                const Vec3d gradW = m_kernels.gradW(neighborInfo[i].relativePos);
+                const bool  isMoving = i < fluidNeighborList.size() && !isStatic(fluidNeighborList[i]);
+                const Vec3d dji = isMoving ? (scale * gradW).eval() : Vec3d::Zero();
+                aii += mass * (dii - dji).dot(gradW);
+            }
+            m_diagonal[p] = aii;
+
+            // Warm start from the last pressures
+            pressures[p] *= 0.5;
+        });
+
+    size_t numSolved = 0;
+    for (size_t p = 0; p < numParticles; p++)
+    {
+        numSolved += isSolved(p) ? 1 : 0;
+    }
+
+    // Relaxed Jacobi on the pressures until the average compression is below the tolerance
+    m_numPressureIterations = 0;
+    m_densityError = 0.0;
+    for (int iter = 0; iter < m_modelParameters->m_maxPressureIterations; iter++)
+    {
+        // sum_j d_ij p_j, displacement by the neighbor pressures
+        ParallelUtils::parallelFor(numParticles,
+            [&](const size_t p)
+            {
+                Vec3d dijpj = Vec3d::Zero();
+                if (isSolved(p))
+                {
+                    const std::vector<NeighborInfo>& neighborInfo      = neighborInfos[p];
+                    const std::vector<size_t>&       fluidNeighborList = neighborLists[p];
+                    for (size_t i = 0; i < fluidNeighborList.size(); ++i)
+                    {
+                        const size_t q = fluidNeighborList[i];
+                        const double qdensity = densities[q];
+                        dijpj -= pressures[q] / (qdensity * qdensity) * m_kernels.gradW(neighborInfo[i].relativePos);
+                    }
+                }
+                m_neighborDisplacements[p] = dijpj * dt2 * mass;
+            });
+
+        ParallelUtils::parallelFor(numParticles,
+            [&](const size_t p)
+            {
+                m_nextPressures[p] = 0.0;
+                m_densityErrors[p] = 0.0;
+                if (!isSolved(p))
+                {
+                    return;
+                }
+
+                const std::vector<NeighborInfo>& neighborInfo      = neighborInfos[p];
+                const std::vector<size_t>&       fluidNeighborList = neighborLists[p];
+                const double                     pdensity = densities[p];
+                const double                     scale    = dt2 * mass / (pdensity * pdensity);
+
+                // Density change by every pressure but our own
+                double sum = 0.0;
+                for (size_t i = 0; i < neighborInfo.size(); ++i)
+                {
+                    const Vec3d gradW = m_kernels.gradW(neighborInfo[i].relativePos);
+                    Vec3d       displacement = m_neighborDisplacements[p];
+                    if (i < fluidNeighborList.size() && !isStatic(fluidNeighborList[i]))
+                    {
+                        const size_t q = fluidNeighborList[i];
+                        displacement -= m_selfDisplacements[q] * pressures[q] + m_neighborDisplacements[q] - scale * gradW * pressures[p];
+                    }
+                    sum += mass * displacement.dot(gradW);
+                }
+
+                const double aii = m_diagonal[p];
+                m_densityErrors[p] = std::max(m_advectedDensities[p] + aii * pressures[p] + sum - restDensity, 0.0);
+                if (std::abs(aii) > 1.0e-20)
+                {
+                    const double pressure = (1.0 - omega) * pressures[p] + omega / aii * (restDensity - m_advectedDensities[p] - sum);
+                    m_nextPressures[p] = std::max(pressure, 0.0);
+                }
+            });
+
+        std::copy(m_nextPressures.begin(), m_nextPressures.end(), pressures.getPointer());
+        m_numPressureIterations = iter + 1;
+
+        m_densityError = std::accumulate(m_densityErrors.begin(), m_densityErrors.end(), 0.0) / (std::max<size_t>(numSolved, 1) * restDensity);
+        if (iter > 0 && m_densityError <= m_modelParameters->m_maxDensityError)
+        {
+            break;
+        }
+    }
+
+    ParallelUtils::parallelFor(numParticles,
+        [&](const size_t p)
+        {
+            Vec3d accel = Vec3d::Zero();
+            if (isSolved(p))
+            {
+                const std::vector<NeighborInfo>& neighborInfo      = neighborInfos[p];
+                const std::vector<size_t>&       fluidNeighborList = neighborLists[p];
+                const double                     pdensity  = densities[p];
+                const double                     ppressure = pressures[p] / (pdensity * pdensity);
+                for (size_t i = 0; i < neighborInfo.size(); ++i)
+                {
+                    double qpressure = 0.0;
+                    if (i < fluidNeighborList.size())
+                    {
+                        const size_t q = fluidNeighborList[i];
+                        qpressure = pressures[q] / (densities[q] * densities[q]);
+                    }
+                    accel -= (ppressure + qpressure) * m_kernels.gradW(neighborInfo[i].relativePos);
+                }
+                accel *= mass;
+            }
+            pressureAccels[p] = accel;
+        });
+}
+
 void
 SphModel::computeViscosity()
 {
@@ -662,8 +960,14 @@ SphModel::updateVelocity(const double timestep)
                 return;
             }
 
+            // The implicit pressures are solved for symplectic Euler
+            if (m_modelParameters->m_pressureSolverType == SphModelConfig::PressureSolverType::Implicit)
+            {
+                halfStepVelocities[p] += (m_modelParameters->m_gravity + accels[p]) * timestep;
+                fullStepVelocities[p]  = halfStepVelocities[p];
+            }
             // todo - simply run SPH for half a time step to start to we don't need to perform this check at every time step
-            if (m_timeStepCount == 0)
+            else if (m_timeStepCount == 0)
             {
                 halfStepVelocities[p]  = fullStepVelocities[p] + (m_modelParameters->m_gravity + accels[p]) * timestep * 0.5;
                 fullStepVelocities[p] += (m_modelParameters->m_gravity + accels[p]) * timestep;
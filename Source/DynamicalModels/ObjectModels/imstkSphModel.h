@@ -50,8 +50,24 @@ public:
     bool m_bNormalizeDensity    = false;
     bool m_bDensityWithBoundary = false;
 
+    ///
+    /// \brief Pressure solver. Weakly compressible computes the pressures from the densities by the
+    /// equation of state, its stable time step is limited by the speed of sound. Implicit solves the
+    /// pressures keeping the rest density (IISPH, Ihmsen et al. 2014), the time step is then only
+    /// limited by the velocities which allows several times larger m_maxTimestep
+    ///
+    enum class PressureSolverType
+    {
+        WeaklyCompressible,
+        Implicit
+    };
+
     // pressure
     double m_pressureStiffness = 50000.0;
+    PressureSolverType m_pressureSolverType = PressureSolverType::WeaklyCompressible;
+    int    m_maxPressureIterations = 100;    ///< Implicit solver max number of iterations
+    double m_maxDensityError       = 1.0e-3; ///< Implicit solver stops below this average relative compression
+    double m_pressureRelaxation    = 0.5;    ///< Implicit solver relaxed Jacobi weight
 
     // viscosity and surface tension/cohesion
     double m_dynamicViscosityCoeff   = 1.0e-2;
@@ -72,6 +88,11 @@ public:
 
     // neighbor search
     NeighborSearch::Method m_neighborSearchMethod = NeighborSearch::Method::UniformGridBasedSearch;
+
+    // Verlet neighbor lists, searched within the kernel radius plus a skin and only rebuilt
+    // once a particle moved more than half the skin, filtered by the kernel radius otherwise
+    bool   m_bUseVerletLists = false;
+    double m_verletSkinOverKernelRadiusRatio = 0.2;
 };
 
 ///
@@ -129,6 +150,21 @@ public:
 
     double getParticlePressure(const double density);
 
+    ///
+    /// \brief Returns the number of iterations of the last implicit pressure solve
+    ///
+    int getNumPressureIterations() const { return m_numPressureIterations; }
+
+    ///
+    /// \brief Returns the average relative compression left by the last implicit pressure solve
+    ///
+    double getDensityError() const { return m_densityError; }
+
+    ///
+    /// \brief Returns the number of full neighbor searches done, every step without Verlet lists
+    ///
+    int getNumNeighborRebuilds() const { return m_numNeighborRebuilds; }
+
     ///
     /// \brief Write the state to external file
     /// \todo move this out of this class
@@ -173,6 +209,12 @@ private:
     ///
     void findParticleNeighbors();
 
+    ///
+    /// \brief Filter the Verlet lists by the kernel radius, rebuild them first when
+    /// a particle moved more than half the skin since the last rebuild
+    ///
+    void updateVerletLists();
+
     ///
     /// \brief Pre-compute relative positions with neighbor particles
     ///
@@ -199,6 +241,12 @@ private:
     ///
     void computePressureAcceleration();
 
+    ///
+    /// \brief Compute particle acceleration due to pressure, solving the pressures for the
+    /// particles to reach the rest density after advecting by the other forces (IISPH)
+    ///
+    void computeImplicitPressureAcceleration();
+
     ///
     /// \brief Sum the forces computed in parallel
     ///
@@ -257,6 +305,25 @@ private:
     std::shared_ptr<VecDataArray<double, 3>> m_viscousAccels    = nullptr;
     std::shared_ptr<VecDataArray<double, 3>> m_neighborVelContr = nullptr;
     std::shared_ptr<VecDataArray<double, 3>> m_particleShift    = nullptr;
+    std::shared_ptr<DataArray<double>>       m_pressures        = nullptr; ///< Implicit solver pressures, warm start the next solve
+
+    // Implicit solver per particle terms
+    StdVectorOfVec3d    m_advectedVelocities; ///< Velocities after the non pressure forces
+    std::vector<double> m_advectedDensities;  ///< Densities after the non pressure forces
+    StdVectorOfVec3d    m_selfDisplacements;  ///< d_ii, displacement per pressure of the particle itself
+    std::vector<double> m_diagonal;           ///< a_ii, density change per pressure of the particle itself
+    StdVectorOfVec3d    m_neighborDisplacements; ///< sum_j d_ij p_j, displacement by the neighbor pressures
+    std::vector<double> m_nextPressures;
+    std::vector<double> m_densityErrors;
+    int    m_numPressureIterations = 0;
+    double m_densityError = 0.0;
+
+    // Verlet lists, candidate neighbors within the kernel radius plus skin
+    std::vector<std::vector<size_t>>         m_verletFluidLists;
+    std::vector<std::vector<size_t>>         m_verletBoundaryLists;
+    std::shared_ptr<VecDataArray<double, 3>> m_verletPositions     = nullptr; ///< Positions at the last rebuild
+    std::shared_ptr<VecDataArray<double, 3>> m_verletDisplacements = nullptr;
+    int m_numNeighborRebuilds = 0;
 
     std::shared_ptr<VecDataArray<double, 3>> m_initialVelocities = nullptr;
     std::shared_ptr<DataArray<double>>       m_initialDensities  = nullptr;
@@ -0,0 +1,280 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkGeometryUtilities.h"
+#include "imstkModalAnalysis.h"
+#include "imstkReducedStVKCubature.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkVecDataArray.h"
+
+#include <Eigen/Eigenvalues>
+
+#include <cstdio>
+
+using namespace imstk;
+
+///
+/// \brief Beam along z of 3 by 3 by 6 vertices spaced 0.1 apart
+///
+static std::shared_ptr<TetrahedralMesh>
+makeBeam()
+{
+    return GeometryUtils::toTetGrid(Vec3d::Zero(), Vec3d(0.2, 0.2, 0.5), Vec3i(3, 3, 6));
+}
+
+///
+/// \brief Ids of the vertices of the z = 0 end of the beam, the first ones
+///
+static std::vector<int>
+getClampedIds()
+{
+    std::vector<int> ids(3 * 3);
+    for (int i = 0; i < 3 * 3; i++)
+    {
+        ids[i] = i;
+    }
+    return ids;
+}
+
+TEST(imstkModalAnalysisTest, SolveGeneralizedEigenproblem)
+{
+    auto                tetMesh = makeBeam();
+    ReducedStVKCubature stvk(tetMesh);
+    SparseMatrixd       K;
+    SparseMatrixd       M;
+    stvk.computeTangentStiffness(Vectord::Zero(3 * tetMesh->getNumVertices()), K);
+    ModalAnalysis::computeMassMatrix(tetMesh, 1000.0, M);
+
+    // Free floating, K is singular and needs a negative shift
+    const int numModes = 12;
+    const double shift = -1.0e-4 * K.diagonal().mean() / M.diagonal().mean();
+    Matrixd      modes;
+    Vectord      eigenvalues;
+    ASSERT_TRUE(ModalAnalysis::solveGeneralizedEigenproblem(K, M, numModes, shift, modes, eigenvalues));
+
+    Eigen::GeneralizedSelfAdjointEigenSolver<Matrixd> dense { Matrixd(K), Matrixd(M) };
+    const double                                      scale = dense.eigenvalues()[numModes - 1];
+    for (int i = 0; i < numModes; i++)
+    {
+        EXPECT_NEAR(dense.eigenvalues()[i], eigenvalues[i], 1.0e-6 * scale);
+    }
+    const Matrixd residual = K * modes - M * modes * eigenvalues.asDiagonal();
+    EXPECT_LT(residual.norm(), 1.0e-6 * scale * std::sqrt(M.diagonal().maxCoeff()));
+    EXPECT_TRUE((modes.transpose() * M * modes).isIdentity(1.0e-8));
+}
+
+TEST(imstkModalAnalysisTest, Compute_ClampedLinearModes)
+{
+    auto          tetMesh = makeBeam();
+    ModalAnalysis analysis;
+    analysis.setMesh(tetMesh);
+    analysis.setFixedNodeIds(getClampedIds());
+    analysis.setNumModes(6);
+    analysis.setNumCubaturePoses(0);
+    ASSERT_TRUE(analysis.compute());
+    EXPECT_EQ(nullptr, analysis.getCubature());
+
+    const Matrixd& U = analysis.getBasis();
+    ASSERT_EQ(3 * tetMesh->getNumVertices(), U.rows());
+    ASSERT_EQ(6, U.cols());
+    EXPECT_TRUE(U.topRows(3 * 9).isZero());
+
+    SparseMatrixd M;
+    ModalAnalysis::computeMassMatrix(tetMesh, 1000.0, M);
+    EXPECT_TRUE((U.transpose() * M * U).isIdentity(1.0e-8));
+
+    // Clamped, the lowest frequencies are positive and ascending
+    const Vectord& eigenvalues = analysis.getEigenvalues();
+    EXPECT_GT(eigenvalues[0], 0.0);
+    for (int i = 1; i < 6; i++)
+    {
+        EXPECT_LE(eigenvalues[i - 1], eigenvalues[i] * (1.0 + 1.0e-8));
+    }
+}
+
+TEST(imstkModalAnalysisTest, Compute_FreeFloatingDropsRigidModes)
+{
+    auto          tetMesh = makeBeam();
+    ModalAnalysis analysis;
+    analysis.setMesh(tetMesh);
+    analysis.setNumModes(4);
+    analysis.setNumCubaturePoses(0);
+    ASSERT_TRUE(analysis.compute());
+
+    ReducedStVKCubature stvk(tetMesh);
+    SparseMatrixd       K;
+    SparseMatrixd       M;
+    stvk.computeTangentStiffness(Vectord::Zero(3 * tetMesh->getNumVertices()), K);
+    ModalAnalysis::computeMassMatrix(tetMesh, 1000.0, M);
+    Eigen::GeneralizedSelfAdjointEigenSolver<Matrixd> dense { Matrixd(K), Matrixd(M) };
+
+    // The first deformation mode follows the 6 rigid ones
+    const Vectord& eigenvalues = analysis.getEigenvalues();
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_NEAR(dense.eigenvalues()[6 + i], eigenvalues[i], 1.0e-6 * dense.eigenvalues()[9]);
+    }
+
+    // Modes don't translate the body
+    Vectord translation = Vectord::Zero(3 * tetMesh->getNumVertices());
+    for (int i = 0; i < tetMesh->getNumVertices(); i++)
+    {
+        translation[3 * i] = 1.0;
+    }
+    EXPECT_LT((analysis.getBasis().transpose() * (M * translation)).norm(), 1.0e-6);
+}
+
+TEST(imstkModalAnalysisTest, Compute_ModalDerivatives)
+{
+    auto          tetMesh = makeBeam();
+    ModalAnalysis analysis;
+    analysis.setMesh(tetMesh);
+    analysis.setFixedNodeIds(getClampedIds());
+    analysis.setNumModalDerivativeModes(3);
+    analysis.setNumModes(8);
+    analysis.setNumCubaturePoses(0);
+    ASSERT_TRUE(analysis.compute());
+
+    // 3 modes and 6 derivatives, the 8 largest components are kept
+    const Matrixd& U = analysis.getBasis();
+    ASSERT_EQ(8, U.cols());
+    EXPECT_TRUE(U.topRows(3 * 9).isZero());
+
+    SparseMatrixd M;
+    ModalAnalysis::computeMassMatrix(tetMesh, 1000.0, M);
+    EXPECT_TRUE((U.transpose() * M * U).isIdentity(1.0e-8));
+}
+
+TEST(imstkModalAnalysisTest, Cubature_ReducedForces)
+{
+    auto          tetMesh = makeBeam();
+    ModalAnalysis analysis;
+    analysis.setMesh(tetMesh);
+    analysis.setFixedNodeIds(getClampedIds());
+    analysis.setNumModes(6);
+    analysis.setNumCubaturePoses(40);
+    analysis.setMaxNumCubatureElements(tetMesh->getNumCells());
+    analysis.setCubatureTolerance(1.0e-3);
+    ASSERT_TRUE(analysis.compute());
+    auto cubature = analysis.getCubature();
+    ASSERT_NE(nullptr, cubature);
+    EXPECT_GT(cubature->getCubatureElements().size(), 0);
+    EXPECT_LT(cubature->getCubatureElements().size(), tetMesh->getNumCells());
+
+    // Pose within the training range
+    Vectord q(6);
+    for (int i = 0; i < 6; i++)
+    {
+        q[i] = 0.01 / std::sqrt(analysis.getEigenvalues()[i]) * ((i % 2 == 0) ? 1.0 : -0.5);
+    }
+    Vectord g;
+    Vectord gExact;
+    cubature->computeReducedInternalForce(q, g);
+    cubature->computeExactReducedInternalForce(q, gExact);
+    EXPECT_LT((g - gExact).norm(), 0.05 * gExact.norm());
+
+    // Stiffness is the derivative of the cubature forces
+    Matrixd K;
+    cubature->computeReducedTangentStiffness(q, K);
+    const double h = 1.0e-6 * q.norm();
+    for (int i = 0; i < 6; i++)
+    {
+        Vectord gPlus;
+        Vectord gMinus;
+        cubature->computeReducedInternalForce(q + h * Vectord::Unit(6, i), gPlus);
+        cubature->computeReducedInternalForce(q - h * Vectord::Unit(6, i), gMinus);
+        EXPECT_LT(((gPlus - gMinus) / (2.0 * h) - K.col(i)).norm(), 1.0e-5 * K.norm());
+    }
+}
+
+TEST(imstkModalAnalysisTest, Cubature_AllElementsIsExact)
+{
+    auto          tetMesh = makeBeam();
+    ModalAnalysis analysis;
+    analysis.setMesh(tetMesh);
+    analysis.setFixedNodeIds(getClampedIds());
+    analysis.setNumModes(4);
+    analysis.setNumCubaturePoses(0);
+    ASSERT_TRUE(analysis.compute());
+
+    ReducedStVKCubature cubature(tetMesh);
+    cubature.setBasis(analysis.getBasis());
+    std::vector<int> elements(tetMesh->getNumCells());
+    for (int i = 0; i < tetMesh->getNumCells(); i++)
+    {
+        elements[i] = i;
+    }
+    cubature.setCubature(elements, std::vector<double>(elements.size(), 1.0));
+
+    const Vectord q = Vectord::Constant(4, 0.01);
+    Vectord       g;
+    Vectord       gExact;
+    cubature.computeReducedInternalForce(q, g);
+    cubature.computeExactReducedInternalForce(q, gExact);
+    EXPECT_TRUE(g.isApprox(gExact, 1.0e-10));
+}
+
+TEST(imstkModalAnalysisTest, SolveNonNegativeLeastSquares)
+{
+    Matrixd A(4, 3);
+    A << 1.0, 0.0, 1.0,
+        0.0, 1.0, 1.0,
+        1.0, 1.0, 0.0,
+        2.0, 0.0, 1.0;
+
+    // Exactly representable with non-negative weights
+    const Vectord x = Vectord(Vec3d(0.5, 0.0, 2.0));
+    EXPECT_TRUE(ReducedStVKCubature::solveNonNegativeLeastSquares(A, A * x).isApprox(x, 1.0e-10));
+
+    // Unconstrained solution has a negative weight, it's clamped
+    const Vectord b  = A * Vectord(Vec3d(1.0, -1.0, 1.0));
+    const Vectord xp = ReducedStVKCubature::solveNonNegativeLeastSquares(A, b);
+    EXPECT_TRUE((xp.array() >= 0.0).all());
+    EXPECT_EQ(0.0, xp[1]);
+    // Optimal on the remaining variables
+    const Vectord residual = b - A * xp;
+    EXPECT_NEAR(0.0, A.col(0).dot(residual), 1.0e-10);
+    EXPECT_NEAR(0.0, A.col(2).dot(residual), 1.0e-10);
+}
+
+TEST(imstkModalAnalysisTest, Compute_Cache)
+{
+    const std::string fileName = "imstkModalAnalysisTest.imod";
+    std::remove(fileName.c_str());
+
+    auto          tetMesh = makeBeam();
+    ModalAnalysis analysis;
+    analysis.setMesh(tetMesh);
+    analysis.setFixedNodeIds(getClampedIds());
+    analysis.setNumModes(4);
+    analysis.setNumCubaturePoses(10);
+    analysis.setCacheFileName(fileName);
+    ASSERT_TRUE(analysis.compute());
+    EXPECT_FALSE(analysis.getLoadedFromCache());
+
+    ModalAnalysis cached;
+    cached.setMesh(tetMesh);
+    cached.setFixedNodeIds(getClampedIds());
+    cached.setNumModes(4);
+    cached.setNumCubaturePoses(10);
+    cached.setCacheFileName(fileName);
+    ASSERT_TRUE(cached.compute());
+    EXPECT_TRUE(cached.getLoadedFromCache());
+    EXPECT_EQ(analysis.getBasis(), cached.getBasis());
+    EXPECT_EQ(analysis.getEigenvalues(), cached.getEigenvalues());
+    ASSERT_NE(nullptr, cached.getCubature());
+    EXPECT_EQ(analysis.getCubature()->getCubatureElements(), cached.getCubature()->getCubatureElements());
+    EXPECT_EQ(analysis.getCubature()->getCubatureWeights(), cached.getCubature()->getCubatureWeights());
+
+    // Changing the material invalidates it
+    cached.setYoungsModulus(2.0e7);
+    ASSERT_TRUE(cached.compute());
+    EXPECT_FALSE(cached.getLoadedFromCache());
+
+    std::remove(fileName.c_str());
+}
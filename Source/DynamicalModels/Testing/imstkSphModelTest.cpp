@@ -0,0 +1,235 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkNeighborSearch.h"
+#include "imstkPointSet.h"
+#include "imstkSequentialTaskGraphController.h"
+#include "imstkSphModel.h"
+#include "imstkTaskGraph.h"
+#include "imstkVecDataArray.h"
+
+#include <algorithm>
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Creates a model of a block of fluid particles on a lattice of the particle diameter
+///
+std::shared_ptr<SphModel>
+makeFluidBlock(const int numPerSide, const std::shared_ptr<SphModelConfig>& config)
+{
+    const double spacing   = 2.0 * config->m_particleRadius;
+    auto         positions = std::make_shared<VecDataArray<double, 3>>();
+    for (int i = 0; i < numPerSide; i++)
+    {
+        for (int j = 0; j < numPerSide; j++)
+        {
+            for (int k = 0; k < numPerSide; k++)
+            {
+                positions->push_back(Vec3d(i, j, k) * spacing);
+            }
+        }
+    }
+    auto pointSet = std::make_shared<PointSet>();
+    pointSet->initialize(positions);
+
+    auto model = std::make_shared<SphModel>();
+    model->setModelGeometry(pointSet);
+    model->configure(config);
+    model->initialize();
+    model->AbstractDynamicalModel::initGraphEdges();
+    return model;
+}
+
+///
+/// \brief Advance the model by one step
+///
+void
+step(SphModel& model)
+{
+    SequentialTaskGraphController controller;
+    controller.setTaskGraph(model.getTaskGraph());
+    controller.init();
+    controller.execute();
+}
+
+///
+/// \brief Sorts each list of neighbors so lists of different searches can be compared
+///
+std::vector<std::vector<size_t>>
+sorted(std::vector<std::vector<size_t>> lists)
+{
+    for (std::vector<size_t>& list : lists)
+    {
+        std::sort(list.begin(), list.end());
+    }
+    return lists;
+}
+} // namespace
+
+///
+/// \brief Test that the implicit pressure solve of a fluid block dropped under gravity onto
+/// boundary particles, with a time step several times the weakly compressible CFL limit,
+/// converges below the max density error within the max iterations, keeps the density
+/// bounded and rests on the boundary
+///
+TEST(imstkSphModelTest, ImplicitPressureConverges)
+{
+    auto config = std::make_shared<SphModelConfig>(0.05);
+    config->m_pressureSolverType   = SphModelConfig::PressureSolverType::Implicit;
+    config->m_bDensityWithBoundary = true;
+    const int                 numPerSide = 6;
+    std::shared_ptr<SphModel> model      = makeFluidBlock(numPerSide, config);
+
+    // Open box of two layers of boundary particles around the block, with two particle
+    // diameters of space under it and on each side
+    const double spacing = 2.0 * config->m_particleRadius;
+    auto         boundaryPositions = std::make_shared<VecDataArray<double, 3>>();
+    for (int i = -4; i < numPerSide + 4; i++)
+    {
+        for (int j = -4; j < numPerSide; j++)
+        {
+            for (int k = -4; k < numPerSide + 4; k++)
+            {
+                const bool isFloor = j < -2;
+                const bool isWall  = i < -2 || i > numPerSide + 1 || k < -2 || k > numPerSide + 1;
+                if (isFloor || isWall)
+                {
+                    boundaryPositions->push_back(Vec3d(i, j, k) * spacing);
+                }
+            }
+        }
+    }
+    model->getCurrentState()->setBoundaryParticlePositions(boundaryPositions);
+
+    // The weakly compressible solver would be limited to dt = CFL * 2r / c
+    const double weaklyCompressibleTimeStep = config->m_cflFactor * spacing / config->m_speedOfSound;
+    model->setTimeStep(3.0 * weaklyCompressibleTimeStep);
+
+    for (int i = 0; i < 60; i++)
+    {
+        step(*model);
+        EXPECT_LT(model->getNumPressureIterations(), config->m_maxPressureIterations) << "step " << i;
+        EXPECT_LE(model->getDensityError(), config->m_maxDensityError) << "step " << i;
+
+        const DataArray<double>& densities  = *model->getCurrentState()->getDensities();
+        double                   maxDensity = 0.0;
+        for (int j = 0; j < densities.size(); j++)
+        {
+            maxDensity = std::max(maxDensity, densities[j]);
+        }
+        EXPECT_LT(maxDensity, 1.2 * config->m_restDensity) << "step " << i;
+    }
+
+    // The block came down and rests on the floor, whose top layer is at -3 spacings
+    const VecDataArray<double, 3>& positions = *model->getCurrentState()->getPositions();
+    double                         minHeight = positions[0][1];
+    for (int p = 1; p < positions.size(); p++)
+    {
+        minHeight = std::min(minHeight, positions[p][1]);
+    }
+    EXPECT_LT(minHeight, -0.5 * spacing);
+    EXPECT_GT(minHeight, -3.0 * spacing);
+}
+
+///
+/// \brief Test that the CFL time step in implicit mode is not limited by the speed of sound
+///
+TEST(imstkSphModelTest, ImplicitCFLTimeStep)
+{
+    double timeSteps[2] = { 0.0, 0.0 };
+    for (int i = 0; i < 2; i++)
+    {
+        auto config = std::make_shared<SphModelConfig>(0.01);
+        config->m_pressureSolverType = (i == 0) ?
+                                       SphModelConfig::PressureSolverType::WeaklyCompressible :
+                                       SphModelConfig::PressureSolverType::Implicit;
+        config->m_maxTimestep = 0.01;
+        std::shared_ptr<SphModel> model = makeFluidBlock(4, config);
+        model->setTimeStepSizeType(TimeSteppingType::RealTime);
+
+        // Uniform motion, the block translates
+        model->getCurrentState()->getFullStepVelocities()->fill(Vec3d(1.0, 0.0, 0.0));
+        model->getCurrentState()->getHalfStepVelocities()->fill(Vec3d(1.0, 0.0, 0.0));
+        step(*model);
+        timeSteps[i] = model->getTimeStep();
+    }
+    EXPECT_GT(timeSteps[1], 5.0 * timeSteps[0]);
+}
+
+///
+/// \brief Test that the Verlet lists are only rebuilt once a particle moved more than half
+/// the skin, and that the fluid and boundary neighbors filtered from them always equal those
+/// of a full search within the kernel radius
+///
+TEST(imstkSphModelTest, VerletLists)
+{
+    auto config = std::make_shared<SphModelConfig>(0.05);
+    config->m_bUseVerletLists      = true;
+    config->m_bDensityWithBoundary = true;
+    std::shared_ptr<SphModel> model = makeFluidBlock(6, config);
+
+    // Layer of boundary particles under the block
+    const double spacing = 2.0 * config->m_particleRadius;
+    auto         boundaryPositions = std::make_shared<VecDataArray<double, 3>>();
+    for (int i = -1; i < 7; i++)
+    {
+        for (int k = -1; k < 7; k++)
+        {
+            boundaryPositions->push_back(Vec3d(i, -1.0, k) * spacing);
+        }
+    }
+    model->getCurrentState()->setBoundaryParticlePositions(boundaryPositions);
+
+    VecDataArray<double, 3>&      positions = *model->getCurrentState()->getPositions();
+    const VecDataArray<double, 3> initPositions = positions;
+    const double                  halfSkin = 0.5 * config->m_kernelRadius * config->m_verletSkinOverKernelRadiusRatio;
+
+    // Moves every particle off the lattice by less than the given distance, with a different
+    // direction per particle so the relative positions change
+    auto jitter = [&](const double dist, const double phase)
+                  {
+                      for (int p = 0; p < positions.size(); p++)
+                      {
+                          const Vec3d dir = Vec3d(std::sin(p + phase), std::cos(1.3 * p + phase), std::sin(2.7 * p + phase));
+                          positions[p] = initPositions[p] + dist / std::sqrt(3.0) * dir;
+                      }
+                  };
+
+    NeighborSearch fullSearch(config->m_neighborSearchMethod, config->m_kernelRadius);
+    auto           expectNeighborsOfFullSearch = [&]()
+                                                 {
+                                                     std::vector<std::vector<size_t>> fluidNeighbors;
+                                                     fullSearch.getNeighbors(fluidNeighbors, positions);
+                                                     EXPECT_EQ(sorted(model->getCurrentState()->getFluidNeighborLists()), sorted(fluidNeighbors));
+
+                                                     std::vector<std::vector<size_t>> boundaryNeighbors;
+                                                     fullSearch.getNeighbors(boundaryNeighbors, positions, *boundaryPositions);
+                                                     EXPECT_EQ(sorted(model->getCurrentState()->getBoundaryNeighborLists()), sorted(boundaryNeighbors));
+                                                 };
+
+    // First search builds the lists
+    jitter(0.3 * halfSkin, 0.0);
+    model->getFindParticleNeighborsNode()->execute();
+    EXPECT_EQ(model->getNumNeighborRebuilds(), 1);
+    expectNeighborsOfFullSearch();
+
+    // Moving less than half the skin only filters the lists
+    jitter(0.3 * halfSkin, 1.0);
+    model->getFindParticleNeighborsNode()->execute();
+    EXPECT_EQ(model->getNumNeighborRebuilds(), 1);
+    expectNeighborsOfFullSearch();
+
+    // Moving one particle more than half the skin rebuilds them
+    positions[0] += Vec3d(1.5 * halfSkin, 0.0, 0.0);
+    model->getFindParticleNeighborsNode()->execute();
+    EXPECT_EQ(model->getNumNeighborRebuilds(), 2);
+    expectNeighborsOfFullSearch();
+}
@@ -0,0 +1,209 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkAppendMesh.h"
+#include "imstkCleanMesh.h"
+#include "imstkExtractEdges.h"
+#include "imstkFastMarch.h"
+#include "imstkImageData.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkSurfaceMeshSmoothen.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace imstk;
+
+///
+/// \brief n by n grid of vertices with noise in y. Every quad is split in two
+/// triangles that don't share vertices, to give CleanMesh something to merge
+///
+static std::shared_ptr<SurfaceMesh>
+makeGrid(const int n, const bool splitQuads)
+{
+    auto verticesPtr = std::make_shared<VecDataArray<double, 3>>();
+    auto cellsPtr    = std::make_shared<VecDataArray<int, 3>>();
+    auto getVertex   = [n](const int i, const int j)
+                       {
+                           const double y = 0.1 * std::sin(static_cast<double>(i * 7 + j * 13));
+                           return Vec3d(static_cast<double>(i) / n, y / n, static_cast<double>(j) / n);
+                       };
+    if (splitQuads)
+    {
+        for (int i = 0; i < n - 1; i++)
+        {
+            for (int j = 0; j < n - 1; j++)
+            {
+                const int v = verticesPtr->size();
+                verticesPtr->push_back(getVertex(i, j));
+                verticesPtr->push_back(getVertex(i, j + 1));
+                verticesPtr->push_back(getVertex(i + 1, j));
+                verticesPtr->push_back(getVertex(i, j + 1));
+                verticesPtr->push_back(getVertex(i + 1, j + 1));
+                verticesPtr->push_back(getVertex(i + 1, j));
+                cellsPtr->push_back(Vec3i(v, v + 1, v + 2));
+                cellsPtr->push_back(Vec3i(v + 3, v + 4, v + 5));
+            }
+        }
+    }
+    else
+    {
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                verticesPtr->push_back(getVertex(i, j));
+            }
+        }
+        for (int i = 0; i < n - 1; i++)
+        {
+            for (int j = 0; j < n - 1; j++)
+            {
+                const int v = i * n + j;
+                cellsPtr->push_back(Vec3i(v, v + 1, v + n));
+                cellsPtr->push_back(Vec3i(v + 1, v + n + 1, v + n));
+            }
+        }
+    }
+    auto mesh = std::make_shared<SurfaceMesh>();
+    mesh->initialize(verticesPtr, cellsPtr);
+    return mesh;
+}
+
+///
+/// \brief Smoothing of a grid with range(0) vertices per side, range(1) selects VTK
+///
+static void
+BM_Smoothen(benchmark::State& state)
+{
+    SurfaceMeshSmoothen smoothen;
+    smoothen.setInputMesh(makeGrid(static_cast<int>(state.range(0)), false));
+    smoothen.setNumberOfIterations(20);
+    smoothen.setUseVtk(state.range(1) != 0);
+    for (auto _ : state)
+    {
+        smoothen.update();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+
+///
+/// \brief Merging the duplicate vertices of a grid with range(0) vertices per side,
+/// range(1) selects VTK
+///
+static void
+BM_CleanMesh(benchmark::State& state)
+{
+    CleanMesh clean;
+    clean.setInputMesh(makeGrid(static_cast<int>(state.range(0)), true));
+    clean.setTolerance(0.0);
+    clean.setUseVtk(state.range(1) != 0);
+    for (auto _ : state)
+    {
+        clean.update();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+
+///
+/// \brief Edges of a grid with range(0) vertices per side, range(1) selects VTK
+///
+static void
+BM_ExtractEdges(benchmark::State& state)
+{
+    ExtractEdges extractEdges;
+    extractEdges.setInputMesh(makeGrid(static_cast<int>(state.range(0)), false));
+    extractEdges.setUseVtk(state.range(1) != 0);
+    for (auto _ : state)
+    {
+        extractEdges.update();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+
+///
+/// \brief Appending 8 grids with range(0) vertices per side, range(1) selects VTK
+///
+static void
+BM_AppendMesh(benchmark::State& state)
+{
+    AppendMesh append;
+    for (int i = 0; i < 8; i++)
+    {
+        append.addInputMesh(makeGrid(static_cast<int>(state.range(0)), false));
+    }
+    append.setUseVtk(state.range(1) != 0);
+    for (auto _ : state)
+    {
+        append.update();
+    }
+    state.SetItemsProcessed(state.iterations() * 8 * state.range(0) * state.range(0));
+}
+
+///
+/// \brief Fast marching a range(0)^3 image from its center voxel, range(1) selects sweeping
+///
+static void
+BM_FastMarch(benchmark::State& state)
+{
+    const int n     = static_cast<int>(state.range(0));
+    auto      image = std::make_shared<ImageData>();
+    image->allocate(IMSTK_DOUBLE, 1, Vec3i(n, n, n));
+    auto scalars = std::dynamic_pointer_cast<DataArray<double>>(image->getScalars());
+
+    FastMarch fastMarch;
+    fastMarch.setImage(image);
+    fastMarch.setSeeds({ Vec3i(n / 2, n / 2, n / 2) });
+    fastMarch.setUseSweeping(state.range(1) != 0);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        scalars->fill(0.0);
+        state.ResumeTiming();
+        fastMarch.solve();
+    }
+    state.SetItemsProcessed(state.iterations() * n * n * n);
+}
+
+///
+/// \brief Fast marching a band of 4 voxels around a seed plane of a range(0)^3 image,
+/// repeated as when reseeding a level set
+///
+static void
+BM_FastMarchBand(benchmark::State& state)
+{
+    const int n     = static_cast<int>(state.range(0));
+    auto      image = std::make_shared<ImageData>();
+    image->allocate(IMSTK_DOUBLE, 1, Vec3i(n, n, n));
+    auto scalars = std::dynamic_pointer_cast<DataArray<double>>(image->getScalars());
+    scalars->fill(0.0);
+
+    std::vector<Vec3i> seeds;
+    for (int y = 0; y < n; y++)
+    {
+        for (int x = 0; x < n; x++)
+        {
+            seeds.push_back(Vec3i(x, y, n / 2));
+        }
+    }
+    FastMarch fastMarch;
+    fastMarch.setImage(image);
+    fastMarch.setSeeds(seeds);
+    fastMarch.setDistThreshold(4.0);
+    for (auto _ : state)
+    {
+        fastMarch.solve();
+    }
+    state.SetItemsProcessed(state.iterations() * n * n * 9);
+}
+
+BENCHMARK(BM_Smoothen)->ArgsProduct({ { 64, 256, 512 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CleanMesh)->ArgsProduct({ { 64, 256, 512 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ExtractEdges)->ArgsProduct({ { 64, 256, 512 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AppendMesh)->ArgsProduct({ { 64, 256, 512 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FastMarch)->ArgsProduct({ { 64, 128, 256 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FastMarchBand)->Arg(64)->Arg(128)->Arg(256)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
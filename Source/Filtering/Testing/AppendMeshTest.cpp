@@ -72,4 +72,29 @@ TEST(AppendMeshTest, Filter)
     // Test equivalence
     EXPECT_EQ(outMesh->getNumVertices(), mesh1->getNumVertices() + mesh2->getNumVertices());
     EXPECT_EQ(outMesh->getNumCells(), mesh1->getNumCells() + mesh2->getNumCells());
-}
\ No newline at end of file
+}
+
+TEST(AppendMeshTest, Attributes)
+{
+    auto mesh1 = makeRect();
+    auto mesh2 = makeRect();
+    mesh2->setVertexAttribute("extra", std::make_shared<DataArray<double>>(mesh2->getNumVertices()));
+
+    AppendMesh append;
+    append.addInputMesh(mesh1);
+    append.addInputMesh(mesh2);
+    append.update();
+
+    auto outMesh = append.getOutputMesh();
+
+    // Cells of the second mesh are offset by the vertices of the first
+    EXPECT_EQ((*outMesh->getCells())[mesh1->getNumCells()],
+        (*mesh2->getCells())[0] + Vec3i::Constant(mesh1->getNumVertices()));
+
+    // Only attributes common to all inputs are appended
+    EXPECT_FALSE(outMesh->hasVertexAttribute("extra"));
+    auto scalars = std::dynamic_pointer_cast<DataArray<float>>(outMesh->getVertexScalars());
+    ASSERT_NE(scalars, nullptr);
+    ASSERT_EQ(scalars->size(), outMesh->getNumVertices());
+    EXPECT_EQ((*scalars)[mesh1->getNumVertices() + 5], 2.0f);
+}
@@ -0,0 +1,104 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkCleanMesh.h"
+#include "imstkLineMesh.h"
+#include "imstkSurfaceMesh.h"
+
+#include <gtest/gtest.h>
+
+using namespace imstk;
+
+///
+/// \brief Two triangles forming a quad, not sharing their diagonal vertices,
+/// plus an unused vertex
+///
+static std::shared_ptr<SurfaceMesh>
+makeSplitQuad(const double gap)
+{
+    auto verticesPtr = std::make_shared<VecDataArray<double, 3>>();
+    verticesPtr->push_back(Vec3d(0.0, 0.0, 0.0));
+    verticesPtr->push_back(Vec3d(1.0, 0.0, 0.0));
+    verticesPtr->push_back(Vec3d(0.0, 0.0, 1.0));
+    verticesPtr->push_back(Vec3d(1.0 + gap, 0.0, 0.0));
+    verticesPtr->push_back(Vec3d(1.0, 0.0, 1.0));
+    verticesPtr->push_back(Vec3d(0.0, 0.0, 1.0 + gap));
+    verticesPtr->push_back(Vec3d(5.0, 5.0, 5.0));
+
+    auto cellsPtr = std::make_shared<VecDataArray<int, 3>>();
+    cellsPtr->push_back(Vec3i(0, 1, 2));
+    cellsPtr->push_back(Vec3i(3, 4, 5));
+
+    auto scalarsPtr = std::make_shared<DataArray<float>>();
+    for (int i = 0; i < verticesPtr->size(); i++)
+    {
+        scalarsPtr->push_back(static_cast<float>(i));
+    }
+
+    auto mesh = std::make_shared<SurfaceMesh>();
+    mesh->initialize(verticesPtr, cellsPtr);
+    mesh->setVertexAttribute("scalars", scalarsPtr);
+    mesh->setVertexScalars("scalars");
+    return mesh;
+}
+
+TEST(CleanMeshTest, MergeCoincident)
+{
+    CleanMesh clean;
+    clean.setInputMesh(makeSplitQuad(0.0));
+    clean.setTolerance(0.0);
+    clean.update();
+
+    auto outputMesh = std::dynamic_pointer_cast<SurfaceMesh>(clean.getOutput());
+    ASSERT_NE(outputMesh, nullptr);
+    EXPECT_EQ(outputMesh->getNumVertices(), 4);
+    EXPECT_EQ(outputMesh->getNumCells(), 2);
+    EXPECT_EQ((*outputMesh->getCells())[1], Vec3i(1, 3, 2));
+
+    // Attributes follow the points kept
+    auto scalarsPtr = std::dynamic_pointer_cast<DataArray<float>>(outputMesh->getVertexScalars());
+    ASSERT_NE(scalarsPtr, nullptr);
+    EXPECT_EQ(scalarsPtr->size(), 4);
+    EXPECT_EQ((*scalarsPtr)[3], 4.0f);
+}
+
+TEST(CleanMeshTest, MergeWithinTolerance)
+{
+    CleanMesh clean;
+    clean.setInputMesh(makeSplitQuad(0.01));
+    clean.setAbsoluteTolerance(0.05);
+    clean.update();
+    EXPECT_EQ(std::dynamic_pointer_cast<SurfaceMesh>(clean.getOutput())->getNumVertices(), 4);
+
+    // Gap larger than the tolerance, only the unused vertex is removed
+    clean.setAbsoluteTolerance(0.001);
+    clean.update();
+    EXPECT_EQ(std::dynamic_pointer_cast<SurfaceMesh>(clean.getOutput())->getNumVertices(), 6);
+}
+
+TEST(CleanMeshTest, RemoveDegenerateLines)
+{
+    auto verticesPtr = std::make_shared<VecDataArray<double, 3>>();
+    verticesPtr->push_back(Vec3d(0.0, 0.0, 0.0));
+    verticesPtr->push_back(Vec3d(0.0, 0.0, 0.0));
+    verticesPtr->push_back(Vec3d(1.0, 0.0, 0.0));
+    auto cellsPtr = std::make_shared<VecDataArray<int, 2>>();
+    cellsPtr->push_back(Vec2i(0, 1));
+    cellsPtr->push_back(Vec2i(1, 2));
+    auto lineMesh = std::make_shared<LineMesh>();
+    lineMesh->initialize(verticesPtr, cellsPtr);
+
+    CleanMesh clean;
+    clean.setInput(lineMesh);
+    clean.setTolerance(0.0);
+    clean.update();
+
+    auto outputMesh = std::dynamic_pointer_cast<LineMesh>(clean.getOutput());
+    ASSERT_NE(outputMesh, nullptr);
+    EXPECT_EQ(outputMesh->getNumVertices(), 2);
+    EXPECT_EQ(outputMesh->getNumCells(), 1);
+    EXPECT_EQ((*outputMesh->getCells())[0], Vec2i(0, 1));
+}
@@ -0,0 +1,42 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkExtractEdges.h"
+#include "imstkLineMesh.h"
+#include "imstkSurfaceMesh.h"
+
+#include <gtest/gtest.h>
+
+using namespace imstk;
+
+TEST(ExtractEdgesTest, Quad)
+{
+    auto verticesPtr = std::make_shared<VecDataArray<double, 3>>();
+    verticesPtr->push_back(Vec3d(0.0, 0.0, 0.0));
+    verticesPtr->push_back(Vec3d(1.0, 0.0, 0.0));
+    verticesPtr->push_back(Vec3d(0.0, 0.0, 1.0));
+    verticesPtr->push_back(Vec3d(1.0, 0.0, 1.0));
+    auto cellsPtr = std::make_shared<VecDataArray<int, 3>>();
+    cellsPtr->push_back(Vec3i(0, 1, 2));
+    cellsPtr->push_back(Vec3i(1, 3, 2));
+    auto surfMesh = std::make_shared<SurfaceMesh>();
+    surfMesh->initialize(verticesPtr, cellsPtr);
+
+    ExtractEdges extractEdges;
+    extractEdges.setInputMesh(surfMesh);
+    extractEdges.update();
+
+    // The shared diagonal is only output once
+    auto lineMesh = extractEdges.getOutputMesh();
+    EXPECT_EQ(lineMesh->getNumVertices(), 4);
+    ASSERT_EQ(lineMesh->getNumCells(), 5);
+    const VecDataArray<int, 2>& lines = *lineMesh->getCells();
+    EXPECT_EQ(lines[0], Vec2i(0, 1));
+    EXPECT_EQ(lines[1], Vec2i(0, 2));
+    EXPECT_EQ(lines[2], Vec2i(1, 2));
+    EXPECT_EQ(lines[3], Vec2i(1, 3));
+    EXPECT_EQ(lines[4], Vec2i(2, 3));
+}
@@ -41,4 +41,66 @@ TEST(FastMarchTest, Filter)
     EXPECT_EQ(scalars[image->getScalarIndex(25, 26, 25)], 1.0);
     EXPECT_EQ(scalars[image->getScalarIndex(25, 25, 24)], 1.0);
     EXPECT_EQ(scalars[image->getScalarIndex(25, 25, 26)], 1.0);
-}
\ No newline at end of file
+}
+
+TEST(FastMarchTest, SweepingMatchesHeap)
+{
+    // Anisotropic image with two seeds of different start values
+    auto image = std::make_shared<ImageData>();
+    image->allocate(IMSTK_DOUBLE, 1, Vec3i(20, 24, 16), Vec3d(1.0, 0.5, 2.0));
+    auto               scalarsPtr = std::dynamic_pointer_cast<DataArray<double>>(image->getScalars());
+    DataArray<double>& scalars    = *scalarsPtr;
+    std::vector<Vec3i> seeds      = { Vec3i(3, 4, 5), Vec3i(15, 20, 10) };
+
+    FastMarch fastMarch;
+    fastMarch.setImage(image);
+    fastMarch.setSeeds(seeds);
+
+    scalars.fill(0.0);
+    scalars[image->getScalarIndex(seeds[1])] = 2.0;
+    fastMarch.solve();
+    const DataArray<double> heapResult = scalars;
+
+    // Along an axis from a seed the distance is exact
+    EXPECT_DOUBLE_EQ(heapResult[image->getScalarIndex(8, 4, 5)], 5.0);
+    EXPECT_DOUBLE_EQ(heapResult[image->getScalarIndex(3, 8, 5)], 2.0);
+    EXPECT_DOUBLE_EQ(heapResult[image->getScalarIndex(3, 4, 2)], 6.0);
+    EXPECT_DOUBLE_EQ(heapResult[image->getScalarIndex(15, 20, 12)], 6.0);
+
+    scalars.fill(0.0);
+    scalars[image->getScalarIndex(seeds[1])] = 2.0;
+    fastMarch.setUseSweeping(true);
+    fastMarch.solve();
+    for (int i = 0; i < scalars.size(); i++)
+    {
+        EXPECT_NEAR(scalars[i], heapResult[i], 1.0e-9);
+    }
+}
+
+TEST(FastMarchTest, Threshold)
+{
+    auto image = std::make_shared<ImageData>();
+    image->allocate(IMSTK_DOUBLE, 1, Vec3i(30, 30, 30));
+    auto               scalarsPtr = std::dynamic_pointer_cast<DataArray<double>>(image->getScalars());
+    DataArray<double>& scalars    = *scalarsPtr;
+
+    FastMarch fastMarch;
+    fastMarch.setImage(image);
+    fastMarch.setDistThreshold(3.0);
+
+    // Solve twice from different seeds, the second solve should not keep the first
+    for (const Vec3i& seed : { Vec3i(5, 5, 5), Vec3i(20, 20, 20) })
+    {
+        scalars.fill(-1.0);
+        scalars[image->getScalarIndex(seed)] = 0.0;
+        fastMarch.setSeeds({ seed });
+        fastMarch.solve();
+
+        // Voxels are solved up to the threshold, their neighbors reached but not solved
+        EXPECT_TRUE(fastMarch.isVisited(static_cast<int>(image->getScalarIndex(seed + Vec3i(2, 0, 0)))));
+        EXPECT_DOUBLE_EQ(scalars[image->getScalarIndex(seed + Vec3i(3, 0, 0))], 3.0);
+        EXPECT_FALSE(fastMarch.isVisited(static_cast<int>(image->getScalarIndex(seed + Vec3i(3, 0, 0)))));
+        EXPECT_EQ(scalars[image->getScalarIndex(seed + Vec3i(4, 0, 0))], -1.0);
+    }
+    EXPECT_FALSE(fastMarch.isVisited(static_cast<int>(image->getScalarIndex(5, 5, 5))));
+}
@@ -6,12 +6,16 @@
 
 #include "gtest/gtest.h"
 
+#include "imstkDataArray.h"
 #include "imstkGeometryUtilities.h"
 #include "imstkImageData.h"
 #include "imstkOrientedBox.h"
 #include "imstkSurfaceMesh.h"
 #include "imstkSurfaceMeshDistanceTransform.h"
 
+#include <cstdio>
+#include <fstream>
+
 using namespace imstk;
 
 TEST(SurfaceMeshDistanceTransformTest, FilterWithBounds)
@@ -61,4 +65,88 @@ TEST(SurfaceMeshDistanceTransformTest, FilterWithoutBounds)
 
     EXPECT_EQ(dimensions, image->getDimensions());
     EXPECT_TRUE(bounds.isApprox(image->getBounds()));
-}
\ No newline at end of file
+}
+
+///
+/// \brief Compare the distances to those of the analytic box, voxels within maxExactDist
+/// of the surface should be exact, the rest only of the right sign
+///
+static void
+testAgainstBox(std::shared_ptr<ImageData> image, std::shared_ptr<OrientedBox> box, const double maxExactDist)
+{
+    const Vec3i&             dim     = image->getDimensions();
+    const Vec3d&             spacing = image->getSpacing();
+    const Vec3d              shift   = image->getOrigin() + spacing * 0.5;
+    const DataArray<double>& scalars = *std::dynamic_pointer_cast<DataArray<double>>(image->getScalars());
+    for (int z = 0; z < dim[2]; z++)
+    {
+        for (int y = 0; y < dim[1]; y++)
+        {
+            for (int x = 0; x < dim[0]; x++)
+            {
+                const Vec3d  pos      = Vec3d(x, y, z).cwiseProduct(spacing) + shift;
+                const double expected = box->getFunctionValue(pos);
+                const double dist     = scalars[ImageData::getScalarIndex(x, y, z, dim, 1)];
+                if (std::abs(expected) < maxExactDist)
+                {
+                    EXPECT_NEAR(dist, expected, 1.0e-9);
+                }
+                else
+                {
+                    EXPECT_EQ(dist < 0.0, expected < 0.0);
+                }
+            }
+        }
+    }
+}
+
+TEST(SurfaceMeshDistanceTransformTest, ExactDistances)
+{
+    auto box  = std::make_shared<OrientedBox>();
+    auto mesh = GeometryUtils::toSurfaceMesh(box);
+
+    auto toSdf = std::make_shared<SurfaceMeshDistanceTransform>();
+    toSdf->setInputMesh(mesh);
+    toSdf->setBounds(Vec3d(-1.0, -1.0, -1.0), Vec3d(1.0, 1.0, 1.0));
+    toSdf->setDimensions(20, 21, 22);
+    toSdf->update();
+    testAgainstBox(toSdf->getOutputImage(), box, IMSTK_DOUBLE_MAX);
+
+    // Narrow banded is exact within the band
+    toSdf->setNarrowBanded(true);
+    toSdf->setDilateSize(2);
+    toSdf->update();
+    testAgainstBox(toSdf->getOutputImage(), box, 2.0 * toSdf->getOutputImage()->getSpacing().maxCoeff());
+}
+
+TEST(SurfaceMeshDistanceTransformTest, Cache)
+{
+    const std::string cacheFile = "SurfaceMeshDistanceTransformTestCache.sdf";
+    std::remove(cacheFile.c_str());
+
+    auto mesh  = GeometryUtils::toSurfaceMesh(std::make_shared<OrientedBox>());
+    auto toSdf = std::make_shared<SurfaceMeshDistanceTransform>();
+    toSdf->setInputMesh(mesh);
+    toSdf->setBounds(Vec3d(-1.0, -1.0, -1.0), Vec3d(1.0, 1.0, 1.0));
+    toSdf->setDimensions(8, 8, 8);
+    toSdf->setCacheFile(cacheFile);
+    toSdf->update();
+
+    // Tamper with the first value of the cache, after its 16 bytes header, it should be read back
+    {
+        const double value = 123.0;
+        std::fstream file(cacheFile, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(16);
+        file.write(reinterpret_cast<const char*>(&value), sizeof(double));
+    }
+    toSdf->update();
+    EXPECT_EQ((*std::dynamic_pointer_cast<DataArray<double>>(toSdf->getOutputImage()->getScalars()))[0], 123.0);
+
+    // Different parameters recompute
+    toSdf->setDimensions(9, 8, 8);
+    toSdf->update();
+    EXPECT_EQ(toSdf->getOutputImage()->getScalars()->size(), 9 * 8 * 8);
+    EXPECT_NE((*std::dynamic_pointer_cast<DataArray<double>>(toSdf->getOutputImage()->getScalars()))[0], 123.0);
+
+    std::remove(cacheFile.c_str());
+}
@@ -0,0 +1,140 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkSurfaceMesh.h"
+#include "imstkSurfaceMeshSmoothen.h"
+
+#include <gtest/gtest.h>
+
+using namespace imstk;
+
+///
+/// \brief Flat n by n grid of vertices in the xz plane, every interior vertex
+/// pushed up or down in y alternately
+///
+static std::shared_ptr<SurfaceMesh>
+makeNoisyGrid(const int n)
+{
+    auto verticesPtr = std::make_shared<VecDataArray<double, 3>>();
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            const bool   isInterior = (i > 0 && i < n - 1 && j > 0 && j < n - 1);
+            const double y = isInterior ? (((i + j) % 2 == 0) ? 0.5 : -0.5) : 0.0;
+            verticesPtr->push_back(Vec3d(static_cast<double>(i), y, static_cast<double>(j)));
+        }
+    }
+    auto cellsPtr = std::make_shared<VecDataArray<int, 3>>();
+    for (int i = 0; i < n - 1; i++)
+    {
+        for (int j = 0; j < n - 1; j++)
+        {
+            const int v = i * n + j;
+            cellsPtr->push_back(Vec3i(v, v + 1, v + n));
+            cellsPtr->push_back(Vec3i(v + 1, v + n + 1, v + n));
+        }
+    }
+    auto mesh = std::make_shared<SurfaceMesh>();
+    mesh->initialize(verticesPtr, cellsPtr);
+    return mesh;
+}
+
+static double
+getMaxHeight(const VecDataArray<double, 3>& vertices)
+{
+    double maxHeight = 0.0;
+    for (const Vec3d& vertex : vertices)
+    {
+        maxHeight = std::max(maxHeight, std::abs(vertex[1]));
+    }
+    return maxHeight;
+}
+
+TEST(SurfaceMeshSmoothenTest, ReduceNoise)
+{
+    auto inputMesh = makeNoisyGrid(8);
+
+    SurfaceMeshSmoothen smoothen;
+    smoothen.setInputMesh(inputMesh);
+    smoothen.setNumberOfIterations(50);
+    smoothen.setRelaxationFactor(0.1);
+    smoothen.update();
+
+    auto outputMesh = std::dynamic_pointer_cast<SurfaceMesh>(smoothen.getOutput());
+    ASSERT_EQ(outputMesh->getNumVertices(), inputMesh->getNumVertices());
+    EXPECT_EQ(outputMesh->getNumCells(), inputMesh->getNumCells());
+    EXPECT_LT(getMaxHeight(*outputMesh->getVertexPositions()), 0.25);
+
+    // Corners are sharper than the edge angle and stay fixed
+    EXPECT_TRUE((*outputMesh->getVertexPositions())[0].isApprox(Vec3d::Zero()));
+}
+
+TEST(SurfaceMeshSmoothenTest, SmoothVertexIds)
+{
+    auto inputMesh = makeNoisyGrid(8);
+
+    SurfaceMeshSmoothen smoothen;
+    smoothen.setInputMesh(inputMesh);
+    smoothen.setVertexIds({ 9 });
+    smoothen.update();
+
+    const VecDataArray<double, 3>& inputVertices  = *inputMesh->getVertexPositions();
+    const VecDataArray<double, 3>& outputVertices = *std::dynamic_pointer_cast<SurfaceMesh>(smoothen.getOutput())->getVertexPositions();
+    for (int i = 0; i < inputVertices.size(); i++)
+    {
+        if (i == 9)
+        {
+            EXPECT_FALSE(outputVertices[i].isApprox(inputVertices[i]));
+        }
+        else
+        {
+            EXPECT_TRUE(outputVertices[i].isApprox(inputVertices[i]));
+        }
+    }
+}
+
+///
+/// \brief Test that the adjacency kept between updates follows changes of the topology,
+/// whether the index buffer is modified in place or replaced
+///
+TEST(SurfaceMeshSmoothenTest, TopologyChange)
+{
+    auto inputMesh = makeNoisyGrid(8);
+
+    SurfaceMeshSmoothen smoothen;
+    smoothen.setInputMesh(inputMesh);
+    smoothen.update();
+
+    auto expectSameAsNewFilter = [&]()
+                                 {
+                                     SurfaceMeshSmoothen newSmoothen;
+                                     newSmoothen.setInputMesh(inputMesh);
+                                     newSmoothen.update();
+
+                                     smoothen.update();
+                                     const VecDataArray<double, 3>& vertices = *std::dynamic_pointer_cast<SurfaceMesh>(smoothen.getOutput())->getVertexPositions();
+                                     const VecDataArray<double, 3>& expectedVertices = *std::dynamic_pointer_cast<SurfaceMesh>(newSmoothen.getOutput())->getVertexPositions();
+                                     for (int i = 0; i < vertices.size(); i++)
+                                     {
+                                         EXPECT_TRUE(vertices[i].isApprox(expectedVertices[i]));
+                                     }
+                                 };
+
+    // Remove the first triangle, in place
+    std::shared_ptr<VecDataArray<int, 3>> cellsPtr = inputMesh->getCells();
+    (*cellsPtr)[0] = (*cellsPtr)[cellsPtr->size() - 1];
+    cellsPtr->resize(cellsPtr->size() - 1);
+    cellsPtr->postModified();
+    expectSameAsNewFilter();
+
+    // Remove the second triangle, in a new buffer
+    auto newCellsPtr = std::make_shared<VecDataArray<int, 3>>(*cellsPtr);
+    (*newCellsPtr)[1] = (*newCellsPtr)[newCellsPtr->size() - 1];
+    newCellsPtr->resize(newCellsPtr->size() - 1);
+    inputMesh->setCells(newCellsPtr);
+    expectSameAsNewFilter();
+}
@@ -7,6 +7,7 @@
 #include "imstkAppendMesh.h"
 #include "imstkGeometryUtilities.h"
 #include "imstkLogger.h"
+#include "imstkParallelUtils.h"
 #include "imstkSurfaceMesh.h"
 
 #include <vtkAppendPolyData.h>
@@ -36,7 +37,7 @@ AppendMesh::getOutputMesh() const
 void
 AppendMesh::requestUpdate()
 {
-    vtkNew<vtkAppendPolyData> filter;
+    std::vector<std::shared_ptr<SurfaceMesh>> inputMeshes;
     for (size_t i = 0; i < getNumInputPorts(); i++)
     {
         std::shared_ptr<SurfaceMesh> inputMesh = std::dynamic_pointer_cast<SurfaceMesh>(getInput(i));
@@ -45,10 +46,158 @@ AppendMesh::requestUpdate()
             LOG(WARNING) << "Input " << i << " invalid";
             return;
         }
+        inputMeshes.push_back(inputMesh);
+    }
+    if (inputMeshes.empty())
+    {
+        LOG(WARNING) << "No inputMesh to append";
+        return;
+    }
+
+    if (m_UseVtk)
+    {
+        appendVtk(inputMeshes);
+    }
+    else
+    {
+        appendNative(inputMeshes);
+    }
+}
+
+void
+AppendMesh::appendVtk(const std::vector<std::shared_ptr<SurfaceMesh>>& inputMeshes)
+{
+    vtkNew<vtkAppendPolyData> filter;
+    for (const auto& inputMesh : inputMeshes)
+    {
         filter->AddInputData(GeometryUtils::copyToVtkPolyData(inputMesh));
     }
     filter->Update();
 
     setOutput(GeometryUtils::copyToSurfaceMesh(filter->GetOutput()));
 }
-} // namespace imstk
\ No newline at end of file
+
+namespace
+{
+///
+/// \brief Append the arrays of the attributes present in every input with the same
+/// type and number of components, offsets gives where each input begins
+///
+std::unordered_map<std::string, std::shared_ptr<AbstractDataArray>>
+appendAttributes(const std::vector<const std::unordered_map<std::string, std::shared_ptr<AbstractDataArray>>*>& attributes,
+                 const std::vector<int>& offsets)
+{
+    std::unordered_map<std::string, std::shared_ptr<AbstractDataArray>> results;
+    for (const auto& attribute : *attributes[0])
+    {
+        const std::shared_ptr<AbstractDataArray>& arr0 = attribute.second;
+        bool                                      isCommon = true;
+        for (size_t i = 1; i < attributes.size() && isCommon; i++)
+        {
+            auto iter = attributes[i]->find(attribute.first);
+            isCommon = (iter != attributes[i]->end())
+                       && iter->second->getScalarType() == arr0->getScalarType()
+                       && iter->second->getNumberOfComponents() == arr0->getNumberOfComponents();
+        }
+        if (!isCommon)
+        {
+            continue;
+        }
+
+        std::shared_ptr<AbstractDataArray> result = arr0->clone();
+        result->resize(offsets.back());
+        for (size_t i = 0; i < attributes.size(); i++)
+        {
+            GeometryUtils::copyDataArrayTuples(attributes[i]->at(attribute.first), result, std::vector<int>(), offsets[i]);
+        }
+        results[attribute.first] = result;
+    }
+    return results;
+}
+} // namespace
+
+void
+AppendMesh::appendNative(const std::vector<std::shared_ptr<SurfaceMesh>>& inputMeshes)
+{
+    // Offsets of every input's vertices and cells in the output
+    std::vector<int> vertexOffsets(1, 0);
+    std::vector<int> cellOffsets(1, 0);
+    for (const auto& inputMesh : inputMeshes)
+    {
+        vertexOffsets.push_back(vertexOffsets.back() + inputMesh->getNumVertices());
+        cellOffsets.push_back(cellOffsets.back() + inputMesh->getNumCells());
+    }
+
+    auto                     verticesPtr = std::make_shared<VecDataArray<double, 3>>(vertexOffsets.back());
+    auto                     cellsPtr    = std::make_shared<VecDataArray<int, 3>>(cellOffsets.back());
+    VecDataArray<double, 3>& vertices    = *verticesPtr;
+    VecDataArray<int, 3>&    cells       = *cellsPtr;
+    ParallelUtils::parallelFor(inputMeshes.size(), [&](const int i)
+        {
+            const VecDataArray<double, 3>& inputVertices = *inputMeshes[i]->getVertexPositions();
+            const VecDataArray<int, 3>&    inputCells    = *inputMeshes[i]->getCells();
+            for (int j = 0; j < inputVertices.size(); j++)
+            {
+                vertices[vertexOffsets[i] + j] = inputVertices[j];
+            }
+            const Vec3i offset = Vec3i::Constant(vertexOffsets[i]);
+            for (int j = 0; j < inputCells.size(); j++)
+            {
+                cells[cellOffsets[i] + j] = inputCells[j] + offset;
+            }
+        }, inputMeshes.size() > 1);
+
+    auto outputMesh = std::make_shared<SurfaceMesh>();
+    outputMesh->initialize(verticesPtr, cellsPtr);
+
+    std::vector<const std::unordered_map<std::string, std::shared_ptr<AbstractDataArray>>*> vertexAttributes;
+    std::vector<const std::unordered_map<std::string, std::shared_ptr<AbstractDataArray>>*> cellAttributes;
+    for (const auto& inputMesh : inputMeshes)
+    {
+        vertexAttributes.push_back(&inputMesh->getVertexAttributes());
+        cellAttributes.push_back(&inputMesh->getCellAttributes());
+    }
+    outputMesh->setVertexAttributes(appendAttributes(vertexAttributes, vertexOffsets));
+    outputMesh->setCellAttributes(appendAttributes(cellAttributes, cellOffsets));
+
+    // Active attributes follow the first input, when they were appended
+    std::shared_ptr<SurfaceMesh> firstMesh = inputMeshes[0];
+    auto                         hasVertexAttribute = [&](const std::string& name)
+                                                      {
+                                                          return !name.empty() && outputMesh->hasVertexAttribute(name);
+                                                      };
+    if (hasVertexAttribute(firstMesh->getActiveVertexNormals()))
+    {
+        outputMesh->setVertexNormals(firstMesh->getActiveVertexNormals());
+    }
+    if (hasVertexAttribute(firstMesh->getActiveVertexScalars()))
+    {
+        outputMesh->setVertexScalars(firstMesh->getActiveVertexScalars());
+    }
+    if (hasVertexAttribute(firstMesh->getActiveVertexTangents()))
+    {
+        outputMesh->setVertexTangents(firstMesh->getActiveVertexTangents());
+    }
+    if (hasVertexAttribute(firstMesh->getActiveVertexTCoords()))
+    {
+        outputMesh->setVertexTCoords(firstMesh->getActiveVertexTCoords());
+    }
+    auto hasCellAttribute = [&](const std::string& name)
+                            {
+                                return !name.empty() && outputMesh->hasCellAttribute(name);
+                            };
+    if (hasCellAttribute(firstMesh->getActiveCellNormals()))
+    {
+        outputMesh->setCellNormals(firstMesh->getActiveCellNormals());
+    }
+    if (hasCellAttribute(firstMesh->getActiveCellScalars()))
+    {
+        outputMesh->setCellScalars(firstMesh->getActiveCellScalars());
+    }
+    if (hasCellAttribute(firstMesh->getActiveCellTangents()))
+    {
+        outputMesh->setCellTangents(firstMesh->getActiveCellTangents());
+    }
+    setOutput(outputMesh);
+}
+} // namespace imstk
@@ -8,6 +8,8 @@
 
 #include "imstkGeometryAlgorithm.h"
 
+#include <vector>
+
 namespace imstk
 {
 class SurfaceMesh;
@@ -15,7 +17,10 @@ class SurfaceMesh;
 ///
 /// \class AppendMesh
 ///
-/// \brief This filter appends two SurfaceMeshes, no topological connections are made
+/// \brief This filter appends two SurfaceMeshes, no topological connections are made.
+/// Vertex and cell attributes present in every input, with the same type and number
+/// of components, are appended too. Active attributes are those of the first input.
+/// VTK is used instead if UseVtk is set
 ///
 class AppendMesh : public GeometryAlgorithm
 {
@@ -26,7 +31,16 @@ public:
     void addInputMesh(std::shared_ptr<SurfaceMesh> inputMesh);
     std::shared_ptr<SurfaceMesh> getOutputMesh() const;
 
+    imstkGetMacro(UseVtk, bool);
+    imstkSetMacro(UseVtk, bool);
+
 protected:
     void requestUpdate() override;
+
+    void appendVtk(const std::vector<std::shared_ptr<SurfaceMesh>>& inputMeshes);
+    void appendNative(const std::vector<std::shared_ptr<SurfaceMesh>>& inputMeshes);
+
+private:
+    bool m_UseVtk = false;
 };
 } // namespace imstk
\ No newline at end of file
@@ -9,15 +9,38 @@
 #include "imstkSurfaceMesh.h"
 #include "imstkLogger.h"
 #include "imstkGeometryUtilities.h"
+#include "imstkParallelUtils.h"
 
 #include <vtkCleanPolyData.h>
 
+#include <array>
+#include <cstdint>
+#include <cstring>
+
 namespace imstk
 {
+namespace
+{
+///
+/// \brief Hash of the bin a point falls in
+///
+struct KeyHash
+{
+    std::size_t operator()(const std::array<long long, 3>& key) const
+    {
+        // Multiply unsigned so large bins wrap instead of overflowing
+        return static_cast<std::size_t>(
+            static_cast<std::uint64_t>(key[0]) * 73856093ULL
+            ^ static_cast<std::uint64_t>(key[1]) * 19349663ULL
+            ^ static_cast<std::uint64_t>(key[2]) * 83492791ULL);
+    }
+};
+} // namespace
+
 CleanMesh::CleanMesh()
 {
     setNumInputPorts(1);
-    setRequiredInputType<SurfaceMesh>(0);
+    setRequiredInputType<PointSet>(0);
 
     setNumOutputPorts(1);
     setOutput(std::make_shared<SurfaceMesh>());
@@ -44,19 +67,38 @@ CleanMesh::requestUpdate()
         LOG(WARNING) << "No inputMesh to clean";
         return;
     }
+    if (std::dynamic_pointer_cast<LineMesh>(inputMesh) == nullptr
+        && std::dynamic_pointer_cast<SurfaceMesh>(inputMesh) == nullptr)
+    {
+        LOG(WARNING) << "Unsupported mesh type";
+        return;
+    }
+
+    if (m_UseVtk)
+    {
+        cleanVtk(inputMesh);
+    }
+    else if (auto lineMesh = std::dynamic_pointer_cast<LineMesh>(inputMesh))
+    {
+        cleanNative(lineMesh);
+    }
+    else
+    {
+        cleanNative(std::dynamic_pointer_cast<SurfaceMesh>(inputMesh));
+    }
+}
+
+void
+CleanMesh::cleanVtk(std::shared_ptr<PointSet> inputMesh)
+{
     vtkSmartPointer<vtkPolyData> inputMeshVtk = nullptr;
     if (auto lineMesh = std::dynamic_pointer_cast<LineMesh>(inputMesh))
     {
         inputMeshVtk = GeometryUtils::copyToVtkPolyData(lineMesh);
     }
-    else if (auto surfMesh = std::dynamic_pointer_cast<SurfaceMesh>(inputMesh))
-    {
-        inputMeshVtk = GeometryUtils::copyToVtkPolyData(surfMesh);
-    }
     else
     {
-        LOG(WARNING) << "Unsupported mesh type";
-        return;
+        inputMeshVtk = GeometryUtils::copyToVtkPolyData(std::dynamic_pointer_cast<SurfaceMesh>(inputMesh));
     }
 
     vtkNew<vtkCleanPolyData> filter;
@@ -70,9 +112,132 @@ CleanMesh::requestUpdate()
     {
         setOutput(GeometryUtils::copyToLineMesh(filter->GetOutput()));
     }
-    else if (std::dynamic_pointer_cast<SurfaceMesh>(inputMesh) != nullptr)
+    else
     {
         setOutput(GeometryUtils::copyToSurfaceMesh(filter->GetOutput()));
     }
 }
-} // namespace imstk
\ No newline at end of file
+
+template<typename MeshType>
+void
+CleanMesh::cleanNative(std::shared_ptr<MeshType> inputMesh)
+{
+    constexpr int N = MeshType::CellVertexCount;
+    std::shared_ptr<VecDataArray<double, 3>> verticesPtr = inputMesh->getVertexPositions();
+    const VecDataArray<double, 3>&           vertices    = *verticesPtr;
+    const VecDataArray<int, N>&              cells       = *inputMesh->getCells();
+
+    double tolerance = m_AbsoluteTolerance;
+    if (!m_UseAbsolute)
+    {
+        Vec3d min, max;
+        ParallelUtils::findAABB(vertices, min, max);
+        tolerance = m_Tolerance * (max - min).norm();
+    }
+
+    // Bin the points in a grid of the tolerance, then a point only needs to be compared
+    // to those of the neighboring bins. Without tolerance, bin by exact position
+    const bool useTolerance = (tolerance > 0.0);
+    auto       getKey       = [&](const Vec3d& pos)
+                              {
+                                  std::array<long long, 3> key;
+                                  for (int i = 0; i < 3; i++)
+                                  {
+                                      if (useTolerance)
+                                      {
+                                          key[i] = static_cast<long long>(std::floor(pos[i] / tolerance));
+                                      }
+                                      else
+                                      {
+                                          const double val = pos[i] + 0.0; // -0.0 to 0.0
+                                          std::memcpy(&key[i], &val, sizeof(double));
+                                      }
+                                  }
+                                  return key;
+                              };
+    std::unordered_map<std::array<long long, 3>, std::vector<int>, KeyHash> bins;
+
+    // Merge every point into the first one within tolerance met going through the cells
+    const double     sqrTolerance = tolerance * tolerance;
+    std::vector<int> newIds(vertices.size(), -1);
+    std::vector<int> oldIds; ///< Old id of every new point
+    for (int i = 0; i < cells.size(); i++)
+    {
+        for (int j = 0; j < N; j++)
+        {
+            const int vertexId = cells[i][j];
+            if (newIds[vertexId] != -1)
+            {
+                continue;
+            }
+            const Vec3d&                   pos = vertices[vertexId];
+            const std::array<long long, 3> key = getKey(pos);
+            const int                      range = useTolerance ? 1 : 0;
+            for (long long x = key[0] - range; x <= key[0] + range && newIds[vertexId] == -1; x++)
+            {
+                for (long long y = key[1] - range; y <= key[1] + range && newIds[vertexId] == -1; y++)
+                {
+                    for (long long z = key[2] - range; z <= key[2] + range && newIds[vertexId] == -1; z++)
+                    {
+                        auto bin = bins.find({ x, y, z });
+                        if (bin == bins.end())
+                        {
+                            continue;
+                        }
+                        for (const int newId : bin->second)
+                        {
+                            if ((vertices[oldIds[newId]] - pos).squaredNorm() <= sqrTolerance)
+                            {
+                                newIds[vertexId] = newId;
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+            if (newIds[vertexId] == -1)
+            {
+                newIds[vertexId] = static_cast<int>(oldIds.size());
+                bins[key].push_back(newIds[vertexId]);
+                oldIds.push_back(vertexId);
+            }
+        }
+    }
+
+    // Remap the cells, removing those with repeated points
+    auto                 newCellsPtr = std::make_shared<VecDataArray<int, N>>(cells.size());
+    VecDataArray<int, N>& newCells   = *newCellsPtr;
+    std::vector<char>    isDegenerate(cells.size(), 0);
+    ParallelUtils::parallelFor(cells.size(), [&](const int i)
+        {
+            for (int j = 0; j < N; j++)
+            {
+                newCells[i][j] = newIds[cells[i][j]];
+                for (int k = 0; k < j; k++)
+                {
+                    isDegenerate[i] |= (newCells[i][j] == newCells[i][k]);
+                }
+            }
+        }, cells.size() > 1000);
+    std::vector<int> cellIds;
+    cellIds.reserve(cells.size());
+    for (int i = 0; i < cells.size(); i++)
+    {
+        if (!isDegenerate[i])
+        {
+            newCells[static_cast<int>(cellIds.size())] = newCells[i];
+            cellIds.push_back(i);
+        }
+    }
+    newCells.resize(static_cast<int>(cellIds.size()));
+
+    auto newVerticesPtr = std::make_shared<VecDataArray<double, 3>>(static_cast<int>(oldIds.size()));
+    GeometryUtils::copyDataArrayTuples(verticesPtr, newVerticesPtr, oldIds);
+
+    auto outputMesh = std::make_shared<MeshType>();
+    outputMesh->initialize(newVerticesPtr, newCellsPtr);
+    GeometryUtils::copyVertexAttributes(inputMesh, outputMesh, oldIds);
+    GeometryUtils::copyCellAttributes(inputMesh, outputMesh, cellIds);
+    setOutput(outputMesh);
+}
+} // namespace imstk
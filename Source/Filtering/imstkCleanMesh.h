@@ -10,6 +10,7 @@
 
 namespace imstk
 {
+class PointSet;
 class SurfaceMesh;
 
 ///
@@ -17,7 +18,11 @@ class SurfaceMesh;
 ///
 /// \brief This filter can merge duplicate points and cells, it only works with
 /// LineMesh and SurfaceMesh. It accepts a tolerance as a fraction of the length
-/// of bounding box of the input data or an absolute tolerance
+/// of bounding box of the input data or an absolute tolerance.
+/// Like vtkCleanPolyData, which is used when UseVtk is on, points are merged into
+/// the first one met going through the cells, unused points are removed, and
+/// cells left degenerate by the merge are removed. Attributes of a merged point
+/// are those of the point it merged into.
 ///
 class CleanMesh : public GeometryAlgorithm
 {
@@ -54,12 +59,27 @@ public:
 
     imstkGetMacro(AbsoluteTolerance, double);
 
+    imstkSetMacro(UseVtk, bool);
+    imstkGetMacro(UseVtk, bool);
+
 protected:
     void requestUpdate() override;
 
+    ///
+    /// \brief Clean with vtkCleanPolyData
+    ///
+    void cleanVtk(std::shared_ptr<PointSet> inputMesh);
+
+    ///
+    /// \brief Clean natively, on the input buffers
+    ///
+    template<typename MeshType>
+    void cleanNative(std::shared_ptr<MeshType> inputMesh);
+
 private:
     double m_Tolerance = 0.0;
     double m_AbsoluteTolerance = 1.0;
     bool   m_UseAbsolute       = false;
+    bool   m_UseVtk = false;
 };
 } // namespace imstk
\ No newline at end of file
@@ -8,11 +8,14 @@
 #include "imstkGeometryUtilities.h"
 #include "imstkLineMesh.h"
 #include "imstkLogger.h"
+#include "imstkParallelUtils.h"
 #include "imstkSurfaceMesh.h"
 
 #include <vtkExtractEdges.h>
 #include <vtkTriangleFilter.h>
 
+#include <algorithm>
+
 namespace imstk
 {
 ExtractEdges::ExtractEdges()
@@ -46,6 +49,40 @@ ExtractEdges::requestUpdate()
         return;
     }
 
+    if (!m_UseVtk)
+    {
+        const VecDataArray<int, 3>& cells = *inputMesh->getCells();
+
+        // Gather the sorted edges of every triangle, then keep the unique ones
+        std::vector<Vec2i> edges(cells.size() * 3);
+        ParallelUtils::parallelFor(cells.size(), [&](const int i)
+            {
+                const Vec3i& cell = cells[i];
+                for (int j = 0; j < 3; j++)
+                {
+                    const int v0 = cell[j];
+                    const int v1 = cell[(j + 1) % 3];
+                    edges[i * 3 + j] = Vec2i(std::min(v0, v1), std::max(v0, v1));
+                }
+            }, cells.size() > 1000);
+        auto lessEdge = [](const Vec2i& a, const Vec2i& b)
+                        {
+                            return (a[0] < b[0]) || (a[0] == b[0] && a[1] < b[1]);
+                        };
+        std::sort(edges.begin(), edges.end(), lessEdge);
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        auto linesPtr = std::make_shared<VecDataArray<int, 2>>(static_cast<int>(edges.size()));
+        std::copy(edges.begin(), edges.end(), linesPtr->begin());
+
+        auto outputMesh = std::make_shared<LineMesh>();
+        outputMesh->initialize(
+            std::make_shared<VecDataArray<double, 3>>(*inputMesh->getVertexPositions()), linesPtr);
+        GeometryUtils::copyVertexAttributes(inputMesh, outputMesh);
+        setOutput(outputMesh);
+        return;
+    }
+
     vtkNew<vtkExtractEdges> extractEdges;
     extractEdges->SetInputData(GeometryUtils::copyToVtkPolyData(inputMesh));
     extractEdges->Update();
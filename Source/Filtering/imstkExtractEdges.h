@@ -16,7 +16,9 @@ class SurfaceMesh;
 ///
 /// \class ExtractEdges
 ///
-/// \brief This filter extracts the edges of a SurfaceMesh producing a LineMesh
+/// \brief This filter extracts the edges of a SurfaceMesh producing a LineMesh.
+/// Each edge shared by triangles is output once, sorted by vertex ids. All vertices
+/// and their attributes are kept. VTK is used instead if UseVtk is set
 ///
 class ExtractEdges : public GeometryAlgorithm
 {
@@ -28,7 +30,13 @@ public:
 
     void setInputMesh(std::shared_ptr<SurfaceMesh> inputMesh);
 
+    imstkGetMacro(UseVtk, bool);
+    imstkSetMacro(UseVtk, bool);
+
 protected:
     void requestUpdate() override;
+
+private:
+    bool m_UseVtk = false;
 };
 } // namespace imstk
\ No newline at end of file
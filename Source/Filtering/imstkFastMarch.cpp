@@ -6,8 +6,11 @@
 
 #include "imstkFastMarch.h"
 #include "imstkLogger.h"
+#include "imstkParallelUtils.h"
 #include "imstkVecDataArray.h"
 
+#include <atomic>
+
 namespace imstk
 {
 void
@@ -26,16 +29,50 @@ FastMarch::solve()
     m_spacing    = m_imageData->getSpacing();
     m_indexShift = m_dim[0] * m_dim[1];
 
-    // We maintain a solution in maps, to keep things sparse
-
-    // Sparse container for which nodes are marked visited
-    m_visited = std::unordered_set<int>();
-    // Sparse container for nodal distances
-    m_distances = std::unordered_map<int, double>();   // Solved distances
+    resetArrays(m_dim[0] * m_dim[1] * m_dim[2]);
+    if (m_UseSweeping)
+    {
+        solveSweeping(imgPtr);
+    }
+    else
+    {
+        solveHeap(imgPtr);
+    }
+}
 
-    m_queue = std::priority_queue<Node, std::vector<Node>, NodeComparator>();
+void
+FastMarch::resetArrays(const int numVoxels)
+{
+    if (static_cast<int>(m_distances.size()) != numVoxels)
+    {
+        m_distances.assign(numVoxels, IMSTK_DOUBLE_MAX);
+        m_states.assign(numVoxels, Far);
+        m_heapIndex.assign(numVoxels, -1);
+    }
+    else if (!m_reachedAll && m_reached.size() * 8 < static_cast<size_t>(numVoxels))
+    {
+        for (const int i : m_reached)
+        {
+            m_distances[i] = IMSTK_DOUBLE_MAX;
+            m_states[i]    = Far;
+            m_heapIndex[i] = -1;
+        }
+    }
+    else
+    {
+        std::fill(m_distances.begin(), m_distances.end(), IMSTK_DOUBLE_MAX);
+        std::fill(m_states.begin(), m_states.end(), Far);
+        std::fill(m_heapIndex.begin(), m_heapIndex.end(), -1);
+    }
+    m_reached.clear();
+    m_reachedAll = false;
+    m_heap.clear();
+}
 
-    // Add the initial seeds to the queue
+void
+FastMarch::solveHeap(double* imgPtr)
+{
+    // Add the initial seeds to the heap
     for (size_t i = 0; i < m_seedVoxels.size(); i++)
     {
         const Vec3i& coord = m_seedVoxels[i];
@@ -45,157 +82,280 @@ FastMarch::solve()
         {
             continue;
         }
-        const int index = static_cast<int>(m_imageData->getScalarIndex(coord));
-        m_distances[index] = imgPtr[m_imageData->getScalarIndex(coord)];
-        m_queue.push(Node(index, 0.0, coord));
+        const int index = static_cast<int>(ImageData::getScalarIndex(coord[0], coord[1], coord[2], m_dim, 1));
+        if (m_states[index] != Far)
+        {
+            continue;
+        }
+        m_distances[index] = imgPtr[index];
+        m_states[index]    = Trial;
+        m_reached.push_back(index);
+        heapPush(index);
     }
 
-    // Process every node in order of minimum distance
-    while (!m_queue.empty())
+    // Process every node in order of minimum distance, once the closest is past the
+    // threshold all the rest are too
+    while (!m_heap.empty() && m_distances[m_heap[0]] < m_distThreshold)
     {
-        Node node = m_queue.top();
-        m_queue.pop();
+        const int nodeId = heapPop();
+        m_states[nodeId] = Known;
+        const Vec3i coord(nodeId % m_dim[0], (nodeId / m_dim[0]) % m_dim[1], nodeId / m_indexShift);
 
-        const Vec3i& coord  = node.m_coord;
-        const int&   nodeId = node.m_nodeId;
+        // Update all its neighbor cells (diagonals not considered neighbors)
+        for (int axis = 0; axis < 3; axis++)
+        {
+            const int stride = (axis == 0) ? 1 : ((axis == 1) ? m_dim[0] : m_indexShift);
+            if (coord[axis] + 1 < m_dim[axis] && m_states[nodeId + stride] != Known)
+            {
+                Vec3i neighborCoord = coord;
+                neighborCoord[axis]++;
+                solveNode(neighborCoord, nodeId + stride);
+            }
+            if (coord[axis] - 1 >= 0 && m_states[nodeId - stride] != Known)
+            {
+                Vec3i neighborCoord = coord;
+                neighborCoord[axis]--;
+                solveNode(neighborCoord, nodeId - stride);
+            }
+        }
+    }
 
-        // Termination conditions
-        if (isVisited(nodeId)
-            || getDistance(nodeId) >= m_distThreshold)
+    // Write the distances reached to the image
+    for (const int i : m_reached)
+    {
+        imgPtr[i] = m_distances[i];
+    }
+}
+
+void
+FastMarch::solveSweeping(double* imgPtr)
+{
+    m_reachedAll = true;
+
+    // Seeds keep their value
+    for (size_t i = 0; i < m_seedVoxels.size(); i++)
+    {
+        const Vec3i& coord = m_seedVoxels[i];
+        if ((coord.array() < 0).any() || (coord.array() >= m_dim.array()).any())
         {
             continue;
         }
+        const int index = static_cast<int>(ImageData::getScalarIndex(coord[0], coord[1], coord[2], m_dim, 1));
+        m_distances[index] = imgPtr[index];
+        m_states[index]    = Known;
+    }
 
-        // Mark node as visited (to avoid readdition)
-        m_visited.insert(nodeId);
-
-        // Update all its neighbor cells (diagonals not considered neighbors)
-        // Right +x
-        int   neighborId    = nodeId + 1;
-        Vec3i neighborCoord = coord + Vec3i(1, 0, 0);
-        if (neighborCoord[0] < m_dim[0] && !isVisited(neighborId))
+    // Sweep in the 8 diagonal orders until the distances settle. Along an order a voxel
+    // only depends on the previous plane x + y + z = level, so a plane is updated in parallel
+    const int maxLevel = m_dim[0] + m_dim[1] + m_dim[2] - 3;
+    for (int iter = 0; iter < 8; iter++)
+    {
+        std::atomic<bool> changed = { false };
+        for (int sweep = 0; sweep < 8; sweep++)
         {
-            solveNode(neighborCoord, neighborId);
+            const Vec3i dir((sweep & 1) ? -1 : 1, (sweep & 2) ? -1 : 1, (sweep & 4) ? -1 : 1);
+            for (int level = 0; level <= maxLevel; level++)
+            {
+                const int xMin = std::max(0, level - (m_dim[1] - 1) - (m_dim[2] - 1));
+                const int xMax = std::min(m_dim[0] - 1, level);
+                ParallelUtils::parallelFor(xMin, xMax + 1, [&](const int xi)
+                    {
+                        bool planeChanged = false;
+                        const int yMin    = std::max(0, level - xi - (m_dim[2] - 1));
+                        const int yMax    = std::min(m_dim[1] - 1, level - xi);
+                        for (int yi = yMin; yi <= yMax; yi++)
+                        {
+                            const int zi = level - xi - yi;
+                            const Vec3i coord((dir[0] > 0) ? xi : m_dim[0] - 1 - xi,
+                                (dir[1] > 0) ? yi : m_dim[1] - 1 - yi,
+                                (dir[2] > 0) ? zi : m_dim[2] - 1 - zi);
+                            const int index = static_cast<int>(ImageData::getScalarIndex(coord[0], coord[1], coord[2], m_dim, 1));
+                            if (m_states[index] == Known)
+                            {
+                                continue;
+                            }
+                            const double solution = solveEikonal(getNeighborDistances(coord, index));
+                            if (solution < m_distances[index])
+                            {
+                                planeChanged       = true;
+                                m_distances[index] = solution;
+                            }
+                        }
+                        if (planeChanged)
+                        {
+                            changed = true;
+                        }
+                    }, xMax - xMin > 16);
+            }
         }
-        // Left -x
-        neighborId    = nodeId - 1;
-        neighborCoord = coord - Vec3i(1, 0, 0);
-        if (neighborCoord[0] >= 0 && !isVisited(neighborId))
+        if (!changed)
         {
-            solveNode(neighborCoord, neighborId);
+            break;
         }
+    }
 
-        // Up +y
-        neighborId    = nodeId + m_dim[0];
-        neighborCoord = coord + Vec3i(0, 1, 0);
-        if (neighborCoord[1] < m_dim[1] && !isVisited(neighborId))
+    // Write the distances within the threshold, the seeds and their neighbors
+    // always being within reach
+    const int numVoxels = static_cast<int>(m_distances.size());
+    ParallelUtils::parallelFor(numVoxels, [&](const int i)
         {
-            solveNode(neighborCoord, neighborId);
+            if (m_states[i] == Known || m_distances[i] < m_distThreshold)
+            {
+                imgPtr[i] = m_distances[i];
+            }
+        }, numVoxels > 10000);
+}
+
+std::array<std::pair<double, double>, 3>
+FastMarch::getNeighborDistances(const Vec3i& coord, const int index) const
+{
+    std::array<std::pair<double, double>, 3> neighbors;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        const int stride = (axis == 0) ? 1 : ((axis == 1) ? m_dim[0] : m_indexShift);
+        double    minDist = IMSTK_DOUBLE_MAX;
+        if (coord[axis] - 1 >= 0)
+        {
+            minDist = std::min(minDist, m_distances[index - stride]);
         }
-        // Down -y
-        neighborId    = nodeId - m_dim[0];
-        neighborCoord = coord - Vec3i(0, 1, 0);
-        if (neighborCoord[1] >= 0 && !isVisited(neighborId))
+        if (coord[axis] + 1 < m_dim[axis])
         {
-            solveNode(neighborCoord, neighborId);
+            minDist = std::min(minDist, m_distances[index + stride]);
         }
+        neighbors[axis] = { minDist, m_spacing[axis] };
+    }
+    return neighbors;
+}
 
-        // Forward +z
-        neighborId    = nodeId + m_indexShift;
-        neighborCoord = coord + Vec3i(0, 0, 1);
-        if (neighborCoord[2] < m_dim[2] && !isVisited(neighborId))
+double
+FastMarch::solveEikonal(std::array<std::pair<double, double>, 3> neighbors)
+{
+    // Sort so that the min distance is first
+    std::sort(neighbors.begin(), neighbors.end());
+    if (neighbors[0].first == IMSTK_DOUBLE_MAX)
+    {
+        return IMSTK_DOUBLE_MAX;
+    }
+
+    // Solve sum_i ((u - d_i) / h_i)^2 = 1 over the axes whose neighbor is closer than u
+    double aa       = 0.0;
+    double bb       = 0.0;
+    double cc       = -1.0;
+    double solution = IMSTK_DOUBLE_MAX;
+    for (int i = 0; i < 3; i++)
+    {
+        const double value = neighbors[i].first;
+        if (solution < value)
         {
-            solveNode(neighborCoord, neighborId);
+            break;
         }
-        // Backward -z
-        neighborId    = nodeId - m_indexShift;
-        neighborCoord = coord - Vec3i(0, 0, 1);
-        if (neighborCoord[2] >= 0 && !isVisited(neighborId))
+        const double spaceFactor = 1.0 / (neighbors[i].second * neighbors[i].second);
+        aa += spaceFactor;
+        bb += value * spaceFactor;
+        cc += value * value * spaceFactor;
+
+        const double discrim = bb * bb - aa * cc;
+        if (discrim < 0.0)
         {
-            solveNode(neighborCoord, neighborId);
+            break;
         }
+        solution = (std::sqrt(discrim) + bb) / aa;
     }
+    return solution;
+}
 
-    // Write the sparse distances to the image
-    for (auto i : m_distances)
+void
+FastMarch::solveNode(const Vec3i& coord, const int index)
+{
+    const double solution = solveEikonal(getNeighborDistances(coord, index));
+    if (solution >= m_distances[index])
     {
-        imgPtr[i.first] = i.second;
+        return;
+    }
+
+    // Accept it as the new distance
+    m_distances[index] = solution;
+    if (m_states[index] == Far)
+    {
+        m_states[index] = Trial;
+        m_reached.push_back(index);
+        heapPush(index);
+    }
+    else
+    {
+        heapSiftUp(m_heapIndex[index]);
     }
 }
 
 void
-FastMarch::solveNode(Vec3i coord, int index)
+FastMarch::heapPush(const int nodeId)
 {
-    // Compute the min distance in each axes
-    const double dists[6] =
-    {
-        coord[0] - 1 >= 0 ? getDistance(index - 1) : IMSTK_DOUBLE_MAX,
-        coord[0] + 1 < m_dim[0] ? getDistance(index + 1) : IMSTK_DOUBLE_MAX,
-        coord[1] - 1 >= 0 ? getDistance(index - m_dim[0]) : IMSTK_DOUBLE_MAX,
-        coord[1] + 1 < m_dim[1] ? getDistance(index + m_dim[0]) : IMSTK_DOUBLE_MAX,
-        coord[2] - 1 >= 0 ? getDistance(index - m_indexShift) : IMSTK_DOUBLE_MAX,
-        coord[2] + 1 < m_dim[2] ? getDistance(index + m_indexShift) : IMSTK_DOUBLE_MAX
-    };
-    const double minDist[3] =
-    {
-        std::min(dists[0], dists[1]),
-        std::min(dists[2], dists[3]),
-        std::min(dists[4], dists[5])
-    };
-
-    // Sort so that the min of minDist is first
-    int dimReorder[3] = { 0, 1, 2 };
-    for (int i = 0; i < 3; i++)
+    m_heap.push_back(nodeId);
+    m_heapIndex[nodeId] = static_cast<int>(m_heap.size()) - 1;
+    heapSiftUp(m_heapIndex[nodeId]);
+}
+
+int
+FastMarch::heapPop()
+{
+    const int nodeId = m_heap[0];
+    m_heapIndex[nodeId] = -1;
+    m_heap[0]           = m_heap.back();
+    m_heap.pop_back();
+    if (!m_heap.empty())
     {
-        for (int j = i + 1; j < 3; j++)
+        m_heapIndex[m_heap[0]] = 0;
+        heapSiftDown(0);
+    }
+    return nodeId;
+}
+
+void
+FastMarch::heapSiftUp(int pos)
+{
+    const int    nodeId = m_heap[pos];
+    const double dist   = m_distances[nodeId];
+    while (pos > 0)
+    {
+        const int parent = (pos - 1) / 2;
+        if (m_distances[m_heap[parent]] <= dist)
         {
-            const int dim1 = dimReorder[i];
-            const int dim2 = dimReorder[j];
-            if (minDist[dim1] > minDist[dim2])
-            {
-                std::swap(dimReorder[i], dimReorder[j]);
-            }
+            break;
         }
+        m_heap[pos] = m_heap[parent];
+        m_heapIndex[m_heap[pos]] = pos;
+        pos = parent;
     }
+    m_heap[pos]         = nodeId;
+    m_heapIndex[nodeId] = pos;
+}
 
-    double aa = 0.0;
-    double bb = 0.0;
-    double cc = -1.0;
-
-    // For every dimension
-    double solution = IMSTK_DOUBLE_MAX;
-    double discrim  = 0.0;
-    // todo: Sort dimensions by minDist, start with smallest (break faster)
-    for (unsigned int i = 0; i < 3; i++)
+void
+FastMarch::heapSiftDown(int pos)
+{
+    const int    size   = static_cast<int>(m_heap.size());
+    const int    nodeId = m_heap[pos];
+    const double dist   = m_distances[nodeId];
+    while (true)
     {
-        const double value = minDist[dimReorder[i]];
-        if (solution >= value)
+        int child = pos * 2 + 1;
+        if (child >= size)
         {
-            const double spaceFactor = std::sqrt(1.0 / m_spacing[dimReorder[i]]);
-            aa += spaceFactor;
-            bb += value * spaceFactor;
-            cc += value * value * spaceFactor;
-
-            discrim = bb * bb - aa * cc;
-            if (discrim < 0.0)
-            {
-                // Whoops
-                return;
-            }
-
-            solution = (std::sqrt(discrim) + bb) / aa;
+            break;
+        }
+        if (child + 1 < size && m_distances[m_heap[child + 1]] < m_distances[m_heap[child]])
+        {
+            child++;
         }
-        else
+        if (dist <= m_distances[m_heap[child]])
         {
             break;
         }
+        m_heap[pos] = m_heap[child];
+        m_heapIndex[m_heap[pos]] = pos;
+        pos = child;
     }
-
-    if (solution < IMSTK_DOUBLE_MAX)
-    {
-        // Accept it as the new distance
-        m_distances[index] = solution;
-        m_queue.push(Node(index, solution, coord));
-    }
+    m_heap[pos]         = nodeId;
+    m_heapIndex[nodeId] = pos;
 }
-} // namespace imstk
\ No newline at end of file
+} // namespace imstk
@@ -8,69 +8,120 @@
 
 #include "imstkImageData.h"
 
-#include <unordered_set>
-#include <queue>
+#include <array>
+#include <vector>
 
 namespace imstk
 {
 ///
 /// \class FastMarch
 ///
-/// \brief
+/// \brief Solves the distance from the seed voxels of a single component double image,
+/// the eikonal equation |grad d| = 1, starting from the image value at the seeds.
+/// Voxels are solved outward in order of distance until the distance threshold, only
+/// the voxels reached are written to the image.
+/// Distances are kept in dense arrays and the front in a binary heap indexed by voxel,
+/// so a voxel is in the heap at most once and its key decreased in place. Arrays are
+/// reused between solves of the same image size, only the voxels reached are reset.
+/// With UseSweeping on, the whole image is solved by fast sweeping instead, voxels of
+/// a diagonal plane being updated in parallel, which is faster when most of the image
+/// is within the threshold.
 ///
 class FastMarch
 {
-protected:
-    // Setup Node struct for priority queue
-    struct Node
-    {
-        int m_nodeId;
-        double m_cost;
-        Vec3i m_coord;
-
-        Node(int nodeId, double cost, Vec3i coord) :
-            m_nodeId(nodeId), m_cost(cost), m_coord(coord)
-        {
-        }
-    };
-    struct NodeComparator
-    {
-        bool operator()(const Node& a, const Node& b)
-        {
-            return a.m_cost > b.m_cost;
-        }
-    };
-
 public:
-    bool isVisited(int nodeId) { return m_visited.count(nodeId) == 0 ? false : true; }
-    double getDistance(int nodeId) { return m_distances.count(nodeId) == 0 ? IMSTK_DOUBLE_MAX : m_distances.at(nodeId); }
+    ///
+    /// \brief Returns if the voxel was solved in the last solve, only for heap marching
+    ///
+    bool isVisited(int nodeId) const { return nodeId < static_cast<int>(m_states.size()) && m_states[nodeId] == Known; }
 
-    void solve();
+    ///
+    /// \brief Returns the distance of the voxel in the last solve, IMSTK_DOUBLE_MAX if not reached
+    ///
+    double getDistance(int nodeId) const { return nodeId < static_cast<int>(m_distances.size()) ? m_distances[nodeId] : IMSTK_DOUBLE_MAX; }
 
-    void solveNode(Vec3i coord, int index);
+    void solve();
 
     void setSeeds(std::vector<Vec3i> seedVoxels) { m_seedVoxels = seedVoxels; }
-    void setVisited(std::unordered_set<int> visited) { m_visited = visited; }
-    void setDistnaces(std::unordered_map<int, double> distances) { m_distances = distances; }
     void setImage(std::shared_ptr<ImageData> image) { m_imageData = image; }
     void setDistThreshold(double distThreshold) { m_distThreshold = distThreshold; }
 
+    ///
+    /// \brief If on, the whole image is solved by parallel fast sweeping
+    ///@{
+    imstkSetMacro(UseSweeping, bool);
+    imstkGetMacro(UseSweeping, bool);
+    ///@}
+
+    ///
+    /// \brief Solve the eikonal equation at a voxel given the smallest neighbor distance
+    /// and the spacing along every axis, IMSTK_DOUBLE_MAX if there is no neighbor
+    ///
+    static double solveEikonal(std::array<std::pair<double, double>, 3> neighbors);
+
 protected:
+    enum State : char
+    {
+        Far,
+        Trial,
+        Known
+    };
+
+    ///
+    /// \brief Solve by marching the front in a heap
+    ///
+    void solveHeap(double* imgPtr);
+
+    ///
+    /// \brief Solve by fast sweeping the whole image
+    ///
+    void solveSweeping(double* imgPtr);
+
+    ///
+    /// \brief Resize the arrays to the image, or reset the voxels reached by the last solve
+    ///
+    void resetArrays(const int numVoxels);
+
+    ///
+    /// \brief Compute the distance of a voxel from its neighbors, pushing it in
+    /// the heap or decreasing its key if it got closer
+    ///
+    void solveNode(const Vec3i& coord, const int index);
+
+    ///
+    /// \brief Returns the smallest neighbor distance and the spacing along every axis
+    ///
+    std::array<std::pair<double, double>, 3> getNeighborDistances(const Vec3i& coord, const int index) const;
+
+    ///
+    /// \brief Binary min heap of voxel ids keyed by distance, m_heapIndex gives the
+    /// position of every voxel in it
+    ///@{
+    void heapPush(const int nodeId);
+    int heapPop();
+    void heapSiftUp(int pos);
+    void heapSiftDown(int pos);
+    ///@}
+
     // The image to operate on
     std::shared_ptr<ImageData> m_imageData;
     Vec3i m_dim;
     Vec3d m_spacing;
     int   m_indexShift;
 
-    std::unordered_set<int> m_visited;
-    std::unordered_map<int, double> m_distances;
+    std::vector<double> m_distances; ///< Distance of every voxel
+    std::vector<char>   m_states;    ///< State of every voxel
+    std::vector<int>    m_heap;
+    std::vector<int>    m_heapIndex; ///< Position of every voxel in the heap, -1 if not in it
+    std::vector<int>    m_reached;   ///< Voxels reached by the last heap solve
+    bool m_reachedAll = false;       ///< If the last solve may have reached every voxel
 
     // The starting voxels
     std::vector<Vec3i> m_seedVoxels;
 
     // Distance to go too
-    double m_distThreshold;
+    double m_distThreshold = IMSTK_DOUBLE_MAX;
 
-    std::priority_queue<Node, std::vector<Node>, NodeComparator> m_queue;
+    bool m_UseSweeping = false;
 };
-} // namespace imstk
\ No newline at end of file
+} // namespace imstk
@@ -7,6 +7,7 @@
 #include "imstkLocalMarchingCubes.h"
 #include "imstkGeometryUtilities.h"
 #include "imstkLogger.h"
+#include "imstkParallelFor.h"
 #include "imstkSurfaceMesh.h"
 #include "imstkImageData.h"
 #include "imstkVecDataArray.h"
@@ -364,12 +365,9 @@ LocalMarchingCubes::setInputImage(std::shared_ptr<ImageData> inputImage)
 }
 
 void
-LocalMarchingCubes::setModified(const Vec3i& coord)
+LocalMarchingCubes::setModifiedRegion(const Vec3i& min, const Vec3i& max)
 {
-    std::shared_ptr<ImageData> image      = std::dynamic_pointer_cast<ImageData>(getInput(0));
-    const int                  voxelIndex = static_cast<int>(image->getScalarIndex(coord));
-    m_modifiedVoxels[voxelIndex] = coord;
-    //m_modifiedVoxels.push_back(std::pair<int, Vec3i>(static_cast<int>(voxelIndex), coord));
+    m_modifiedRegions.push_back(std::pair<Vec3i, Vec3i>(min, max));
 }
 
 void
@@ -657,56 +655,57 @@ LocalMarchingCubes::requestUpdate()
     {
         const Vec3i dim1 = dims - Vec3i(1, 1, 1);
 
-        // Set of modified blocks (all in one map to remove duplicates)
-        std::unordered_map<int, Vec3i> modifiedBlocks;
+        // Flag the chunks containing the blocks of the modified regions, a voxel modifies the
+        // blocks on either side of it along every axis
+        std::vector<char> chunkModified(m_chunkCount, false);
+        for (const auto& region : m_modifiedRegions)
         {
-            // We need to compute the set of blocks that are modified given the modified voxels
-            // then we can compute the set of chunks modified
-            for (auto modifiedVoxel : m_modifiedVoxels)
+            const Vec3i minBlock = (region.first - Vec3i(1, 1, 1)).cwiseMax(Vec3i(0, 0, 0));
+            const Vec3i maxBlock = region.second.cwiseMin(dim1 - Vec3i(1, 1, 1));
+            if ((minBlock.array() > maxBlock.array()).any())
             {
-                const Vec3i& voxelCoord = modifiedVoxel.second;
-
-                // 2x2 iteration, index space for blocks is -(1, 1, 1)
-                const Vec3i minCoord = (voxelCoord - Vec3i(1, 1, 1)).cwiseMax(Vec3i(0, 0, 0));
-                const Vec3i maxCoord = (voxelCoord + Vec3i(1, 1, 1)).cwiseMin(dim1 - Vec3i(1, 1, 1));
-                for (int z = minCoord[2]; z < maxCoord[2]; z++)
+                continue;
+            }
+            const Vec3i minChunk = minBlock.cwiseQuotient(chunkDimensions);
+            const Vec3i maxChunk = maxBlock.cwiseQuotient(chunkDimensions);
+            for (int z = minChunk[2]; z <= maxChunk[2]; z++)
+            {
+                for (int y = minChunk[1]; y <= maxChunk[1]; y++)
                 {
-                    for (int y = minCoord[1]; y < maxCoord[1]; y++)
+                    for (int x = minChunk[0]; x <= maxChunk[0]; x++)
                     {
-                        for (int x = minCoord[0]; x < maxCoord[0]; x++)
-                        {
-                            modifiedBlocks[x + dim1[0] * (y + z * dim1[1])] = Vec3i(x, y, z);
-                        }
+                        chunkModified[x + (y + z * m_numChunks[1]) * m_numChunks[0]] = true;
                     }
                 }
             }
         }
 
-        // Set of modified chunks (all in one map to remove duplicates)
+        // Set of modified chunks
         m_modifiedChunks.clear();
+        std::vector<std::pair<int, Vec3i>> modifiedChunks;
+        for (int i = 0; i < static_cast<int>(m_chunkCount); i++)
         {
-            for (auto modifiedBlock : modifiedBlocks)
+            if (chunkModified[i])
             {
-                //const int    blockIndex = modifiedBlock.first;
-                const Vec3i& blockCoord = modifiedBlock.second;
-
-                // Compute the chunk
-                const Vec3i chunkCoord = blockCoord.cast<double>().cwiseQuotient(dim1.cast<double>()).cwiseProduct(m_numChunks.cast<double>()).cast<int>();
-
-                const int chunkId = chunkCoord[0] + (chunkCoord[1] + chunkCoord[2] * m_numChunks[1]) * m_numChunks[0];
-                m_modifiedChunks.insert(std::pair<int, Vec3i>(chunkId, chunkCoord));
+                const Vec3i chunkCoord(i % m_numChunks[0], (i / m_numChunks[0]) % m_numChunks[1], i / (m_numChunks[0] * m_numChunks[1]));
+                m_modifiedChunks[i] = chunkCoord;
+                modifiedChunks.push_back(std::pair<int, Vec3i>(i, chunkCoord));
             }
         }
-        // Updates all the modified chunks
-        for (auto i : m_modifiedChunks)
+
+        // Updates all the modified chunks, each to its own output
+        ParallelUtils::parallelFor(modifiedChunks.size(), [&](const size_t i)
+            {
+                const Vec3i& chunkCoord = modifiedChunks[i].second;
+                std::shared_ptr<SurfaceMesh> outputSurf = std::dynamic_pointer_cast<SurfaceMesh>(getOutput(modifiedChunks[i].first));
+                const Vec3i coordStart = chunkCoord.cwiseProduct(chunkDimensions);
+                mcSubImage(imageData, outputSurf, coordStart, coordStart + chunkDimensions, m_isoValue);
+            }, modifiedChunks.size() > 1);
+        for (const auto& chunk : modifiedChunks)
         {
-            const Vec3i&                 chunkCoord = i.second;
-            std::shared_ptr<SurfaceMesh> outputSurf = std::dynamic_pointer_cast<SurfaceMesh>(getOutput(i.first));
-            const Vec3i                  coordStart = chunkCoord.cwiseProduct(chunkDimensions);
-            mcSubImage(imageData, outputSurf, coordStart, coordStart + chunkDimensions, m_isoValue);
-            outputSurf->postModified();
+            getOutput(chunk.first)->postModified();
         }
-        m_modifiedVoxels.clear();
+        m_modifiedRegions.clear();
     }
 }
 } // namespace imstk
\ No newline at end of file
@@ -10,7 +10,8 @@
 #include "imstkMath.h"
 
 #include <list>
-#include <unordered_set>
+#include <unordered_map>
+#include <vector>
 
 namespace imstk
 {
@@ -54,12 +55,19 @@ public:
     /// \brief Set a voxel that was modified in the image (the neighboring dual
     /// voxels will be updated on the next request)
     ///
-    void setModified(const Vec3i& coord);
+    void setModified(const Vec3i& coord) { setModifiedRegion(coord, coord); }
+
+    ///
+    /// \brief Set a box of voxels that were modified in the image, bounds inclusive.
+    /// Only the chunks overlapping the box and its neighboring dual voxels are updated
+    /// on the next request, the cost not depending on the number of voxels in it
+    ///
+    void setModifiedRegion(const Vec3i& min, const Vec3i& max);
 
     ///
     /// \brief Clear all pending modifications
     ///
-    void clearModified() { m_modifiedVoxels.clear(); }
+    void clearModified() { m_modifiedRegions.clear(); }
 
     ///
     /// \brief Set the number of chunks.
@@ -77,8 +85,8 @@ protected:
     void requestUpdate() override;
 
 private:
-    // Id + coordinate of the modified voxels
-    std::unordered_map<int, Vec3i> m_modifiedVoxels;   // Id + coordinate
+    // Min and max voxel coordinates of the modified regions
+    std::vector<std::pair<Vec3i, Vec3i>> m_modifiedRegions;
 
     bool m_allModified = true;
 
@@ -6,7 +6,9 @@
 
 #include "imstkSurfaceMeshDistanceTransform.h"
 #include "imstkDataArray.h"
+#include "imstkFastMarch.h"
 #include "imstkGeometryUtilities.h"
+#include "imstkBvh.h"
 #include "imstkImageData.h"
 #include "imstkLogger.h"
 #include "imstkLooseOctree.h"
@@ -23,8 +25,13 @@
 #include <vtkPolyData.h>
 #include <vtkSelectEnclosedPoints.h>
 
+#include <cstring>
+#include <fstream>
+
 namespace imstk
 {
+static const char CacheMagic[8] = { 'i', 'm', 's', 't', 'k', 'S', 'D', 'F' };
+
 ///
 /// \brief Only works with binary image
 /// returns 0 if neighborhood is equivalent to val
@@ -79,7 +86,7 @@ isNeighborhoodEquivalent(const Vec3i& pt, const Vec3i& dim, const float val, con
 
 // Narrow band is WIP, it works but is slow
 static void
-computeNarrowBandedDT(std::shared_ptr<ImageData> imageData, std::shared_ptr<SurfaceMesh> surfMesh, const int dilateSize,
+computeNarrowBandedDTVtk(std::shared_ptr<ImageData> imageData, std::shared_ptr<SurfaceMesh> surfMesh, const int dilateSize,
                       const double tolerance)
 {
     // Rasterize a mask from the polygon
@@ -140,7 +147,7 @@ computeNarrowBandedDT(std::shared_ptr<ImageData> imageData, std::shared_ptr<Surf
 }
 
 static void
-computeFullDT(std::shared_ptr<ImageData> imageData, std::shared_ptr<SurfaceMesh> surfMesh, const double tolerance)
+computeFullDTVtk(std::shared_ptr<ImageData> imageData, std::shared_ptr<SurfaceMesh> surfMesh, const double tolerance)
 {
     // Get the optimal number of threads
     const int numThreads = static_cast<int>(ParallelUtils::ThreadManager::getThreadPoolSize());
@@ -176,6 +183,341 @@ computeFullDT(std::shared_ptr<ImageData> imageData, std::shared_ptr<SurfaceMesh>
         });
 }
 
+namespace
+{
+///
+/// \brief Returns the point of triangle a-b-c closest to p and the feature it lies on,
+/// 0-2 vertices a, b, c, 3-5 edges ab, bc, ca, 6 face
+///
+Vec3d
+closestPointOnTriangle(const Vec3d& p, const Vec3d& a, const Vec3d& b, const Vec3d& c, int& feature)
+{
+    const Vec3d  ab = b - a;
+    const Vec3d  ac = c - a;
+    const Vec3d  ap = p - a;
+    const double d1 = ab.dot(ap);
+    const double d2 = ac.dot(ap);
+    if (d1 <= 0.0 && d2 <= 0.0)
+    {
+        feature = 0;
+        return a;
+    }
+
+    const Vec3d  bp = p - b;
+    const double d3 = ab.dot(bp);
+    const double d4 = ac.dot(bp);
+    if (d3 >= 0.0 && d4 <= d3)
+    {
+        feature = 1;
+        return b;
+    }
+
+    const double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    {
+        feature = 3;
+        return a + ab * (d1 / (d1 - d3));
+    }
+
+    const Vec3d  cp = p - c;
+    const double d5 = ab.dot(cp);
+    const double d6 = ac.dot(cp);
+    if (d6 >= 0.0 && d5 <= d6)
+    {
+        feature = 2;
+        return c;
+    }
+
+    const double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    {
+        feature = 5;
+        return a + ac * (d2 / (d2 - d6));
+    }
+
+    const double va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+    {
+        feature = 4;
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    feature = 6;
+    const double denom = 1.0 / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+///
+/// \class SignedDistanceFunc
+///
+/// \brief Exact signed distance to a closed SurfaceMesh, negative inside. The closest
+/// triangle is found with a Bvh and the sign given by the angle weighted pseudonormal
+/// of the feature closest (Baerentzen & Aanaes 2005), which unlike the face normal is
+/// correct when the closest point lies on an edge or vertex. Thread safe once constructed
+///
+class SignedDistanceFunc
+{
+public:
+    SignedDistanceFunc(std::shared_ptr<SurfaceMesh> surfMesh) :
+        m_vertices(*surfMesh->getVertexPositions()), m_cells(*surfMesh->getCells())
+    {
+        m_bvh.build(m_vertices, m_cells);
+        computePseudoNormals();
+    }
+
+    ///
+    /// \brief Compute the signed distance of pos if the surface is within maxDist of it
+    /// \return false if no triangle is within maxDist
+    ///
+    bool evaluate(const Vec3d& pos, double& dist, const double maxDist = IMSTK_DOUBLE_MAX) const
+    {
+        const double maxSqrDist = (maxDist == IMSTK_DOUBLE_MAX) ? IMSTK_DOUBLE_MAX : maxDist * maxDist;
+        double       sqrDist    = 0.0;
+        const int    cellId     = m_bvh.findClosest(pos, [&](const int i)
+            {
+                int feature = 0;
+                const Vec3i& cell = m_cells[i];
+                return (closestPointOnTriangle(pos, m_vertices[cell[0]], m_vertices[cell[1]], m_vertices[cell[2]], feature) - pos).squaredNorm();
+            }, sqrDist, maxSqrDist);
+        if (cellId == -1)
+        {
+            return false;
+        }
+
+        const Vec3i& cell      = m_cells[cellId];
+        int          feature   = 0;
+        const Vec3d  closestPt = closestPointOnTriangle(pos, m_vertices[cell[0]], m_vertices[cell[1]], m_vertices[cell[2]], feature);
+        Vec3d        normal;
+        if (feature < 3)
+        {
+            normal = m_vertexNormals[cell[feature]];
+        }
+        else if (feature < 6)
+        {
+            normal = m_edgeNormals[cellId][feature - 3];
+        }
+        else
+        {
+            normal = m_faceNormals[cellId];
+        }
+        dist = std::sqrt(sqrDist);
+        if ((pos - closestPt).dot(normal) < 0.0)
+        {
+            dist = -dist;
+        }
+        return true;
+    }
+
+protected:
+    void computePseudoNormals()
+    {
+        m_faceNormals.resize(m_cells.size());
+        m_edgeNormals.resize(m_cells.size());
+        m_vertexNormals.assign(m_vertices.size(), Vec3d::Zero());
+        ParallelUtils::parallelFor(m_cells.size(), [&](const int i)
+            {
+                const Vec3i& cell = m_cells[i];
+                const Vec3d  n    = (m_vertices[cell[1]] - m_vertices[cell[0]]).cross(m_vertices[cell[2]] - m_vertices[cell[0]]);
+                const double norm = n.norm();
+                m_faceNormals[i]  = (norm > 0.0) ? Vec3d(n / norm) : Vec3d::Zero();
+            }, m_cells.size() > 1000);
+
+        // Vertex normals are the face normals weighted by the angle of the face at the vertex
+        for (int i = 0; i < m_cells.size(); i++)
+        {
+            const Vec3i& cell = m_cells[i];
+            for (int j = 0; j < 3; j++)
+            {
+                const Vec3d& x  = m_vertices[cell[j]];
+                const Vec3d  e0 = m_vertices[cell[(j + 1) % 3]] - x;
+                const Vec3d  e1 = m_vertices[cell[(j + 2) % 3]] - x;
+                const double angle = std::atan2(e0.cross(e1).norm(), e0.dot(e1));
+                m_vertexNormals[cell[j]] += m_faceNormals[i] * angle;
+            }
+        }
+
+        // Edge normals are the sum of the normals of the faces sharing the edge
+        std::vector<std::pair<Vec2i, int>> edges(m_cells.size() * 3);
+        for (int i = 0; i < m_cells.size(); i++)
+        {
+            const Vec3i& cell = m_cells[i];
+            for (int j = 0; j < 3; j++)
+            {
+                const int v0 = cell[j];
+                const int v1 = cell[(j + 1) % 3];
+                edges[i * 3 + j] = { Vec2i(std::min(v0, v1), std::max(v0, v1)), i * 3 + j };
+            }
+        }
+        std::sort(edges.begin(), edges.end(), [](const std::pair<Vec2i, int>& a, const std::pair<Vec2i, int>& b)
+            {
+                return (a.first[0] < b.first[0]) || (a.first[0] == b.first[0] && a.first[1] < b.first[1]);
+            });
+        for (size_t begin = 0; begin < edges.size();)
+        {
+            size_t end    = begin;
+            Vec3d  normal = Vec3d::Zero();
+            for (; end < edges.size() && edges[end].first == edges[begin].first; end++)
+            {
+                normal += m_faceNormals[edges[end].second / 3];
+            }
+            for (size_t i = begin; i < end; i++)
+            {
+                m_edgeNormals[edges[i].second / 3][edges[i].second % 3] = normal;
+            }
+            begin = end;
+        }
+    }
+
+    const VecDataArray<double, 3>&    m_vertices;
+    const VecDataArray<int, 3>&       m_cells;
+    Bvh                               m_bvh;
+    std::vector<Vec3d>                m_faceNormals;
+    std::vector<Vec3d>                m_vertexNormals;
+    std::vector<std::array<Vec3d, 3>> m_edgeNormals; ///< Per triangle, of edges ab, bc, ca
+};
+} // namespace
+
+///
+/// \brief Exact signed distance at every voxel, rows of the image are split among threads.
+/// Along a row a voxel is at most the spacing farther from the surface than the previous
+/// one, which bounds the search
+///
+static void
+computeFullDT(std::shared_ptr<ImageData> imageData, std::shared_ptr<SurfaceMesh> surfMesh)
+{
+    const SignedDistanceFunc distFunc(surfMesh);
+
+    const Vec3i& dim     = imageData->getDimensions();
+    const Vec3d  spacing = imageData->getSpacing();
+    const Vec3d  shift   = imageData->getOrigin() + spacing * 0.5;
+    double*      imgPtr  = std::dynamic_pointer_cast<DataArray<double>>(imageData->getScalars())->getPointer();
+
+    ParallelUtils::parallelFor(dim[1] * dim[2], [&](const int row)
+        {
+            const int y = row % dim[1];
+            const int z = row / dim[1];
+            double* rowPtr = imgPtr + ImageData::getScalarIndex(0, y, z, dim, 1);
+            double maxDist = IMSTK_DOUBLE_MAX;
+            for (int x = 0; x < dim[0]; x++)
+            {
+                const Vec3d pos = Vec3d(x, y, z).cwiseProduct(spacing) + shift;
+                if (!distFunc.evaluate(pos, rowPtr[x], maxDist))
+                {
+                    distFunc.evaluate(pos, rowPtr[x]);
+                }
+                maxDist = (std::abs(rowPtr[x]) + spacing[0]) * (1.0 + 1.0e-10) + 1.0e-12;
+            }
+        });
+}
+
+///
+/// \brief Exact signed distance of the voxels within dilateSize voxels of the surface.
+/// The rest is filled outward by fast sweeping the eikonal equation from the band, with
+/// the sign of the band flooded into it, giving a continuous approximate distance
+///
+static void
+computeNarrowBandedDT(std::shared_ptr<ImageData> imageData, std::shared_ptr<SurfaceMesh> surfMesh, const int dilateSize)
+{
+    const SignedDistanceFunc distFunc(surfMesh);
+
+    const Vec3i& dim       = imageData->getDimensions();
+    const Vec3d  spacing   = imageData->getSpacing();
+    const Vec3d  shift     = imageData->getOrigin() + spacing * 0.5;
+    double*      imgPtr    = std::dynamic_pointer_cast<DataArray<double>>(imageData->getScalars())->getPointer();
+    const double bandWidth = dilateSize * spacing.maxCoeff();
+    const int    numVoxels = dim[0] * dim[1] * dim[2];
+
+    // Sign of every voxel and whether its value is exact
+    std::vector<signed char> signs(numVoxels, 0);
+    std::vector<char>        isExact(numVoxels, 0);
+    ParallelUtils::parallelFor(dim[1] * dim[2], [&](const int row)
+        {
+            const int y = row % dim[1];
+            const int z = row / dim[1];
+            const size_t rowStart = ImageData::getScalarIndex(0, y, z, dim, 1);
+            for (int x = 0; x < dim[0]; x++)
+            {
+                const Vec3d pos = Vec3d(x, y, z).cwiseProduct(spacing) + shift;
+                const size_t i  = rowStart + x;
+                if (distFunc.evaluate(pos, imgPtr[i], bandWidth))
+                {
+                    isExact[i] = 1;
+                    signs[i]   = (imgPtr[i] < 0.0) ? -1 : 1;
+                }
+                else
+                {
+                    imgPtr[i] = IMSTK_DOUBLE_MAX;
+                }
+            }
+        });
+
+    // Flood the sign of the band through the 6-connected rest of the image. A region
+    // the band does not reach gets the exact value of one of its voxels
+    const std::array<Vec3i, 6> offsets = { Vec3i(1, 0, 0), Vec3i(-1, 0, 0), Vec3i(0, 1, 0),
+                                           Vec3i(0, -1, 0), Vec3i(0, 0, 1), Vec3i(0, 0, -1) };
+    std::vector<int> front;
+    auto             flood = [&]()
+                             {
+                                 while (!front.empty())
+                                 {
+                                     const int i = front.back();
+                                     front.pop_back();
+                                     const Vec3i pt(i % dim[0], (i / dim[0]) % dim[1], i / (dim[0] * dim[1]));
+                                     for (const Vec3i& offset : offsets)
+                                     {
+                                         const Vec3i nbr = pt + offset;
+                                         if ((nbr.array() < 0).any() || (nbr.array() >= dim.array()).any())
+                                         {
+                                             continue;
+                                         }
+                                         const size_t j = ImageData::getScalarIndex(nbr[0], nbr[1], nbr[2], dim, 1);
+                                         if (signs[j] == 0)
+                                         {
+                                             signs[j] = signs[i];
+                                             front.push_back(static_cast<int>(j));
+                                         }
+                                     }
+                                 }
+                             };
+    for (int i = 0; i < numVoxels; i++)
+    {
+        if (isExact[i])
+        {
+            front.push_back(i);
+        }
+    }
+    flood();
+    for (int i = 0; i < numVoxels; i++)
+    {
+        if (signs[i] == 0)
+        {
+            const Vec3d pos = Vec3d(i % dim[0], (i / dim[0]) % dim[1], i / (dim[0] * dim[1])).cwiseProduct(spacing) + shift;
+            distFunc.evaluate(pos, imgPtr[i]);
+            isExact[i] = 1;
+            signs[i]   = (imgPtr[i] < 0.0) ? -1 : 1;
+            front.push_back(i);
+            flood();
+        }
+    }
+
+    // Fast sweep the unsigned distance outward from the exact voxels
+    std::vector<Vec3i> seeds;
+    for (int i = 0; i < numVoxels; i++)
+    {
+        if (isExact[i])
+        {
+            imgPtr[i] = std::abs(imgPtr[i]);
+            seeds.push_back(Vec3i(i % dim[0], (i / dim[0]) % dim[1], i / (dim[0] * dim[1])));
+        }
+    }
+    FastMarch fastMarch;
+    fastMarch.setImage(imageData);
+    fastMarch.setSeeds(seeds);
+    fastMarch.setUseSweeping(true);
+    fastMarch.solve();
+    ParallelUtils::parallelFor(numVoxels, [&](const int i) { imgPtr[i] *= signs[i]; }, numVoxels > 10000);
+}
+
 SurfaceMeshDistanceTransform::SurfaceMeshDistanceTransform()
 {
     setNumInputPorts(1);
@@ -263,19 +605,109 @@ SurfaceMeshDistanceTransform::requestUpdate()
     const Vec3d origin  = Vec3d(bounds[0], bounds[2], bounds[4]);
     outputImageData->allocate(IMSTK_DOUBLE, 1, m_Dimensions, spacing, origin);
 
-    /* StopWatch timer;
-     timer.start();*/
+    const uint64_t cacheKey = computeCacheKey(inputSurfaceMesh, bounds);
+    if (!m_CacheFile.empty() && readCache(outputImageData, cacheKey))
+    {
+        return;
+    }
 
-    if (m_NarrowBanded)
+    if (m_UseVtk)
     {
-        computeNarrowBandedDT(outputImageData, inputSurfaceMesh, m_DilateSize,
-            m_Tolerance);
+        if (m_NarrowBanded)
+        {
+            computeNarrowBandedDTVtk(outputImageData, inputSurfaceMesh, m_DilateSize, m_Tolerance);
+        }
+        else
+        {
+            computeFullDTVtk(outputImageData, inputSurfaceMesh, m_Tolerance);
+        }
     }
     else
     {
-        computeFullDT(outputImageData, inputSurfaceMesh, m_Tolerance);
+        if (m_NarrowBanded)
+        {
+            computeNarrowBandedDT(outputImageData, inputSurfaceMesh, m_DilateSize);
+        }
+        else
+        {
+            computeFullDT(outputImageData, inputSurfaceMesh);
+        }
+    }
+
+    if (!m_CacheFile.empty())
+    {
+        writeCache(outputImageData, cacheKey);
+    }
+}
+
+uint64_t
+SurfaceMeshDistanceTransform::computeCacheKey(std::shared_ptr<SurfaceMesh> surfMesh, const Vec6d& bounds) const
+{
+    // 64 bit FNV-1a hash of the input and every parameter that changes the output
+    uint64_t key  = 14695981039346656037ULL;
+    auto     hash = [&key](const void* data, const size_t numBytes)
+                    {
+                        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+                        for (size_t i = 0; i < numBytes; i++)
+                        {
+                            key = (key ^ bytes[i]) * 1099511628211ULL;
+                        }
+                    };
+    VecDataArray<double, 3>& vertices = *surfMesh->getVertexPositions();
+    VecDataArray<int, 3>&    cells    = *surfMesh->getCells();
+    hash(vertices.getVoidPointer(), vertices.size() * sizeof(Vec3d));
+    hash(cells.getVoidPointer(), cells.size() * sizeof(Vec3i));
+    hash(m_Dimensions.data(), sizeof(Vec3i));
+    hash(bounds.data(), sizeof(Vec6d));
+    hash(&m_NarrowBanded, sizeof(bool));
+    hash(&m_DilateSize, sizeof(int));
+    hash(&m_UseVtk, sizeof(bool));
+    hash(&m_Tolerance, sizeof(double));
+    return key;
+}
+
+bool
+SurfaceMeshDistanceTransform::readCache(std::shared_ptr<ImageData> imageData, const uint64_t key) const
+{
+    std::ifstream file(m_CacheFile, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    char     magic[8];
+    uint64_t fileKey = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&fileKey), sizeof(fileKey));
+    if (!file || std::memcmp(magic, CacheMagic, sizeof(magic)) != 0 || fileKey != key)
+    {
+        LOG(INFO) << "SurfaceMeshDistanceTransform cache " << m_CacheFile << " is out of date, recomputing";
+        return false;
+    }
+
+    auto scalarsPtr = std::dynamic_pointer_cast<DataArray<double>>(imageData->getScalars());
+    file.read(reinterpret_cast<char*>(scalarsPtr->getPointer()), scalarsPtr->size() * sizeof(double));
+    if (!file)
+    {
+        LOG(WARNING) << "SurfaceMeshDistanceTransform cache " << m_CacheFile << " is truncated, recomputing";
+        return false;
+    }
+    return true;
+}
+
+void
+SurfaceMeshDistanceTransform::writeCache(std::shared_ptr<ImageData> imageData, const uint64_t key) const
+{
+    std::ofstream file(m_CacheFile, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        LOG(WARNING) << "SurfaceMeshDistanceTransform could not write cache " << m_CacheFile;
+        return;
     }
 
-    //printf("time: %f\n", timer.getTimeElapsed());
+    auto scalarsPtr = std::dynamic_pointer_cast<DataArray<double>>(imageData->getScalars());
+    file.write(CacheMagic, 8);
+    file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+    file.write(reinterpret_cast<const char*>(scalarsPtr->getPointer()), scalarsPtr->size() * sizeof(double));
 }
-} // namespace imstk
\ No newline at end of file
+} // namespace imstk
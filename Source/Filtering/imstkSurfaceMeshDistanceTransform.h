@@ -21,9 +21,14 @@ class SurfaceMesh;
 ///
 /// \class SurfaceMeshDistanceTransform
 ///
-/// \brief This filter computes exact signed distance fields using octrees
-/// and pseudonormal computations. One might need to adjust the tolerance
-/// depending on dataset scale.
+/// \brief This filter computes exact signed distance fields using a bounding volume
+/// hierarchy of the triangles and angle weighted pseudonormals for the sign, negative
+/// inside. The input should be closed and consistently oriented. Voxels are computed
+/// in parallel. When narrow banded only the voxels within DilateSize voxels of the
+/// surface are exact, the rest are filled by fast sweeping outward.
+/// VTK's vtkImplicitPolyDataDistance is used instead if UseVtk is set, one might need
+/// to adjust the tolerance depending on dataset scale.
+/// The output can be cached to a file to skip the computation on the next load.
 /// The bounds for the image can be set in the filter, when none are set
 /// the bounding box of the mesh is used, the margin.  When providing your own bounds a
 /// box larger than the original object might be necessary depending on shape
@@ -86,9 +91,39 @@ public:
     imstkGetMacro(Tolerance, double);
 ///@}
 
+    ///
+    /// \brief If on, VTK is used to compute the distances, Tolerance only applies then
+    ///@{
+    imstkSetMacro(UseVtk, bool);
+    imstkGetMacro(UseVtk, bool);
+    ///@}
+
+    ///
+    /// \brief File to cache the output in. When set, the output is read from it if it was
+    /// computed from the same mesh and parameters, else computed and written to it
+    ///@{
+    imstkSetMacro(CacheFile, const std::string&);
+    imstkGetMacro(CacheFile, const std::string&);
+    ///@}
+
 protected:
     void requestUpdate() override;
 
+    ///
+    /// \brief Hash of the input and parameters, to check a cache is up to date
+    ///
+    uint64_t computeCacheKey(std::shared_ptr<SurfaceMesh> surfMesh, const Vec6d& bounds) const;
+
+    ///
+    /// \brief Read the cached output into the image, returns false if absent or out of date
+    ///
+    bool readCache(std::shared_ptr<ImageData> imageData, const uint64_t key) const;
+
+    ///
+    /// \brief Write the output to the cache
+    ///
+    void writeCache(std::shared_ptr<ImageData> imageData, const uint64_t key) const;
+
 private:
     Vec3i  m_Dimensions = Vec3i::Zero();
     Vec6d  m_Bounds     = Vec6d::Zero();
@@ -96,6 +131,9 @@ private:
 
     bool m_NarrowBanded = false;
     int  m_DilateSize   = 4; ///< Only for narrow banded
+    bool m_UseVtk       = false;
+
+    std::string m_CacheFile = "";
 
     vtkSmartPointer<vtkImplicitPolyDataDistance> m_distFunc;
 };
@@ -7,10 +7,13 @@
 #include "imstkSurfaceMeshSmoothen.h"
 #include "imstkGeometryUtilities.h"
 #include "imstkLogger.h"
+#include "imstkParallelUtils.h"
 #include "imstkSurfaceMesh.h"
 
 #include <vtkSmoothPolyDataFilter.h>
 
+#include <numeric>
+
 namespace imstk
 {
 SurfaceMeshSmoothen::SurfaceMeshSmoothen()
@@ -38,6 +41,19 @@ SurfaceMeshSmoothen::requestUpdate()
         return;
     }
 
+    if (m_UseVtk || m_FeatureEdgeSmoothing)
+    {
+        smoothVtk(inputMesh);
+    }
+    else
+    {
+        smoothNative(inputMesh);
+    }
+}
+
+void
+SurfaceMeshSmoothen::smoothVtk(std::shared_ptr<SurfaceMesh> inputMesh)
+{
     vtkNew<vtkSmoothPolyDataFilter> filter;
     filter->SetInputData(GeometryUtils::copyToVtkPolyData(inputMesh));
     filter->SetNumberOfIterations(m_NumberOfIterations);
@@ -51,4 +67,208 @@ SurfaceMeshSmoothen::requestUpdate()
 
     setOutput(GeometryUtils::copyToSurfaceMesh(filter->GetOutput()));
 }
-} // namespace imstk
\ No newline at end of file
+
+void
+SurfaceMeshSmoothen::updateAdjacency(const SurfaceMesh& inputMesh)
+{
+    std::shared_ptr<VecDataArray<int, 3>> cellsPtr    = inputMesh.getCells();
+    const int                             numVertices = inputMesh.getNumVertices();
+    if (m_adjacencyCells != cellsPtr)
+    {
+        m_adjacencyCells      = cellsPtr;
+        *m_adjacencyModified = true;
+
+        // Lambdas can't be disconnected, only hold the flag weakly as the buffer may outlive this
+        std::weak_ptr<bool> adjacencyModified = m_adjacencyModified;
+        connect<Event>(cellsPtr, &AbstractDataArray::modified,
+            std::function<void(Event*)>([adjacencyModified](Event*)
+            {
+                if (std::shared_ptr<bool> modified = adjacencyModified.lock())
+                {
+                    *modified = true;
+                }
+            }));
+    }
+    if (!*m_adjacencyModified && m_adjacencyNumVertices == numVertices)
+    {
+        return;
+    }
+    *m_adjacencyModified   = false;
+    m_adjacencyNumVertices = numVertices;
+    m_localIds.assign(numVertices, -1);
+
+    // Gather the neighbors of every vertex, once per triangle they share an edge in
+    const VecDataArray<int, 3>& cells = *cellsPtr;
+    m_adjacencyOffsets.assign(numVertices + 1, 0);
+    for (int i = 0; i < cells.size(); i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            m_adjacencyOffsets[cells[i][j] + 1] += 2;
+        }
+    }
+    for (int i = 0; i < numVertices; i++)
+    {
+        m_adjacencyOffsets[i + 1] += m_adjacencyOffsets[i];
+    }
+    m_adjacencyNeighbors.resize(m_adjacencyOffsets[numVertices]);
+    std::vector<int> fill(m_adjacencyOffsets.begin(), m_adjacencyOffsets.end() - 1);
+    for (int i = 0; i < cells.size(); i++)
+    {
+        const Vec3i& cell = cells[i];
+        for (int j = 0; j < 3; j++)
+        {
+            m_adjacencyNeighbors[fill[cell[j]]++] = cell[(j + 1) % 3];
+            m_adjacencyNeighbors[fill[cell[j]]++] = cell[(j + 2) % 3];
+        }
+    }
+
+    // Sort them so a neighbor is listed as many times as there are triangles on its edge,
+    // once for boundary edges, then classify the vertex from its boundary edges
+    m_adjacencyTypes.assign(numVertices, SmoothType::Fixed);
+    m_boundaryNeighbors.assign(numVertices, Vec2i(-1, -1));
+    ParallelUtils::parallelFor(numVertices, [&](const int i)
+        {
+            const auto begin = m_adjacencyNeighbors.begin() + m_adjacencyOffsets[i];
+            const auto end   = m_adjacencyNeighbors.begin() + m_adjacencyOffsets[i + 1];
+            if (begin == end)
+            {
+                return;
+            }
+            std::sort(begin, end);
+            int  numBoundaryEdges = 0;
+            bool isManifold       = true;
+            for (auto j = begin; j != end;)
+            {
+                const auto next  = std::find_if(j, end, [&](const int k) { return k != *j; });
+                const auto count = std::distance(j, next);
+                if (count == 1)
+                {
+                    if (numBoundaryEdges < 2)
+                    {
+                        m_boundaryNeighbors[i][numBoundaryEdges] = *j;
+                    }
+                    numBoundaryEdges++;
+                }
+                isManifold &= (count <= 2);
+                j = next;
+            }
+            if (!isManifold)
+            {
+                return;
+            }
+            if (numBoundaryEdges == 0)
+            {
+                m_adjacencyTypes[i] = SmoothType::Interior;
+            }
+            else if (numBoundaryEdges == 2)
+            {
+                m_adjacencyTypes[i] = SmoothType::Boundary;
+            }
+        }, numVertices > 1000);
+}
+
+void
+SurfaceMeshSmoothen::smoothNative(std::shared_ptr<SurfaceMesh> inputMesh)
+{
+    updateAdjacency(*inputMesh);
+
+    std::shared_ptr<VecDataArray<double, 3>> verticesPtr = inputMesh->getVertexPositions();
+    const VecDataArray<double, 3>&           vertices    = *verticesPtr;
+    const int                                numVertices = vertices.size();
+
+    std::vector<int> vertexIds = m_vertexIds;
+    if (vertexIds.empty())
+    {
+        vertexIds.resize(numVertices);
+        std::iota(vertexIds.begin(), vertexIds.end(), 0);
+    }
+    const int numIds = static_cast<int>(vertexIds.size());
+
+    // Boundary vertices at a corner sharper than the edge angle stay in place
+    const double            cosEdgeAngle = std::cos(m_EdgeAngle * PI / 180.0);
+    std::vector<SmoothType> types(numIds);
+    for (int i = 0; i < numIds; i++)
+    {
+        const int vertexId = vertexIds[i];
+        m_localIds[vertexId] = i;
+        types[i] = m_adjacencyTypes[vertexId];
+        if (types[i] == SmoothType::Boundary)
+        {
+            const Vec2i& boundaryNeighbors = m_boundaryNeighbors[vertexId];
+            const Vec3d  dir0 = (vertices[vertexId] - vertices[boundaryNeighbors[0]]).normalized();
+            const Vec3d  dir1 = (vertices[boundaryNeighbors[1]] - vertices[vertexId]).normalized();
+            if (!m_BoundarySmoothing || dir0.dot(dir1) < cosEdgeAngle)
+            {
+                types[i] = SmoothType::Fixed;
+            }
+        }
+    }
+
+    // Jacobi iterations between two buffers of the vertices to smooth, the others are read
+    // from the input
+    VecDataArray<double, 3> prevPositions(numIds);
+    VecDataArray<double, 3> newPositions(numIds);
+    VecDataArray<double, 3> displacements(numIds);
+    for (int i = 0; i < numIds; i++)
+    {
+        prevPositions[i] = vertices[vertexIds[i]];
+    }
+    newPositions = prevPositions;
+    double convergenceDist = 0.0;
+    if (m_Convergence > 0.0)
+    {
+        Vec3d min, max;
+        ParallelUtils::findAABB(vertices, min, max);
+        convergenceDist = m_Convergence * (max - min).norm();
+    }
+    for (int iter = 0; iter < m_NumberOfIterations; iter++)
+    {
+        ParallelUtils::parallelFor(numIds, [&](const int i)
+            {
+                if (types[i] == SmoothType::Fixed)
+                {
+                    displacements[i] = Vec3d::Zero();
+                    return;
+                }
+                const int vertexId = vertexIds[i];
+                Vec3d     sum      = Vec3d::Zero();
+                int       count    = 0;
+                for (int j = m_adjacencyOffsets[vertexId]; j < m_adjacencyOffsets[vertexId + 1]; j++)
+                {
+                    // Boundary vertices only use their neighbors on a boundary edge, listed once
+                    const int  k = m_adjacencyNeighbors[j];
+                    const bool isRepeated = (j > m_adjacencyOffsets[vertexId] && m_adjacencyNeighbors[j - 1] == k)
+                                            || (j + 1 < m_adjacencyOffsets[vertexId + 1] && m_adjacencyNeighbors[j + 1] == k);
+                    if (types[i] == SmoothType::Interior || !isRepeated)
+                    {
+                        const int localId = m_localIds[k];
+                        sum += (localId == -1) ? vertices[k] : prevPositions[localId];
+                        count++;
+                    }
+                }
+                displacements[i] = m_RelaxationFactor * (sum / count - prevPositions[i]);
+                newPositions[i]  = prevPositions[i] + displacements[i];
+            }, numIds > 1000);
+        std::swap(prevPositions, newPositions);
+
+        if (ParallelUtils::findMaxL2Norm(displacements) <= convergenceDist)
+        {
+            break;
+        }
+    }
+
+    auto outputVerticesPtr = std::make_shared<VecDataArray<double, 3>>(vertices);
+    for (int i = 0; i < numIds; i++)
+    {
+        (*outputVerticesPtr)[vertexIds[i]] = prevPositions[i];
+        m_localIds[vertexIds[i]] = -1;
+    }
+
+    auto outputMesh = std::make_shared<SurfaceMesh>();
+    outputMesh->initialize(outputVerticesPtr, std::make_shared<VecDataArray<int, 3>>(*inputMesh->getCells()));
+    GeometryUtils::copyVertexAttributes(inputMesh, outputMesh);
+    GeometryUtils::copyCellAttributes(inputMesh, outputMesh);
+    setOutput(outputMesh);
+}
+} // namespace imstk
@@ -7,16 +7,24 @@
 #pragma once
 
 #include "imstkGeometryAlgorithm.h"
+#include "imstkMath.h"
+
+#include <vector>
 
 namespace imstk
 {
 class SurfaceMesh;
+template<typename T, int N> class VecDataArray;
 
 ///
 /// \class SurfaceMeshSmoothen
 ///
 /// \brief This filter smoothes the input SurfaceMesh currently only laplacian
-/// smoothing is provided
+/// smoothing is provided. Smoothing is done natively and in parallel unless
+/// feature edge smoothing or UseVtk is on, in which case vtkSmoothPolyDataFilter is used.
+/// Like it, interior vertices move towards the average of their neighbors, boundary
+/// vertices towards the average of their boundary neighbors, and vertices of non
+/// manifold edges or corners sharper than the edge angle stay in place.
 ///
 class SurfaceMeshSmoothen : public GeometryAlgorithm
 {
@@ -32,6 +40,7 @@ public:
     imstkGetMacro(EdgeAngle, double);
     imstkGetMacro(FeatureEdgeSmoothing, bool);
     imstkGetMacro(BoundarySmoothing, bool);
+    imstkGetMacro(UseVtk, bool);
 
     ///
     /// \brief Required input, port 0
@@ -45,11 +54,47 @@ public:
     imstkSetMacro(EdgeAngle, double);
     imstkSetMacro(FeatureEdgeSmoothing, bool);
     imstkSetMacro(BoundarySmoothing, bool);
+    imstkSetMacro(UseVtk, bool);
+
+    ///
+    /// \brief Set the vertices to smooth, the others stay in place. All of them
+    /// when empty, the default. Only used by the native smoothing, ie: to smooth the
+    /// region around a cut every frame
+    ///
+    void setVertexIds(const std::vector<int>& vertexIds) { m_vertexIds = vertexIds; }
+    const std::vector<int>& getVertexIds() const { return m_vertexIds; }
 
 protected:
     void requestUpdate() override;
 
+    ///
+    /// \brief Smooth with vtkSmoothPolyDataFilter
+    ///
+    void smoothVtk(std::shared_ptr<SurfaceMesh> inputMesh);
+
+    ///
+    /// \brief Smooth natively, on the input buffers. Only the vertices to smooth are
+    /// iterated, the output is a copy of the input with them replaced
+    ///
+    void smoothNative(std::shared_ptr<SurfaceMesh> inputMesh);
+
+    ///
+    /// \brief Rebuild the vertex adjacency and the vertex types it implies when the
+    /// topology of the input changed since the last update
+    ///
+    void updateAdjacency(const SurfaceMesh& inputMesh);
+
 private:
+    ///
+    /// \brief Vertices a vertex moves towards
+    ///
+    enum class SmoothType
+    {
+        Fixed,
+        Interior, ///< Towards all its neighbors
+        Boundary  ///< Towards its two boundary neighbors
+    };
+
     int    m_NumberOfIterations = 20;
     double m_RelaxationFactor   = 0.01;
     double m_Convergence  = 0.0;
@@ -57,5 +102,21 @@ private:
     double m_EdgeAngle    = 15.0;
     bool   m_FeatureEdgeSmoothing = false;
     bool   m_BoundarySmoothing    = true;
+    bool   m_UseVtk = false;
+
+    std::vector<int> m_vertexIds;
+
+    // Adjacency of the last input topology, kept until its index buffer is replaced or
+    // modified. The sorted neighbors of a vertex list a neighbor once per triangle on
+    // their edge, vertices are typed by their edges regardless of the positions.
+    std::shared_ptr<VecDataArray<int, 3>> m_adjacencyCells;
+    std::shared_ptr<bool>   m_adjacencyModified    = std::make_shared<bool>(true);
+    int                     m_adjacencyNumVertices = 0;
+    std::vector<int>        m_adjacencyOffsets;
+    std::vector<int>        m_adjacencyNeighbors;
+    std::vector<SmoothType> m_adjacencyTypes;
+    std::vector<Vec2i>      m_boundaryNeighbors;
+
+    std::vector<int> m_localIds; ///< Index of a vertex among the vertices to smooth, -1 if not
 };
 } // namespace imstk
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include <vector>
 #include <unordered_set>
 #include <algorithm>
+#include <numeric>
+#include <random>
 #include <gtest/gtest.h>
 
 #include "imstkGeometry.h"
@@ -247,4 +249,133 @@ TEST(imstkRCMTest, TestRCM)
         //std::cout << "Number of vertices = " << numVerts << std::endl;
         testRCM(*tetMesh->getCells(), numVerts);
     }
-}
\ No newline at end of file
+}
+///
+/// \brief Returns the average difference between the largest and smallest vertex index of the cells
+///
+template<int N>
+static double
+averageCellSpan(const VecDataArray<int, N>& cells)
+{
+    double span = 0.0;
+    for (const auto& cell : cells)
+    {
+        span += cell.maxCoeff() - cell.minCoeff();
+    }
+    return span / cells.size();
+}
+
+///
+/// \brief Create a tet grid with its vertices and cells randomly shuffled
+///
+static std::shared_ptr<TetrahedralMesh>
+createShuffledTetGrid()
+{
+    auto gridMesh = GeometryUtils::createUniformMesh(Vec3d(0.0, 0.0, 0.0), Vec3d(1.0, 1.0, 1.0), 8, 8, 8);
+    const VecDataArray<double, 3>& gridVertices = *gridMesh->getVertexPositions();
+    const VecDataArray<int, 4>&    gridCells    = *gridMesh->getCells();
+
+    std::mt19937     rng(0);
+    std::vector<int> vertexPerm(gridVertices.size());
+    std::iota(vertexPerm.begin(), vertexPerm.end(), 0);
+    std::shuffle(vertexPerm.begin(), vertexPerm.end(), rng);
+    std::vector<int> cellPerm(gridCells.size());
+    std::iota(cellPerm.begin(), cellPerm.end(), 0);
+    std::shuffle(cellPerm.begin(), cellPerm.end(), rng);
+
+    auto verticesPtr = std::make_shared<VecDataArray<double, 3>>(gridVertices.size());
+    for (int i = 0; i < gridVertices.size(); i++)
+    {
+        (*verticesPtr)[vertexPerm[i]] = gridVertices[i];
+    }
+    auto cellsPtr = std::make_shared<VecDataArray<int, 4>>(gridCells.size());
+    for (int i = 0; i < gridCells.size(); i++)
+    {
+        const Vec4i& cell = gridCells[cellPerm[i]];
+        (*cellsPtr)[i] = Vec4i(vertexPerm[cell[0]], vertexPerm[cell[1]], vertexPerm[cell[2]], vertexPerm[cell[3]]);
+    }
+
+    auto tetMesh = std::make_shared<TetrahedralMesh>();
+    tetMesh->initialize(verticesPtr, cellsPtr);
+    return tetMesh;
+}
+
+///
+/// \brief Reorder a shuffled tet grid, check the vertices of the cells are closer to
+/// each other and that the attributes and original ids follow the vertices and cells
+///
+static void
+testReorderMesh(const GeometryUtils::MeshNodeRenumberingStrategy method)
+{
+    auto                           tetMesh = createShuffledTetGrid();
+    const VecDataArray<double, 3>  oldVertices(*tetMesh->getVertexPositions());
+    const VecDataArray<int, 4>     oldCells(*tetMesh->getCells());
+    std::vector<std::array<size_t, 4>> connSTL;
+    toSTLVector(oldCells, connSTL);
+    const size_t numVerts     = tetMesh->getNumVertices();
+    const size_t oldBandwidth = bandwidth(connSTL, numVerts);
+    const double oldSpan      = averageCellSpan(oldCells);
+
+    // An attribute to check it's permuted with the vertices
+    auto vertexIds = std::make_shared<DataArray<int>>(static_cast<int>(numVerts));
+    std::iota(vertexIds->getPointer(), vertexIds->getPointer() + numVerts, 0);
+    tetMesh->setVertexAttribute("VertexIds", vertexIds);
+
+    GeometryUtils::reorderMesh(*tetMesh, method);
+
+    const VecDataArray<double, 3>& vertices = *tetMesh->getVertexPositions();
+    const VecDataArray<double, 3>& initialVertices = *tetMesh->getInitialVertexPositions();
+    const VecDataArray<int, 4>&    cells = *tetMesh->getCells();
+    ASSERT_EQ(vertices.size(), oldVertices.size());
+    ASSERT_EQ(cells.size(), oldCells.size());
+    ASSERT_TRUE(tetMesh->hasVertexAttribute("OriginalVertexIds"));
+    ASSERT_TRUE(tetMesh->hasCellAttribute("OriginalCellIds"));
+    const DataArray<int>& originalVertexIds = *std::dynamic_pointer_cast<DataArray<int>>(tetMesh->getVertexAttribute("OriginalVertexIds"));
+    const DataArray<int>& originalCellIds   = *std::dynamic_pointer_cast<DataArray<int>>(tetMesh->getCellAttribute("OriginalCellIds"));
+
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        EXPECT_EQ(vertices[i], oldVertices[originalVertexIds[i]]);
+        EXPECT_EQ(initialVertices[i], oldVertices[originalVertexIds[i]]);
+        EXPECT_EQ((*vertexIds)[i], originalVertexIds[i]);
+    }
+    int prevMinVertex = 0;
+    for (int i = 0; i < cells.size(); i++)
+    {
+        const Vec4i& oldCell = oldCells[originalCellIds[i]];
+        for (int j = 0; j < 4; j++)
+        {
+            EXPECT_EQ(originalVertexIds[cells[i][j]], oldCell[j]);
+        }
+        // Cells are sorted by their smallest vertex
+        EXPECT_LE(prevMinVertex, cells[i].minCoeff());
+        prevMinVertex = cells[i].minCoeff();
+    }
+
+    // Translate user ids
+    const std::vector<int> ids = GeometryUtils::getReorderedVertexIds(*tetMesh, { 0, 10, 20 });
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+        EXPECT_EQ(originalVertexIds[ids[i]], static_cast<int>(i * 10));
+    }
+    const std::vector<int> cellIds = GeometryUtils::getReorderedCellIds(*tetMesh, { 5 });
+    EXPECT_EQ(originalCellIds[cellIds[0]], 5);
+
+    EXPECT_LT(averageCellSpan(cells), oldSpan / 4.0);
+    // Only RCM minimizes the bandwidth, Morton has jumps between octants
+    if (method == GeometryUtils::MeshNodeRenumberingStrategy::ReverseCuthillMckee)
+    {
+        toSTLVector(cells, connSTL);
+        EXPECT_LT(bandwidth(connSTL, numVerts), oldBandwidth / 4);
+    }
+}
+
+TEST(imstkRCMTest, ReorderMeshRCM)
+{
+    testReorderMesh(GeometryUtils::MeshNodeRenumberingStrategy::ReverseCuthillMckee);
+}
+
+TEST(imstkRCMTest, ReorderMeshMorton)
+{
+    testReorderMesh(GeometryUtils::MeshNodeRenumberingStrategy::Morton);
+}
@@ -36,6 +36,7 @@
 #include <vtkTransform.h>
 #include <vtkTransformFilter.h>
 #include <vtkTriangleFilter.h>
+#include <vtkTypeInt32Array.h>
 #include <vtkUnsignedCharArray.h>
 #include <vtkUnsignedIntArray.h>
 #include <vtkUnsignedLongArray.h>
@@ -125,6 +126,32 @@ GeometryUtils::coupleVtkImageData(std::shared_ptr<ImageData> imageData)
     return imageDataVtk;
 }
 
+template<int dim>
+void
+GeometryUtils::coupleVtkCellArray(vtkCellArray* vtkCells, std::shared_ptr<VecDataArray<int, dim>> cells)
+{
+    static_assert(sizeof(int) == sizeof(vtkTypeInt32), "Cells are coupled as 32 bit connectivity");
+    CHECK(vtkCells != nullptr) << "vtkCellArray provided is not valid!";
+    CHECK(cells != nullptr) << "VecDataArray provided is not valid!";
+
+    vtkNew<vtkTypeInt32Array> connectivity;
+    connectivity->SetArray(reinterpret_cast<vtkTypeInt32*>(cells->getPointer()), static_cast<vtkIdType>(cells->size()) * dim, 1);
+    vtkCells->SetData(static_cast<vtkIdType>(dim), connectivity);
+}
+
+template void GeometryUtils::coupleVtkCellArray<2>(vtkCellArray*, std::shared_ptr<VecDataArray<int, 2>>);
+template void GeometryUtils::coupleVtkCellArray<3>(vtkCellArray*, std::shared_ptr<VecDataArray<int, 3>>);
+template void GeometryUtils::coupleVtkCellArray<4>(vtkCellArray*, std::shared_ptr<VecDataArray<int, 4>>);
+template void GeometryUtils::coupleVtkCellArray<8>(vtkCellArray*, std::shared_ptr<VecDataArray<int, 8>>);
+
+bool
+GeometryUtils::isCoupled(vtkDataArray* vtkArray, std::shared_ptr<AbstractDataArray> imstkArray)
+{
+    return vtkArray != nullptr && imstkArray != nullptr
+           && vtkArray->GetVoidPointer(0) == imstkArray->getVoidPointer()
+           && vtkArray->GetNumberOfValues() == static_cast<vtkIdType>(imstkArray->size());
+}
+
 vtkSmartPointer<vtkDataArray>
 GeometryUtils::copyToVtkDataArray(std::shared_ptr<AbstractDataArray> imstkArray)
 {
@@ -1119,6 +1146,107 @@ GeometryUtils::getVolume(std::shared_ptr<SurfaceMesh> surfMesh)
     return massProps->GetVolume();
 }
 
+void
+GeometryUtils::copyDataArrayTuples(std::shared_ptr<AbstractDataArray> src, std::shared_ptr<AbstractDataArray> dst,
+                                   const std::vector<int>& srcIds, const int dstOffset)
+{
+    CHECK(src->getScalarType() == dst->getScalarType() && src->getNumberOfComponents() == dst->getNumberOfComponents())
+        << "Cannot copy tuples between arrays of different types";
+
+    const int numComps  = src->getNumberOfComponents();
+    const int numTuples = srcIds.empty() ? src->size() / numComps : static_cast<int>(srcIds.size());
+    if (dst->size() / numComps < dstOffset + numTuples)
+    {
+        dst->resize(dstOffset + numTuples);
+    }
+    switch (src->getScalarType())
+    {
+        TemplateMacro(
+            const IMSTK_TT * srcPtr = static_cast<const IMSTK_TT*>(src->getVoidPointer());
+            IMSTK_TT * dstPtr       = static_cast<IMSTK_TT*>(dst->getVoidPointer()) + dstOffset * numComps;
+            if (srcIds.empty())
+            {
+                std::copy_n(srcPtr, numTuples * numComps, dstPtr);
+            }
+            else
+            {
+                ParallelUtils::parallelFor(numTuples, [&](const int i)
+                {
+                    std::copy_n(srcPtr + srcIds[i] * numComps, numComps, dstPtr + i * numComps);
+                }, numTuples > 1000);
+            });
+    default:
+        LOG(FATAL) << "Unknown scalar type";
+        break;
+    }
+}
+
+namespace // anonymous namespace
+{
+///
+/// \brief Copy the attributes of a data map, gathering the tuples ids
+///
+static std::unordered_map<std::string, std::shared_ptr<AbstractDataArray>>
+copyAttributes(const std::unordered_map<std::string, std::shared_ptr<AbstractDataArray>>& attributes,
+               const std::vector<int>& ids)
+{
+    std::unordered_map<std::string, std::shared_ptr<AbstractDataArray>> results;
+    for (const auto& attribute : attributes)
+    {
+        std::shared_ptr<AbstractDataArray> arr = attribute.second->clone();
+        if (!ids.empty())
+        {
+            arr->resize(static_cast<int>(ids.size()));
+            GeometryUtils::copyDataArrayTuples(attribute.second, arr, ids);
+        }
+        results[attribute.first] = arr;
+    }
+    return results;
+}
+} // namespace
+
+void
+GeometryUtils::copyVertexAttributes(std::shared_ptr<PointSet> src, std::shared_ptr<PointSet> dst,
+                                    const std::vector<int>& vertexIds)
+{
+    dst->setVertexAttributes(copyAttributes(src->getVertexAttributes(), vertexIds));
+    if (src->getActiveVertexNormals() != "")
+    {
+        dst->setVertexNormals(src->getActiveVertexNormals());
+    }
+    if (src->getActiveVertexScalars() != "")
+    {
+        dst->setVertexScalars(src->getActiveVertexScalars());
+    }
+    if (src->getActiveVertexTangents() != "")
+    {
+        dst->setVertexTangents(src->getActiveVertexTangents());
+    }
+    if (src->getActiveVertexTCoords() != "")
+    {
+        dst->setVertexTCoords(src->getActiveVertexTCoords());
+    }
+}
+
+void
+GeometryUtils::copyCellAttributes(std::shared_ptr<AbstractCellMesh> src, std::shared_ptr<AbstractCellMesh> dst,
+                                  const std::vector<int>& cellIds)
+{
+    dst->setCellAttributes(copyAttributes(src->getCellAttributes(), cellIds));
+    if (src->getActiveCellNormals() != "")
+    {
+        dst->setCellNormals(src->getActiveCellNormals());
+    }
+    if (src->getActiveCellScalars() != "")
+    {
+        dst->setCellScalars(src->getActiveCellScalars());
+    }
+    if (src->getActiveCellTangents() != "")
+    {
+        dst->setCellTangents(src->getActiveCellTangents());
+    }
+}
+
 namespace // anonymous namespace
 {
 ///
@@ -1318,6 +1446,140 @@ RCM(const std::vector<ElemConn>& conn, const size_t numVerts)
     return RCM(vertToVert);
 }
 
+///
+/// \brief Spread the lower 21 bits of x so that there are two zero bits between each
+///
+static uint64_t
+expandBits(uint64_t x)
+{
+    x &= 0x1FFFFF;
+    x  = (x | (x << 32)) & 0x1F00000000FFFFULL;
+    x  = (x | (x << 16)) & 0x1F0000FF0000FFULL;
+    x  = (x | (x << 8)) & 0x100F00F00F00F00FULL;
+    x  = (x | (x << 4)) & 0x10C30C30C30C30C3ULL;
+    x  = (x | (x << 2)) & 0x1249249249249249ULL;
+    return x;
+}
+
+///
+/// \brief Order the vertices along a Z-order (Morton) curve of their bounding box
+///
+/// \param[in] vertices positions
+/// \return the permutation vector that maps from new indices to old indices
+///
+static std::vector<size_t>
+mortonOrder(const VecDataArray<double, 3>& vertices)
+{
+    const size_t numVerts = static_cast<size_t>(vertices.size());
+    if (numVerts == 0)
+    {
+        return std::vector<size_t>();
+    }
+
+    Vec3d lowerCorner;
+    Vec3d upperCorner;
+    ParallelUtils::findAABB(vertices, lowerCorner, upperCorner);
+    const Vec3d  range = (upperCorner - lowerCorner).cwiseMax(Vec3d::Constant(IMSTK_DOUBLE_EPS));
+    const double maxCoord = static_cast<double>((1 << 21) - 1);
+
+    std::vector<uint64_t> codes(numVerts);
+    ParallelUtils::parallelFor(numVerts, [&](const size_t i)
+        {
+            const Vec3d p = (vertices[i] - lowerCorner).cwiseQuotient(range) * maxCoord;
+            codes[i] = expandBits(static_cast<uint64_t>(p[0])) |
+                       (expandBits(static_cast<uint64_t>(p[1])) << 1) |
+                       (expandBits(static_cast<uint64_t>(p[2])) << 2);
+        }, numVerts > 1000);
+
+    std::vector<size_t> P(numVerts);
+    std::iota(P.begin(), P.end(), 0);
+    std::stable_sort(P.begin(), P.end(), [&codes](const size_t i, const size_t j) { return codes[i] < codes[j]; });
+    return P;
+}
+
+///
+/// \brief Permute the tuples of an array, tuple i becomes the old tuple newToOld[i]
+///
+template<typename T>
+static void
+permuteTuples(T* data, const int numComps, const std::vector<int>& newToOld)
+{
+    const std::vector<T> oldData(data, data + newToOld.size() * numComps);
+    for (size_t i = 0; i < newToOld.size(); i++)
+    {
+        std::copy_n(&oldData[newToOld[i] * numComps], numComps, &data[i * numComps]);
+    }
+}
+
+///
+/// \brief Permute the tuples of an array of any type, arrays of another size are left alone
+///
+static void
+permuteTuples(AbstractDataArray& arr, const std::vector<int>& newToOld)
+{
+    const int numComps = arr.getNumberOfComponents();
+    if (static_cast<size_t>(arr.size()) != newToOld.size() * numComps)
+    {
+        LOG(WARNING) << "Array size doesn't match the amount of vertices or cells, not reordered";
+        return;
+    }
+    switch (arr.getScalarType())
+    {
+        TemplateMacro(permuteTuples(static_cast<IMSTK_TT*>(arr.getVoidPointer()), numComps, newToOld); );
+    default:
+        LOG(WARNING) << "Unknown scalar type";
+        break;
+    }
+}
+
+///
+/// \brief Permute all the arrays of an attribute map that weren't permuted yet
+///
+static void
+permuteAttributes(const std::unordered_map<std::string, std::shared_ptr<AbstractDataArray>>& attributes,
+                  const std::vector<int>& newToOld, std::unordered_set<AbstractDataArray*>& permutedArrays)
+{
+    for (const auto& attribute : attributes)
+    {
+        // Arrays may be shared between attributes
+        if (attribute.second != nullptr && permutedArrays.insert(attribute.second.get()).second)
+        {
+            permuteTuples(*attribute.second, newToOld);
+        }
+    }
+}
+
+///
+/// \brief Translate ids through an inverse permutation stored as an attribute
+///
+static std::vector<int>
+toReorderedIds(std::shared_ptr<AbstractDataArray> originalIdsArr, const std::vector<int>& originalIds)
+{
+    auto originalIdsPtr = std::dynamic_pointer_cast<DataArray<int>>(originalIdsArr);
+    if (originalIdsPtr == nullptr)
+    {
+        return originalIds;
+    }
+
+    const DataArray<int>& newToOld = *originalIdsPtr;
+    std::vector<int>      oldToNew(newToOld.size(), -1);
+    for (int i = 0; i < newToOld.size(); i++)
+    {
+        if (newToOld[i] >= 0 && newToOld[i] < newToOld.size())
+        {
+            oldToNew[newToOld[i]] = i;
+        }
+    }
+
+    std::vector<int> ids(originalIds.size());
+    for (size_t i = 0; i < originalIds.size(); i++)
+    {
+        CHECK(originalIds[i] >= 0 && originalIds[i] < static_cast<int>(oldToNew.size())) << "Id out of range";
+        ids[i] = oldToNew[originalIds[i]];
+    }
+    return ids;
+}
+
 ///
 /// \brief Given a set of points mark them as e (true) and outside
 /// \param surfaceMesh a \ref SurfaceMesh
@@ -1963,6 +2225,9 @@ GeometryUtils::reorderConnectivity(const std::vector<NeighborContainer>& neighbo
     {
     case (MeshNodeRenumberingStrategy::ReverseCuthillMckee):
         return RCM(neighbors);
+    case (MeshNodeRenumberingStrategy::Morton):
+        LOG(WARNING) << "Morton reordering needs the vertex positions, use reorderMesh; using RCM instead";
+        return RCM(neighbors);
     default:
         LOG(WARNING) << "Unrecognized reorder method; using RCM instead";
         return RCM(neighbors);
@@ -1977,11 +2242,137 @@ GeometryUtils::reorderConnectivity(const std::vector<ElemConn>& conn, const size
     {
     case (MeshNodeRenumberingStrategy::ReverseCuthillMckee):
         return RCM(conn, numVerts);
+    case (MeshNodeRenumberingStrategy::Morton):
+        LOG(WARNING) << "Morton reordering needs the vertex positions, use reorderMesh; using Reverse Cuthill-Mckee strategy instead";
+        return RCM(conn, numVerts);
     default:
         LOG(WARNING) << "Unrecognized reorder method; using Reverse Cuthill-Mckee strategy instead";
         return RCM(conn, numVerts);
     }
 }
+
+void
+GeometryUtils::reorderMesh(AbstractCellMesh& mesh, const MeshNodeRenumberingStrategy& method)
+{
+    std::shared_ptr<VecDataArray<double, 3>> verticesPtr = mesh.getInitialVertexPositions();
+    std::shared_ptr<AbstractDataArray>       cellsPtr    = mesh.getAbstractCells();
+    CHECK(verticesPtr != nullptr && cellsPtr != nullptr) << "Mesh has no vertices or cells";
+    CHECK(cellsPtr->getScalarType() == IMSTK_INT) << "Cells must be int";
+
+    const int  numVerts  = verticesPtr->size();
+    const int  cellSize  = mesh.getCellVertexCount();
+    const int  numCells  = mesh.getNumCells();
+    int* const cellsData = static_cast<int*>(cellsPtr->getVoidPointer());
+
+    // Compute the new to old vertex permutation
+    std::vector<size_t> vertexOrder;
+    switch (method)
+    {
+    case (MeshNodeRenumberingStrategy::Morton):
+        vertexOrder = mortonOrder(*verticesPtr);
+        break;
+    case (MeshNodeRenumberingStrategy::ReverseCuthillMckee):
+    default:
+    {
+        std::vector<std::vector<size_t>> neighbors(numVerts);
+        for (int i = 0; i < numCells; i++)
+        {
+            const int* cell = &cellsData[i * cellSize];
+            for (int j = 0; j < cellSize; j++)
+            {
+                for (int k = 0; k < cellSize; k++)
+                {
+                    if (j != k)
+                    {
+                        neighbors[cell[j]].push_back(static_cast<size_t>(cell[k]));
+                    }
+                }
+            }
+        }
+        ParallelUtils::parallelFor(neighbors.size(), [&neighbors](const size_t i)
+            {
+                std::sort(neighbors[i].begin(), neighbors[i].end());
+                neighbors[i].erase(std::unique(neighbors[i].begin(), neighbors[i].end()), neighbors[i].end());
+            }, numVerts > 1000);
+        vertexOrder = RCM(neighbors);
+        break;
+    }
+    }
+    std::vector<int> vertexNewToOld(vertexOrder.begin(), vertexOrder.end());
+    std::vector<int> vertexOldToNew(numVerts);
+    for (int i = 0; i < numVerts; i++)
+    {
+        vertexOldToNew[vertexNewToOld[i]] = i;
+    }
+
+    // Relabel the cells, then order them by their smallest vertex
+    std::vector<int> cellMinVertex(numCells);
+    for (int i = 0; i < numCells; i++)
+    {
+        int* cell = &cellsData[i * cellSize];
+        for (int j = 0; j < cellSize; j++)
+        {
+            cell[j] = vertexOldToNew[cell[j]];
+        }
+        cellMinVertex[i] = *std::min_element(cell, cell + cellSize);
+    }
+    std::vector<int> cellNewToOld(numCells);
+    std::iota(cellNewToOld.begin(), cellNewToOld.end(), 0);
+    std::stable_sort(cellNewToOld.begin(), cellNewToOld.end(),
+        [&cellMinVertex](const int i, const int j) { return cellMinVertex[i] < cellMinVertex[j]; });
+
+    // Keep the ids of the first ordering, if reordered before they are permuted with the others
+    if (!mesh.hasVertexAttribute("OriginalVertexIds"))
+    {
+        auto originalVertexIds = std::make_shared<DataArray<int>>(numVerts);
+        std::iota(originalVertexIds->getPointer(), originalVertexIds->getPointer() + numVerts, 0);
+        mesh.setVertexAttribute("OriginalVertexIds", originalVertexIds);
+    }
+    if (!mesh.hasCellAttribute("OriginalCellIds"))
+    {
+        auto originalCellIds = std::make_shared<DataArray<int>>(numCells);
+        std::iota(originalCellIds->getPointer(), originalCellIds->getPointer() + numCells, 0);
+        mesh.setCellAttribute("OriginalCellIds", originalCellIds);
+    }
+
+    // Permute every distinct array once
+    std::unordered_set<AbstractDataArray*> permutedVertexArrays;
+    for (auto arr : { mesh.getInitialVertexPositions(), mesh.getVertexPositions() })
+    {
+        if (arr != nullptr && permutedVertexArrays.insert(arr.get()).second)
+        {
+            permuteTuples(*arr, vertexNewToOld);
+        }
+    }
+    permuteAttributes(mesh.getVertexAttributes(), vertexNewToOld, permutedVertexArrays);
+    std::unordered_set<AbstractDataArray*> permutedCellArrays;
+    permutedCellArrays.insert(cellsPtr.get());
+    permuteTuples(*cellsPtr, cellNewToOld);
+    permuteAttributes(mesh.getCellAttributes(), cellNewToOld, permutedCellArrays);
+
+    // Recompute the maps that were in use
+    if (!mesh.getVertexNeighbors().empty())
+    {
+        mesh.computeVertexNeighbors();
+    }
+    else if (!mesh.getVertexToCellMap().empty())
+    {
+        mesh.computeVertexToCellMap();
+    }
+    mesh.postModified();
+}
+
+std::vector<int>
+GeometryUtils::getReorderedVertexIds(const PointSet& mesh, const std::vector<int>& originalIds)
+{
+    return toReorderedIds(mesh.getVertexAttribute("OriginalVertexIds"), originalIds);
+}
+
+std::vector<int>
+GeometryUtils::getReorderedCellIds(const AbstractCellMesh& mesh, const std::vector<int>& originalIds)
+{
+    return toReorderedIds(mesh.getCellAttribute("OriginalCellIds"), originalIds);
+}
 } // namespace imstk
 
 template std::vector<size_t> imstk::GeometryUtils::reorderConnectivity<std::set<size_t>>(const std::vector<std::set<size_t>>&, const GeometryUtils::MeshNodeRenumberingStrategy&);
@@ -95,6 +95,20 @@ vtkSmartPointer<vtkDataArray> coupleVtkDataArray(std::shared_ptr<AbstractDataArr
 vtkSmartPointer<vtkImageData> coupleVtkImageData(std::shared_ptr<ImageData> imstkImageData);
 ///@}
 
+///
+/// \brief Couple the cells to the vtk cell array, its connectivity points to the imstk
+/// indices and only the offsets are generated. The cell array has to be coupled again
+/// when the cells are reallocated or resized
+///
+template<int dim>
+void coupleVtkCellArray(vtkCellArray* vtkCells, std::shared_ptr<VecDataArray<int, dim>> cells);
+
+///
+/// \brief Returns if the vtk array points to all the values of the imstk array, false
+/// once the imstk array was reallocated or resized and the vtk array has to be coupled again
+///
+bool isCoupled(vtkDataArray* vtkArray, std::shared_ptr<AbstractDataArray> imstkArray);
+
 ///
 /// \brief Copy functions, these copy to/from vtk data objects
 ///@{
@@ -247,6 +261,28 @@ isClosed(std::shared_ptr<SurfaceMesh> surfMesh)
 ///
 double getVolume(std::shared_ptr<SurfaceMesh> surfMesh);
 
+///
+/// \brief Copy the tuples srcIds of src, all of them if empty, to dst from dstOffset on.
+/// dst is resized if too small, and must have the same scalar type and number of components
+///
+void copyDataArrayTuples(std::shared_ptr<AbstractDataArray> src, std::shared_ptr<AbstractDataArray> dst,
+                         const std::vector<int>& srcIds = std::vector<int>(), const int dstOffset = 0);
+
+///
+/// \brief Copy the vertex attributes of src to dst, only the tuples vertexIds if given,
+/// so vertex i of dst gets the attributes of vertex vertexIds[i] of src. The active
+/// attributes of src are also made active in dst
+///
+void copyVertexAttributes(std::shared_ptr<PointSet> src, std::shared_ptr<PointSet> dst,
+                          const std::vector<int>& vertexIds = std::vector<int>());
+
+///
+/// \brief Copy the cell attributes of src to dst, only the tuples cellIds if given,
+/// see copyVertexAttributes
+///
+void copyCellAttributes(std::shared_ptr<AbstractCellMesh> src, std::shared_ptr<AbstractCellMesh> dst,
+                        const std::vector<int>& cellIds = std::vector<int>());
+
 ///
 /// \brief Create a tetrahedral mesh based on a uniform Cartesian mesh
 /// \param aabbMin  the small corner of a box
@@ -269,14 +305,16 @@ std::shared_ptr<TetrahedralMesh> createTetrahedralMeshCover(std::shared_ptr<Surf
 ///
 enum class MeshNodeRenumberingStrategy
 {
-    ReverseCuthillMckee     // Reverse Cuthill-Mckee
+    ReverseCuthillMckee,    // Reverse Cuthill-Mckee
+    Morton                  // Z-order curve of the vertex positions
 };
 
 ///
 /// \brief Reorder indices in a connectivity to reduce bandwidth
 ///
 /// \param[in] neighbors array of neighbors of each vertex; eg, neighbors[i] is an object containing all neighbors of vertex-i
-/// \param[i] method reordering method; see \ref ReorderMethod
+/// \param[i] method reordering method; see \ref ReorderMethod. Morton needs the vertex
+/// positions, it is only supported by reorderMesh and falls back to ReverseCuthillMckee here
 ///
 /// \return the permutation vector that map from new indices to old indices
 ///
@@ -288,11 +326,40 @@ std::vector<size_t> reorderConnectivity(const std::vector<NeighborContainer>& ne
 ///
 /// \param[in] conn element-to-vertex connectivity
 /// \param[in] numVerts number of vertices
-/// \param[in] method reordering method; see \ref ReorderMethod
+/// \param[in] method reordering method; see \ref ReorderMethod. Morton needs the vertex
+/// positions, it is only supported by reorderMesh and falls back to ReverseCuthillMckee here
 ///
 /// \return the permutation vector that maps from new indices to old indices
 ///
 template<typename ElemConn>
 std::vector<size_t> reorderConnectivity(const std::vector<ElemConn>& conn, const size_t numVerts, const MeshNodeRenumberingStrategy& method = MeshNodeRenumberingStrategy::ReverseCuthillMckee);
+
+///
+/// \brief Renumber the vertices of a mesh to improve memory locality, then sort the cells
+/// by their smallest vertex. The positions, initial positions, vertex and cell attributes
+/// are permuted in place. Any computed vertex to cell and vertex neighbor maps are recomputed.
+///
+/// The original ids are kept in the int vertex attribute "OriginalVertexIds" and cell attribute
+/// "OriginalCellIds", already existing ones are permuted along, so ids refer to the first ordering.
+/// Reorder before the scene is initialized, the geometry maps are then computed on the new ordering.
+/// User given ids (ie: fixed nodes) can be translated with getReorderedVertexIds.
+///
+/// \param mesh to reorder
+/// \param method reordering method; ReverseCuthillMckee reduces the bandwidth of the vertex
+/// adjacency, Morton sorts the vertices along a Z-order curve
+///
+void reorderMesh(AbstractCellMesh& mesh, const MeshNodeRenumberingStrategy& method = MeshNodeRenumberingStrategy::ReverseCuthillMckee);
+
+///
+/// \brief Translate vertex ids of the mesh before reorderMesh into the current ids. Returns the
+/// ids unchanged if the mesh was never reordered
+///
+std::vector<int> getReorderedVertexIds(const PointSet& mesh, const std::vector<int>& originalIds);
+
+///
+/// \brief Translate cell ids of the mesh before reorderMesh into the current ids. Returns the
+/// ids unchanged if the mesh was never reordered
+///
+std::vector<int> getReorderedCellIds(const AbstractCellMesh& mesh, const std::vector<int>& originalIds);
 } // namespace GeometryUtils
 } // namespace imstk
\ No newline at end of file
@@ -0,0 +1,156 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkMshMeshIO.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkVegaMeshIO.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+
+using namespace imstk;
+
+///
+/// \brief n by n by n grid of vertices, every cube split in 6 tetrahedra
+///
+static void
+makeTetGrid(const int n, std::vector<Vec3d>& vertices, std::vector<Vec4i>& tets)
+{
+    auto id = [n](const int i, const int j, const int k) { return (i * n + j) * n + k; };
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            for (int k = 0; k < n; k++)
+            {
+                vertices.push_back(Vec3d(i, j, k) / n);
+            }
+        }
+    }
+    for (int i = 0; i < n - 1; i++)
+    {
+        for (int j = 0; j < n - 1; j++)
+        {
+            for (int k = 0; k < n - 1; k++)
+            {
+                const int v0 = id(i, j, k);
+                const int v1 = id(i + 1, j, k);
+                const int v2 = id(i + 1, j + 1, k);
+                const int v3 = id(i, j + 1, k);
+                const int v4 = id(i, j, k + 1);
+                const int v5 = id(i + 1, j, k + 1);
+                const int v6 = id(i + 1, j + 1, k + 1);
+                const int v7 = id(i, j + 1, k + 1);
+                tets.push_back(Vec4i(v0, v1, v2, v6));
+                tets.push_back(Vec4i(v0, v2, v3, v6));
+                tets.push_back(Vec4i(v0, v3, v7, v6));
+                tets.push_back(Vec4i(v0, v7, v4, v6));
+                tets.push_back(Vec4i(v0, v4, v5, v6));
+                tets.push_back(Vec4i(v0, v5, v1, v6));
+            }
+        }
+    }
+}
+
+///
+/// \brief Write the grid with n vertices per side as ASCII .msh and .veg once, returns the
+/// file path without extension
+///
+static std::string
+getGridFile(const int n)
+{
+    static std::map<int, std::string> files;
+    auto                              iter = files.find(n);
+    if (iter != files.end())
+    {
+        return iter->second;
+    }
+
+    std::vector<Vec3d> vertices;
+    std::vector<Vec4i> tets;
+    makeTetGrid(n, vertices, tets);
+    const std::string filePath = "MeshIOBenchmark_grid" + std::to_string(n);
+    char              line[256];
+
+    std::ofstream msh(filePath + ".msh", std::ios::binary);
+    msh << "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n$Nodes\n" << vertices.size() << "\n";
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        std::snprintf(line, sizeof(line), "%zu %.17g %.17g %.17g\n", i + 1, vertices[i][0], vertices[i][1], vertices[i][2]);
+        msh << line;
+    }
+    msh << "$EndNodes\n$Elements\n" << tets.size() << "\n";
+    for (size_t i = 0; i < tets.size(); i++)
+    {
+        std::snprintf(line, sizeof(line), "%zu 4 2 0 1 %d %d %d %d\n", i + 1, tets[i][0] + 1, tets[i][1] + 1, tets[i][2] + 1, tets[i][3] + 1);
+        msh << line;
+    }
+    msh << "$EndElements\n";
+
+    std::ofstream veg(filePath + ".veg", std::ios::binary);
+    veg << "# Vega mesh file.\n*VERTICES\n" << vertices.size() << " 3 0 0\n";
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        std::snprintf(line, sizeof(line), "%zu %.17g %.17g %.17g\n", i + 1, vertices[i][0], vertices[i][1], vertices[i][2]);
+        veg << line;
+    }
+    veg << "\n*ELEMENTS\nTET\n" << tets.size() << " 4 0\n";
+    for (size_t i = 0; i < tets.size(); i++)
+    {
+        std::snprintf(line, sizeof(line), "%zu %d %d %d %d\n", i + 1, tets[i][0] + 1, tets[i][1] + 1, tets[i][2] + 1, tets[i][3] + 1);
+        veg << line;
+    }
+    veg << "\n*MATERIAL BODY\nENU, 1000, 1E7, 0.4\n\n*REGION\nallElements, BODY\n";
+
+    files[n] = filePath;
+    return filePath;
+}
+
+///
+/// \brief Read of an ASCII .msh grid with range(0) vertices per side
+///
+static void
+BM_ReadMsh(benchmark::State& state)
+{
+    const int         n = static_cast<int>(state.range(0));
+    const std::string filePath = getGridFile(n) + ".msh";
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(MshMeshIO::read(filePath));
+    }
+    state.SetItemsProcessed(state.iterations() * (n - 1) * (n - 1) * (n - 1) * 6);
+}
+
+///
+/// \brief Read of a .veg grid with range(0) vertices per side, range(1) selects the vega loader
+///
+static void
+BM_ReadVega(benchmark::State& state)
+{
+    const int         n = static_cast<int>(state.range(0));
+    const std::string filePath = getGridFile(n) + ".veg";
+    for (auto _ : state)
+    {
+        if (state.range(1) == 0)
+        {
+            benchmark::DoNotOptimize(VegaMeshIO::read(filePath, MeshFileType::VEG));
+        }
+        else
+        {
+            benchmark::DoNotOptimize(VegaMeshIO::convertVegaMeshToVolumetricMesh(VegaMeshIO::readVegaMesh(filePath)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (n - 1) * (n - 1) * (n - 1) * 6);
+}
+
+// 56 vertices per side is about a million tetrahedra
+BENCHMARK(BM_ReadMsh)->Arg(16)->Arg(32)->Arg(56)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReadVega)->ArgsProduct({ { 16, 32, 56 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,191 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkBinaryMeshIO.h"
+#include "imstkImageData.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkVecDataArray.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+using namespace imstk;
+
+namespace
+{
+std::shared_ptr<SurfaceMesh>
+makeTriangles()
+{
+    auto vertices = std::make_shared<VecDataArray<double, 3>>(4);
+    (*vertices)[0] = Vec3d(0.0, 0.0, 0.0);
+    (*vertices)[1] = Vec3d(1.0, 0.0, 0.0);
+    (*vertices)[2] = Vec3d(0.0, 1.0, 0.0);
+    (*vertices)[3] = Vec3d(1.0, 1.0, 0.0);
+    auto indices = std::make_shared<VecDataArray<int, 3>>(2);
+    (*indices)[0] = Vec3i(0, 1, 2);
+    (*indices)[1] = Vec3i(1, 3, 2);
+
+    auto surfMesh = std::make_shared<SurfaceMesh>();
+    surfMesh->initialize(vertices, indices);
+
+    auto normals = std::make_shared<VecDataArray<double, 3>>(4);
+    for (int i = 0; i < 4; i++)
+    {
+        (*normals)[i] = Vec3d(0.0, 0.0, 1.0);
+    }
+    surfMesh->setVertexNormals("normals", normals);
+    auto ids = std::make_shared<DataArray<float>>(2);
+    (*ids)[0] = 5.0f;
+    (*ids)[1] = 7.0f;
+    surfMesh->setCellScalars("ids", ids);
+    return surfMesh;
+}
+} // namespace
+
+TEST(imstkBinaryMeshIOTest, SurfaceMeshRoundTrip)
+{
+    const std::string fileName = "imstkBinaryMeshIOTest_surf.imb";
+    ASSERT_TRUE(BinaryMeshIO::write(makeTriangles(), fileName));
+
+    auto surfMesh = std::dynamic_pointer_cast<SurfaceMesh>(BinaryMeshIO::read(fileName));
+    ASSERT_TRUE(surfMesh);
+
+    const VecDataArray<double, 3>& vertices = *surfMesh->getVertexPositions();
+    ASSERT_EQ(4, vertices.size());
+    EXPECT_EQ(Vec3d(1.0, 1.0, 0.0), vertices[3]);
+    EXPECT_EQ(Vec3d(1.0, 1.0, 0.0), (*surfMesh->getInitialVertexPositions())[3]);
+
+    const VecDataArray<int, 3>& indices = *surfMesh->getCells();
+    ASSERT_EQ(2, indices.size());
+    EXPECT_EQ(Vec3i(1, 3, 2), indices[1]);
+
+    ASSERT_TRUE(surfMesh->getVertexNormals());
+    EXPECT_EQ("normals", surfMesh->getActiveVertexNormals());
+    EXPECT_EQ(Vec3d(0.0, 0.0, 1.0), (*surfMesh->getVertexNormals())[2]);
+
+    auto ids = std::dynamic_pointer_cast<DataArray<float>>(surfMesh->getCellScalars());
+    ASSERT_TRUE(ids);
+    EXPECT_EQ(7.0f, (*ids)[1]);
+
+    surfMesh = nullptr;
+    ids      = nullptr;
+    std::remove(fileName.c_str());
+}
+
+TEST(imstkBinaryMeshIOTest, MappedArraysResize)
+{
+    const std::string fileName = "imstkBinaryMeshIOTest_resize.imb";
+    ASSERT_TRUE(BinaryMeshIO::write(makeTriangles(), fileName));
+    auto surfMesh = std::dynamic_pointer_cast<SurfaceMesh>(BinaryMeshIO::read(fileName));
+    ASSERT_TRUE(surfMesh);
+
+    // Writes are private and growing moves the values out of the file
+    VecDataArray<double, 3>& vertices = *surfMesh->getVertexPositions();
+    vertices[0] = Vec3d(-1.0, -1.0, -1.0);
+    for (int i = 0; i < 100; i++)
+    {
+        vertices.push_back(Vec3d(i, i, i));
+    }
+    ASSERT_EQ(104, vertices.size());
+    EXPECT_EQ(Vec3d(-1.0, -1.0, -1.0), vertices[0]);
+    EXPECT_EQ(Vec3d(1.0, 1.0, 0.0), vertices[3]);
+    EXPECT_EQ(Vec3d(99.0, 99.0, 99.0), vertices[103]);
+
+    surfMesh = nullptr;
+    std::remove(fileName.c_str());
+}
+
+TEST(imstkBinaryMeshIOTest, TetrahedralMeshRoundTrip)
+{
+    auto vertices = std::make_shared<VecDataArray<double, 3>>(4);
+    (*vertices)[0] = Vec3d(0.0, 0.0, 0.0);
+    (*vertices)[1] = Vec3d(1.0, 0.0, 0.0);
+    (*vertices)[2] = Vec3d(0.0, 1.0, 0.0);
+    (*vertices)[3] = Vec3d(0.0, 0.0, 1.0);
+    auto indices = std::make_shared<VecDataArray<int, 4>>(1);
+    (*indices)[0] = Vec4i(0, 1, 2, 3);
+    auto tetMesh = std::make_shared<TetrahedralMesh>();
+    tetMesh->initialize(vertices, indices);
+
+    const std::string fileName = "imstkBinaryMeshIOTest_tet.imb";
+    ASSERT_TRUE(BinaryMeshIO::write(tetMesh, fileName));
+    auto results = std::dynamic_pointer_cast<TetrahedralMesh>(BinaryMeshIO::read(fileName));
+    ASSERT_TRUE(results);
+
+    ASSERT_EQ(4, results->getNumVertices());
+    EXPECT_EQ(Vec3d(0.0, 0.0, 1.0), results->getVertexPosition(3));
+    ASSERT_EQ(1, results->getNumCells());
+    EXPECT_EQ(Vec4i(0, 1, 2, 3), (*results->getCells())[0]);
+
+    results = nullptr;
+    std::remove(fileName.c_str());
+}
+
+TEST(imstkBinaryMeshIOTest, ImageDataRoundTrip)
+{
+    auto image = std::make_shared<ImageData>();
+    image->allocate(IMSTK_UNSIGNED_SHORT, 1, Vec3i(4, 3, 2), Vec3d(0.5, 1.0, 2.0), Vec3d(1.0, 2.0, 3.0));
+    auto scalars = std::dynamic_pointer_cast<DataArray<unsigned short>>(image->getScalars());
+    for (int i = 0; i < scalars->size(); i++)
+    {
+        (*scalars)[i] = static_cast<unsigned short>(i);
+    }
+
+    const std::string fileName = "imstkBinaryMeshIOTest_image.imb";
+    ASSERT_TRUE(BinaryMeshIO::write(image, fileName));
+    auto results = std::dynamic_pointer_cast<ImageData>(BinaryMeshIO::read(fileName));
+    ASSERT_TRUE(results);
+
+    EXPECT_EQ(Vec3i(4, 3, 2), results->getDimensions());
+    EXPECT_EQ(Vec3d(0.5, 1.0, 2.0), results->getSpacing());
+    EXPECT_EQ(Vec3d(1.0, 2.0, 3.0), results->getOrigin());
+    EXPECT_EQ(1, results->getNumComponents());
+    auto resultScalars = std::dynamic_pointer_cast<DataArray<unsigned short>>(results->getScalars());
+    ASSERT_TRUE(resultScalars);
+    ASSERT_EQ(24, resultScalars->size());
+    EXPECT_EQ(23, (*resultScalars)[23]);
+
+    results       = nullptr;
+    resultScalars = nullptr;
+    std::remove(fileName.c_str());
+}
+
+TEST(imstkBinaryMeshIOTest, RejectsOtherSource)
+{
+    const std::string fileName = "imstkBinaryMeshIOTest_hash.imb";
+    ASSERT_TRUE(BinaryMeshIO::write(makeTriangles(), fileName, { 42, 7, 100 }));
+    EXPECT_FALSE(BinaryMeshIO::read(fileName, { 43, 7, 100 }));
+    // Same hash of another source, as a hash collision would give
+    EXPECT_FALSE(BinaryMeshIO::read(fileName, { 42, 8, 100 }));
+    EXPECT_FALSE(BinaryMeshIO::read(fileName, { 42, 7, 101 }));
+    EXPECT_TRUE(BinaryMeshIO::read(fileName, { 42, 7, 100 }));
+    std::remove(fileName.c_str());
+}
+
+TEST(imstkBinaryMeshIOTest, RejectsCorruptImageDimensions)
+{
+    auto image = std::make_shared<ImageData>();
+    image->allocate(IMSTK_UNSIGNED_SHORT, 1, Vec3i(4, 3, 2));
+
+    const std::string fileName = "imstkBinaryMeshIOTest_dims.imb";
+    for (const Vec3i& dims : { Vec3i(4, 3, 3), Vec3i(0, 3, 2), Vec3i(-4, -3, 2), Vec3i(1 << 30, 1 << 30, 1 << 30) })
+    {
+        ASSERT_TRUE(BinaryMeshIO::write(image, fileName));
+        {
+            // Overwrite the dimensions of the header, after the magic, version, byte order, geometry
+            // type, array count, source hashes and size, file size, origin and spacing
+            std::fstream file(fileName, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(104);
+            const int32_t fileDims[3] = { dims[0], dims[1], dims[2] };
+            file.write(reinterpret_cast<const char*>(fileDims), sizeof(fileDims));
+        }
+        EXPECT_FALSE(BinaryMeshIO::read(fileName)) << dims.transpose();
+    }
+    std::remove(fileName.c_str());
+}
@@ -0,0 +1,120 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkHexahedralMesh.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkVecDataArray.h"
+#include "imstkVegaMeshIO.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+using namespace imstk;
+
+TEST(imstkVegaMeshIOTest, ReadVeg_TetrahedralMesh)
+{
+    const std::string fileName = "imstkVegaMeshIOTest_tet.veg";
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        file << "# Vega mesh file.\r\n"
+             << "*VERTICES\r\n"
+             << "5 3 0 0\r\n"
+             << "1 0.0 0.0 0.0\r\n"
+             << "2 1.0 0.0 0.0\r\n"
+             << "# a comment between vertices\r\n"
+             << "3 0.0 1.0 0.0\r\n"
+             << "4 0.0 0.0 1.0\r\n"
+             << "5 -1.5e-1 2.5 +3\r\n"
+             << "\r\n"
+             << "*ELEMENTS\r\n"
+             << "TET\r\n"
+             << "2 4 0\r\n"
+             << "1 1 2 3 4\r\n"
+             << "2 2 3 4 5\r\n"
+             << "\r\n"
+             << "*MATERIAL BODY\r\n"
+             << "ENU, 1000, 1E7, 0.4\r\n";
+    }
+
+    auto tetMesh = std::dynamic_pointer_cast<TetrahedralMesh>(VegaMeshIO::read(fileName, MeshFileType::VEG));
+    ASSERT_TRUE(tetMesh);
+    std::remove(fileName.c_str());
+
+    const VecDataArray<double, 3>& vertices = *tetMesh->getVertexPositions();
+    ASSERT_EQ(5, vertices.size());
+    EXPECT_EQ(Vec3d(0.0, 1.0, 0.0), vertices[2]);
+    EXPECT_EQ(Vec3d(-0.15, 2.5, 3.0), vertices[4]);
+
+    const VecDataArray<int, 4>& indices = *tetMesh->getCells();
+    ASSERT_EQ(2, indices.size());
+    EXPECT_EQ(Vec4i(0, 1, 2, 3), indices[0]);
+    EXPECT_EQ(Vec4i(1, 2, 3, 4), indices[1]);
+}
+
+TEST(imstkVegaMeshIOTest, ReadVeg_HexahedralMesh_ZeroIndexed)
+{
+    const std::string fileName = "imstkVegaMeshIOTest_hex.veg";
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        file << "*VERTICES\n8 3 0 0\n";
+        for (int i = 0; i < 8; i++)
+        {
+            file << i << " " << (i & 1) << " " << ((i >> 1) & 1) << " " << ((i >> 2) & 1) << "\n";
+        }
+        file << "*ELEMENTS\nCUBIC\n1 8 0\n0 0 1 3 2 4 5 7 6\n";
+    }
+
+    auto hexMesh = std::dynamic_pointer_cast<HexahedralMesh>(VegaMeshIO::read(fileName, MeshFileType::VEG));
+    ASSERT_TRUE(hexMesh);
+    std::remove(fileName.c_str());
+
+    ASSERT_EQ(8, hexMesh->getNumVertices());
+    EXPECT_EQ(Vec3d(1.0, 1.0, 0.0), hexMesh->getVertexPosition(3));
+    ASSERT_EQ(1, hexMesh->getNumCells());
+    const Vec8i& hex = (*hexMesh->getCells())[0];
+    EXPECT_EQ(0, hex[0]);
+    EXPECT_EQ(3, hex[2]);
+    EXPECT_EQ(6, hex[7]);
+}
+
+TEST(imstkVegaMeshIOTest, ReadVeg_ParallelChunks)
+{
+    // Large enough to be parsed in several chunks
+    const int         n = 20000;
+    const std::string fileName = "imstkVegaMeshIOTest_large.veg";
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        file << "*VERTICES\n" << n << " 3 0 0\n";
+        for (int i = 0; i < n; i++)
+        {
+            file << i + 1 << " " << i << " " << 2 * i << " " << 3 * i << "\n";
+        }
+        file << "*ELEMENTS\nTET\n" << n - 3 << " 4 0\n";
+        for (int i = 0; i < n - 3; i++)
+        {
+            file << i + 1 << " " << i + 1 << " " << i + 2 << " " << i + 3 << " " << i + 4 << "\n";
+        }
+    }
+
+    auto tetMesh = std::dynamic_pointer_cast<TetrahedralMesh>(VegaMeshIO::read(fileName, MeshFileType::VEG));
+    ASSERT_TRUE(tetMesh);
+    std::remove(fileName.c_str());
+
+    const VecDataArray<double, 3>& vertices = *tetMesh->getVertexPositions();
+    ASSERT_EQ(n, vertices.size());
+    const VecDataArray<int, 4>& indices = *tetMesh->getCells();
+    ASSERT_EQ(n - 3, indices.size());
+    for (int i = 0; i < n; i++)
+    {
+        ASSERT_EQ(Vec3d(i, 2 * i, 3 * i), vertices[i]);
+    }
+    for (int i = 0; i < n - 3; i++)
+    {
+        ASSERT_EQ(Vec4i(i, i + 1, i + 2, i + 3), indices[i]);
+    }
+}
@@ -0,0 +1,598 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkBinaryMeshIO.h"
+#include "imstkDataArrayAllocator.h"
+#include "imstkHexahedralMesh.h"
+#include "imstkImageData.h"
+#include "imstkLineMesh.h"
+#include "imstkLogger.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkVecDataArray.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+namespace imstk
+{
+namespace
+{
+enum class GeometryId : uint32_t
+{
+    PointSet,
+    LineMesh,
+    SurfaceMesh,
+    TetrahedralMesh,
+    HexahedralMesh,
+    ImageData
+};
+
+enum class ArrayRole : uint32_t
+{
+    Vertices,
+    Cells,
+    VertexAttribute,
+    CellAttribute,
+    ImageScalars
+};
+
+///
+/// \brief Flags of the active attributes
+///
+enum ActiveFlag : uint32_t
+{
+    ActiveScalars  = 1,
+    ActiveNormals  = 2,
+    ActiveTangents = 4,
+    ActiveTCoords  = 8
+};
+
+constexpr char     Magic[8]        = { 'I', 'M', 'S', 'T', 'K', 'M', 'S', 'H' };
+constexpr uint32_t ByteOrderMark   = 0x01020304;
+constexpr uint64_t ArrayAlignment  = 64;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t geometryType;
+    uint32_t numArrays;
+    uint64_t sourceHash;
+    uint64_t sourceCheckHash;
+    uint64_t sourceSize;
+    uint64_t fileSize;
+    double origin[3];  ///< ImageData only
+    double spacing[3];
+    int32_t dims[3];
+    int32_t numComps;
+};
+
+struct ArrayRecord
+{
+    uint32_t role;
+    uint32_t scalarType;
+    uint32_t numComps;
+    uint32_t activeFlags;
+    uint64_t numValues;
+    uint64_t offset;     ///< Offset of the values from the start of the file
+    uint64_t nameOffset;
+    uint64_t nameLength;
+};
+
+static_assert(std::is_trivially_copyable<FileHeader>::value && std::is_trivially_copyable<ArrayRecord>::value,
+    "Header and records are written as raw memory");
+
+struct ArrayToWrite
+{
+    ArrayRole role;
+    std::string name;
+    uint32_t activeFlags;
+    std::shared_ptr<AbstractDataArray> array;
+};
+
+uint64_t
+getScalarTypeSize(const uint32_t scalarType)
+{
+    switch (scalarType)
+    {
+        TemplateMacro(return sizeof(IMSTK_TT));
+    default:
+        return 0;
+    }
+}
+
+uint64_t
+alignUp(const uint64_t value)
+{
+    return ((value + ArrayAlignment - 1) / ArrayAlignment) * ArrayAlignment;
+}
+
+bool
+getGeometryId(const std::string& typeName, GeometryId& id)
+{
+    static const std::pair<const char*, GeometryId> ids[] =
+    {
+        { "PointSet", GeometryId::PointSet },
+        { "LineMesh", GeometryId::LineMesh },
+        { "SurfaceMesh", GeometryId::SurfaceMesh },
+        { "TetrahedralMesh", GeometryId::TetrahedralMesh },
+        { "HexahedralMesh", GeometryId::HexahedralMesh },
+        { "ImageData", GeometryId::ImageData }
+    };
+    for (const auto& pair : ids)
+    {
+        if (typeName == pair.first)
+        {
+            id = pair.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+///
+/// \brief Create an array that adopts the values of the record in the mapped file
+///
+template<typename ArrayType>
+std::shared_ptr<ArrayType>
+adoptArray(const ArrayRecord& record, std::shared_ptr<MappedFileAllocator> file)
+{
+    auto      arr       = std::make_shared<ArrayType>();
+    const int numTuples = static_cast<int>(record.numValues / ArrayType::NumComponents);
+    if (numTuples > 0)
+    {
+        arr->setData(reinterpret_cast<typename ArrayType::ValueType*>(file->getData() + record.offset), numTuples, file);
+    }
+    return arr;
+}
+
+template<typename T>
+std::shared_ptr<AbstractDataArray>
+adoptTypedArray(const ArrayRecord& record, std::shared_ptr<MappedFileAllocator> file)
+{
+    switch (record.numComps)
+    {
+    case 1: return adoptArray<DataArray<T>>(record, file);
+    case 2: return adoptArray<VecDataArray<T, 2>>(record, file);
+    case 3: return adoptArray<VecDataArray<T, 3>>(record, file);
+    case 4: return adoptArray<VecDataArray<T, 4>>(record, file);
+    default: break;
+    }
+    return nullptr;
+}
+
+///
+/// \brief Create an array of any scalar type with up to 4 components adopting the record values
+///
+std::shared_ptr<AbstractDataArray>
+adoptAbstractArray(const ArrayRecord& record, std::shared_ptr<MappedFileAllocator> file)
+{
+    switch (record.scalarType)
+    {
+        TemplateMacro(return adoptTypedArray<IMSTK_TT>(record, file));
+    default:
+        break;
+    }
+    return nullptr;
+}
+
+template<typename MeshType>
+std::shared_ptr<MeshType>
+makeCellMesh(std::shared_ptr<VecDataArray<double, 3>> vertices, const ArrayRecord* cellsRecord,
+             std::shared_ptr<MappedFileAllocator> file)
+{
+    constexpr int N = MeshType::CellVertexCount;
+    if (cellsRecord == nullptr || cellsRecord->scalarType != IMSTK_INT || cellsRecord->numComps != N)
+    {
+        return nullptr;
+    }
+    auto mesh = std::make_shared<MeshType>();
+    mesh->initialize(vertices, adoptArray<VecDataArray<int, N>>(*cellsRecord, file));
+    return mesh;
+}
+} // namespace
+
+std::shared_ptr<PointSet>
+BinaryMeshIO::read(const std::string& filePath, const SourceId& source)
+{
+    auto file = std::make_shared<MappedFileAllocator>(filePath);
+    if (!file->isValid() || file->getSize() < sizeof(FileHeader))
+    {
+        LOG(WARNING) << "Failed to read binary mesh " << filePath;
+        return nullptr;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, file->getData(), sizeof(FileHeader));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.byteOrder != ByteOrderMark
+        || header.fileSize != file->getSize())
+    {
+        LOG(WARNING) << "Invalid binary mesh " << filePath;
+        return nullptr;
+    }
+    if (header.version != Version)
+    {
+        LOG(WARNING) << "Binary mesh " << filePath << " has version " << header.version << ", expected " << Version;
+        return nullptr;
+    }
+    if (source.hash != 0
+        && source != SourceId { header.sourceHash, header.sourceCheckHash, header.sourceSize })
+    {
+        return nullptr;
+    }
+
+    // Check the records lie within the file
+    const uint64_t tableEnd = sizeof(FileHeader) + static_cast<uint64_t>(header.numArrays) * sizeof(ArrayRecord);
+    if (tableEnd > header.fileSize)
+    {
+        LOG(WARNING) << "Truncated binary mesh " << filePath;
+        return nullptr;
+    }
+    std::vector<ArrayRecord> records(header.numArrays);
+    if (header.numArrays > 0)
+    {
+        std::memcpy(records.data(), file->getData() + sizeof(FileHeader), header.numArrays * sizeof(ArrayRecord));
+    }
+    const ArrayRecord* verticesRecord = nullptr;
+    const ArrayRecord* cellsRecord    = nullptr;
+    const ArrayRecord* scalarsRecord  = nullptr;
+    for (const ArrayRecord& record : records)
+    {
+        const uint64_t scalarSize = getScalarTypeSize(record.scalarType);
+        if (scalarSize == 0 || record.numComps == 0 || record.numValues % record.numComps != 0
+            || record.offset % ArrayAlignment != 0
+            || record.offset > header.fileSize || record.numValues > (header.fileSize - record.offset) / scalarSize
+            || record.nameOffset > header.fileSize || record.nameLength > header.fileSize - record.nameOffset)
+        {
+            LOG(WARNING) << "Corrupt array in binary mesh " << filePath;
+            return nullptr;
+        }
+        if (record.role == static_cast<uint32_t>(ArrayRole::Vertices))
+        {
+            verticesRecord = &record;
+        }
+        else if (record.role == static_cast<uint32_t>(ArrayRole::Cells))
+        {
+            cellsRecord = &record;
+        }
+        else if (record.role == static_cast<uint32_t>(ArrayRole::ImageScalars))
+        {
+            scalarsRecord = &record;
+        }
+    }
+
+    std::shared_ptr<VecDataArray<double, 3>> vertices;
+    if (verticesRecord != nullptr)
+    {
+        if (verticesRecord->scalarType != IMSTK_DOUBLE || verticesRecord->numComps != 3)
+        {
+            LOG(WARNING) << "Binary mesh " << filePath << " vertices are not 3 component doubles";
+            return nullptr;
+        }
+        vertices = adoptArray<VecDataArray<double, 3>>(*verticesRecord, file);
+    }
+    else
+    {
+        vertices = std::make_shared<VecDataArray<double, 3>>();
+    }
+
+    std::shared_ptr<PointSet> mesh = nullptr;
+    switch (static_cast<GeometryId>(header.geometryType))
+    {
+    case GeometryId::PointSet:
+        mesh = std::make_shared<PointSet>();
+        mesh->initialize(vertices);
+        break;
+    case GeometryId::LineMesh:
+        mesh = makeCellMesh<LineMesh>(vertices, cellsRecord, file);
+        break;
+    case GeometryId::SurfaceMesh:
+        mesh = makeCellMesh<SurfaceMesh>(vertices, cellsRecord, file);
+        break;
+    case GeometryId::TetrahedralMesh:
+        mesh = makeCellMesh<TetrahedralMesh>(vertices, cellsRecord, file);
+        break;
+    case GeometryId::HexahedralMesh:
+        mesh = makeCellMesh<HexahedralMesh>(vertices, cellsRecord, file);
+        break;
+    case GeometryId::ImageData:
+        if (scalarsRecord != nullptr)
+        {
+            // Number of values expected from the dimensions, without overflowing on corrupt dimensions
+            bool     validDims = header.numComps > 0;
+            uint64_t numValues = static_cast<uint64_t>(header.numComps);
+            for (int i = 0; i < 3 && validDims; i++)
+            {
+                validDims = header.dims[i] > 0 && numValues <= scalarsRecord->numValues / static_cast<uint64_t>(header.dims[i]);
+                numValues *= validDims ? static_cast<uint64_t>(header.dims[i]) : 1;
+            }
+            if (!validDims || numValues != scalarsRecord->numValues)
+            {
+                LOG(WARNING) << "Binary mesh " << filePath << " image dimensions do not match its scalars";
+                return nullptr;
+            }
+            auto imageData = std::make_shared<ImageData>();
+            int  dims[3]   = { header.dims[0], header.dims[1], header.dims[2] };
+            imageData->setScalars(adoptAbstractArray(*scalarsRecord, file), header.numComps, dims);
+            imageData->setOrigin(Vec3d(header.origin[0], header.origin[1], header.origin[2]));
+            imageData->setSpacing(Vec3d(header.spacing[0], header.spacing[1], header.spacing[2]));
+            mesh = imageData;
+        }
+        break;
+    default:
+        break;
+    }
+    if (mesh == nullptr)
+    {
+        LOG(WARNING) << "Binary mesh " << filePath << " has an unknown geometry or is missing its cells";
+        return nullptr;
+    }
+
+    // Attributes
+    auto cellMesh = std::dynamic_pointer_cast<AbstractCellMesh>(mesh);
+    for (const ArrayRecord& record : records)
+    {
+        const bool isVertexAttribute = record.role == static_cast<uint32_t>(ArrayRole::VertexAttribute);
+        const bool isCellAttribute   = record.role == static_cast<uint32_t>(ArrayRole::CellAttribute) && cellMesh != nullptr;
+        if (!isVertexAttribute && !isCellAttribute)
+        {
+            continue;
+        }
+        const std::string                  name(file->getData() + record.nameOffset, record.nameLength);
+        std::shared_ptr<AbstractDataArray> arr = adoptAbstractArray(record, file);
+        if (arr == nullptr)
+        {
+            LOG(WARNING) << "Skipping attribute " << name << " of binary mesh " << filePath;
+            continue;
+        }
+        if (isVertexAttribute)
+        {
+            mesh->setVertexAttribute(name, arr);
+            if (record.activeFlags & ActiveScalars)
+            {
+                mesh->setVertexScalars(name);
+            }
+            if (record.activeFlags & ActiveNormals)
+            {
+                mesh->setVertexNormals(name);
+            }
+            if (record.activeFlags & ActiveTangents)
+            {
+                mesh->setVertexTangents(name);
+            }
+            if (record.activeFlags & ActiveTCoords)
+            {
+                mesh->setVertexTCoords(name);
+            }
+        }
+        else
+        {
+            cellMesh->setCellAttribute(name, arr);
+            if (record.activeFlags & ActiveScalars)
+            {
+                cellMesh->setCellScalars(name);
+            }
+            if (record.activeFlags & ActiveNormals)
+            {
+                cellMesh->setCellNormals(name);
+            }
+            if (record.activeFlags & ActiveTangents)
+            {
+                cellMesh->setCellTangents(name);
+            }
+        }
+    }
+    return mesh;
+}
+
+bool
+BinaryMeshIO::write(std::shared_ptr<PointSet> mesh, const std::string& filePath, const SourceId& source)
+{
+    GeometryId geometryId;
+    if (mesh == nullptr || !getGeometryId(mesh->getTypeName(), geometryId))
+    {
+        LOG(WARNING) << "Binary mesh can't be written for " << (mesh == nullptr ? "null mesh" : mesh->getTypeName());
+        return false;
+    }
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(FileHeader));
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version      = Version;
+    header.byteOrder    = ByteOrderMark;
+    header.geometryType    = static_cast<uint32_t>(geometryId);
+    header.sourceHash      = source.hash;
+    header.sourceCheckHash = source.checkHash;
+    header.sourceSize      = source.size;
+
+    // Gather the arrays to write
+    std::vector<ArrayToWrite> arrays;
+    if (auto imageData = std::dynamic_pointer_cast<ImageData>(mesh))
+    {
+        if (imageData->getScalars() == nullptr)
+        {
+            LOG(WARNING) << "Binary mesh can't be written for ImageData without scalars";
+            return false;
+        }
+        const Vec3d& origin  = imageData->getOrigin();
+        const Vec3d& spacing = imageData->getSpacing();
+        for (int i = 0; i < 3; i++)
+        {
+            header.origin[i]  = origin[i];
+            header.spacing[i] = spacing[i];
+            header.dims[i]    = imageData->getDimensions()[i];
+        }
+        header.numComps = imageData->getNumComponents();
+        arrays.push_back({ ArrayRole::ImageScalars, "", 0, imageData->getScalars() });
+    }
+    else
+    {
+        arrays.push_back({ ArrayRole::Vertices, "", 0, mesh->getVertexPositions() });
+    }
+    for (const auto& attribute : mesh->getVertexAttributes())
+    {
+        uint32_t flags = 0;
+        flags |= (attribute.first == mesh->getActiveVertexScalars()) ? ActiveScalars : 0;
+        flags |= (attribute.first == mesh->getActiveVertexNormals()) ? ActiveNormals : 0;
+        flags |= (attribute.first == mesh->getActiveVertexTangents()) ? ActiveTangents : 0;
+        flags |= (attribute.first == mesh->getActiveVertexTCoords()) ? ActiveTCoords : 0;
+        arrays.push_back({ ArrayRole::VertexAttribute, attribute.first, flags, attribute.second });
+    }
+    if (auto cellMesh = std::dynamic_pointer_cast<AbstractCellMesh>(mesh))
+    {
+        arrays.push_back({ ArrayRole::Cells, "", 0, cellMesh->getAbstractCells() });
+        for (const auto& attribute : cellMesh->getCellAttributes())
+        {
+            uint32_t flags = 0;
+            flags |= (attribute.first == cellMesh->getActiveCellScalars()) ? ActiveScalars : 0;
+            flags |= (attribute.first == cellMesh->getActiveCellNormals()) ? ActiveNormals : 0;
+            flags |= (attribute.first == cellMesh->getActiveCellTangents()) ? ActiveTangents : 0;
+            arrays.push_back({ ArrayRole::CellAttribute, attribute.first, flags, attribute.second });
+        }
+    }
+
+    // Skip what can't be written
+    std::vector<const ArrayToWrite*> written;
+    for (const ArrayToWrite& arr : arrays)
+    {
+        if (arr.array == nullptr)
+        {
+            continue;
+        }
+        if (arr.role != ArrayRole::Cells && arr.array->getNumberOfComponents() > 4)
+        {
+            LOG(WARNING) << "Skipping attribute " << arr.name << ", only up to 4 components are written";
+            continue;
+        }
+        written.push_back(&arr);
+    }
+
+    // Lay out the table, the names and then the values
+    std::vector<ArrayRecord> records(written.size());
+    uint64_t                 offset = sizeof(FileHeader) + written.size() * sizeof(ArrayRecord);
+    for (size_t i = 0; i < written.size(); i++)
+    {
+        ArrayRecord& record = records[i];
+        record.role        = static_cast<uint32_t>(written[i]->role);
+        record.scalarType  = written[i]->array->getScalarType();
+        record.numComps    = static_cast<uint32_t>(written[i]->array->getNumberOfComponents());
+        record.activeFlags = written[i]->activeFlags;
+        record.numValues   = static_cast<uint64_t>(written[i]->array->size());
+        record.nameOffset  = offset;
+        record.nameLength  = written[i]->name.size();
+        offset += record.nameLength;
+    }
+    const uint64_t namesEnd = offset;
+    for (ArrayRecord& record : records)
+    {
+        record.offset = alignUp(offset);
+        offset        = record.offset + record.numValues * getScalarTypeSize(record.scalarType);
+    }
+    header.numArrays = static_cast<uint32_t>(records.size());
+    header.fileSize  = offset;
+
+    // Write to a temporary then rename so an interrupted write never leaves a partial file
+    const std::string tmpPath = filePath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            LOG(WARNING) << "Failed to open " << filePath << " for writing";
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+        out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(ArrayRecord));
+        for (const ArrayToWrite* arr : written)
+        {
+            out.write(arr->name.data(), arr->name.size());
+        }
+        const char padding[ArrayAlignment] = {};
+        uint64_t   pos = namesEnd;
+        for (size_t i = 0; i < records.size(); i++)
+        {
+            out.write(padding, records[i].offset - pos);
+            const uint64_t numBytes = records[i].numValues * getScalarTypeSize(records[i].scalarType);
+            out.write(static_cast<const char*>(written[i]->array->getVoidPointer()), numBytes);
+            pos = records[i].offset + numBytes;
+        }
+        if (!out.good())
+        {
+            LOG(WARNING) << "Failed to write " << filePath;
+            out.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+    std::remove(filePath.c_str());
+    if (std::rename(tmpPath.c_str(), filePath.c_str()) != 0)
+    {
+        LOG(WARNING) << "Failed to write " << filePath;
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool
+BinaryMeshIO::isSupported(std::shared_ptr<PointSet> mesh)
+{
+    GeometryId id;
+    return mesh != nullptr && getGeometryId(mesh->getTypeName(), id);
+}
+
+BinaryMeshIO::SourceId
+BinaryMeshIO::computeSourceId(const std::string& filePath)
+{
+    SourceId      source = SourceId();
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open())
+    {
+        return source;
+    }
+
+    // Mix 8 bytes at a time into two hashes with different seeds, multipliers and shifts
+    uint64_t              hash      = 0x9E3779B97F4A7C15ull;
+    uint64_t              checkHash = 0xC2B2AE3D27D4EB4Full;
+    std::vector<uint64_t> buffer(1 << 17);
+    while (file)
+    {
+        file.read(reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(uint64_t));
+        const size_t numBytes = static_cast<size_t>(file.gcount());
+        if (numBytes == 0)
+        {
+            break;
+        }
+        // Zero the tail of a partial last word
+        std::memset(reinterpret_cast<char*>(buffer.data()) + numBytes, 0, (8 - numBytes % 8) % 8);
+        const size_t numWords = (numBytes + 7) / 8;
+        for (size_t i = 0; i < numWords; i++)
+        {
+            hash ^= buffer[i];
+            hash *= 0xBF58476D1CE4E5B9ull;
+            hash ^= hash >> 31;
+
+            checkHash += buffer[i];
+            checkHash *= 0xFF51AFD7ED558CCDull;
+            checkHash ^= checkHash >> 33;
+        }
+        source.size += numBytes;
+    }
+    hash ^= source.size;
+    hash *= 0x94D049BB133111EBull;
+    hash ^= hash >> 29;
+    checkHash ^= source.size;
+    checkHash *= 0xC4CEB9FE1A85EC53ull;
+    checkHash ^= checkHash >> 33;
+
+    source.hash      = (hash == 0) ? 1 : hash;
+    source.checkHash = checkHash;
+    return source;
+}
+} // namespace imstk
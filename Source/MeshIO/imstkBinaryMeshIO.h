@@ -0,0 +1,76 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkMeshIO.h"
+
+#include <cstdint>
+
+namespace imstk
+{
+///
+/// \class BinaryMeshIO
+///
+/// \brief Reads and writes the native binary mesh format (.imb) of PointSet, LineMesh,
+/// SurfaceMesh, TetrahedralMesh, HexahedralMesh and ImageData with their vertex and
+/// cell attributes.
+///
+/// The file is a header, a table of the arrays, their names and then the raw values
+/// of every array, each 64 byte aligned. Reading maps the file copy-on-write and the
+/// arrays adopt their values in place, so loading costs a page fault per page touched
+/// instead of a parse. The file is kept mapped as long as one of its arrays is alive.
+/// Arrays are stored in native byte order, files of another byte order are rejected.
+///
+class BinaryMeshIO
+{
+public:
+    static constexpr uint32_t Version = 1;
+
+    ///
+    /// \brief Identifies the contents of the file a mesh was read from. The cache is named
+    /// after the hash, the independent check hash and size tell collisions apart.
+    /// Value initialize it, SourceId(), for no source
+    ///
+    struct SourceId
+    {
+        uint64_t hash; ///< 0 for no source
+        uint64_t checkHash;
+        uint64_t size;
+
+        bool operator==(const SourceId& other) const
+        {
+            return hash == other.hash && checkHash == other.checkHash && size == other.size;
+        }
+
+        bool operator!=(const SourceId& other) const { return !(*this == other); }
+    };
+
+    BinaryMeshIO() = default;
+    virtual ~BinaryMeshIO() = default;
+
+    ///
+    /// \brief Read the mesh of a .imb file, nullptr if it can't be read. With a
+    /// non zero source hash the file is only read if it was written from that source
+    ///
+    static std::shared_ptr<PointSet> read(const std::string& filePath, const SourceId& source = SourceId());
+
+    ///
+    /// \brief Write the mesh to a .imb file, the source is stored for read to check
+    ///
+    static bool write(std::shared_ptr<PointSet> mesh, const std::string& filePath, const SourceId& source = SourceId());
+
+    ///
+    /// \brief Returns if the geometry type can be written
+    ///
+    static bool isSupported(std::shared_ptr<PointSet> mesh);
+
+    ///
+    /// \brief Hashes and size of the contents of a file, a zero hash if it can't be read
+    ///
+    static SourceId computeSourceId(const std::string& filePath);
+};
+} // namespace imstk
@@ -6,6 +6,8 @@
 
 #include "imstkMeshIO.h"
 #include "imstkAssimpMeshIO.h"
+#include "imstkBinaryMeshIO.h"
+#include "imstkGeometryUtilities.h"
 #include "imstkLogger.h"
 #include "imstkMshMeshIO.h"
 #include "imstkSurfaceMesh.h"
@@ -14,6 +16,8 @@
 #include "imstkVTKMeshIO.h"
 
 #include <cctype>
+#include <iomanip>
+#include <sstream>
 #include <sys/stat.h>
 #include <unordered_map>
 
@@ -40,17 +44,17 @@ static std::unordered_map<std::string, MeshFileType> extToType =
     { "jpeg", MeshFileType::JPG },
     { "png", MeshFileType::PNG },
     { "bmp", MeshFileType::BMP },
+    { "imb", MeshFileType::IMB },
 };
 
-std::shared_ptr<PointSet>
-MeshIO::read(const std::string& filePath)
-{
-    bool isDirectory = false;
-    bool exists      = fileExists(filePath, isDirectory);
-
-    CHECK(exists && !isDirectory) << "File " << filePath << " doesn't exist or is a directory.";
+static std::string cacheDirectory = "";
 
-    MeshFileType meshType = MeshIO::getFileType(filePath);
+///
+/// \brief Read the file according to its type, without the cache
+///
+static std::shared_ptr<PointSet>
+readFile(const std::string& filePath, const MeshFileType meshType)
+{
     switch (meshType)
     {
     case MeshFileType::VTK:
@@ -79,6 +83,9 @@ MeshIO::read(const std::string& filePath)
     case MeshFileType::MSH:
         return MshMeshIO::read(filePath);
         break;
+    case MeshFileType::IMB:
+        return BinaryMeshIO::read(filePath);
+        break;
     case MeshFileType::UNKNOWN:
     default:
         break;
@@ -87,6 +94,73 @@ MeshIO::read(const std::string& filePath)
     return nullptr;
 }
 
+std::shared_ptr<PointSet>
+MeshIO::read(const std::string& filePath)
+{
+    bool isDirectory = false;
+    bool exists      = fileExists(filePath, isDirectory);
+
+    CHECK(exists && !isDirectory) << "File " << filePath << " doesn't exist or is a directory.";
+
+    MeshFileType meshType = MeshIO::getFileType(filePath);
+    if (cacheDirectory.empty() || meshType == MeshFileType::IMB)
+    {
+        return readFile(filePath, meshType);
+    }
+
+    // The cached copy is named after the hash of the file contents, a second independent
+    // hash and the size of the file are stored in it to tell collisions apart
+    const BinaryMeshIO::SourceId source = BinaryMeshIO::computeSourceId(filePath);
+    std::ostringstream           cachePath;
+    cachePath << cacheDirectory << "/" << std::hex << std::setw(16) << std::setfill('0') << source.hash
+              << "_v" << BinaryMeshIO::Version << ".imb";
+    bool isCacheDirectory = false;
+    if (fileExists(cachePath.str(), isCacheDirectory) && !isCacheDirectory)
+    {
+        if (std::shared_ptr<PointSet> mesh = BinaryMeshIO::read(cachePath.str(), source))
+        {
+            return mesh;
+        }
+    }
+
+    std::shared_ptr<PointSet> mesh = readFile(filePath, meshType);
+    if (BinaryMeshIO::isSupported(mesh))
+    {
+        BinaryMeshIO::write(mesh, cachePath.str(), source);
+    }
+    return mesh;
+}
+
+void
+MeshIO::setCacheDirectory(const std::string& cacheDir)
+{
+    bool isDirectory = false;
+    if (!cacheDir.empty() && !(fileExists(cacheDir, isDirectory) && isDirectory))
+    {
+        LOG(WARNING) << "Mesh cache directory " << cacheDir << " doesn't exist, cache disabled";
+        cacheDirectory = "";
+        return;
+    }
+    cacheDirectory = cacheDir;
+}
+
+std::string
+MeshIO::getCacheDirectory()
+{
+    return cacheDirectory;
+}
+
+std::shared_ptr<PointSet>
+MeshIO::read(const std::string& filePath, const GeometryUtils::MeshNodeRenumberingStrategy method)
+{
+    std::shared_ptr<PointSet> pointSet = read(filePath);
+    if (auto cellMesh = std::dynamic_pointer_cast<AbstractCellMesh>(pointSet))
+    {
+        GeometryUtils::reorderMesh(*cellMesh, method);
+    }
+    return pointSet;
+}
+
 bool
 MeshIO::fileExists(const std::string& file, bool& isDirectory)
 {
@@ -143,6 +217,9 @@ MeshIO::write(const std::shared_ptr<imstk::PointSet> imstkMesh, const std::strin
     case MeshFileType::VEG:
         return VegaMeshIO::write(imstkMesh, filePath, meshType);
         break;
+    case MeshFileType::IMB:
+        return BinaryMeshIO::write(imstkMesh, filePath);
+        break;
     case MeshFileType::NII:
     case MeshFileType::NRRD:
     case MeshFileType::VTU:
@@ -13,6 +13,11 @@ namespace imstk
 {
 class PointSet;
 
+namespace GeometryUtils
+{
+enum class MeshNodeRenumberingStrategy;
+} // namespace GeometryUtils
+
 ///
 /// \brief Enumeration the mesh file type
 ///
@@ -36,7 +41,8 @@ enum class MeshFileType
     MHD,
     JPG,
     PNG,
-    BMP
+    BMP,
+    IMB
 };
 
 ///
@@ -51,13 +57,35 @@ public:
     virtual ~MeshIO() = default;
 
     ///
-    /// \brief Read external file
+    /// \brief Read external file. With a cache directory set, the mesh is read from
+    /// its binary copy in the cache when the file contents didn't change, else it is
+    /// read and written to the cache for the next read
     ///
     static std::shared_ptr<PointSet> read(const std::string& filePath);
 
     template<typename T>
     static std::shared_ptr<T> read(const std::string& filePath) { return std::dynamic_pointer_cast<T>(read(filePath)); }
 
+    ///
+    /// \brief Read external file and renumber the vertices and cells of the mesh for
+    /// memory locality, see GeometryUtils::reorderMesh. Geometries without cells are
+    /// returned as read
+    ///
+    static std::shared_ptr<PointSet> read(const std::string& filePath, const GeometryUtils::MeshNodeRenumberingStrategy method);
+    template<typename T>
+    static std::shared_ptr<T> read(const std::string& filePath, const GeometryUtils::MeshNodeRenumberingStrategy method)
+    {
+        return std::dynamic_pointer_cast<T>(read(filePath, method));
+    }
+
+    ///
+    /// \brief Set the directory of the binary mesh cache, an empty directory (default)
+    /// disables the cache. See BinaryMeshIO
+    ///@{
+    static void setCacheDirectory(const std::string& cacheDirectory);
+    static std::string getCacheDirectory();
+    ///@}
+
     ///
     /// \brief Write external file
     ///
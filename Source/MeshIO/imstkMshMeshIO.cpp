@@ -7,14 +7,32 @@
 #include "imstkMshMeshIO.h"
 #include "imstkHexahedralMesh.h"
 #include "imstkLineMesh.h"
+#include "imstkParallelFor.h"
 #include "imstkSurfaceMesh.h"
 #include "imstkTetrahedralMesh.h"
+#include "imstkTextParsingUtils.h"
 #include "imstkVecDataArray.h"
 
+#include <algorithm>
 #include <fstream>
 
 namespace imstk
 {
+///
+/// \brief Vertex ids of the elements of each type, 1 - line, 2 - triangle, 3 - quad, 4 - tet, 5 - hex
+///
+using ElementVertIds = std::array<std::vector<int>, 6>;
+
+static const std::array<int, 6> elemTypeToCount =
+{
+    0,
+    2, // Line
+    3, // Triangle
+    4, // Quad
+    4, // Tetrahedron
+    8  // Hexahedron
+};
+
 ///
 /// \brief Consume all characters up to delimiters
 ///
@@ -30,21 +48,204 @@ readToDelimiter(std::ifstream& file)
 }
 
 ///
-/// \brief Converts a flat vector of ints to VecDataArray of ints of specified stride
+/// \brief Concatenates the vertex ids of an element type read by every chunk, in order,
+/// into a VecDataArray of ints of specified stride
 ///
 template<int N>
 static std::shared_ptr<VecDataArray<int, N>>
-toVecDataArray(const std::vector<int>& vertIds)
+toVecDataArray(const std::vector<ElementVertIds>& chunkVertIds, const int elemType)
 {
-    const int cellCount = static_cast<int>(vertIds.size() / N);
-    CHECK(vertIds.size() % N == 0) << "Failed to convert array stride not divisable";
+    std::vector<size_t> offsets(chunkVertIds.size() + 1, 0);
+    for (size_t i = 0; i < chunkVertIds.size(); i++)
+    {
+        offsets[i + 1] = offsets[i] + chunkVertIds[i][elemType].size();
+    }
+    CHECK(offsets.back() % N == 0) << "Failed to convert array stride not divisable";
+    const int cellCount = static_cast<int>(offsets.back() / N);
     std::shared_ptr<VecDataArray<int, N>> indicesPtr =
         std::make_shared<VecDataArray<int, N>>(cellCount);
-    std::copy(vertIds.data(), vertIds.data() + cellCount * N,
-        std::dynamic_pointer_cast<DataArray<int>>(indicesPtr)->getPointer());
+    int* indices = std::dynamic_pointer_cast<DataArray<int>>(indicesPtr)->getPointer();
+    ParallelUtils::parallelFor(chunkVertIds.size(),
+        [&](const size_t i)
+        {
+            const std::vector<int>& vertIds = chunkVertIds[i][elemType];
+            std::copy(vertIds.begin(), vertIds.end(), indices + offsets[i]);
+        }, chunkVertIds.size() > 1);
     return indicesPtr;
 }
 
+///
+/// \brief Create the mesh of the element type with the most vertices
+///
+static std::shared_ptr<PointSet>
+makeMesh(std::shared_ptr<VecDataArray<double, 3>> verticesPtr, const std::vector<ElementVertIds>& chunkVertIds)
+{
+    // We only support homogenous element types
+    int typeToUse = 0;
+    int typeCount = 0;
+    for (int i = 0; i < 6; i++)
+    {
+        for (const ElementVertIds& vertIds : chunkVertIds)
+        {
+            if (vertIds[i].size() > 0)
+            {
+                typeCount++;
+                typeToUse = i;
+                break;
+            }
+        }
+    }
+    // If we have more than one only choose the highest in vertex count of the element
+    // so hex > tet > quad > tri > line
+    if (typeCount > 1)
+    {
+        LOG(WARNING) << "MshMeshIO::read only supports homogenous types of elements, " <<
+            typeCount << " types of elements were found, choosing one";
+    }
+
+    if (typeToUse == 1)
+    {
+        auto mesh = std::make_shared<LineMesh>();
+        mesh->initialize(verticesPtr, toVecDataArray<2>(chunkVertIds, typeToUse));
+        return mesh;
+    }
+    else if (typeToUse == 2)
+    {
+        auto mesh = std::make_shared<SurfaceMesh>();
+        mesh->initialize(verticesPtr, toVecDataArray<3>(chunkVertIds, typeToUse));
+        return mesh;
+    }
+    else if (typeToUse == 4)
+    {
+        auto mesh = std::make_shared<TetrahedralMesh>();
+        mesh->initialize(verticesPtr, toVecDataArray<4>(chunkVertIds, typeToUse));
+        return mesh;
+    }
+    else if (typeToUse == 5)
+    {
+        auto mesh = std::make_shared<HexahedralMesh>();
+        mesh->initialize(verticesPtr, toVecDataArray<8>(chunkVertIds, typeToUse));
+        return mesh;
+    }
+    return nullptr;
+}
+
+///
+/// \brief Reads an ASCII file. The file is read at once then the lines of nodes and
+/// elements are split in chunks parsed in parallel
+///
+static std::shared_ptr<PointSet>
+readAscii(const std::string& filePath)
+{
+    using namespace TextParsingUtils;
+
+    std::string buffer;
+    CHECK(readFile(filePath, buffer)) << "Failed to read file, failed to open " << filePath;
+    const char* end = buffer.data() + buffer.size();
+
+    // Nodes, a line of count then a line per node
+    const char* p = findKeywordLine(buffer.data(), end, "$Nodes");
+    CHECK(p != nullptr) << "Failed to read file, no $Nodes";
+    p = nextLine(p, end);
+    int nNodes = -1;
+    CHECK(parseNumber(p, end, nNodes) && nNodes >= 0) << "Failed to read file, invalid node count";
+    p = nextLine(p, end);
+    const char* nodesEnd = findKeywordLine(p, end, "$EndNodes");
+    CHECK(nodesEnd != nullptr) << "Failed to read file, invalid format";
+
+    auto                     verticesPtr = std::make_shared<VecDataArray<double, 3>>(nNodes);
+    VecDataArray<double, 3>& vertices    = *verticesPtr;
+    std::vector<TextRange>   nodeChunks  = splitLines(p, nodesEnd, getNumChunks(static_cast<size_t>(nodesEnd - p)));
+    std::vector<char>        nodeChunkValid(nodeChunks.size(), true);
+    ParallelUtils::parallelFor(nodeChunks.size(),
+        [&](const size_t i)
+        {
+            for (const char* line = nodeChunks[i].first; line < nodeChunks[i].second;
+                 line = nextLine(line, nodeChunks[i].second))
+            {
+                const char* q = line;
+                int id;
+                if (!parseNumber(q, nodeChunks[i].second, id))
+                {
+                    continue; // Blank line
+                }
+                Vec3d pos;
+                if (id < 1 || id > nNodes
+                    || !parseNumber(q, nodeChunks[i].second, pos[0])
+                    || !parseNumber(q, nodeChunks[i].second, pos[1])
+                    || !parseNumber(q, nodeChunks[i].second, pos[2]))
+                {
+                    nodeChunkValid[i] = false;
+                    return;
+                }
+                vertices[id - 1] = pos;
+            }
+        }, nodeChunks.size() > 1);
+    CHECK(std::all_of(nodeChunkValid.begin(), nodeChunkValid.end(), [](char valid) { return valid; }))
+        << "Failed to read file, invalid node";
+
+    // Elements, a line of count then a line per element
+    p = findKeywordLine(nodesEnd, end, "$Elements");
+    CHECK(p != nullptr) << "Failed to read file, no $Elements";
+    p = nextLine(p, end);
+    int numElements = -1;
+    CHECK(parseNumber(p, end, numElements) && numElements >= 0) << "Failed to read file, invalid element count";
+    p = nextLine(p, end);
+    const char* elementsEnd = findKeywordLine(p, end, "$EndElements");
+    CHECK(elementsEnd != nullptr) << "Failed to read file, invalid format";
+
+    std::vector<TextRange>      elementChunks = splitLines(p, elementsEnd, getNumChunks(static_cast<size_t>(elementsEnd - p)));
+    std::vector<ElementVertIds> chunkVertIds(elementChunks.size());
+    std::vector<char>           elementChunkValid(elementChunks.size(), true);
+    ParallelUtils::parallelFor(elementChunks.size(),
+        [&](const size_t i)
+        {
+            const char* chunkEnd = elementChunks[i].second;
+            for (const char* line = elementChunks[i].first; line < chunkEnd; line = nextLine(line, chunkEnd))
+            {
+                // Parse element header.
+                const char* q = line;
+                int elemGroupId = -1;
+                int elemType    = -1;
+                int numTags     = 0;
+                if (!parseNumber(q, chunkEnd, elemGroupId))
+                {
+                    continue; // Blank line
+                }
+                if (!parseNumber(q, chunkEnd, elemType) || !parseNumber(q, chunkEnd, numTags)
+                    || elemType < 1 || elemType > 5)
+                {
+                    elementChunkValid[i] = false;
+                    return;
+                }
+
+                // Read the tags but don't do anything with them
+                for (int j = 0; j < numTags; j++)
+                {
+                    int tag;
+                    parseNumber(q, chunkEnd, tag);
+                }
+
+                // Vertex ids
+                std::vector<int>& elemVertIds = chunkVertIds[i][elemType];
+                for (int j = 0; j < elemTypeToCount[elemType]; j++)
+                {
+                    int vertId;
+                    if (!parseNumber(q, chunkEnd, vertId))
+                    {
+                        elementChunkValid[i] = false;
+                        return;
+                    }
+                    elemVertIds.push_back(vertId - 1);
+                }
+            }
+        }, elementChunks.size() > 1);
+    CHECK(std::all_of(elementChunkValid.begin(), elementChunkValid.end(), [](char valid) { return valid; }))
+        << "Failed to read file, unsupported element type";
+
+    return makeMesh(verticesPtr, chunkVertIds);
+}
+
 std::shared_ptr<PointSet>
 MshMeshIO::read(const std::string& filePath)
 {
@@ -72,16 +273,18 @@ MshMeshIO::read(const std::string& filePath)
     CHECK(sizeof(int) == 4) << "Failed to read file, code must be compiled with int size 4 bytes";
 
     const bool isBinary = (fileType == 1);
+    if (!isBinary)
+    {
+        file.close();
+        return readAscii(filePath);
+    }
 
     // Read the number one written in binary to check endianness
     // If it's not one then file was written with different endian
-    if (isBinary)
-    {
-        int oneFromBinary;
-        readToDelimiter(file);
-        file.read(reinterpret_cast<char*>(&oneFromBinary), sizeof(int));
-        CHECK(oneFromBinary == 1) << "Failed to read file, file saved with different endianness than this machine";
-    }
+    int oneFromBinary;
+    readToDelimiter(file);
+    file.read(reinterpret_cast<char*>(&oneFromBinary), sizeof(int));
+    CHECK(oneFromBinary == 1) << "Failed to read file, file saved with different endianness than this machine";
 
     file >> bufferStr; // Read $EndMeshFormat
     CHECK(bufferStr == "$EndMeshFormat") << "Failed to read file, invalid format";
@@ -105,36 +308,22 @@ MshMeshIO::read(const std::string& filePath)
             VecDataArray<double, 3>& vertices = *verticesPtr;
             std::vector<size_t>      nodeIDs(nNodes);
 
-            if (isBinary)
+            // Read entire buffer as bytes
+            size_t            numBytes = (4 + 3 * dataSize) * nNodes;
+            std::vector<char> data(numBytes);
+            readToDelimiter(file);
+            file.read(data.data(), numBytes);
+            for (int i = 0; i < nNodes; i++)
             {
-                // Read entire buffer as bytes
-                size_t            numBytes = (4 + 3 * dataSize) * nNodes;
-                std::vector<char> data(numBytes);
-                readToDelimiter(file);
-                file.read(data.data(), numBytes);
-                for (int i = 0; i < nNodes; i++)
-                {
-                    int id = *reinterpret_cast<int*>(&data[i * (4 + 3 * dataSize)]) - 1;
-                    nodeIDs[i] = id;
+                int id = *reinterpret_cast<int*>(&data[i * (4 + 3 * dataSize)]) - 1;
+                nodeIDs[i] = id;
 
-                    // Note in code above we restrict to only double (8 byte floating pt), but in
-                    // the spec support could be added here for float (4 byte floating pt)
+                // Note in code above we restrict to only double (8 byte floating pt), but in
+                // the spec support could be added here for float (4 byte floating pt)
 
-                    // Copy the next 3 doubles
-                    double* x = reinterpret_cast<double*>(&data[i * (4 + 3 * dataSize) + 4]);
-                    std::copy(x, x + 3, &vertices[id][0]);
-                }
-            }
-            else
-            {
-                for (int i = 0; i < nNodes; i++)
-                {
-                    int   id;
-                    Vec3d pos;
-                    file >> id >> pos[0] >> pos[1] >> pos[2];
-                    nodeIDs[i]       = id - 1;
-                    vertices[id - 1] = pos;
-                }
+                // Copy the next 3 doubles
+                double* x = reinterpret_cast<double*>(&data[i * (4 + 3 * dataSize) + 4]);
+                std::copy(x, x + 3, &vertices[id][0]);
             }
 
             file >> bufferStr; // Read $EndNodes
@@ -142,143 +331,52 @@ MshMeshIO::read(const std::string& filePath)
         }
         else if (bufferStr == "$Elements")
         {
-            std::array<int, 6> elemTypeToCount =
-            {
-                0,
-                2, // Line
-                3, // Triangle
-                4, // Quad
-                4, // Tetrahedron
-                8  // Hexahedron
-            };
-
-            // 1 - line, 2 - triangle, 3 - quad, 4 - tet, 5 - hex
-            //std::array<std::vector<int>, 6> elementsIds;
-            std::array<std::vector<int>, 6> elementVertIds;
+            std::vector<ElementVertIds> elementVertIds(1);
 
             int numElements;
             file >> numElements;
             CHECK(!file.fail()) << "Failed to read file, ifstream error";
             readToDelimiter(file);
 
-            if (isBinary)
+            int elemIter = 0;
+            // Why not use a for loop?
+            while (elemIter < numElements)
             {
-                int elemIter = 0;
-                // Why not use a for loop?
-                while (elemIter < numElements)
+                // Parse element header.
+                int elemType, numElems, numTags;
+                file.read((char*)&elemType, sizeof(int));
+                file.read((char*)&numElems, sizeof(int));
+                file.read((char*)&numTags, sizeof(int));
+
+                CHECK(elemType > 0 && elemType < 6) <<
+                    "Failed to read file, unsupported element type";
+                int               vertexCount = elemTypeToCount[elemType];
+                std::vector<int>& elemVertIds = elementVertIds[0][elemType];
+
+                for (int i = 0; i < numElems; i++)
                 {
-                    // Parse element header.
-                    int elemType, numElems, numTags;
-                    file.read((char*)&elemType, sizeof(int));
-                    file.read((char*)&numElems, sizeof(int));
-                    file.read((char*)&numTags, sizeof(int));
-
-                    CHECK(elemType > 0 && elemType < 6) <<
-                        "Failed to read file, unsupported element type";
-                    int               vertexCount = elemTypeToCount[elemType];
-                    std::vector<int>& elemVertIds = elementVertIds[elemType];
-                    //std::vector<int>& elemIds = elementsIds[elemType];
-
-                    for (int i = 0; i < numElems; i++)
-                    {
-                        int elementId;
-                        file.read((char*)&elementId, sizeof(int));
-                        //elemIds.push_back(elementId - 1); // Msh starts from 1
-
-                        // Read the tags but don't do anything with them
-                        for (int j = 0; j < numTags; j++)
-                        {
-                            int tag;
-                            file.read((char*)&tag, sizeof(int));
-                        }
-
-                        // Vertex ids
-                        for (int j = 0; j < vertexCount; j++)
-                        {
-                            int vertId;
-                            file.read((char*)&vertId, sizeof(int));
-                            elemVertIds.push_back(vertId - 1);
-                        }
-                    }
-
-                    elemIter += numElems;
-                }
-            }
-            else
-            {
-                for (int i = 0; i < numElements; i++)
-                {
-                    // Parse element header.
-                    int elemGroupId = -1;
-                    int elemType    = -1;
-                    int numTags     = 0;
-                    file >> elemGroupId >> elemType >> numTags;
-                    CHECK(elemType > 0 && elemType < 6) <<
-                        "Failed to read file, unsupported element type";
-
-                    int               vertexCount = elemTypeToCount[elemType];
-                    std::vector<int>& elemVertIds = elementVertIds[elemType];
+                    int elementId;
+                    file.read((char*)&elementId, sizeof(int));
 
                     // Read the tags but don't do anything with them
                     for (int j = 0; j < numTags; j++)
                     {
                         int tag;
-                        file >> tag;
+                        file.read((char*)&tag, sizeof(int));
                     }
 
                     // Vertex ids
                     for (int j = 0; j < vertexCount; j++)
                     {
                         int vertId;
-                        file >> vertId;
+                        file.read((char*)&vertId, sizeof(int));
                         elemVertIds.push_back(vertId - 1);
                     }
                 }
-            }
 
-            // We only support homogenous element types
-            int typeToUse = 0;
-            int typeCount = 0;
-            for (int i = 0; i < 6; i++)
-            {
-                if (elementVertIds[i].size() > 0)
-                {
-                    typeCount++;
-                    typeToUse = i;
-                }
-            }
-            // If we have more than one only choose the highest in vertex count of the element
-            // so hex > tet > quad > tri > line
-            if (typeCount > 1)
-            {
-                LOG(WARNING) << "MshMeshIO::read only supports homogenous types of elements, " <<
-                    typeCount << " types of elements were found, choosing one";
-            }
-
-            if (typeToUse == 1)
-            {
-                auto mesh = std::make_shared<LineMesh>();
-                mesh->initialize(verticesPtr, toVecDataArray<2>(elementVertIds[typeToUse]));
-                results = mesh;
-            }
-            else if (typeToUse == 2)
-            {
-                auto mesh = std::make_shared<SurfaceMesh>();
-                mesh->initialize(verticesPtr, toVecDataArray<3>(elementVertIds[typeToUse]));
-                results = mesh;
-            }
-            else if (typeToUse == 4)
-            {
-                auto mesh = std::make_shared<TetrahedralMesh>();
-                mesh->initialize(verticesPtr, toVecDataArray<4>(elementVertIds[typeToUse]));
-                results = mesh;
-            }
-            else if (typeToUse == 5)
-            {
-                auto mesh = std::make_shared<HexahedralMesh>();
-                mesh->initialize(verticesPtr, toVecDataArray<8>(elementVertIds[typeToUse]));
-                results = mesh;
+                elemIter += numElems;
             }
+            results = makeMesh(verticesPtr, elementVertIds);
 
             file >> bufferStr; // Read $EndElements
             CHECK(bufferStr == "$EndElements") << "Failed to read file, invalid format";
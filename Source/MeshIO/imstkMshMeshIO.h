@@ -24,6 +24,9 @@ class SurfaceMesh;
 ///
 /// Only supports vertex data that is doubles (8 byte sized floating point).
 ///
+/// ASCII files are read in memory at once, their nodes and elements are then
+/// split in chunks of lines parsed in parallel.
+///
 class MshMeshIO
 {
 public:
@@ -0,0 +1,82 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkTextParsingUtils.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+#include <thread>
+
+namespace imstk
+{
+namespace TextParsingUtils
+{
+bool
+readFile(const std::string& filePath, std::string& buffer)
+{
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    const std::streamsize size = file.tellg();
+    if (size < 0)
+    {
+        return false;
+    }
+    buffer.resize(static_cast<size_t>(size));
+    file.seekg(0, std::ios::beg);
+    file.read(&buffer[0], size);
+    return !file.fail();
+}
+
+std::vector<TextRange>
+splitLines(const char* begin, const char* end, const int numChunks)
+{
+    std::vector<TextRange> chunks;
+    const size_t           chunkSize = std::max<size_t>(static_cast<size_t>(end - begin) / std::max(numChunks, 1), 1);
+    const char*            p = begin;
+    while (p < end)
+    {
+        const char* chunkEnd = (static_cast<size_t>(end - p) > chunkSize) ? nextLine(p + chunkSize - 1, end) : end;
+        chunks.push_back({ p, chunkEnd });
+        p = chunkEnd;
+    }
+    return chunks;
+}
+
+int
+getNumChunks(const size_t numBytes)
+{
+    const size_t minChunkSize = 64 * 1024;
+    const size_t maxNumChunks = std::max<size_t>(std::thread::hardware_concurrency(), 1) * 4;
+    return static_cast<int>(std::max<size_t>(std::min(numBytes / minChunkSize, maxNumChunks), 1));
+}
+
+const char*
+findKeywordLine(const char* p, const char* end, const std::string& keyword)
+{
+    const std::string_view text(p, static_cast<size_t>(end - p));
+    size_t                 pos = text.find(keyword);
+    while (pos != std::string_view::npos)
+    {
+        // Only blanks may precede it on its line
+        size_t lineStart = pos;
+        while (lineStart > 0 && (text[lineStart - 1] == ' ' || text[lineStart - 1] == '\t'))
+        {
+            lineStart--;
+        }
+        if (lineStart == 0 || text[lineStart - 1] == '\n')
+        {
+            return p + pos;
+        }
+        pos = text.find(keyword, pos + 1);
+    }
+    return nullptr;
+}
+} // namespace TextParsingUtils
+} // namespace imstk
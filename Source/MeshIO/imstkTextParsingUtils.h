@@ -0,0 +1,133 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include <charconv>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace imstk
+{
+namespace TextParsingUtils
+{
+///
+/// \brief Range of characters [begin, end)
+///
+using TextRange = std::pair<const char*, const char*>;
+
+///
+/// \brief Read the whole file into the buffer with a single read, false if it can't be read
+///
+bool readFile(const std::string& filePath, std::string& buffer);
+
+///
+/// \brief Split the range into about numChunks ranges of whole lines, each ends
+/// after a newline except the last one
+///
+std::vector<TextRange> splitLines(const char* begin, const char* end, const int numChunks);
+
+///
+/// \brief Number of chunks to parse a range of the given size with, a chunk per
+/// thread and a few more to balance uneven lines, no less than 64KB each
+///
+int getNumChunks(const size_t numBytes);
+
+///
+/// \brief Returns the start of the line after the one p is on, or end
+///
+inline const char*
+nextLine(const char* p, const char* end)
+{
+    while (p < end && *p != '\n')
+    {
+        p++;
+    }
+    return p < end ? p + 1 : end;
+}
+
+///
+/// \brief Skip spaces, tabs and commas, not newlines
+///
+inline const char*
+skipBlanks(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == ',' || *p == '\r'))
+    {
+        p++;
+    }
+    return p;
+}
+
+///
+/// \brief Skip any whitespace including newlines
+///
+inline const char*
+skipWhitespace(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == ',' || *p == '\r' || *p == '\n'))
+    {
+        p++;
+    }
+    return p;
+}
+
+///
+/// \brief Parse the next number on the line, skipping the blanks before it.
+/// Advances p past the number, returns false if there is none
+///
+template<typename T>
+bool
+parseNumber(const char*& p, const char* end, T& value)
+{
+    p = skipBlanks(p, end);
+    if (p < end && *p == '+')
+    {
+        p++;
+    }
+    const std::from_chars_result result = std::from_chars(p, end, value);
+    if (result.ec != std::errc())
+    {
+        return false;
+    }
+    p = result.ptr;
+    return true;
+}
+
+///
+/// \brief Doubles without floating point from_chars go through strtod, the
+/// numbers are terminated by whitespace so it never reads past the buffer
+///
+#if !defined(__cpp_lib_to_chars)
+template<>
+inline bool
+parseNumber<double>(const char*& p, const char* end, double& value)
+{
+    p = skipBlanks(p, end);
+    if (p == end)
+    {
+        return false;
+    }
+    char* numEnd = nullptr;
+    value = std::strtod(p, &numEnd);
+    if (numEnd == p)
+    {
+        return false;
+    }
+    p = numEnd;
+    return true;
+}
+#endif
+
+///
+/// \brief Find the first line at or after p starting with the keyword, returns the
+/// keyword position or nullptr if not found
+///
+const char* findKeywordLine(const char* p, const char* end, const std::string& keyword);
+} // namespace TextParsingUtils
+} // namespace imstk
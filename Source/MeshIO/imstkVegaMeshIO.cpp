@@ -7,10 +7,15 @@
 #include "imstkHexahedralMesh.h"
 #include "imstkLogger.h"
 #include "imstkMacros.h"
+#include "imstkParallelFor.h"
 #include "imstkTetrahedralMesh.h"
+#include "imstkTextParsingUtils.h"
 #include "imstkVecDataArray.h"
 #include "imstkVegaMeshIO.h"
 
+#include <algorithm>
+#include <atomic>
+
 DISABLE_WARNING_PUSH
     DISABLE_WARNING_HIDES_CLASS_MEMBER
 
@@ -21,11 +26,214 @@ DISABLE_WARNING_POP
 
 namespace imstk
 {
+namespace
+{
+using namespace TextParsingUtils;
+
+///
+/// \brief Returns if the line holds values, not blank nor a comment
+///
+bool
+isDataLine(const char* p, const char* end)
+{
+    p = skipBlanks(p, end);
+    return p < end && *p != '\n' && *p != '#';
+}
+
+///
+/// \brief Returns the first data line at or after p, or end
+///
+const char*
+nextDataLine(const char* p, const char* end)
+{
+    while (p < end && !isDataLine(p, end))
+    {
+        p = nextLine(p, end);
+    }
+    return p;
+}
+
+///
+/// \brief Parse the lines of a section in parallel chunks into count tuples of N values,
+/// skipping the first value of each line (its index). Lines are counted per chunk first
+/// so each chunk knows where its tuples go. Returns false if the section doesn't hold
+/// count tuples
+///
+template<typename T, int N>
+bool
+parseSection(const char* begin, const char* end, const int count, VecDataArray<T, N>& values)
+{
+    const std::vector<TextRange> chunks = splitLines(begin, end, getNumChunks(static_cast<size_t>(end - begin)));
+    std::vector<int>             offsets(chunks.size() + 1, 0);
+    ParallelUtils::parallelFor(chunks.size(),
+        [&](const size_t i)
+        {
+            int numLines = 0;
+            for (const char* line = chunks[i].first; line < chunks[i].second; line = nextLine(line, chunks[i].second))
+            {
+                numLines += isDataLine(line, chunks[i].second) ? 1 : 0;
+            }
+            offsets[i + 1] = numLines;
+        }, chunks.size() > 1);
+    for (size_t i = 0; i < chunks.size(); i++)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+    if (offsets.back() != count)
+    {
+        return false;
+    }
+
+    values.resize(count);
+    std::vector<char> chunkValid(chunks.size(), true);
+    ParallelUtils::parallelFor(chunks.size(),
+        [&](const size_t i)
+        {
+            const char* chunkEnd = chunks[i].second;
+            int         j = offsets[i];
+            for (const char* line = chunks[i].first; line < chunkEnd; line = nextLine(line, chunkEnd))
+            {
+                if (!isDataLine(line, chunkEnd))
+                {
+                    continue;
+                }
+                const char* q = line;
+                int         index;
+                bool        valid = parseNumber(q, chunkEnd, index);
+                for (int k = 0; k < N; k++)
+                {
+                    valid = valid && parseNumber(q, chunkEnd, values[j][k]);
+                }
+                if (!valid)
+                {
+                    chunkValid[i] = false;
+                    return;
+                }
+                j++;
+            }
+        }, chunks.size() > 1);
+    return std::all_of(chunkValid.begin(), chunkValid.end(), [](char valid) { return valid; });
+}
+
+///
+/// \brief Read the vertices and elements of a .veg file. The file is read at once then the
+/// sections are split in chunks of lines parsed in parallel. Returns nullptr for files
+/// it doesn't handle (binary, *INCLUDE, other element types) which are left to vega
+///
+std::shared_ptr<PointSet>
+readAscii(const std::string& filePath)
+{
+    std::string buffer;
+    if (!readFile(filePath, buffer) || buffer.find("*INCLUDE") != std::string::npos)
+    {
+        return nullptr;
+    }
+    const char* end = buffer.data() + buffer.size();
+
+    // *VERTICES then a line of: count, 3, 0, 0
+    const char* p = findKeywordLine(buffer.data(), end, "*VERTICES");
+    if (p == nullptr)
+    {
+        return nullptr;
+    }
+    p = nextDataLine(nextLine(p, end), end);
+    int numVertices = -1;
+    if (!parseNumber(p, end, numVertices) || numVertices < 0)
+    {
+        return nullptr;
+    }
+    p = nextDataLine(nextLine(p, end), end);
+
+    // Vertices are 1-indexed unless the first one is 0
+    const char* q         = p;
+    int         indexBase = 1;
+    if (!parseNumber(q, end, indexBase) || (indexBase != 0 && indexBase != 1))
+    {
+        return nullptr;
+    }
+
+    const char* verticesEnd = findKeywordLine(p, end, "*");
+    verticesEnd = (verticesEnd == nullptr) ? end : verticesEnd;
+    auto vertices = std::make_shared<VecDataArray<double, 3>>();
+    if (!parseSection(p, verticesEnd, numVertices, *vertices))
+    {
+        return nullptr;
+    }
+
+    // *ELEMENTS, the element type, then a line of: count, vertices per element, 0
+    p = findKeywordLine(verticesEnd, end, "*ELEMENTS");
+    if (p == nullptr)
+    {
+        return nullptr;
+    }
+    p = skipBlanks(nextDataLine(nextLine(p, end), end), end);
+    const bool isTet  = static_cast<size_t>(end - p) >= 3 && std::string(p, 3) == "TET";
+    const bool isCube = static_cast<size_t>(end - p) >= 5 && std::string(p, 5) == "CUBIC";
+    if (!isTet && !isCube)
+    {
+        return nullptr;
+    }
+    p = nextDataLine(nextLine(p, end), end);
+    int numElements = -1;
+    if (!parseNumber(p, end, numElements) || numElements < 0)
+    {
+        return nullptr;
+    }
+    p = nextDataLine(nextLine(p, end), end);
+    const char* elementsEnd = findKeywordLine(p, end, "*");
+    elementsEnd = (elementsEnd == nullptr) ? end : elementsEnd;
+
+    // Shift the vertex ids to 0-indexed and check them
+    auto toZeroIndexed = [&](auto& cells)
+                         {
+                             std::atomic<bool> valid = true;
+                             ParallelUtils::parallelFor(cells.size(),
+                                 [&](const int i)
+                                 {
+                                     cells[i].array() -= indexBase;
+                                     if ((cells[i].array() < 0).any() || (cells[i].array() >= numVertices).any())
+                                     {
+                                         valid = false;
+                                     }
+                                 }, cells.size() > 1000);
+                             return valid.load();
+                         };
+
+    if (isTet)
+    {
+        auto cells = std::make_shared<VecDataArray<int, 4>>();
+        if (!parseSection(p, elementsEnd, numElements, *cells) || !toZeroIndexed(*cells))
+        {
+            return nullptr;
+        }
+        auto tetMesh = std::make_shared<TetrahedralMesh>();
+        tetMesh->initialize(vertices, cells);
+        return tetMesh;
+    }
+    else
+    {
+        auto cells = std::make_shared<VecDataArray<int, 8>>();
+        if (!parseSection(p, elementsEnd, numElements, *cells) || !toZeroIndexed(*cells))
+        {
+            return nullptr;
+        }
+        auto hexMesh = std::make_shared<HexahedralMesh>();
+        hexMesh->initialize(vertices, cells);
+        return hexMesh;
+    }
+}
+} // namespace
+
 std::shared_ptr<PointSet>
 VegaMeshIO::read(const std::string& filePath, MeshFileType meshType)
 {
     CHECK(meshType == MeshFileType::VEG) << "@VegaMeshIO::read error: input file type is not veg for input " << filePath;
 
+    if (std::shared_ptr<PointSet> mesh = readAscii(filePath))
+    {
+        return mesh;
+    }
+
     // Read Vega Mesh
     std::shared_ptr<vega::VolumetricMesh> vegaMesh = VegaMeshIO::readVegaMesh(filePath);
 
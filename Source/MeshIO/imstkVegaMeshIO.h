@@ -32,7 +32,9 @@ public:
     virtual ~VegaMeshIO() = default;
 
     ///
-    /// \brief Read and generate volumetric mesh given a external vega mesh file
+    /// \brief Read and generate volumetric mesh given a external vega mesh file.
+    /// The vertices and elements are parsed in parallel chunks of lines, files using
+    /// *INCLUDE or other element types than TET and CUBIC are read through vega
     ///
     static std::shared_ptr<PointSet> read(const std::string& filePath, MeshFileType meshType);
 
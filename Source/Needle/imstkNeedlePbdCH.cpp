@@ -67,58 +67,94 @@ NeedlePbdCH::generateNewPunctureData()
     const Vec3d tip1    = m_needleMesh->getVertexPositions()->at(nodeIds[0]);
     const Vec3d tip2    = m_needleMesh->getVertexPositions()->at(nodeIds[1]);
 
-    // For every triangle, check if segment is in triangle (if so, puncture)
-    for (int triangleId = 0; triangleId < m_tissueSurfMesh->getNumCells(); triangleId++)
+    // Only lookup the ids and build the tree again when the surface index buffer is replaced
+    // or modified, ie: by cutting, refit it otherwise
+    std::shared_ptr<VecDataArray<int, 3>> surfTrianglesPtr = m_tissueSurfMesh->getCells();
+    const VecDataArray<double, 3>&        physVertices     = *physMesh->getVertexPositions();
+    if (m_tissueSurfTriangles != surfTrianglesPtr)
     {
-        const Vec3i& surfTriIds = m_tissueSurfMesh->getCells()->at(triangleId);
+        m_tissueSurfTriangles      = surfTrianglesPtr;
+        *m_tissueTrianglesModified = true;
 
-        // Indices of the vertices on the physics mesh (which could be a tet mesh)
-        Vec3i physTriIds;
-        physTriIds[0] = one2one->getParentVertexId(surfTriIds[0]);
-        physTriIds[1] = one2one->getParentVertexId(surfTriIds[1]);
-        physTriIds[2] = one2one->getParentVertexId(surfTriIds[2]);
+        // Lambdas can't be disconnected, only hold the flag weakly as the buffer may outlive this
+        std::weak_ptr<bool> trianglesModified = m_tissueTrianglesModified;
+        connect<Event>(surfTrianglesPtr, &AbstractDataArray::modified,
+            std::function<void(Event*)>([trianglesModified](Event*)
+            {
+                if (std::shared_ptr<bool> modified = trianglesModified.lock())
+                {
+                    *modified = true;
+                }
+            }));
+    }
+    if (*m_tissueTrianglesModified)
+    {
+        *m_tissueTrianglesModified = false;
+        m_tissuePhysTriangles.resize(surfTrianglesPtr->size());
+        for (int triangleId = 0; triangleId < surfTrianglesPtr->size(); triangleId++)
+        {
+            const Vec3i& surfTriIds = (*surfTrianglesPtr)[triangleId];
+            m_tissuePhysTriangles[triangleId] = Vec3i(
+                one2one->getParentVertexId(surfTriIds[0]),
+                one2one->getParentVertexId(surfTriIds[1]),
+                one2one->getParentVertexId(surfTriIds[2]));
+        }
+        m_tissueBvh.build(physVertices, m_tissuePhysTriangles);
+    }
+    else
+    {
+        m_tissueBvh.refit(physVertices, m_tissuePhysTriangles);
+    }
 
-        const Vec3d& a = physMesh->getVertexPositions()->at(physTriIds[0]);
-        const Vec3d& b = physMesh->getVertexPositions()->at(physTriIds[1]);
-        const Vec3d& c = physMesh->getVertexPositions()->at(physTriIds[2]);
+    // For every triangle near the tip segment, check if segment is in triangle (if so, puncture)
+    m_tissueBvh.intersectSegment(tip1, tip2, [&](const int triangleId)
+        {
+            // Indices of the vertices on the physics mesh (which could be a tet mesh)
+            const Vec3i& physTriIds = m_tissuePhysTriangles[triangleId];
 
-        // Barycentric coordinates of intersection point
-        Vec3d uvw = Vec3d::Zero();
+            const Vec3d& a = physVertices[physTriIds[0]];
+            const Vec3d& b = physVertices[physTriIds[1]];
+            const Vec3d& c = physVertices[physTriIds[2]];
 
-        // If this triangle has not already been punctured
-        const PunctureId punctureId = getPunctureId(needle, puncturable, triangleId);
-        if (needle->getState(punctureId) != Puncture::State::INSERTED)
-        {
-            // Check for intersection
-            if (CollisionUtils::testSegmentTriangle(tip1, tip2, a, b, c, uvw))
+            // Barycentric coordinates of intersection point
+            Vec3d uvw = Vec3d::Zero();
+
+            // Check for intersection, then if this triangle has not already been punctured
+            if (!CollisionUtils::testSegmentTriangle(tip1, tip2, a, b, c, uvw))
             {
-                needle->setState(punctureId, Puncture::State::INSERTED);
-
-                // Save the puncture data to the needle
-                Puncture& data = *needle->getPuncture(punctureId);
-                data.userData.id         = triangleId;
-                data.userData.ids[0]     = physTriIds[0];
-                data.userData.ids[1]     = physTriIds[1];
-                data.userData.ids[2]     = physTriIds[2];
-                data.userData.weights[0] = uvw[0];
-                data.userData.weights[1] = uvw[1];
-                data.userData.weights[2] = uvw[2];
-
-                // Create penetration data for constraints
-                PuncturePoint newPuncture;
-
-                newPuncture.triId      = triangleId;
-                newPuncture.triVertIds = physTriIds;
-                newPuncture.baryCoords = uvw;
-                newPuncture.segId      = tipSegmentId;
-
-                pData.needle.push_back(newPuncture);
-
-                m_needlePunctured = true;
-                LOG(DEBUG) << "Needle punctured triangle: " << triangleId;
+                return;
             }
-        }
-    }
+            const PunctureId punctureId = getPunctureId(needle, puncturable, triangleId);
+            if (needle->getState(punctureId) == Puncture::State::INSERTED)
+            {
+                return;
+            }
+
+            needle->setState(punctureId, Puncture::State::INSERTED);
+
+            // Save the puncture data to the needle
+            Puncture& data = *needle->getPuncture(punctureId);
+            data.userData.id         = triangleId;
+            data.userData.ids[0]     = physTriIds[0];
+            data.userData.ids[1]     = physTriIds[1];
+            data.userData.ids[2]     = physTriIds[2];
+            data.userData.weights[0] = uvw[0];
+            data.userData.weights[1] = uvw[1];
+            data.userData.weights[2] = uvw[2];
+
+            // Create penetration data for constraints
+            PuncturePoint newPuncture;
+
+            newPuncture.triId      = triangleId;
+            newPuncture.triVertIds = physTriIds;
+            newPuncture.baryCoords = uvw;
+            newPuncture.segId      = tipSegmentId;
+
+            pData.needle.push_back(newPuncture);
+
+            m_needlePunctured = true;
+            LOG(DEBUG) << "Needle punctured triangle: " << triangleId;
+        });
 }
 
 void
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "imstkBvh.h"
 #include "imstkMacros.h"
 #include "imstkPbdCollisionHandling.h"
 #include "imstkPbdPointTriangleConstraint.h"
@@ -128,6 +129,14 @@ protected:
     std::shared_ptr<PbdObject>   m_pbdTissueObj;
     std::shared_ptr<SurfaceMesh> m_tissueSurfMesh;
 
+    // Surface triangles with the vertex ids of the physics mesh, and a tree over them
+    // refit every step to find the triangles near the needle tip. Both are rebuilt when
+    // the surface index buffer is replaced or modified.
+    std::shared_ptr<VecDataArray<int, 3>> m_tissueSurfTriangles;
+    std::shared_ptr<bool> m_tissueTrianglesModified = std::make_shared<bool>(true);
+    VecDataArray<int, 3>  m_tissuePhysTriangles;
+    Bvh m_tissueBvh;
+
     std::shared_ptr<PbdObject> m_needleObj;
     std::shared_ptr<LineMesh>  m_needleMesh;
 
@@ -0,0 +1,195 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkPointSet.h"
+#include "imstkRenderMaterial.h"
+#include "imstkScene.h"
+#include "imstkSceneObject.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkVecDataArray.h"
+#include "imstkVisualModel.h"
+#include "imstkVTKRenderer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vtkRenderer.h>
+#include <vtkRenderWindow.h>
+
+using namespace imstk;
+
+///
+/// \brief n by n grid of vertices in the xz plane, two triangles per quad
+///
+static std::shared_ptr<SurfaceMesh>
+makeGrid(const int n)
+{
+    auto verticesPtr = std::make_shared<VecDataArray<double, 3>>(n * n);
+    auto cellsPtr    = std::make_shared<VecDataArray<int, 3>>((n - 1) * (n - 1) * 2);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            (*verticesPtr)[i * n + j] = Vec3d(static_cast<double>(i) / n - 0.5, 0.0, static_cast<double>(j) / n - 0.5);
+        }
+    }
+    int k = 0;
+    for (int i = 0; i < n - 1; i++)
+    {
+        for (int j = 0; j < n - 1; j++)
+        {
+            const int v = i * n + j;
+            (*cellsPtr)[k++] = Vec3i(v, v + 1, v + n);
+            (*cellsPtr)[k++] = Vec3i(v + 1, v + n + 1, v + n);
+        }
+    }
+    auto mesh = std::make_shared<SurfaceMesh>();
+    mesh->initialize(verticesPtr, cellsPtr);
+    return mesh;
+}
+
+///
+/// \brief Offscreen window rendering a scene with a single geometry, the delegates
+/// are updated and the window rendered for every frame
+///
+class OffscreenRender
+{
+public:
+    OffscreenRender(std::shared_ptr<Geometry> geometry, const bool isDynamic)
+    {
+        m_scene = std::make_shared<Scene>("BenchmarkScene");
+        auto sceneObj = std::make_shared<SceneObject>("Object");
+        auto material = std::make_shared<RenderMaterial>();
+        material->setIsDynamicMesh(isDynamic);
+        material->setRecomputeVertexNormals(false);
+        sceneObj->setVisualGeometry(geometry);
+        sceneObj->getVisualModel(0)->setRenderMaterial(material);
+        m_scene->addSceneObject(sceneObj);
+
+        m_renderer = std::make_shared<VTKRenderer>(m_scene, false);
+        m_renderer->initialize();
+
+        m_renderWindow = vtkSmartPointer<vtkRenderWindow>::New();
+        m_renderWindow->SetOffScreenRendering(1);
+        m_renderWindow->SetSize(640, 480);
+        m_renderWindow->AddRenderer(m_renderer->getVtkRenderer());
+        m_renderer->getVtkRenderer()->ResetCamera();
+    }
+
+    bool isValid() { return m_renderWindow->SupportsOpenGL() != 0; }
+
+    void render()
+    {
+        m_renderer->updateRenderDelegates();
+        m_renderWindow->Render();
+    }
+
+protected:
+    std::shared_ptr<Scene>           m_scene;
+    std::shared_ptr<VTKRenderer>     m_renderer;
+    vtkSmartPointer<vtkRenderWindow> m_renderWindow;
+};
+
+///
+/// \brief Deform every vertex of a surface mesh every frame, the vertex buffer is re-uploaded
+///
+static void
+BM_DeformSurfaceMesh(benchmark::State& state)
+{
+    const int                    n    = static_cast<int>(state.range(0));
+    std::shared_ptr<SurfaceMesh> mesh = makeGrid(n);
+    OffscreenRender              render(mesh, true);
+    if (!render.isValid())
+    {
+        state.SkipWithError("No OpenGL context for offscreen rendering");
+        return;
+    }
+
+    std::shared_ptr<VecDataArray<double, 3>> verticesPtr = mesh->getVertexPositions();
+    VecDataArray<double, 3>&                 vertices    = *verticesPtr;
+    double                                   t = 0.0;
+    for (auto _ : state)
+    {
+        t += 0.01;
+        for (int i = 0; i < vertices.size(); i++)
+        {
+            vertices[i][1] = 0.05 * std::sin(vertices[i][0] * 10.0 + t);
+        }
+        verticesPtr->postModified();
+        render.render();
+    }
+    state.SetItemsProcessed(state.iterations() * vertices.size());
+}
+
+///
+/// \brief Modify the cells of a surface mesh every frame, as when cutting, the index
+/// buffer is coupled again
+///
+static void
+BM_RetopologizeSurfaceMesh(benchmark::State& state)
+{
+    const int                    n    = static_cast<int>(state.range(0));
+    std::shared_ptr<SurfaceMesh> mesh = makeGrid(n);
+    OffscreenRender              render(mesh, true);
+    if (!render.isValid())
+    {
+        state.SkipWithError("No OpenGL context for offscreen rendering");
+        return;
+    }
+
+    std::shared_ptr<VecDataArray<int, 3>> cellsPtr = mesh->getCells();
+    VecDataArray<int, 3>&                 cells    = *cellsPtr;
+    int                                   cellId   = 0;
+    for (auto _ : state)
+    {
+        // Flip the diagonal of a quad
+        const Vec3i a = cells[cellId];
+        const Vec3i b = cells[cellId + 1];
+        cells[cellId]     = Vec3i(a[0], b[1], a[2]);
+        cells[cellId + 1] = Vec3i(a[0], a[1], b[1]);
+        cellId = (cellId + 2) % cells.size();
+        cellsPtr->postModified();
+        render.render();
+    }
+    state.SetItemsProcessed(state.iterations() * cells.size());
+}
+
+///
+/// \brief Deform every point of a point set every frame
+///
+static void
+BM_DeformPointSet(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    auto      pointSet = std::make_shared<PointSet>();
+    pointSet->initialize(makeGrid(n)->getVertexPositions());
+    OffscreenRender render(pointSet, true);
+    if (!render.isValid())
+    {
+        state.SkipWithError("No OpenGL context for offscreen rendering");
+        return;
+    }
+
+    std::shared_ptr<VecDataArray<double, 3>> verticesPtr = pointSet->getVertexPositions();
+    VecDataArray<double, 3>&                 vertices    = *verticesPtr;
+    double                                   t = 0.0;
+    for (auto _ : state)
+    {
+        t += 0.01;
+        for (int i = 0; i < vertices.size(); i++)
+        {
+            vertices[i][1] = 0.05 * std::sin(vertices[i][2] * 10.0 + t);
+        }
+        verticesPtr->postModified();
+        render.render();
+    }
+    state.SetItemsProcessed(state.iterations() * vertices.size());
+}
+
+BENCHMARK(BM_DeformSurfaceMesh)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_RetopologizeSurfaceMesh)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_DeformPointSet)->Unit(benchmark::kMillisecond)->RangeMultiplier(4)->Range(64, 1024);
+
+BENCHMARK_MAIN();
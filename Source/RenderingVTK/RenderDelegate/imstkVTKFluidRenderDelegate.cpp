@@ -112,17 +112,8 @@ VTKFluidRenderDelegate::geometryModified(Event* imstkNotUsed(e))
     auto geometry = std::static_pointer_cast<PointSet>(m_visualModel->getGeometry());
 
     // Test if the vertex buffer changed
-    if (m_vertices != geometry->getVertexPositions())
-    {
-        //printf("Vertex data swapped\n");
-        m_vertices = geometry->getVertexPositions();
-        {
-            // Update the pointer of the coupled array
-            m_mappedVertexArray->SetNumberOfComponents(3);
-            m_mappedVertexArray->SetArray(reinterpret_cast<double*>(m_vertices->getPointer()), m_vertices->size() * 3, 1);
-        }
-    }
-    m_mappedVertexArray->Modified();
+    m_vertices = geometry->getVertexPositions();
+    coupleVertexBuffer();
 }
 
 void
@@ -130,10 +121,18 @@ VTKFluidRenderDelegate::vertexDataModified(Event* imstkNotUsed(e))
 {
     auto geometry = std::static_pointer_cast<PointSet>(m_visualModel->getGeometry());
     m_vertices = geometry->getVertexPositions();
-    if (m_vertices->getVoidPointer() != m_mappedVertexArray->GetVoidPointer(0))
+    coupleVertexBuffer();
+}
+
+void
+VTKFluidRenderDelegate::coupleVertexBuffer()
+{
+    // Only update the pointer of the coupled array when reallocated or resized
+    if (!GeometryUtils::isCoupled(m_mappedVertexArray, m_vertices))
     {
         m_mappedVertexArray->SetNumberOfComponents(3);
         m_mappedVertexArray->SetArray(reinterpret_cast<double*>(m_vertices->getPointer()), m_vertices->size() * 3, 1);
+        m_polydata->GetPoints()->SetNumberOfPoints(m_vertices->size());
     }
     m_mappedVertexArray->Modified();
 }
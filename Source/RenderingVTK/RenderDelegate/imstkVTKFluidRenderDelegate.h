@@ -44,6 +44,12 @@ protected:
     ///
     void vertexDataModified(Event* e);
 
+    ///
+    /// \brief Point the vertex array at the vertices if they were reallocated or resized
+    /// and flag it modified
+    ///
+    void coupleVertexBuffer();
+
     void updateRenderProperties() override;
 
     std::shared_ptr<VecDataArray<double, 3>> m_vertices;
@@ -49,18 +49,10 @@ VTKHexahedralMeshRenderDelegate::init()
         m_mesh->GetPointData()->SetScalars(m_mappedVertexScalarArray);
     }
 
-    // Map indices to VTK cell data (copied, not coupled)
+    // Map indices to VTK cell data
     {
         m_cellArray = vtkSmartPointer<vtkCellArray>::New();
-        vtkIdType cell[8];
-        for (const auto& t : *m_indices)
-        {
-            for (size_t i = 0; i < 8; ++i)
-            {
-                cell[i] = t[i];
-            }
-            m_cellArray->InsertNextCell(8, cell);
-        }
+        GeometryUtils::coupleVtkCellArray(m_cellArray, m_indices);
         m_mesh->SetCells(VTK_HEXAHEDRON, m_cellArray);
     }
 
@@ -136,38 +128,16 @@ VTKHexahedralMeshRenderDelegate::geometryModified(Event* imstkNotUsed(e))
     auto geometry = std::static_pointer_cast<HexahedralMesh>(m_visualModel->getGeometry());
 
     // Test if the vertex buffer changed
-    if (m_vertices != geometry->getVertexPositions())
-    {
-        //printf("Vertex data swapped\n");
-        m_vertices = geometry->getVertexPositions();
-        {
-            // Update the pointer of the coupled array
-            m_mappedVertexArray->SetNumberOfComponents(3);
-            m_mappedVertexArray->SetArray(reinterpret_cast<double*>(m_vertices->getPointer()), m_vertices->size() * 3, 1);
-        }
-    }
-    m_mappedVertexArray->Modified();
+    m_vertices = geometry->getVertexPositions();
+    coupleVertexBuffer();
 
-    // Test if the index buffer changed
-    if (m_indices != geometry->getCells())
+    // Test if the index buffer was swapped, reallocated or resized
+    if (m_indices != geometry->getCells() || !GeometryUtils::isCoupled(m_cellArray->GetConnectivityArray(), m_indices))
     {
-        //printf("Index data swapped\n");
         m_indices = geometry->getCells();
-        {
-            // Copy cells
-            m_cellArray->Reset();
-            vtkIdType cell[8];
-            for (const auto& t : *m_indices)
-            {
-                for (size_t i = 0; i < 8; ++i)
-                {
-                    cell[i] = t[i];
-                }
-                m_cellArray->InsertNextCell(8, cell);
-            }
-            m_mesh->SetCells(VTK_TETRA, m_cellArray);
-            m_cellArray->Modified();
-        }
+        GeometryUtils::coupleVtkCellArray(m_cellArray, m_indices);
+        m_mesh->SetCells(VTK_HEXAHEDRON, m_cellArray);
+        m_cellArray->Modified();
     }
 }
 
@@ -176,10 +146,18 @@ VTKHexahedralMeshRenderDelegate::vertexDataModified(Event* imstkNotUsed(e))
 {
     auto geometry = std::static_pointer_cast<HexahedralMesh>(m_visualModel->getGeometry());
     m_vertices = geometry->getVertexPositions();
-    if (m_vertices->getVoidPointer() != m_mappedVertexArray->GetVoidPointer(0))
+    coupleVertexBuffer();
+}
+
+void
+VTKHexahedralMeshRenderDelegate::coupleVertexBuffer()
+{
+    // Only update the pointer of the coupled array when reallocated or resized
+    if (!GeometryUtils::isCoupled(m_mappedVertexArray, m_vertices))
     {
         m_mappedVertexArray->SetNumberOfComponents(3);
         m_mappedVertexArray->SetArray(reinterpret_cast<double*>(m_vertices->getPointer()), m_vertices->size() * 3, 1);
+        m_mesh->GetPoints()->SetNumberOfPoints(m_vertices->size());
     }
     m_mappedVertexArray->Modified();
 }
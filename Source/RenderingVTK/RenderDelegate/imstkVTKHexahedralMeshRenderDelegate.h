@@ -42,6 +42,12 @@ public:
 protected:
     void init() override;
 
+    ///
+    /// \brief Point the vertex array at the vertices if they were reallocated or resized
+    /// and flag it modified
+    ///
+    void coupleVertexBuffer();
+
     std::shared_ptr<VecDataArray<double, 3>> m_vertices;
     std::shared_ptr<VecDataArray<int, 8>>    m_indices;
 
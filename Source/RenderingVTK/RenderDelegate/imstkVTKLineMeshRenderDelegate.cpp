@@ -47,19 +47,11 @@ VTKLineMeshRenderDelegate::init()
         m_polydata->SetPoints(points);
     }
 
-    // Map indices to VTK cell data (copied)
+    // Map indices to VTK cell data
     if (m_indices != nullptr)
     {
         m_cellArray = vtkSmartPointer<vtkCellArray>::New();
-        vtkIdType cell[2];
-        for (const auto& t : *m_indices)
-        {
-            for (size_t i = 0; i < 2; i++)
-            {
-                cell[i] = t[i];
-            }
-            m_cellArray->InsertNextCell(2, cell);
-        }
+        GeometryUtils::coupleVtkCellArray(m_cellArray, m_indices);
         m_polydata->SetLines(m_cellArray);
     }
 
@@ -197,8 +189,8 @@ VTKLineMeshRenderDelegate::cellScalarsModified(Event* imstkNotUsed(e))
 void
 VTKLineMeshRenderDelegate::geometryModified(Event* imstkNotUsed(e))
 {
-    // If the vertices were reallocated
-    if (m_vertices != m_geometry->getVertexPositions())
+    // If the vertices were reallocated or resized
+    if (m_vertices != m_geometry->getVertexPositions() || !GeometryUtils::isCoupled(m_mappedVertexArray, m_vertices))
     {
         setVertexBuffer(m_geometry->getVertexPositions());
     }
@@ -206,8 +198,8 @@ VTKLineMeshRenderDelegate::geometryModified(Event* imstkNotUsed(e))
     // Assume vertices are always changed
     m_mappedVertexArray->Modified();
 
-    // Only update index buffer when reallocated
-    if (m_indices != m_geometry->getCells())
+    // Only update index buffer when reallocated or resized
+    if (m_indices != m_geometry->getCells() || !GeometryUtils::isCoupled(m_cellArray->GetConnectivityArray(), m_indices))
     {
         setIndexBuffer(m_geometry->getCells());
     }
@@ -270,18 +262,8 @@ VTKLineMeshRenderDelegate::setIndexBuffer(std::shared_ptr<VecDataArray<int, 2>>
             &VTKLineMeshRenderDelegate::indexDataModified);
     }
 
-    // Copy the buffer
-    // Copy cells
-    m_cellArray->Reset();
-    vtkIdType cell[3];
-    for (const auto& t : *m_indices)
-    {
-        for (size_t i = 0; i < 2; i++)
-        {
-            cell[i] = t[i];
-        }
-        m_cellArray->InsertNextCell(2, cell);
-    }
+    // Couple the buffer
+    GeometryUtils::coupleVtkCellArray(m_cellArray, m_indices);
     m_cellArray->Modified();
 }
 
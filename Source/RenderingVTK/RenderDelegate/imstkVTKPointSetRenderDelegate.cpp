@@ -11,13 +11,15 @@
 #include "imstkRenderMaterial.h"
 
 #include <array>
+#include <numeric>
 #include <vtkActor.h>
+#include <vtkCellArray.h>
 #include <vtkDoubleArray.h>
 #include <vtkOpenGLPolyDataMapper.h>
 #include <vtkOpenGLVertexBufferObject.h>
 #include <vtkPointData.h>
 #include <vtkTransform.h>
-#include <vtkVertexGlyphFilter.h>
+#include <vtkTypeInt32Array.h>
 
 namespace imstk
 {
@@ -26,6 +28,7 @@ VTKPointSetRenderDelegate::VTKPointSetRenderDelegate() :
     m_vertices(nullptr),
     m_vertexScalars(nullptr),
     m_polydata(vtkSmartPointer<vtkPolyData>::New()),
+    m_vertexCells(vtkSmartPointer<vtkCellArray>::New()),
     m_mappedVertexArray(vtkSmartPointer<vtkDoubleArray>::New()),
     m_mappedVertexScalarArray(vtkSmartPointer<vtkDoubleArray>::New())
 {
@@ -56,10 +59,9 @@ VTKPointSetRenderDelegate::init()
         setVertexScalarBuffer(m_geometry->getVertexScalars());
     }
 
-    // \todo: Slow, replace with opengl hardware instancing which is actually an OpenGLMapper
-    vtkNew<vtkVertexGlyphFilter> glyphFilter;
-    glyphFilter->SetInputData(m_polydata);
-    glyphFilter->Update();
+    // Render every point as a vertex cell, only regenerated when the number of points changes
+    m_polydata->SetVerts(m_vertexCells);
+    updateVertexCells();
 
     // When geometry is modified, update data source, mostly for when an entirely new array/buffer was set
     queueConnect<Event>(m_geometry, &Geometry::modified,
@@ -74,7 +76,7 @@ VTKPointSetRenderDelegate::init()
     // Setup mapper
     {
         vtkNew<vtkPolyDataMapper> mapper;
-        mapper->SetInputConnection(glyphFilter->GetOutputPort());
+        mapper->SetInputData(m_polydata);
         vtkNew<vtkActor> actor;
         actor->SetMapper(mapper);
         actor->SetUserTransform(m_transform);
@@ -152,8 +154,8 @@ VTKPointSetRenderDelegate::vertexScalarsModified(Event* imstkNotUsed(e))
 void
 VTKPointSetRenderDelegate::geometryModified(Event* imstkNotUsed(e))
 {
-    // If the vertices were reallocated
-    if (m_vertices != m_geometry->getVertexPositions())
+    // If the vertices were reallocated or resized
+    if (m_vertices != m_geometry->getVertexPositions() || !GeometryUtils::isCoupled(m_mappedVertexArray, m_vertices))
     {
         setVertexBuffer(m_geometry->getVertexPositions());
     }
@@ -193,6 +195,7 @@ VTKPointSetRenderDelegate::setVertexBuffer(std::shared_ptr<VecDataArray<double,
     m_mappedVertexArray->SetArray(reinterpret_cast<double*>(m_vertices->getPointer()), m_vertices->size() * 3, 1);
     m_mappedVertexArray->Modified();
     m_polydata->GetPoints()->SetNumberOfPoints(m_vertices->size());
+    updateVertexCells();
 }
 
 void
@@ -222,4 +225,20 @@ VTKPointSetRenderDelegate::setVertexScalarBuffer(std::shared_ptr<AbstractDataArr
         static_cast<vtkIdType>(m_vertexScalars->size()), 1);
     m_mappedVertexScalarArray->Modified();
 }
+
+void
+VTKPointSetRenderDelegate::updateVertexCells()
+{
+    const vtkIdType numPoints = m_polydata->GetNumberOfPoints();
+    if (m_vertexCells->GetNumberOfCells() == numPoints)
+    {
+        return;
+    }
+
+    vtkNew<vtkTypeInt32Array> connectivity;
+    connectivity->SetNumberOfValues(numPoints);
+    std::iota(connectivity->GetPointer(0), connectivity->GetPointer(0) + numPoints, 0);
+    m_vertexCells->SetData(1, connectivity);
+    m_vertexCells->Modified();
+}
 } // namespace imstk
\ No newline at end of file
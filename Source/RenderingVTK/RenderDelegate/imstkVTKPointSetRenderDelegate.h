@@ -8,6 +8,7 @@
 
 #include "imstkVTKPolyDataRenderDelegate.h"
 
+class vtkCellArray;
 class vtkDataArray;
 class vtkDoubleArray;
 class vtkPolyData;
@@ -54,11 +55,17 @@ protected:
     void setVertexBuffer(std::shared_ptr<VecDataArray<double, 3>> vertices);
     void setVertexScalarBuffer(std::shared_ptr<AbstractDataArray> scalars);
 
+    ///
+    /// \brief Regenerate the vertex cells, one per point, when the number of points changed
+    ///
+    void updateVertexCells();
+
     std::shared_ptr<PointSet> m_geometry;
     std::shared_ptr<VecDataArray<double, 3>> m_vertices;
     std::shared_ptr<AbstractDataArray>       m_vertexScalars;
 
-    vtkSmartPointer<vtkPolyData> m_polydata;
+    vtkSmartPointer<vtkPolyData>  m_polydata;
+    vtkSmartPointer<vtkCellArray> m_vertexCells; ///< One vertex cell per point
 
     vtkSmartPointer<vtkDoubleArray> m_mappedVertexArray;       ///< Mapped array of vertices
     vtkSmartPointer<vtkDataArray>   m_mappedVertexScalarArray; ///< Mapped array of scalars
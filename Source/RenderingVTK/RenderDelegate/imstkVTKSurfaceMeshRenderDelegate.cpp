@@ -56,19 +56,11 @@ VTKSurfaceMeshRenderDelegate::init()
         m_polydata->SetPoints(points);
     }
 
-    // Map indices to VTK cell data (copied)
+    // Map indices to VTK cell data
     if (m_indices != nullptr)
     {
         m_cellArray = vtkSmartPointer<vtkCellArray>::New();
-        vtkIdType cell[3];
-        for (const auto& t : *m_indices)
-        {
-            for (size_t i = 0; i < 3; i++)
-            {
-                cell[i] = t[i];
-            }
-            m_cellArray->InsertNextCell(3, cell);
-        }
+        GeometryUtils::coupleVtkCellArray(m_cellArray, m_indices);
         m_polydata->SetPolys(m_cellArray);
     }
 
@@ -290,8 +282,8 @@ VTKSurfaceMeshRenderDelegate::geometryModified(Event* imstkNotUsed(e))
     // the vertex buffer. Recompute normals dynamically.
     if (m_isDynamicMesh)
     {
-        // If the vertices were reallocated
-        if (m_vertices != m_geometry->getVertexPositions())
+        // If the vertices were reallocated or resized
+        if (m_vertices != m_geometry->getVertexPositions() || !GeometryUtils::isCoupled(m_mappedVertexArray, m_vertices))
         {
             setVertexBuffer(m_geometry->getVertexPositions());
         }
@@ -299,8 +291,8 @@ VTKSurfaceMeshRenderDelegate::geometryModified(Event* imstkNotUsed(e))
         // Consistently reupload the vertex buffer
         m_mappedVertexArray->Modified();
 
-        // Only update index buffer when reallocated
-        if (m_indices != m_geometry->getCells())
+        // Only update index buffer when reallocated or resized
+        if (m_indices != m_geometry->getCells() || !GeometryUtils::isCoupled(m_cellArray->GetConnectivityArray(), m_indices))
         {
             setIndexBuffer(m_geometry->getCells());
         }
@@ -320,16 +312,16 @@ VTKSurfaceMeshRenderDelegate::geometryModified(Event* imstkNotUsed(e))
     // vertices & normals can be changed rigidly by a transform in the shader
     else
     {
-        // If the vertices were reallocated
+        // If the vertices were reallocated or resized
         bool normalsOutdated = false;
-        if (m_vertices != m_geometry->getInitialVertexPositions())
+        if (m_vertices != m_geometry->getInitialVertexPositions() || !GeometryUtils::isCoupled(m_mappedVertexArray, m_vertices))
         {
             setVertexBuffer(m_geometry->getInitialVertexPositions());
             normalsOutdated = true;
         }
 
-        // Only update index buffer when reallocated
-        if (m_indices != m_geometry->getCells())
+        // Only update index buffer when reallocated or resized
+        if (m_indices != m_geometry->getCells() || !GeometryUtils::isCoupled(m_cellArray->GetConnectivityArray(), m_indices))
         {
             setIndexBuffer(m_geometry->getCells());
             normalsOutdated = true;
@@ -453,18 +445,8 @@ VTKSurfaceMeshRenderDelegate::setIndexBuffer(std::shared_ptr<VecDataArray<int, 3
             &VTKSurfaceMeshRenderDelegate::indexDataModified);
     }
 
-    // Copy the buffer
-    // Copy cells
-    m_cellArray->Reset();
-    vtkIdType cell[3];
-    for (const auto& t : *m_indices)
-    {
-        for (size_t i = 0; i < 3; i++)
-        {
-            cell[i] = t[i];
-        }
-        m_cellArray->InsertNextCell(3, cell);
-    }
+    // Couple the buffer
+    GeometryUtils::coupleVtkCellArray(m_cellArray, m_indices);
     m_cellArray->Modified();
 }
 
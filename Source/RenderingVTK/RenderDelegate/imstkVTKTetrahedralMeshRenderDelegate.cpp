@@ -137,8 +137,8 @@ VTKTetrahedralMeshRenderDelegate::geometryModified(Event* imstkNotUsed(e))
 {
     auto geometry = std::static_pointer_cast<TetrahedralMesh>(m_visualModel->getGeometry());
 
-    // If the vertices were reallocated
-    if (m_vertices != geometry->getVertexPositions())
+    // If the vertices were reallocated or resized
+    if (m_vertices != geometry->getVertexPositions() || !GeometryUtils::isCoupled(m_mappedVertexArray, m_vertices))
     {
         setVertexBuffer(geometry->getVertexPositions());
     }
@@ -146,8 +146,8 @@ VTKTetrahedralMeshRenderDelegate::geometryModified(Event* imstkNotUsed(e))
     // Assume vertices are always changed
     m_mappedVertexArray->Modified();
 
-    // Only update index buffer when reallocated
-    if (m_indices != geometry->getCells())
+    // Only update index buffer when reallocated or resized
+    if (m_indices != geometry->getCells() || !GeometryUtils::isCoupled(m_cellArray->GetConnectivityArray(), m_indices))
     {
         setIndexBuffer(geometry->getCells());
     }
@@ -202,17 +202,8 @@ VTKTetrahedralMeshRenderDelegate::setIndexBuffer(std::shared_ptr<VecDataArray<in
             &VTKTetrahedralMeshRenderDelegate::indexDataModified);
     }
 
-    // Copy the buffer
-    m_cellArray->Reset();
-    vtkIdType cell[4];
-    for (const auto& t : *m_indices)
-    {
-        for (size_t i = 0; i < 4; i++)
-        {
-            cell[i] = t[i];
-        }
-        m_cellArray->InsertNextCell(4, cell);
-    }
+    // Couple the buffer
+    GeometryUtils::coupleVtkCellArray(m_cellArray, m_indices);
     m_mesh->SetCells(VTK_TETRA, m_cellArray);
     m_cellArray->Modified();
     m_mesh->Modified();
@@ -8,13 +8,47 @@
 
 #include "imstkScene.h"
 #include "imstkCamera.h"
+#include "imstkCollidingObject.h"
+#include "imstkCollisionData.h"
+#include "imstkCollisionDetectionAlgorithm.h"
+#include "imstkCollisionInteraction.h"
 #include "imstkDirectionalLight.h"
+#include "imstkPlane.h"
+#include "imstkSphere.h"
 #include "imstkSpotLight.h"
 #include "imstkSceneObject.h"
 #include "imstkTaskGraph.h"
 
 using namespace imstk;
 
+namespace
+{
+///
+/// \brief Interaction with detection but no handling
+///
+class DetectionOnlyInteraction : public CollisionInteraction
+{
+public:
+    DetectionOnlyInteraction(std::shared_ptr<CollidingObject> objA, std::shared_ptr<CollidingObject> objB) :
+        CollisionInteraction("DetectionOnly_" + objA->getName() + "_vs_" + objB->getName(), objA, objB, "") { }
+
+    void initGraphEdges(std::shared_ptr<TaskNode> source, std::shared_ptr<TaskNode> sink) override
+    {
+        m_taskGraph->addEdge(source, m_collisionGeometryUpdateNode);
+        m_taskGraph->addEdge(m_collisionGeometryUpdateNode, m_collisionDetectionNode);
+        m_taskGraph->addEdge(m_collisionDetectionNode, sink);
+    }
+};
+
+std::shared_ptr<CollidingObject>
+makeCollidingObject(const std::string& name, std::shared_ptr<Geometry> geom)
+{
+    auto obj = std::make_shared<CollidingObject>(name);
+    obj->setCollidingGeometry(geom);
+    return obj;
+}
+} // namespace
+
 TEST(imstkSceneTest, empty_scene_emptiness_checks)
 {
     Scene scene("test scene");
@@ -197,4 +231,82 @@ TEST(imstkSceneTest, add_same_name_scene_objects)
     EXPECT_EQ(m_scene.getSceneObject("TestObj_1"), obj2);
     EXPECT_EQ(obj2->getName(), "TestObj_1");
     EXPECT_EQ(m_scene.getSceneObjects().size(), 2);
-}
\ No newline at end of file
+}
+
+TEST(imstkSceneTest, broad_phase_skips_separated_interactions)
+{
+    auto config = std::make_shared<SceneConfig>();
+    config->broadPhaseEnabled = true;
+    Scene scene("test scene", config);
+
+    auto sphere1 = std::make_shared<Sphere>(Vec3d(0.0, 0.0, 0.0), 1.0);
+    auto sphere2 = std::make_shared<Sphere>(Vec3d(5.0, 0.0, 0.0), 1.0);
+    auto obj1    = makeCollidingObject("sphere1", sphere1);
+    auto obj2    = makeCollidingObject("sphere2", sphere2);
+    auto plane   = makeCollidingObject("plane", std::make_shared<Plane>(Vec3d(0.0, -10.0, 0.0)));
+    scene.addSceneObject(obj1);
+    scene.addSceneObject(obj2);
+    scene.addSceneObject(plane);
+
+    auto sphereVsSphere = std::make_shared<DetectionOnlyInteraction>(obj1, obj2);
+    auto planeVsSphere  = std::make_shared<DetectionOnlyInteraction>(plane, obj1);
+    scene.addInteraction(sphereVsSphere);
+    scene.addInteraction(planeVsSphere);
+    ASSERT_TRUE(scene.initialize());
+
+    // Separated spheres are skipped, the unbounded plane never is
+    scene.advance(0.01);
+    EXPECT_FALSE(sphereVsSphere->getBroadPhaseActive());
+    EXPECT_TRUE(planeVsSphere->getBroadPhaseActive());
+    EXPECT_EQ(scene.getNumActiveInteractions(), 1);
+    EXPECT_TRUE(sphereVsSphere->getCollisionDetection()->getCollisionData()->elementsA.empty());
+
+    // Within the margin
+    config->broadPhaseMargin = 1.6;
+    scene.advance(0.01);
+    EXPECT_TRUE(sphereVsSphere->getBroadPhaseActive());
+
+    // Overlapping
+    config->broadPhaseMargin = 0.0;
+    sphere2->setPosition(Vec3d(1.5, 0.0, 0.0));
+    scene.advance(0.01);
+    EXPECT_TRUE(sphereVsSphere->getBroadPhaseActive());
+    EXPECT_EQ(scene.getNumActiveInteractions(), 2);
+    EXPECT_FALSE(sphereVsSphere->getCollisionDetection()->getCollisionData()->elementsA.empty());
+
+    // Disabling the broad phase activates all
+    sphere2->setPosition(Vec3d(5.0, 0.0, 0.0));
+    config->broadPhaseEnabled = false;
+    scene.advance(0.01);
+    EXPECT_TRUE(sphereVsSphere->getBroadPhaseActive());
+}
+
+TEST(imstkSceneTest, broad_phase_predicts_motion)
+{
+    for (const double motionScale : { 0.0, 2.0 })
+    {
+        auto config = std::make_shared<SceneConfig>();
+        config->broadPhaseEnabled     = true;
+        config->broadPhaseMotionScale = motionScale;
+        Scene scene("test scene", config);
+
+        auto sphere1 = std::make_shared<Sphere>(Vec3d(0.0, 0.0, 0.0), 1.0);
+        auto sphere2 = std::make_shared<Sphere>(Vec3d(3.5, 0.0, 0.0), 1.0);
+        auto obj1    = makeCollidingObject("sphere1", sphere1);
+        auto obj2    = makeCollidingObject("sphere2", sphere2);
+        scene.addSceneObject(obj1);
+        scene.addSceneObject(obj2);
+        auto sphereVsSphere = std::make_shared<DetectionOnlyInteraction>(obj1, obj2);
+        scene.addInteraction(sphereVsSphere);
+        ASSERT_TRUE(scene.initialize());
+
+        scene.advance(0.01);
+        EXPECT_FALSE(sphereVsSphere->getBroadPhaseActive());
+
+        // Approaching by 1 per step, the spheres overlap after the next step. Only
+        // the predicted motion activates the interaction before
+        sphere2->setPosition(Vec3d(2.5, 0.0, 0.0));
+        scene.advance(0.01);
+        EXPECT_EQ(sphereVsSphere->getBroadPhaseActive(), motionScale > 0.0);
+    }
+}
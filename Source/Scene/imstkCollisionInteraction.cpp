@@ -4,6 +4,7 @@
 ** See accompanying NOTICE for details.
 */
 
+#include "imstkCCDAlgorithm.h"
 #include "imstkCDObjectFactory.h"
 #include "imstkCollisionInteraction.h"
 #include "imstkCollidingObject.h"
@@ -80,6 +81,16 @@ CollisionInteraction::setCollisionHandlingAB(std::shared_ptr<CollisionHandling>
 void
 CollisionInteraction::updateCD()
 {
+    if (!m_broadPhaseActive)
+    {
+        // Bounds don't overlap, drop the contacts of the last step
+        if (m_colDetect != nullptr)
+        {
+            m_colDetect->getCollisionData()->elementsA.resize(0);
+            m_colDetect->getCollisionData()->elementsB.resize(0);
+        }
+        return;
+    }
     if (m_colDetect != nullptr)
     {
         m_colDetect->update();
@@ -89,7 +100,7 @@ CollisionInteraction::updateCD()
 void
 CollisionInteraction::updateCHA()
 {
-    if (m_colHandlingA != nullptr)
+    if (m_broadPhaseActive && m_colHandlingA != nullptr)
     {
         m_colHandlingA->update();
     }
@@ -98,7 +109,7 @@ CollisionInteraction::updateCHA()
 void
 CollisionInteraction::updateCHB()
 {
-    if (m_colHandlingB != nullptr)
+    if (m_broadPhaseActive && m_colHandlingB != nullptr)
     {
         m_colHandlingB->update();
     }
@@ -110,6 +121,10 @@ CollisionInteraction::updateCollisionGeometry()
     // Ensure the collision geometry is updatedbefore checking collision
     // this could involve a geometry map or something, ex: simulated
     // tet mesh mapped to a collision surface mesh
+    if (!m_broadPhaseActive)
+    {
+        return;
+    }
     if (auto colObj1 = std::dynamic_pointer_cast<CollidingObject>(m_objA))
     {
         colObj1->updateGeometries();
@@ -136,6 +151,12 @@ CollisionInteraction::setEnabled(const bool enabled)
     }
 }
 
+bool
+CollisionInteraction::isBroadPhaseCullable() const
+{
+    return std::dynamic_pointer_cast<CCDAlgorithm>(m_colDetect) == nullptr;
+}
+
 bool
 CollisionInteraction::getEnabled() const
 {
@@ -58,6 +58,9 @@ public:
     std::shared_ptr<TaskNode> getCollisionHandlingANode() const { return m_collisionHandleANode; }
     std::shared_ptr<TaskNode> getCollisionHandlingBNode() const { return m_collisionHandleBNode; }
 
+    std::shared_ptr<CollidingObject> getObjectA() const { return m_objA; }
+    std::shared_ptr<CollidingObject> getObjectB() const { return m_objB; }
+
     void updateCollisionGeometry();
 
     ///
@@ -67,6 +70,20 @@ public:
     virtual bool getEnabled() const;
 ///@}
 
+    ///
+    /// \brief Set by the Scene broad phase, when inactive the collision geometry update,
+    /// detection and handling are skipped and the collision data is cleared
+    ///@{
+    void setBroadPhaseActive(const bool active) { m_broadPhaseActive = active; }
+    bool getBroadPhaseActive() const { return m_broadPhaseActive; }
+    ///@}
+
+    ///
+    /// \brief Returns if the broad phase may skip this interaction, continuous collision
+    /// detection keeps state of the previous step and is never skipped
+    ///
+    virtual bool isBroadPhaseCullable() const;
+
 protected:
     ///
     /// \brief Update collision
@@ -94,5 +111,7 @@ protected:
     std::shared_ptr<TaskNode> m_collisionHandleANode        = nullptr;
     std::shared_ptr<TaskNode> m_collisionHandleBNode        = nullptr;
     std::shared_ptr<TaskNode> m_collisionGeometryUpdateNode = nullptr;
+
+    bool m_broadPhaseActive = true;
 };
 } // namespace imstk
\ No newline at end of file
@@ -84,7 +84,7 @@ PbdObjectCutting::apply()
 
     // update pbd states, constraints and solver
     m_objA->setBodyFromGeometry();
-    pbdModel->getConstraints()->removeConstraints(m_removeConstraintVertices,
+    pbdModel->removeConstraints(m_removeConstraintVertices,
         m_objA->getPbdBody()->bodyHandle);
     pbdModel->addConstraints(m_addConstraintVertices, m_objA->getPbdBody()->bodyHandle);
 
@@ -15,6 +15,7 @@
 #include "imstkPbdObject.h"
 #include "imstkPbdSolver.h"
 #include "imstkPointPicker.h"
+#include "imstkPointSetBvh.h"
 #include "imstkPointwiseMap.h"
 #include "imstkSurfaceMesh.h"
 #include "imstkTaskGraph.h"
@@ -209,7 +210,9 @@ PbdObjectGrasping::PbdObjectGrasping(std::shared_ptr<PbdObject> graspedObject,
                                      std::shared_ptr<PbdObject> grasperObject) :
     m_objectToGrasp(graspedObject),
     m_grasperObject(grasperObject),
-    m_pickMethod(std::make_shared<CellPicker>())
+    m_pickMethod(std::make_shared<CellPicker>()),
+    m_vertexBvh(std::make_shared<PointSetBvh>()),
+    m_cellBvh(std::make_shared<PointSetBvh>())
 {
     m_pickingNode = std::make_shared<TaskNode>(std::bind(&PbdObjectGrasping::updatePicking, this),
         "PbdPickingUpdate", true);
@@ -235,6 +238,7 @@ PbdObjectGrasping::beginVertexGrasp(std::shared_ptr<AnalyticalGeometry> geometry
 {
     auto vertexPicker = std::make_shared<VertexPicker>();
     vertexPicker->setPickingGeometry(geometry);
+    vertexPicker->setBvh(m_vertexBvh);
     m_pickMethod = vertexPicker;
     m_graspMode  = GraspMode::Vertex;
     m_graspGeom  = geometry;
@@ -273,6 +277,7 @@ PbdObjectGrasping::beginRayPointGrasp(std::shared_ptr<AnalyticalGeometry> geomet
 {
     auto pointPicker = std::make_shared<PointPicker>();
     pointPicker->setPickingRay(rayStart, rayDir, maxDist);
+    pointPicker->setBvh(m_cellBvh);
     m_pickMethod = pointPicker;
     m_graspMode  = GraspMode::RayPoint;
     m_graspGeom  = geometry;
@@ -286,6 +291,7 @@ PbdObjectGrasping::beginRayCellGrasp(std::shared_ptr<AnalyticalGeometry> geometr
 {
     auto pointPicker = std::make_shared<PointPicker>();
     pointPicker->setPickingRay(rayStart, rayDir, maxDist);
+    pointPicker->setBvh(m_cellBvh);
     m_pickMethod = pointPicker;
     m_graspMode  = GraspMode::RayCell;
     m_graspGeom  = geometry;
@@ -18,6 +18,7 @@ namespace imstk
 class AnalyticalGeometry;
 class PbdObject;
 class PickingAlgorithm;
+class PointSetBvh;
 class PointwiseMap;
 
 ///
@@ -201,6 +202,10 @@ protected:
     std::shared_ptr<PickingAlgorithm> m_pickMethod = nullptr;
     GraspMode m_graspMode = GraspMode::Cell;
 
+    /// Trees of the geometry to pick, kept between grasps so they are only refit
+    std::shared_ptr<PointSetBvh> m_vertexBvh = nullptr;
+    std::shared_ptr<PointSetBvh> m_cellBvh   = nullptr;
+
     bool m_isGrasping     = false;
     bool m_isPrevGrasping = false;
 
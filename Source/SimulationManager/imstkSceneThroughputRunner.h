@@ -0,0 +1,110 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace imstk
+{
+class Scene;
+
+///
+/// \class SceneThroughputRunner
+///
+/// \brief Steps a scene without a viewer through a SceneManager at a fixed dt and
+/// gathers the distribution of the compute time of every TaskNode, the length of the
+/// critical path and the steps per second. Scene::setEnableTaskTiming only keeps the
+/// latest time per node, this keeps every step so percentiles can be reported.
+/// The results can be written as json, ie: to track throughput in CI.
+///
+class SceneThroughputRunner
+{
+public:
+    ///
+    /// \brief Statistics of a set of samples, times are in ms
+    ///
+    struct TimeStats
+    {
+        double mean = 0.0;
+        double p50  = 0.0;
+        double p95  = 0.0;
+        double p99  = 0.0;
+        double max  = 0.0;
+    };
+
+public:
+    SceneThroughputRunner() = default;
+    virtual ~SceneThroughputRunner() = default;
+
+    ///
+    /// \brief Set the scene to run, it is initialized by the run if not yet
+    ///
+    void setScene(std::shared_ptr<Scene> scene) { m_scene = scene; }
+    std::shared_ptr<Scene> getScene() const { return m_scene; }
+
+    ///
+    /// \brief Fixed time step the scene is advanced with (s)
+    ///
+    void setDt(const double dt) { m_dt = dt; }
+    double getDt() const { return m_dt; }
+
+    ///
+    /// \brief Number of steps measured
+    ///
+    void setNumSteps(const int numSteps) { m_numSteps = numSteps; }
+    int getNumSteps() const { return m_numSteps; }
+
+    ///
+    /// \brief Number of steps run before measuring, not part of the statistics
+    ///
+    void setNumWarmupSteps(const int numWarmupSteps) { m_numWarmupSteps = numWarmupSteps; }
+    int getNumWarmupSteps() const { return m_numWarmupSteps; }
+
+    ///
+    /// \brief Initialize and step the scene, returns false if the scene could not be initialized
+    ///
+    bool run();
+
+    ///
+    /// \brief Statistics of the measured steps
+    ///@{
+    const std::map<std::string, TimeStats>& getTaskStats() const { return m_taskStats; }
+    const TimeStats& getCriticalPathStats() const { return m_criticalPathStats; }
+    const TimeStats& getStepStats() const { return m_stepStats; }
+    double getStepsPerSecond() const { return m_stepsPerSecond; }
+    ///@}
+
+    ///
+    /// \brief Returns the results of the last run as json
+    ///
+    std::string toJson() const;
+
+    ///
+    /// \brief Write the results of the last run as json to the file
+    ///
+    bool writeJson(const std::string& fileName) const;
+
+    ///
+    /// \brief Compute the mean, nearest rank percentiles and max of the samples
+    ///
+    static TimeStats computeStats(std::vector<double> samples);
+
+protected:
+    std::shared_ptr<Scene> m_scene = nullptr;
+    double m_dt = 0.01;
+    int    m_numSteps       = 1000;
+    int    m_numWarmupSteps = 10;
+
+    std::map<std::string, TimeStats> m_taskStats; ///< Compute times per TaskNode name
+    TimeStats m_criticalPathStats;                ///< Sum of the compute times on the critical path per step
+    TimeStats m_stepStats;                        ///< Wall time per step
+    double    m_stepsPerSecond = 0.0;
+};
+} // namespace imstk
@@ -103,14 +103,17 @@ SimulationManager::start()
                 continue;
             }
 
-            const double passedTime = timer.getTimeElapsed();
-            timer.start();
-
             if (newState == ModuleDriverPaused)
             {
+                // Block until resumed/stopped, time passed while paused is discarded
+                waitWhilePaused();
+                timer.start();
                 continue;
             }
 
+            const double passedTime = timer.getTimeElapsed();
+            timer.start();
+
             // Accumulate the real time passed
             accumulator += passedTime;
 
@@ -134,6 +137,20 @@ SimulationManager::start()
                 m_dt *= 0.001; // ms->s
             }
 
+            // With nothing to render or run per loop, sleep until the next step is due
+            // instead of spinning on the accumulator
+            if (m_numSteps == 0 && m_viewers.empty() && m_syncModules.empty())
+            {
+                const double remainingTime = desiredDt_ms - accumulator - timer.getTimeElapsed();
+                if (remainingTime > 0.0)
+                {
+                    waitUntil(std::chrono::steady_clock::now() +
+                        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                            std::chrono::duration<double, std::milli>(remainingTime)));
+                }
+                continue;
+            }
+
             //printf("%d steps at %f\n", m_numSteps, m_dt);
 
             // Optional smoothening + loss here
@@ -231,6 +248,10 @@ SimulationManager::runModuleParallel(std::shared_ptr<Module> module)
 
     waitForInit();
 
+    using Clock = std::chrono::steady_clock;
+    std::shared_ptr<Viewer> viewer = std::dynamic_pointer_cast<Viewer>(module);
+    Clock::time_point       nextDeadline = Clock::now();
+
     m_running[module.get()] = true;
     while (m_running[module.get()])
     {
@@ -240,19 +261,75 @@ SimulationManager::runModuleParallel(std::shared_ptr<Module> module)
         {
             m_running[module.get()] = false;
         }
+        else if (newState == ModuleDriverPaused)
+        {
+            waitWhilePaused();
+            nextDeadline = Clock::now();
+        }
         else if (newState == ModuleDriverRunning)
         {
-            std::shared_ptr<Viewer> viewer = std::dynamic_pointer_cast<Viewer>(module);
+            // Paused modules block instead of spinning, wake up periodically to check for stop
+            if (module->getPaused())
+            {
+                module->waitForResume(100.0);
+                nextDeadline = Clock::now();
+                continue;
+            }
+
             if (viewer != nullptr)
             {
                 viewer->processEvents();
             }
 
             module->update();
+
+            const double targetRate = module->getTargetRate();
+            if (targetRate > 0.0)
+            {
+                const Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(1.0 / targetRate));
+                nextDeadline += period;
+
+                const Clock::time_point now = Clock::now();
+                if (now > nextDeadline)
+                {
+                    // Missed the deadline, don't try to catch up with a burst of updates
+                    module->addSchedulingSample(std::chrono::duration<double, std::milli>(now - nextDeadline).count(), true);
+                    nextDeadline = now;
+                }
+                else
+                {
+                    waitUntil(nextDeadline);
+                    module->addSchedulingSample(std::chrono::duration<double, std::milli>(Clock::now() - nextDeadline).count(), false);
+                }
+            }
+            else
+            {
+                // Unlimited rate, still give up the core between updates instead of busy looping
+                std::this_thread::yield();
+            }
         }
     }
 }
 
+void
+SimulationManager::waitUntil(const std::chrono::steady_clock::time_point& deadline) const
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration spinThreshold = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(m_spinThreshold));
+
+    // Coarse OS sleep, then yield the last bit for a precise wake up
+    if (deadline - Clock::now() > spinThreshold)
+    {
+        std::this_thread::sleep_until(deadline - spinThreshold);
+    }
+    while (Clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+}
+
 void
 SimulationManager::requestStop(Event* e)
 {
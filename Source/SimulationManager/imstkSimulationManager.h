@@ -8,6 +8,7 @@
 
 #include "imstkModuleDriver.h"
 
+#include <chrono>
 #include <unordered_map>
 
 namespace imstk
@@ -106,11 +107,24 @@ public:
     bool getUseRemainderTimeDivide() const { return m_useRemainderTimeDivide; }
 /// @}
 
+    ///
+    /// \brief Rate limited modules sleep until this amount of time (ms) before
+    /// their deadline and then spin/yield the remainder for precise wake ups.
+    /// Larger values give less jitter at the cost of cpu, default 1.0ms
+    ///
+    void setSpinThreshold(const double ms) { m_spinThreshold = ms; }
+    double getSpinThreshold() const { return m_spinThreshold; }
+
 protected:
     void requestStop(Event* e);
 
     void runModuleParallel(std::shared_ptr<Module> module);
 
+    ///
+    /// \brief Hybrid sleep then spin until the given deadline
+    ///
+    void waitUntil(const std::chrono::steady_clock::time_point& deadline) const;
+
     std::vector<std::shared_ptr<Viewer>> m_viewers;
 
     std::unordered_map<Module*, bool> m_running;
@@ -124,5 +138,6 @@ protected:
     double m_dt       = 0.0;                ///< Actual timestep
     int    m_numSteps = 0;
     bool   m_useRemainderTimeDivide = true; ///< Whether to divide out remainder time or not
+    double m_spinThreshold = 1.0;           ///< Time before a deadline to stop sleeping and spin (ms)
 };
 };                                          // namespace imstk
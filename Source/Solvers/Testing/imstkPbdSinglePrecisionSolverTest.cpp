@@ -0,0 +1,223 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkPbdFemTetConstraint.h"
+#include "imstkPbdSinglePrecisionSolver.h"
+#include "imstkPbdSolverTest.h"
+
+using namespace imstk;
+
+///
+/// \brief Solves a stretched chain in single and double precision, both
+/// should recover the rest lengths and agree with each other
+///
+TEST_F(PbdSolverTest, SinglePrecisionMatchesDouble)
+{
+    PbdState singleState;
+    PbdState doubleState;
+    auto     singleConstraints = std::make_shared<PbdConstraintContainer>();
+    auto     doubleConstraints = std::make_shared<PbdConstraintContainer>();
+    setupStretchedChain(singleState, *singleConstraints, 10, 0.1);
+    setupStretchedChain(doubleState, *doubleConstraints, 10, 0.1);
+
+    PbdSinglePrecisionSolver singleSolver;
+    PbdSolver                doubleSolver;
+    for (PbdSolver* solver : { static_cast<PbdSolver*>(&singleSolver), &doubleSolver })
+    {
+        solver->setTimeStep(0.01);
+        solver->setIterations(500);
+        solver->setSolverType(PbdConstraint::SolverType::PBD);
+    }
+    singleSolver.setPbdBodies(&singleState);
+    singleSolver.setConstraints(singleConstraints);
+    doubleSolver.setPbdBodies(&doubleState);
+    doubleSolver.setConstraints(doubleConstraints);
+    singleSolver.solve();
+    doubleSolver.solve();
+
+    EXPECT_EQ(singleSolver.getNumSinglePrecisionConstraints(), 9);
+
+    const VecDataArray<double, 3>& singleVertices = *singleState.m_bodies[0]->vertices;
+    const VecDataArray<double, 3>& doubleVertices = *doubleState.m_bodies[0]->vertices;
+    EXPECT_TRUE(singleVertices[0].isApprox(Vec3d::Zero()));
+    for (int i = 0; i < singleVertices.size(); i++)
+    {
+        EXPECT_NEAR((singleVertices[i] - doubleVertices[i]).norm(), 0.0, 1.0e-5);
+        if (i > 0)
+        {
+            EXPECT_NEAR((singleVertices[i] - singleVertices[i - 1]).norm(), 0.1, 1.0e-5);
+        }
+    }
+}
+
+///
+/// \brief Solves a stretched FEM tetrahedron in single and double precision
+///
+TEST_F(PbdSolverTest, SinglePrecisionFemTet)
+{
+    const std::vector<Vec3d> restPositions = {
+        Vec3d(0.0, 0.0, 0.0), Vec3d(0.01, 0.0, 0.0), Vec3d(0.0, 0.01, 0.0), Vec3d(0.0, 0.0, 0.01) };
+    std::vector<Vec3d> stretchedPositions = restPositions;
+    stretchedPositions[3] = Vec3d(0.0, 0.0, 0.015);
+
+    PbdFemConstraintConfig config(0.0, 0.0, 1000.0, 0.2);
+    config.setYoungAndPoisson(1000.0, 0.2);
+
+    std::shared_ptr<PbdBody> bodies[2];
+    PbdState                 states[2];
+    for (int i = 0; i < 2; i++)
+    {
+        bodies[i] = addBody(states[i], stretchedPositions, { 0.0, 0.0, 0.0, 1000.0 });
+    }
+
+    auto singleConstraints = std::make_shared<PbdConstraintContainer>();
+    auto doubleConstraints = std::make_shared<PbdConstraintContainer>();
+    for (auto constraints : { singleConstraints, doubleConstraints })
+    {
+        auto constraint = std::make_shared<PbdFemTetConstraint>(PbdFemConstraint::MaterialType::StVK);
+        ASSERT_TRUE(constraint->initConstraint(restPositions[0], restPositions[1], restPositions[2], restPositions[3],
+            { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, config));
+        constraints->addConstraint(constraint);
+    }
+
+    PbdSinglePrecisionSolver singleSolver;
+    PbdSolver                doubleSolver;
+    singleSolver.setPbdBodies(&states[0]);
+    singleSolver.setConstraints(singleConstraints);
+    doubleSolver.setPbdBodies(&states[1]);
+    doubleSolver.setConstraints(doubleConstraints);
+    for (PbdSolver* solver : { static_cast<PbdSolver*>(&singleSolver), &doubleSolver })
+    {
+        solver->setTimeStep(0.01);
+        solver->setIterations(10);
+        solver->solve();
+    }
+
+    EXPECT_EQ(singleSolver.getNumSinglePrecisionConstraints(), 1);
+    const Vec3d& singlePos = (*bodies[0]->vertices)[3];
+    const Vec3d& doublePos = (*bodies[1]->vertices)[3];
+    // The element relaxes towards rest
+    EXPECT_LT(doublePos[2], 0.015);
+    EXPECT_NEAR((singlePos - doublePos).norm(), 0.0, 1.0e-6);
+}
+
+///
+/// \brief Constraints that involve oriented bodies stay in double precision and
+/// are coupled with the single precision ones every iteration
+///
+TEST_F(PbdSolverTest, SinglePrecisionDoublePrecisionFallback)
+{
+    PbdState state;
+    auto     constraints = std::make_shared<PbdConstraintContainer>();
+    setupStretchedChain(state, *constraints, 5, 0.1);
+
+    // Pin the end of the chain to a fixed oriented particle at its rest length
+    std::shared_ptr<PbdBody> orientedBody = addBody(state, { Vec3d(0.4, 0.0, 0.0) }, { 0.0 });
+    orientedBody->bodyType = PbdBody::Type::DEFORMABLE_ORIENTED;
+    auto constraint = std::make_shared<PbdDistanceConstraint>();
+    constraint->initConstraint(0.0, { 0, 4 }, { 1, 0 }, 1.0);
+    constraints->addConstraint(constraint);
+
+    PbdSinglePrecisionSolver solver;
+    solver.setPbdBodies(&state);
+    solver.setConstraints(constraints);
+    solver.setTimeStep(0.01);
+    solver.setIterations(500);
+    solver.setSolverType(PbdConstraint::SolverType::PBD);
+    solver.solve();
+
+    EXPECT_EQ(solver.getNumSinglePrecisionConstraints(), 4);
+    const VecDataArray<double, 3>& vertices = *state.m_bodies[0]->vertices;
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        EXPECT_NEAR((vertices[i] - Vec3d(0.1 * i, 0.0, 0.0)).norm(), 0.0, 1.0e-5);
+    }
+    EXPECT_TRUE((*orientedBody->vertices)[0].isApprox(Vec3d(0.4, 0.0, 0.0)));
+}
+
+///
+/// \brief Edits the stiffness of the constraints in place, without changing the
+/// constraint count, the next single precision solve should pick it up
+///
+TEST_F(PbdSolverTest, SinglePrecisionStiffnessEdit)
+{
+    PbdState singleState;
+    PbdState doubleState;
+    auto     singleConstraints = std::make_shared<PbdConstraintContainer>();
+    auto     doubleConstraints = std::make_shared<PbdConstraintContainer>();
+    setupStretchedChain(singleState, *singleConstraints, 10, 0.1);
+    setupStretchedChain(doubleState, *doubleConstraints, 10, 0.1);
+    const VecDataArray<double, 3> stretchedVertices = *singleState.m_bodies[0]->vertices;
+
+    PbdSinglePrecisionSolver singleSolver;
+    PbdSolver                doubleSolver;
+    singleSolver.setPbdBodies(&singleState);
+    singleSolver.setConstraints(singleConstraints);
+    doubleSolver.setPbdBodies(&doubleState);
+    doubleSolver.setConstraints(doubleConstraints);
+    for (PbdSolver* solver : { static_cast<PbdSolver*>(&singleSolver), &doubleSolver })
+    {
+        solver->setTimeStep(0.01);
+        solver->setIterations(1);
+        solver->setSolverType(PbdConstraint::SolverType::PBD);
+        solver->solve();
+    }
+    const VecDataArray<double, 3> stiffVertices = *singleState.m_bodies[0]->vertices;
+
+    // Soften the constraints and solve again from the stretched positions
+    for (auto constraints : { singleConstraints, doubleConstraints })
+    {
+        for (auto& constraint : constraints->getConstraints())
+        {
+            constraint->setStiffness(0.2);
+        }
+    }
+    *singleState.m_bodies[0]->vertices = stretchedVertices;
+    *doubleState.m_bodies[0]->vertices = stretchedVertices;
+    singleSolver.solve();
+    doubleSolver.solve();
+
+    const VecDataArray<double, 3>& singleVertices = *singleState.m_bodies[0]->vertices;
+    const VecDataArray<double, 3>& doubleVertices = *doubleState.m_bodies[0]->vertices;
+    EXPECT_EQ(singleSolver.getNumSinglePrecisionConstraints(), 9);
+    EXPECT_GT((singleVertices[9] - stiffVertices[9]).norm(), 1.0e-3);
+    for (int i = 0; i < singleVertices.size(); i++)
+    {
+        EXPECT_NEAR((singleVertices[i] - doubleVertices[i]).norm(), 0.0, 1.0e-5);
+    }
+}
+
+///
+/// \brief Particles added to an oriented body, as the virtual particles of the contacts
+/// every step, don't rebuild the float state, particles added to a flattened body do
+///
+TEST_F(PbdSolverTest, SinglePrecisionRebuildOnFlattenedLayout)
+{
+    PbdState state;
+    auto     constraints = std::make_shared<PbdConstraintContainer>();
+    setupStretchedChain(state, *constraints, 5, 0.1);
+    std::shared_ptr<PbdBody> orientedBody = addBody(state, { Vec3d(1.0, 0.0, 0.0) }, { 0.0 });
+    orientedBody->bodyType = PbdBody::Type::DEFORMABLE_ORIENTED;
+
+    PbdSinglePrecisionSolver solver;
+    solver.setPbdBodies(&state);
+    solver.setConstraints(constraints);
+    solver.setTimeStep(0.01);
+    solver.setIterations(1);
+    solver.setSolverType(PbdConstraint::SolverType::PBD);
+    solver.solve();
+    EXPECT_EQ(solver.getNumRebuilds(), 1);
+
+    orientedBody->vertices->push_back(Vec3d(2.0, 0.0, 0.0));
+    orientedBody->invMasses->push_back(0.0);
+    solver.solve();
+    EXPECT_EQ(solver.getNumRebuilds(), 1);
+
+    state.m_bodies[0]->vertices->push_back(Vec3d(1.0, 0.0, 0.0));
+    state.m_bodies[0]->invMasses->push_back(1.0);
+    solver.solve();
+    EXPECT_EQ(solver.getNumRebuilds(), 2);
+}
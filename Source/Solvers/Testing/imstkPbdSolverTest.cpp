@@ -0,0 +1,70 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkPbdSolverTest.h"
+
+using namespace imstk;
+
+///
+/// \brief Solves a stretched chain with both solver modes, both should
+/// recover the rest lengths
+///
+TEST_F(PbdSolverTest, SolverModes)
+{
+    for (const PbdSolver::SolverMode mode :
+         { PbdSolver::SolverMode::GaussSeidel, PbdSolver::SolverMode::Jacobi })
+    {
+        PbdState state;
+        auto     constraints = std::make_shared<PbdConstraintContainer>();
+        setupStretchedChain(state, *constraints, 5, 0.1);
+
+        PbdSolver solver;
+        solver.setPbdBodies(&state);
+        solver.setConstraints(constraints);
+        solver.setTimeStep(0.01);
+        solver.setIterations(500);
+        solver.setSolverType(PbdConstraint::SolverType::PBD);
+        solver.setSolverMode(mode);
+        solver.solve();
+
+        const VecDataArray<double, 3>& vertices = *state.m_bodies[0]->vertices;
+        EXPECT_TRUE(vertices[0].isApprox(Vec3d::Zero()));
+        for (int i = 0; i < vertices.size() - 1; i++)
+        {
+            EXPECT_NEAR((vertices[i + 1] - vertices[i]).norm(), 0.1, 1.0e-6);
+        }
+    }
+}
+
+///
+/// \brief Solves a stretched chain with a convergence criterion, the solve
+/// should stop early once the constraints are satisfied
+///
+TEST_F(PbdSolverTest, EarlyTermination)
+{
+    PbdState state;
+    auto     constraints = std::make_shared<PbdConstraintContainer>();
+    setupStretchedChain(state, *constraints, 5, 0.1);
+
+    PbdSolver solver;
+    solver.setPbdBodies(&state);
+    solver.setConstraints(constraints);
+    solver.setTimeStep(0.01);
+    solver.setIterations(1000);
+    solver.setMinIterations(2);
+    solver.setSolverType(PbdConstraint::SolverType::PBD);
+    solver.setConvergenceCriterion(PbdSolver::ConvergenceCriterion::MaxC);
+    solver.setConvergenceTolerance(1.0e-8);
+    solver.solve();
+
+    EXPECT_GE(solver.getIterationsUsed(), 2);
+    EXPECT_LT(solver.getIterationsUsed(), 1000);
+    EXPECT_LE(solver.getResidual(), 1.0e-8);
+
+    // Solving again at rest should only take the minimum iterations
+    solver.solve();
+    EXPECT_EQ(solver.getIterationsUsed(), 2);
+}
@@ -0,0 +1,66 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkPbdConstraintContainer.h"
+#include "imstkPbdDistanceConstraint.h"
+#include "imstkPbdSolver.h"
+
+#include <gtest/gtest.h>
+
+///
+/// \class PbdSolverTest
+///
+/// \brief Test that solves pbd bodies, provides the bodies and constraints
+/// shared between the solver tests
+///
+class PbdSolverTest : public testing::Test
+{
+public:
+    ///
+    /// \brief Creates a body with the given positions, particles with 0 inverse mass are fixed
+    ///
+    static std::shared_ptr<imstk::PbdBody> addBody(imstk::PbdState& state,
+                                                   const std::vector<imstk::Vec3d>& positions,
+                                                   const std::vector<double>& invMasses)
+    {
+        auto body = std::make_shared<imstk::PbdBody>(static_cast<int>(state.m_bodies.size()));
+        body->vertices  = std::make_shared<imstk::VecDataArray<double, 3>>(static_cast<int>(positions.size()));
+        body->invMasses = std::make_shared<imstk::DataArray<double>>(static_cast<int>(positions.size()));
+        for (size_t i = 0; i < positions.size(); i++)
+        {
+            (*body->vertices)[i]  = positions[i];
+            (*body->invMasses)[i] = invMasses[i];
+        }
+        state.m_bodies.push_back(body);
+        return body;
+    }
+
+    ///
+    /// \brief Creates a chain of distance constraints stretched to twice its rest length,
+    /// the first particle is fixed
+    ///
+    static void setupStretchedChain(imstk::PbdState& state, imstk::PbdConstraintContainer& constraints,
+                                    const int numParticles, const double restLength)
+    {
+        std::vector<imstk::Vec3d> positions;
+        std::vector<double>       invMasses;
+        for (int i = 0; i < numParticles; i++)
+        {
+            positions.push_back(imstk::Vec3d(2.0 * restLength * i, 0.0, 0.0));
+            invMasses.push_back((i == 0) ? 0.0 : 1.0);
+        }
+        const int bodyId = addBody(state, positions, invMasses)->bodyHandle;
+
+        for (int i = 0; i < numParticles - 1; i++)
+        {
+            auto constraint = std::make_shared<imstk::PbdDistanceConstraint>();
+            constraint->initConstraint(restLength, { bodyId, i }, { bodyId, i + 1 }, 1.0);
+            constraints.addConstraint(constraint);
+        }
+    }
+};
@@ -0,0 +1,497 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkPbdSinglePrecisionSolver.h"
+#include "imstkParallelUtils.h"
+#include "imstkPbdConstraintContainer.h"
+#include "imstkPbdConstraintKernels.h"
+#include "imstkPbdDihedralConstraint.h"
+#include "imstkPbdDistanceConstraint.h"
+#include "imstkPbdFemTetConstraint.h"
+#include "imstkPbdVolumeConstraint.h"
+
+#include <atomic>
+#include <type_traits>
+
+namespace
+{
+using namespace imstk;
+
+///
+/// \brief Projects a single precision constraint, mirrors PbdConstraint::projectConstraint
+/// \param computeValueAndGradient Computes c and dcdx of the element, returns false if it can't be solved
+///
+template<int N, typename ElementType, typename Func>
+void
+projectElement(ElementType& element, VecDataArray<float, 3>& positions, const DataArray<float>& invMasses,
+               const float dt, const PbdConstraint::SolverType solverType, Func computeValueAndGradient)
+{
+    float c = 0.0f;
+    Vec3f dcdx[N];
+    if (!computeValueAndGradient(element, c, dcdx))
+    {
+        return;
+    }
+
+    float w = 0.0f;
+    for (int i = 0; i < N; i++)
+    {
+        w += invMasses[element.ids[i]] * dcdx[i].squaredNorm();
+    }
+    if (w == 0.0f)
+    {
+        return;
+    }
+
+    float dlambda = 0.0f;
+    if (solverType == PbdConstraint::SolverType::PBD)
+    {
+        dlambda = -c * element.stiffness / w;
+    }
+    else
+    {
+        const float alpha = element.compliance / (dt * dt);
+        dlambda = -(c + alpha * element.lambda) / (w + alpha);
+    }
+    element.lambda += dlambda;
+
+    for (int i = 0; i < N; i++)
+    {
+        const float invMass = invMasses[element.ids[i]];
+        if (invMass > 0.0f)
+        {
+            positions[element.ids[i]] += invMass * dlambda * dcdx[i];
+        }
+    }
+}
+
+///
+/// \brief Projects all elements of a type, in parallel if they don't share particles
+///
+template<int N, typename ElementType, typename Func>
+void
+projectElements(std::vector<ElementType>& elements, const bool parallel,
+                VecDataArray<float, 3>& positions, const DataArray<float>& invMasses,
+                const float dt, const PbdConstraint::SolverType solverType, Func computeValueAndGradient)
+{
+    ParallelUtils::parallelFor(elements.size(),
+        [&](const size_t i)
+        {
+            projectElement<N>(elements[i], positions, invMasses, dt, solverType, computeValueAndGradient);
+        }, parallel && elements.size() > 50);
+}
+
+///
+/// \brief Whether the particles of a body are flattened to single precision, oriented and
+/// rigid bodies, such as the virtual particles, stay double
+///
+bool
+isFlattened(const PbdBody& body)
+{
+    return body.bodyType == PbdBody::Type::DEFORMABLE && body.vertices != nullptr && body.invMasses != nullptr;
+}
+} // namespace
+
+namespace imstk
+{
+void
+PbdSinglePrecisionSolver::solve()
+{
+    if (m_dataTracker)
+    {
+        m_dataTracker->getStopWatch(DataTracker::ePhysics::SolverTime_ms).start();
+    }
+
+    m_residual = 0.0;
+
+    const std::vector<std::vector<std::shared_ptr<PbdConstraint>>>& partitionedConstraints = m_constraints->getPartitionedConstraints();
+    if (!m_valid || needsRebuild(partitionedConstraints) || !updateElements())
+    {
+        rebuild(partitionedConstraints);
+    }
+
+    // Load the float state
+    ParallelUtils::parallelFor(m_particleIds.size(),
+        [&](const size_t i)
+        {
+            m_positions[i] = m_state->getPosition(m_particleIds[i]).cast<float>();
+            m_invMasses[i] = static_cast<float>(m_state->getInvMass(m_particleIds[i]));
+        }, m_particleIds.size() > 50);
+
+    size_t numConstraints = m_numSinglePrecisionConstraints + m_doubleConstraints.size();
+    for (PbdConstraint* constraint : m_doubleConstraints)
+    {
+        constraint->zeroOutLambda();
+    }
+    for (auto constraintList : *m_constraintLists)
+    {
+        numConstraints += constraintList->size();
+        for (PbdConstraint* constraint : *constraintList)
+        {
+            constraint->zeroOutLambda();
+        }
+    }
+
+    gatherExchangedParticles();
+    const bool hasDoubleConstraints = !m_doubleConstraints.empty() || !m_constraintLists->empty();
+
+    for (size_t iter = 0; iter < m_iterations; iter++)
+    {
+        if (hasDoubleConstraints)
+        {
+            for (const int i : m_exchangedParticles)
+            {
+                m_state->getPosition(m_particleIds[i]) = m_positions[i].cast<double>();
+            }
+
+            // Project collision and all external constraints
+            for (auto constraintList : *m_constraintLists)
+            {
+                for (PbdConstraint* constraint : *constraintList)
+                {
+                    constraint->projectConstraint(*m_state, m_dt, m_solverType);
+                }
+            }
+            for (PbdConstraint* constraint : m_doubleConstraints)
+            {
+                constraint->projectConstraint(*m_state, m_dt, m_solverType);
+            }
+
+            for (const int i : m_exchangedParticles)
+            {
+                m_positions[i] = m_state->getPosition(m_particleIds[i]).cast<float>();
+            }
+        }
+
+        for (auto& batch : m_batches)
+        {
+            projectBatch(batch);
+        }
+    }
+    m_iterationsUsed = m_iterations;
+
+    // Write back the solved positions
+    ParallelUtils::parallelFor(m_particleIds.size(),
+        [&](const size_t i)
+        {
+            m_state->getPosition(m_particleIds[i]) = m_positions[i].cast<double>();
+        }, m_particleIds.size() > 50);
+
+    if (m_dataTracker)
+    {
+        m_dataTracker->probeElapsedTime_s(DataTracker::ePhysics::SolverTime_ms);
+        m_dataTracker->probe(DataTracker::ePhysics::NumConstraints, numConstraints);
+        m_dataTracker->probe(DataTracker::ePhysics::NumIterations, static_cast<double>(m_iterationsUsed));
+    }
+}
+
+bool
+PbdSinglePrecisionSolver::needsRebuild(const std::vector<std::vector<std::shared_ptr<PbdConstraint>>>& partitionedConstraints)
+{
+    // Compare the identity of the constraints, not only their count, so replaced constraints are caught
+    size_t numConstraints = m_constraints->getConstraints().size();
+    for (const auto& partition : partitionedConstraints)
+    {
+        numConstraints += partition.size();
+    }
+    if (numConstraints != m_constraintOrder.size())
+    {
+        return true;
+    }
+    size_t i = 0;
+    for (const auto& partition : partitionedConstraints)
+    {
+        for (const auto& constraint : partition)
+        {
+            if (m_constraintOrder[i++] != constraint.get())
+            {
+                return true;
+            }
+        }
+    }
+    for (const auto& constraint : m_constraints->getConstraints())
+    {
+        if (m_constraintOrder[i++] != constraint.get())
+        {
+            return true;
+        }
+    }
+
+    // Only the flattened bodies matter, the virtual particle bodies are refilled every step
+    if (m_layout.size() != m_state->m_bodies.size())
+    {
+        return true;
+    }
+    for (size_t bodyId = 0; bodyId < m_state->m_bodies.size(); bodyId++)
+    {
+        const PbdBody& body = *m_state->m_bodies[bodyId];
+        if (isFlattened(body) != (m_bodyOffsets[bodyId] != -1)
+            || (isFlattened(body) && m_layout[bodyId] != static_cast<size_t>(body.vertices->size())))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+PbdSinglePrecisionSolver::rebuild(const std::vector<std::vector<std::shared_ptr<PbdConstraint>>>& partitionedConstraints)
+{
+    m_constraintOrder.clear();
+    for (const auto& partition : partitionedConstraints)
+    {
+        for (const auto& constraint : partition)
+        {
+            m_constraintOrder.push_back(constraint.get());
+        }
+    }
+    for (const auto& constraint : m_constraints->getConstraints())
+    {
+        m_constraintOrder.push_back(constraint.get());
+    }
+    m_numRebuilds++;
+
+    // Flatten the particles of all deformable bodies, oriented and rigid bodies stay double
+    m_layout.assign(m_state->m_bodies.size(), 0);
+    m_bodyOffsets.assign(m_state->m_bodies.size(), -1);
+    m_particleIds.clear();
+    for (size_t bodyId = 0; bodyId < m_state->m_bodies.size(); bodyId++)
+    {
+        const PbdBody& body = *m_state->m_bodies[bodyId];
+        if (!isFlattened(body))
+        {
+            continue;
+        }
+        m_layout[bodyId]      = static_cast<size_t>(body.vertices->size());
+        m_bodyOffsets[bodyId] = static_cast<int>(m_particleIds.size());
+        for (int i = 0; i < body.vertices->size(); i++)
+        {
+            m_particleIds.push_back({ static_cast<int>(bodyId), i });
+        }
+    }
+    m_positions.resize(static_cast<int>(m_particleIds.size()));
+    m_invMasses.resize(static_cast<int>(m_particleIds.size()));
+    m_isExchanged.assign(m_particleIds.size(), 0);
+
+    // Convert the constraints, partitions keep their coloring
+    m_batches.clear();
+    m_doubleConstraints.clear();
+    m_numSinglePrecisionConstraints = 0;
+    for (const auto& partition : partitionedConstraints)
+    {
+        ConstraintBatch batch;
+        batch.parallel = true;
+        for (const auto& constraint : partition)
+        {
+            if (!addElement(batch, *constraint))
+            {
+                m_doubleConstraints.push_back(constraint.get());
+            }
+        }
+        m_batches.push_back(std::move(batch));
+    }
+    ConstraintBatch sequentialBatch;
+    for (const auto& constraint : m_constraints->getConstraints())
+    {
+        if (!addElement(sequentialBatch, *constraint))
+        {
+            m_doubleConstraints.push_back(constraint.get());
+        }
+    }
+    m_batches.push_back(std::move(sequentialBatch));
+
+    for (const auto& batch : m_batches)
+    {
+        m_numSinglePrecisionConstraints +=
+            batch.distances.size() + batch.volumes.size() + batch.dihedrals.size() + batch.femTets.size();
+    }
+    m_valid = true;
+}
+
+bool
+PbdSinglePrecisionSolver::addElement(ConstraintBatch& batch, PbdConstraint& constraint) const
+{
+    // Subclasses may change the projection, only convert the exact types
+    const std::string typeName = constraint.getTypeName();
+    auto              add      = [&](auto& elements, std::vector<PbdConstraint*>& sources)
+                                 {
+                                     typename std::decay_t<decltype(elements)>::value_type element;
+                                     if (!computeIds(constraint, element.ids))
+                                     {
+                                         return false;
+                                     }
+                                     loadParameters(element, constraint);
+                                     elements.push_back(element);
+                                     sources.push_back(&constraint);
+                                     return true;
+                                 };
+
+    if (typeName == PbdDistanceConstraint::getStaticTypeName())
+    {
+        return add(batch.distances, batch.distanceSources);
+    }
+    else if (typeName == PbdVolumeConstraint::getStaticTypeName())
+    {
+        return add(batch.volumes, batch.volumeSources);
+    }
+    else if (typeName == PbdDihedralConstraint::getStaticTypeName())
+    {
+        return add(batch.dihedrals, batch.dihedralSources);
+    }
+    else if (typeName == PbdFemTetConstraint::getStaticTypeName())
+    {
+        return add(batch.femTets, batch.femTetSources);
+    }
+    return false;
+}
+
+bool
+PbdSinglePrecisionSolver::updateElements()
+{
+    std::atomic<bool> valid = { true };
+    auto              update = [&](auto& elements, const std::vector<PbdConstraint*>& sources)
+                               {
+                                   ParallelUtils::parallelFor(elements.size(),
+                                       [&](const size_t i)
+                                       {
+                                           if (!computeIds(*sources[i], elements[i].ids))
+                                           {
+                                               valid = false;
+                                               return;
+                                           }
+                                           loadParameters(elements[i], *sources[i]);
+                                       }, elements.size() > 50);
+                               };
+    for (auto& batch : m_batches)
+    {
+        update(batch.distances, batch.distanceSources);
+        update(batch.volumes, batch.volumeSources);
+        update(batch.dihedrals, batch.dihedralSources);
+        update(batch.femTets, batch.femTetSources);
+    }
+    return valid;
+}
+
+template<size_t N>
+bool
+PbdSinglePrecisionSolver::computeIds(PbdConstraint& constraint, std::array<int, N>& ids) const
+{
+    const std::vector<PbdParticleId>& particles = constraint.getParticles();
+    if (particles.size() != N)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < N; i++)
+    {
+        const PbdParticleId& pid = particles[i];
+        if (pid.first < 0 || pid.first >= static_cast<int>(m_bodyOffsets.size()) || m_bodyOffsets[pid.first] == -1)
+        {
+            return false;
+        }
+        ids[i] = m_bodyOffsets[pid.first] + pid.second;
+    }
+    return true;
+}
+
+template<int N>
+void
+PbdSinglePrecisionSolver::loadParameters(Element<N>& element, const PbdConstraint& constraint)
+{
+    element.restValue  = static_cast<float>(constraint.getRestValue());
+    element.stiffness  = static_cast<float>(constraint.getStiffness());
+    element.compliance = static_cast<float>(constraint.getCompliance());
+    element.lambda     = 0.0f;
+}
+
+void
+PbdSinglePrecisionSolver::loadParameters(FemTetElement& element, const PbdConstraint& constraint)
+{
+    const auto& femConstraint = static_cast<const PbdFemTetConstraint&>(constraint);
+    element.restValue        = static_cast<float>(femConstraint.m_initialElementVolume);
+    element.stiffness        = static_cast<float>(constraint.getStiffness());
+    element.compliance       = static_cast<float>(constraint.getCompliance());
+    element.lambda           = 0.0f;
+    element.invRestMat       = femConstraint.m_invRestMat.cast<float>();
+    element.mu               = static_cast<float>(femConstraint.m_config.m_mu);
+    element.lameLambda       = static_cast<float>(femConstraint.m_config.m_lambda);
+    element.material         = femConstraint.m_material;
+    element.handleInversions = femConstraint.getInverstionHandling();
+}
+
+void
+PbdSinglePrecisionSolver::gatherExchangedParticles()
+{
+    for (const int i : m_exchangedParticles)
+    {
+        m_isExchanged[i] = 0;
+    }
+    m_exchangedParticles.clear();
+
+    auto gather = [&](PbdConstraint& constraint)
+                  {
+                      for (const PbdParticleId& pid : constraint.getParticles())
+                      {
+                          if (pid.first < 0 || pid.first >= static_cast<int>(m_bodyOffsets.size())
+                              || m_bodyOffsets[pid.first] == -1)
+                          {
+                              continue;
+                          }
+                          const int i = m_bodyOffsets[pid.first] + pid.second;
+                          if (!m_isExchanged[i])
+                          {
+                              m_isExchanged[i] = 1;
+                              m_exchangedParticles.push_back(i);
+                          }
+                      }
+                  };
+    for (PbdConstraint* constraint : m_doubleConstraints)
+    {
+        gather(*constraint);
+    }
+    for (auto constraintList : *m_constraintLists)
+    {
+        for (PbdConstraint* constraint : *constraintList)
+        {
+            gather(*constraint);
+        }
+    }
+}
+
+void
+PbdSinglePrecisionSolver::projectBatch(ConstraintBatch& batch)
+{
+    VecDataArray<float, 3>& x = m_positions;
+    const float             dt = static_cast<float>(m_dt);
+    if (dt == 0.0f)
+    {
+        return;
+    }
+
+    projectElements<2>(batch.distances, batch.parallel, x, m_invMasses, dt, m_solverType,
+        [&](const Element<2>& e, float& c, Vec3f* dcdx)
+        {
+            return PbdConstraintKernels::distance<float>(x[e.ids[0]], x[e.ids[1]], e.restValue, c, dcdx);
+        });
+    projectElements<4>(batch.volumes, batch.parallel, x, m_invMasses, dt, m_solverType,
+        [&](const Element<4>& e, float& c, Vec3f* dcdx)
+        {
+            return PbdConstraintKernels::volume<float>(x[e.ids[0]], x[e.ids[1]], x[e.ids[2]], x[e.ids[3]],
+                e.restValue, c, dcdx);
+        });
+    projectElements<4>(batch.dihedrals, batch.parallel, x, m_invMasses, dt, m_solverType,
+        [&](const Element<4>& e, float& c, Vec3f* dcdx)
+        {
+            return PbdConstraintKernels::dihedral<float>(x[e.ids[0]], x[e.ids[1]], x[e.ids[2]], x[e.ids[3]],
+                e.restValue, c, dcdx);
+        });
+    projectElements<4>(batch.femTets, batch.parallel, x, m_invMasses, dt, m_solverType,
+        [&](const FemTetElement& e, float& c, Vec3f* dcdx)
+        {
+            return PbdConstraintKernels::femTet<float>(x[e.ids[0]], x[e.ids[1]], x[e.ids[2]], x[e.ids[3]],
+                e.invRestMat, e.restValue, e.mu, e.lameLambda, e.material, e.handleInversions, c, dcdx);
+        });
+}
+} // namespace imstk
@@ -0,0 +1,165 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkPbdFemConstraint.h"
+#include "imstkPbdSolver.h"
+#include "imstkVecDataArray.h"
+
+#include <array>
+
+namespace imstk
+{
+///
+/// \class PbdSinglePrecisionSolver
+///
+/// \brief Position Based Dynamics solver that projects the distance, volume, dihedral and
+/// FEM tet constraints of deformable (non oriented) bodies in single precision. This halves
+/// the memory traffic of the constraint projection, which dominates the cost of a pbd step.
+///
+/// The positions and inverse masses of those bodies are copied to float once at the start
+/// of a solve and written back once at the end, so collision detection and rendering keep
+/// working on the double precision PbdState. All other constraints, and all collision
+/// constraints, are still projected in double precision. Only the particles they touch are
+/// exchanged between the two every iteration.
+///
+/// Constraints are projected Gauss-Seidel style, colored partitions of the container are
+/// projected in parallel. The solver mode and convergence criterion are ignored, the set
+/// amount of iterations is always run.
+///
+class PbdSinglePrecisionSolver : public PbdSolver
+{
+public:
+    PbdSinglePrecisionSolver() = default;
+    ~PbdSinglePrecisionSolver() override = default;
+
+    void solve() override;
+
+    ///
+    /// \brief Forces the float constraints to be rebuilt on the next solve. They are
+    /// rebuilt automatically when the constraints of the container or the particle counts
+    /// change, and their parameters are reloaded every solve
+    ///
+    void invalidate() override { m_valid = false; }
+
+    ///
+    /// \brief Returns the number of constraints projected in single precision
+    ///
+    size_t getNumSinglePrecisionConstraints() const { return m_numSinglePrecisionConstraints; }
+
+    ///
+    /// \brief Returns the number of times the float state and constraints were rebuilt
+    ///
+    size_t getNumRebuilds() const { return m_numRebuilds; }
+
+protected:
+    ///
+    /// \brief Float copy of a constraint, ids index the flat float state
+    ///
+    template<int N>
+    struct Element
+    {
+        std::array<int, N> ids;
+        float restValue  = 0.0f;
+        float stiffness  = 1.0f;
+        float compliance = 0.0f;
+        float lambda     = 0.0f;
+    };
+
+    struct FemTetElement : public Element<4>
+    {
+        Mat3f invRestMat = Mat3f::Identity();
+        float mu         = 0.0f;
+        float lameLambda = 0.0f;
+        PbdFemConstraint::MaterialType material = PbdFemConstraint::MaterialType::StVK;
+        bool handleInversions = true;
+    };
+
+    ///
+    /// \brief Float constraints of one partition (or the unpartitioned constraints)
+    ///
+    struct ConstraintBatch
+    {
+        std::vector<Element<2>>    distances;
+        std::vector<Element<4>>    volumes;
+        std::vector<Element<4>>    dihedrals;
+        std::vector<FemTetElement> femTets;
+        bool parallel = false;    ///< Constraints don't share particles
+
+        ///< Constraints the elements were converted from, per element
+        std::vector<PbdConstraint*> distanceSources;
+        std::vector<PbdConstraint*> volumeSources;
+        std::vector<PbdConstraint*> dihedralSources;
+        std::vector<PbdConstraint*> femTetSources;
+    };
+
+    ///
+    /// \brief Returns true if the constraints of the container or the particle counts
+    /// changed since the last build
+    ///
+    bool needsRebuild(const std::vector<std::vector<std::shared_ptr<PbdConstraint>>>& partitionedConstraints);
+
+    ///
+    /// \brief Builds the flat float state layout and converts the supported constraints
+    ///
+    void rebuild(const std::vector<std::vector<std::shared_ptr<PbdConstraint>>>& partitionedConstraints);
+
+    ///
+    /// \brief Converts a constraint into the batch, returns false if it has to stay double
+    ///
+    bool addElement(ConstraintBatch& batch, PbdConstraint& constraint) const;
+
+    ///
+    /// \brief Reloads the particle ids and parameters of all elements from their constraints,
+    /// so in place edits (stiffness, rest values, ...) are picked up, and zeroes the lambdas.
+    /// Returns false if a constraint now touches a particle not solved in single precision
+    ///
+    bool updateElements();
+
+    ///
+    /// \brief Computes the flat ids of the particles of the constraint, returns false if
+    /// one of them is not solved in single precision
+    ///
+    template<size_t N>
+    bool computeIds(PbdConstraint& constraint, std::array<int, N>& ids) const;
+
+    ///
+    /// \brief Loads the rest value, stiffness and material of the constraint into its
+    /// element and zeroes its lambda
+    ///@{
+    template<int N>
+    static void loadParameters(Element<N>& element, const PbdConstraint& constraint);
+    static void loadParameters(FemTetElement& element, const PbdConstraint& constraint);
+    ///@}
+
+    ///
+    /// \brief Collects the float particles touched by double precision constraints
+    ///
+    void gatherExchangedParticles();
+
+    ///
+    /// \brief Projects all constraints of a batch once
+    ///
+    void projectBatch(ConstraintBatch& batch);
+
+    bool   m_valid = false;
+    size_t m_numSinglePrecisionConstraints = 0;
+    size_t m_numRebuilds = 0;
+    std::vector<const PbdConstraint*> m_constraintOrder; ///< Constraints of the container at the last build, partitions first
+    std::vector<size_t> m_layout;                        ///< Particle counts of the flattened bodies at the last build, 0 for others
+
+    VecDataArray<float, 3>     m_positions;            ///< Flat positions of all single precision particles
+    DataArray<float>           m_invMasses;            ///< Flat inverse masses of all single precision particles
+    std::vector<PbdParticleId> m_particleIds;          ///< Flat index -> body particle
+    std::vector<int> m_bodyOffsets;                    ///< Per body offset into the flat state, -1 if solved in double
+
+    std::vector<ConstraintBatch> m_batches;            ///< Float constraints, partitions first
+    std::vector<PbdConstraint*>  m_doubleConstraints;  ///< Internal constraints left in double precision
+    std::vector<int>  m_exchangedParticles;            ///< Flat ids of the particles double constraints touch
+    std::vector<char> m_isExchanged;                   ///< Flat id -> is in m_exchangedParticles
+};
+} // namespace imstk
@@ -10,6 +10,53 @@
 #include "imstkPbdCollisionConstraint.h"
 #include "imstkPbdConstraintContainer.h"
 
+namespace
+{
+using namespace imstk;
+
+///
+/// \brief Accumulates the residual of the constraints projected in an iteration
+///
+struct PbdResidual
+{
+    double maxC       = 0.0;
+    double sumSqrC    = 0.0;
+    double maxDLambda = 0.0;
+    size_t count      = 0;
+
+    void add(const PbdConstraint& constraint)
+    {
+        const double c = constraint.getConstraintC();
+        maxC       = std::max(maxC, std::abs(c));
+        sumSqrC   += c * c;
+        maxDLambda = std::max(maxDLambda, std::abs(constraint.getDeltaLambda()));
+        count++;
+    }
+
+    void merge(const PbdResidual& other)
+    {
+        maxC       = std::max(maxC, other.maxC);
+        sumSqrC   += other.sumSqrC;
+        maxDLambda = std::max(maxDLambda, other.maxDLambda);
+        count     += other.count;
+    }
+
+    double get(const PbdSolver::ConvergenceCriterion criterion) const
+    {
+        switch (criterion)
+        {
+        case PbdSolver::ConvergenceCriterion::RmsC:
+            return (count == 0) ? 0.0 : std::sqrt(sumSqrC / count);
+        case PbdSolver::ConvergenceCriterion::DeltaLambda:
+            return maxDLambda;
+        case PbdSolver::ConvergenceCriterion::MaxC:
+        default:
+            return maxC;
+        }
+    }
+};
+} // namespace
+
 namespace imstk
 {
 PbdSolver::PbdSolver() :
@@ -26,6 +73,8 @@ PbdSolver::solve()
         m_dataTracker->getStopWatch(DataTracker::ePhysics::SolverTime_ms).start();
     }
 
+    m_residual = 0.0;
+
     size_t                                                          numConstraints = 0;
     const std::vector<std::shared_ptr<PbdConstraint>>&              constraints    = m_constraints->getConstraints();
     const std::vector<std::vector<std::shared_ptr<PbdConstraint>>>& partitionedConstraints = m_constraints->getPartitionedConstraints();
@@ -50,55 +99,92 @@ PbdSolver::solve()
             });
     }
 
-    // Zero out insertion/collision constraints
+    // Zero out insertion/collision constraints, persistent contacts are warm started
+    // with the multipliers of the previous step
     for (auto constraintList : *m_constraintLists)
     {
         const std::vector<PbdConstraint*>& constraintVec = *constraintList;
         numConstraints += constraintVec.size();
         for (size_t j = 0; j < constraintVec.size(); j++)
         {
-            constraintVec[j]->zeroOutLambda();
+            constraintVec[j]->warmStart(*m_state);
         }
     }
 
-    unsigned int i = 0;
-    while (i++ < m_iterations)
+    if (m_solverMode == SolverMode::Jacobi)
     {
-        // Project collision and all external constraints
-        for (auto constraintList : *m_constraintLists)
+        solveJacobi();
+    }
+    else
+    {
+        size_t iter = 0;
+        while (iter < m_iterations)
         {
-            const std::vector<PbdConstraint*>& constraintVec = *constraintList;
-            for (size_t j = 0; j < constraintVec.size(); j++)
+            iter++;
+            const bool checkConvergence = (m_convergenceCriterion != ConvergenceCriterion::None) && (iter >= m_minIterations);
+            PbdResidual residual;
+            tbb::combinable<PbdResidual> partitionResiduals;
+
+            // Project collision and all external constraints
+            for (auto constraintList : *m_constraintLists)
             {
-                constraintVec[j]->projectConstraint(*m_state, m_dt, m_solverType);
+                const std::vector<PbdConstraint*>& constraintVec = *constraintList;
+                for (size_t j = 0; j < constraintVec.size(); j++)
+                {
+                    constraintVec[j]->projectConstraint(*m_state, m_dt, m_solverType);
+                    if (checkConvergence)
+                    {
+                        residual.add(*constraintVec[j]);
+                    }
+                }
             }
-        }
 
-        // Project all internal body constraints
-        for (const auto& constraint : constraints)
-        {
-            constraint->projectConstraint(*m_state, m_dt, m_solverType);
-        }
+            // Project all internal body constraints
+            for (const auto& constraint : constraints)
+            {
+                constraint->projectConstraint(*m_state, m_dt, m_solverType);
+                if (checkConvergence)
+                {
+                    residual.add(*constraint);
+                }
+            }
 
-        for (const auto& constraintPartition : partitionedConstraints)
-        {
-            ParallelUtils::parallelFor(constraintPartition.size(),
-                [&](const size_t idx)
+            for (const auto& constraintPartition : partitionedConstraints)
+            {
+                ParallelUtils::parallelFor(constraintPartition.size(),
+                    [&](const size_t idx)
+                    {
+                        constraintPartition[idx]->projectConstraint(*m_state, m_dt, m_solverType);
+                        if (checkConvergence)
+                        {
+                            partitionResiduals.local().add(*constraintPartition[idx]);
+                        }
+                    });
+                //// Sequential
+                //for (size_t k = 0; k < constraintPartition.size(); k++)
+                //{
+                //    constraintPartition[k]->projectConstraint(invMasses, m_dt, m_solverType, currPositions);
+                //}
+            }
+
+            if (checkConvergence)
+            {
+                partitionResiduals.combine_each([&](const PbdResidual& r) { residual.merge(r); });
+                m_residual = residual.get(m_convergenceCriterion);
+                if (m_residual <= m_convergenceTolerance)
                 {
-                    constraintPartition[idx]->projectConstraint(*m_state, m_dt, m_solverType);
-                });
-            //// Sequential
-            //for (size_t k = 0; k < constraintPartition.size(); k++)
-            //{
-            //    constraintPartition[k]->projectConstraint(invMasses, m_dt, m_solverType, currPositions);
-            //}
+                    break;
+                }
+            }
         }
+        m_iterationsUsed = iter;
     }
 
     if (m_dataTracker)
     {
         m_dataTracker->probeElapsedTime_s(DataTracker::ePhysics::SolverTime_ms);
         m_dataTracker->probe(DataTracker::ePhysics::NumConstraints, numConstraints);
+        m_dataTracker->probe(DataTracker::ePhysics::NumIterations, static_cast<double>(m_iterationsUsed));
 
         for (const auto& constraint : constraints)
         {
@@ -129,4 +215,136 @@ PbdSolver::solve()
         m_dataTracker->probe(DataTracker::ePhysics::AverageC, averageC);
     }
 }
+
+void
+PbdSolver::solveJacobi()
+{
+    PbdState& state = *m_state;
+
+    // Gather all constraints, those that cannot be solved in parallel are projected sequentially
+    m_jacobiConstraints.clear();
+    m_sequentialConstraints.clear();
+    auto addConstraint = [&](PbdConstraint* constraint)
+                         {
+                             if (constraint->getSupportsJacobi())
+                             {
+                                 m_jacobiConstraints.push_back(constraint);
+                             }
+                             else
+                             {
+                                 m_sequentialConstraints.push_back(constraint);
+                             }
+                         };
+    for (auto constraintList : *m_constraintLists)
+    {
+        for (PbdConstraint* constraint : *constraintList)
+        {
+            addConstraint(constraint);
+        }
+    }
+    for (const auto& constraint : m_constraints->getConstraints())
+    {
+        addConstraint(constraint.get());
+    }
+    for (const auto& constraintPartition : m_constraints->getPartitionedConstraints())
+    {
+        for (const auto& constraint : constraintPartition)
+        {
+            addConstraint(constraint.get());
+        }
+    }
+
+    // Size the per particle accumulation buffers
+    const size_t numBodies = state.m_bodies.size();
+    m_jacobiCorrections.resize(numBodies);
+    m_jacobiCounts.resize(numBodies);
+    for (size_t i = 0; i < numBodies; i++)
+    {
+        const std::shared_ptr<VecDataArray<double, 3>>& vertices = state.m_bodies[i]->vertices;
+        const size_t numParticles = (vertices == nullptr) ? 0 : static_cast<size_t>(vertices->size());
+        m_jacobiCorrections[i].resize(numParticles);
+        m_jacobiCounts[i].resize(numParticles);
+    }
+
+    size_t iter = 0;
+    while (iter < m_iterations)
+    {
+        iter++;
+        const bool checkConvergence = (m_convergenceCriterion != ConvergenceCriterion::None) && (iter >= m_minIterations);
+        PbdResidual residual;
+        tbb::combinable<PbdResidual> jacobiResiduals;
+
+        for (size_t i = 0; i < numBodies; i++)
+        {
+            std::fill(m_jacobiCorrections[i].begin(), m_jacobiCorrections[i].end(), Vec3d::Zero());
+            std::fill(m_jacobiCounts[i].begin(), m_jacobiCounts[i].end(), 0);
+        }
+
+        // Project all constraints against the same positions
+        ParallelUtils::parallelFor(m_jacobiConstraints.size(),
+            [&](const size_t idx)
+            {
+                thread_local std::vector<Vec3d> dx;
+                PbdConstraint* constraint = m_jacobiConstraints[idx];
+                const bool     update     = constraint->computeCorrections(state, m_dt, m_solverType, dx);
+                if (checkConvergence)
+                {
+                    jacobiResiduals.local().add(*constraint);
+                }
+                if (update)
+                {
+                    const std::vector<PbdParticleId>& particles = constraint->getParticles();
+                    for (size_t j = 0; j < particles.size(); j++)
+                    {
+                        if (!dx[j].isZero())
+                        {
+                            const PbdParticleId& pid = particles[j];
+                            ParallelUtils::atomicAdd(m_jacobiCorrections[pid.first][pid.second], dx[j]);
+                            ParallelUtils::atomicAdd(m_jacobiCounts[pid.first][pid.second], 1);
+                        }
+                    }
+                }
+            });
+
+        // Apply the averaged corrections
+        for (size_t i = 0; i < numBodies; i++)
+        {
+            if (m_jacobiCounts[i].empty())
+            {
+                continue;
+            }
+            VecDataArray<double, 3>&  vertices    = *state.m_bodies[i]->vertices;
+            const std::vector<Vec3d>& corrections = m_jacobiCorrections[i];
+            const std::vector<int>&   counts      = m_jacobiCounts[i];
+            ParallelUtils::parallelFor(vertices.size(),
+                [&](const int j)
+                {
+                    if (counts[j] > 0)
+                    {
+                        vertices[j] += corrections[j] * (m_jacobiRelaxation / counts[j]);
+                    }
+                }, vertices.size() > 50);
+        }
+
+        for (PbdConstraint* constraint : m_sequentialConstraints)
+        {
+            constraint->projectConstraint(state, m_dt, m_solverType);
+            if (checkConvergence)
+            {
+                residual.add(*constraint);
+            }
+        }
+
+        if (checkConvergence)
+        {
+            jacobiResiduals.combine_each([&](const PbdResidual& r) { residual.merge(r); });
+            m_residual = residual.get(m_convergenceCriterion);
+            if (m_residual <= m_convergenceTolerance)
+            {
+                break;
+            }
+        }
+    }
+    m_iterationsUsed = iter;
+}
 } // namespace imstk
@@ -20,8 +20,35 @@ class PbdConstraintContainer;
 /// This solver can solve both partitioned constraints (unordered_set of vector'd constraints) in parallel
 /// and sequentially on vector'd constraints. It requires a set of constraints, positions, and invMasses.
 ///
+/// In Jacobi mode all constraints are projected in parallel against the same positions. Their
+/// corrections are accumulated per particle and averaged (times a relaxation factor) at the end
+/// of every iteration. This does not need graph coloring but converges slower than Gauss-Seidel.
+/// Constraints that don't support it (see PbdConstraint::getSupportsJacobi) are still projected
+/// sequentially after every Jacobi iteration.
+///
 class PbdSolver : public SolverBase
 {
+public:
+    ///
+    /// \brief How constraints are iterated
+    ///
+    enum class SolverMode
+    {
+        GaussSeidel,  ///< Sequential projection, colored partitions in parallel
+        Jacobi        ///< All constraints in parallel with averaged corrections
+    };
+
+    ///
+    /// \brief Residual measure used to terminate the iterations early
+    ///
+    enum class ConvergenceCriterion
+    {
+        None,        ///< Always run the maximum number of iterations
+        MaxC,        ///< Max absolute constraint violation
+        RmsC,        ///< Root mean square of the constraint violations
+        DeltaLambda  ///< Max absolute change in lagrange multiplier, preferred for compliant xPBD constraints
+    };
+
 public:
     PbdSolver();
     ~PbdSolver() override = default;
@@ -61,11 +88,59 @@ public:
     ///
     size_t getIterations() const { return this->m_iterations; }
 
+    ///
+    /// \brief Set/Get the minimum number of iterations before convergence is checked.
+    /// When a convergence criterion is given the iterations (see setIterations) are the maximum
+    ///@{
+    void setMinIterations(const size_t minIterations) { m_minIterations = minIterations; }
+    size_t getMinIterations() const { return m_minIterations; }
+    ///@}
+
+    ///
+    /// \brief Set/Get the residual measure used for early termination, default None
+    ///@{
+    void setConvergenceCriterion(const ConvergenceCriterion criterion) { m_convergenceCriterion = criterion; }
+    ConvergenceCriterion getConvergenceCriterion() const { return m_convergenceCriterion; }
+    ///@}
+
+    ///
+    /// \brief Set/Get the residual below which iterations stop
+    ///@{
+    void setConvergenceTolerance(const double tolerance) { m_convergenceTolerance = tolerance; }
+    double getConvergenceTolerance() const { return m_convergenceTolerance; }
+    ///@}
+
+    ///
+    /// \brief Get the number of iterations used in the last solve
+    ///
+    size_t getIterationsUsed() const { return m_iterationsUsed; }
+
+    ///
+    /// \brief Get the residual of the last checked iteration of the last solve,
+    /// only computed when a convergence criterion is used
+    ///
+    double getResidual() const { return m_residual; }
+
     ///
     /// \brief Set the PBD solver type
     ///
     void setSolverType(const PbdConstraint::SolverType& type) { m_solverType = type; }
 
+    ///
+    /// \brief Set/Get the way constraints are iterated, default GaussSeidel
+    ///@{
+    void setSolverMode(const SolverMode mode) { m_solverMode = mode; }
+    SolverMode getSolverMode() const { return m_solverMode; }
+    ///@}
+
+    ///
+    /// \brief Set/Get the relaxation factor applied to the averaged Jacobi corrections.
+    /// Values in (1, 2) speed up convergence at the risk of overshoot, default 1.0
+    ///@{
+    void setJacobiRelaxation(const double relaxation) { m_jacobiRelaxation = relaxation; }
+    double getJacobiRelaxation() const { return m_jacobiRelaxation; }
+    ///@}
+
     ///
     /// \brief Solve the non linear system of equations G(x)=0 using Newton's method.
     ///
@@ -81,7 +156,18 @@ public:
     ///
     void clearConstraintLists() { m_constraintLists->clear(); }
 
-private:
+    ///
+    /// \brief Tells the solver the constraints were added, removed or re-parameterized,
+    /// solvers that cache data of the constraints rebuild it on the next solve
+    ///
+    virtual void invalidate() { }
+
+protected:
+    ///
+    /// \brief Runs the iterations in Jacobi mode
+    ///
+    void solveJacobi();
+
     size_t m_iterations = 20;                                        ///< Number of NL Gauss-Seidel iterations for constraints
     double m_dt = 0.0;                                               ///< time step
 
@@ -92,5 +178,21 @@ private:
 
     PbdState* m_state = nullptr;
     PbdConstraint::SolverType m_solverType = PbdConstraint::SolverType::xPBD;
+    SolverMode m_solverMode       = SolverMode::GaussSeidel;
+    double     m_jacobiRelaxation = 1.0;
+
+    size_t m_minIterations = 1;                                                      ///< Iterations always run before checking convergence
+    ConvergenceCriterion m_convergenceCriterion = ConvergenceCriterion::None;
+    double m_convergenceTolerance = 1.0e-6;                                          ///< Residual to stop iterating at
+    size_t m_iterationsUsed       = 0;                                               ///< Iterations run in the last solve
+    double m_residual = 0.0;                                                         ///< Residual of the last solve
+
+    ///< Jacobi buffers, kept between solves to avoid reallocation
+    ///@{
+    std::vector<PbdConstraint*>     m_jacobiConstraints;     ///< Constraints projected in parallel
+    std::vector<PbdConstraint*>     m_sequentialConstraints; ///< Constraints that don't support Jacobi
+    std::vector<std::vector<Vec3d>> m_jacobiCorrections;     ///< Per body, per particle summed corrections
+    std::vector<std::vector<int>>   m_jacobiCounts;          ///< Per body, per particle number of corrections
+    ///@}
 };
 } // namespace imstk
\ No newline at end of file